@@ -0,0 +1,40 @@
+#
+# Try to find LZ4 library and include path.
+# Once done this will define
+#
+# LZ4_FOUND
+# LZ4_INCLUDE_PATH
+# LZ4_LIBRARY
+#
+
+FIND_PATH(LZ4_INCLUDE_PATH lz4.h
+	/usr/include
+	/usr/local/include
+	/sw/include
+	/opt/local/include
+	${LZ4_ROOT_DIR}/include
+	DOC "The directory where lz4.h resides")
+
+# Prefer the static library.
+FIND_LIBRARY(LZ4_LIBRARY
+	NAMES
+		liblz4.a
+		liblz4.so
+		liblz4.dylib
+	PATHS
+		/usr/lib64
+		/usr/lib
+		/usr/local/lib64
+		/usr/local/lib
+		/sw/lib
+		/opt/local/lib
+		${LZ4_ROOT_DIR}/lib
+	DOC
+		"The LZ4 library")
+
+SET(LZ4_FOUND "NO")
+IF(LZ4_INCLUDE_PATH AND LZ4_LIBRARY)
+	SET(LZ4_LIBRARIES ${LZ4_LIBRARY})
+	SET(LZ4_FOUND "YES")
+	message(STATUS "Found LZ4")
+ENDIF()
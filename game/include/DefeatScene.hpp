@@ -90,6 +90,11 @@ private:
 	 * Subscription for window resize events.
 	 */
 	Engine::EventDispatcher::SubscriptionID m_windowResizeSubscription;
+
+	/**
+	 * Handle to the shader program for drawing the user interface.
+	 */
+	Engine::ResourceHandle<Engine::ShaderProgram> m_uiShader;
 };
 
 #endif
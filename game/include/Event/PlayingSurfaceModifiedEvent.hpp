@@ -2,6 +2,7 @@
 #define PLAYINGSURFACEMODIFIEDEVENT_H
 
 #include <Engine/Event/IEvent.hpp>
+#include <Engine/Event/CoalescingPolicy.hpp>
 
 #include "PlayingSurface.hpp"
 
@@ -37,4 +38,21 @@ namespace Event
 	};
 }
 
+namespace Engine
+{
+	namespace Event
+	{
+		/**
+		 * Each event carries a complete copy of the playing surface, so only
+		 * the latest modification needs to be delivered. This avoids
+		 * recalculating paths for every wall placed within a single update.
+		 */
+		template <>
+		struct CoalescingTraits< ::Event::PlayingSurfaceModifiedEvent>
+		{
+			static const CoalescingPolicy Policy = CoalescingPolicy::KeepLatest;
+		};
+	}
+}
+
 #endif
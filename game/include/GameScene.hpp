@@ -6,6 +6,7 @@
 #include <Engine/IGameScene.hpp>
 #include <Engine/GameObject.hpp>
 #include <Engine/Plane.hpp>
+#include <Engine/ResourceManifest.hpp>
 #include <Engine/Event/MouseButtonPressedEvent.hpp>
 #include <Engine/UI/Rectangle.hpp>
 #include <Engine/UI/Font.hpp>
@@ -35,6 +36,14 @@ public:
 	 */
 	virtual ~GameScene();
 
+	/**
+	 * Returns the resources that the scene needs, which should be loaded
+	 * before the scene is pushed.
+	 *
+	 * @return Manifest of the scene's resources.
+	 */
+	static Engine::ResourceManifest GetResourceManifest();
+
 	/**
 	 * Scene was created.
 	 */
@@ -267,6 +276,11 @@ private:
 	 */
 	Engine::UI::Rectangle m_centerPanelBackground;
 
+	/**
+	 * Handle to the shader program for drawing the user interface.
+	 */
+	Engine::ResourceHandle<Engine::ShaderProgram> m_uiShader;
+
 private:
 	/**
 	 * The initial cell for all enemy units.
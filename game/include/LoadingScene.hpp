@@ -2,6 +2,7 @@
 #define	LOADINGSCENE_H
 
 #include <Engine/IScene.hpp>
+#include <Engine/ResourceBundle.hpp>
 #include <Engine/Event/MouseButtonPressedEvent.hpp>
 #include <Engine/UI/Rectangle.hpp>
 
@@ -127,14 +128,14 @@ private:
 	Engine::EventDispatcher::SubscriptionID m_windowResizeSubscription;
 
 	/**
-	 * Number of resource loading requests made.
+	 * Resources being loaded for this scene and the Game Scene.
 	 */
-	unsigned int m_resourceLoadingRequestCount;
+	std::shared_ptr<Engine::ResourceBundle> m_resourceBundle;
 
 	/**
-	 * Number of resource loading requests that have been completed.
+	 * Handle to the shader program for drawing the user interface.
 	 */
-	unsigned int m_resourceLoadingCompleteCount;
+	Engine::ResourceHandle<Engine::ShaderProgram> m_uiShader;
 
 private:
 	/**
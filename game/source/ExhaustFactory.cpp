@@ -31,7 +31,7 @@ void ExhaustFactory::CreateGameObject(std::shared_ptr<Engine::GameObject> gameOb
 	// Add a shader program attribute.
 	std::shared_ptr<Engine::Attribute::ShaderProgram> shaderProgram =
 		gameObject->CreateAttribute<Engine::Attribute::ShaderProgram>(
-			"resources/shaders/Phong.vert",
+			"resources/shaders/Cloud.vert",
 			"resources/shaders/Cloud.frag"
 		);
 
@@ -41,7 +41,7 @@ void ExplosionFactory::CreateGameObject(std::shared_ptr<Engine::GameObject> game
 		// Add a shader program attribute.
 		std::shared_ptr<Engine::Attribute::ShaderProgram> shaderProgram =
 			cloud->CreateAttribute<Engine::Attribute::ShaderProgram>(
-				"resources/shaders/Phong.vert",
+				"resources/shaders/Cloud.vert",
 				"resources/shaders/Cloud.frag"
 			);
 
@@ -68,6 +68,7 @@ GameScene::GameScene(std::shared_ptr<Engine::Window> window,
 , m_roundsLabel()
 , m_metalRemainingLabel()
 , m_centerPanelBackground()
+, m_uiShader(resourceManager->GetShaderProgramHandle("resources/shaders/UI.vert", "resources/shaders/UI.frag"))
 {
 	// Nothing to do.
 }
@@ -78,6 +79,57 @@ GameScene::~GameScene()
 	UnsubscribeForEvents();
 }
 
+Engine::ResourceManifest GameScene::GetResourceManifest()
+{
+	Engine::ResourceManifest manifest;
+
+	// Music and sound effects.
+	manifest.AddAudio("resources/audio/HeroicDemise.wav");
+	manifest.AddAudio("resources/audio/SmallExplosion.wav");
+	manifest.AddAudio("resources/audio/RocketExplosion.wav");
+	manifest.AddAudio("resources/audio/RocketLaunch.wav");
+	manifest.AddAudio("resources/audio/MissileExplosion.wav");
+	manifest.AddAudio("resources/audio/MissileLaunch.wav");
+
+	// Shader programs.
+	manifest.AddShaderProgram("resources/shaders/Phong.vert", "resources/shaders/Phong.frag");
+	manifest.AddShaderProgram("resources/shaders/PhongInstanced.vert", "resources/shaders/Phong.frag");
+	manifest.AddShaderProgram("resources/shaders/Cloud.vert", "resources/shaders/Cloud.frag");
+
+	// Models.
+	manifest.AddModel("resources/models/tank/Tank.dae");
+	manifest.AddModel("resources/models/heavybot/AnimatedHeavyBot.dae");
+	manifest.AddModel("resources/models/scout/Scout.dae");
+	manifest.AddModel("resources/models/range/Range.dae");
+	manifest.AddModel("resources/models/lasertower/LaserTowerBase.dae");
+	manifest.AddModel("resources/models/lasertower/LaserTowerTurret.dae");
+	manifest.AddModel("resources/models/lasertower/Laser.dae");
+	manifest.AddModel("resources/models/rocketlauncher/RocketLauncherBase.dae");
+	manifest.AddModel("resources/models/rocketlauncher/RocketLauncherTurret.dae");
+	manifest.AddModel("resources/models/rocketlauncher/Rocket.dae");
+	manifest.AddModel("resources/models/wall/Wall.dae");
+	manifest.AddModel("resources/models/missilesilo/MissileSilo.dae");
+	manifest.AddModel("resources/models/missilesilo/Missile.dae");
+	manifest.AddModel("resources/models/explosion/Cloud.dae");
+	manifest.AddModel("resources/maps/outlands/Map.obj");
+
+	// User interface textures.
+	manifest.AddTexture("resources/images/BuildLaserTowerButton.png");
+	manifest.AddTexture("resources/images/BuildRocketLauncherButton.png");
+	manifest.AddTexture("resources/images/DeleteButton.png");
+	manifest.AddTexture("resources/images/BuildWallButton.png");
+	manifest.AddTexture("resources/images/BuildMissileSiloButton.png");
+	manifest.AddTexture("resources/images/Heart.png");
+	manifest.AddTexture("resources/images/Metal.png");
+
+	// Textures used by the map.
+	manifest.AddTexture("resources/maps/outlands/HeavyDutyConcrete.png");
+	manifest.AddTexture("resources/maps/outlands/Asphalt.png");
+	manifest.AddTexture("resources/maps/outlands/TerrainTexture.png");
+
+	return manifest;
+}
+
 void GameScene::OnCreate()
 {
 	// Subscribe for events.
@@ -170,6 +222,22 @@ void GameScene::OnCreate()
 	lightTransform->LookAt(glm::vec3(0.0f, 0.0f, 0.0f));
 	light->CreateAttribute<Engine::Attribute::DirectionalLight>();
 
+	// The map's textures are tiled across the terrain.
+	const char* mapTextureFilepaths[] = {
+		"resources/maps/outlands/HeavyDutyConcrete.png",
+		"resources/maps/outlands/Asphalt.png",
+		"resources/maps/outlands/TerrainTexture.png"
+	};
+	for (const char* filepath : mapTextureFilepaths)
+	{
+		std::shared_ptr<Engine::Texture> texture = GetResourceManager()->GetTexture(filepath);
+		if (texture)
+		{
+			texture->SetSmooth(true);
+			texture->SetRepeat(true);
+		}
+	}
+
 	// Create the map.
 	// Note: The width and depth of the playing surface in the map are 1.0.
 	// Therefore, we can scale the map by the value of PLAYING_SURFACE_SIZE
@@ -359,7 +427,7 @@ void GameScene::OnUpdate(double deltaTime)
 void GameScene::OnDrawUI()
 {
 	// Get the UI shader.
-	std::shared_ptr<Engine::ShaderProgram> uiShader = GetResourceManager()->GetShaderProgram("resources/shaders/UI.vert", "resources/shaders/UI.frag");
+	std::shared_ptr<Engine::ShaderProgram> uiShader = GetResourceManager()->GetShaderProgram(m_uiShader);
 
 	// Draw the build tower buttons.
 	DrawShape(m_buildMissileSiloButton, uiShader);
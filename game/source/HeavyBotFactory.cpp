@@ -48,7 +48,7 @@ void HeavyBotFactory::CreateGameObject(std::shared_ptr<Engine::GameObject> gameO
 	transform->SetPosition(m_playingSurface->GetPositionForCell(m_initialCell) - glm::vec3(50.0f, 0.0, 0.0f));
 
 	// Add a shader program attribute.
-	gameObject->CreateAttribute<Engine::Attribute::ShaderProgram>("resources/shaders/Phong.vert", "resources/shaders/Phong.frag");
+	gameObject->CreateAttribute<Engine::Attribute::ShaderProgram>("resources/shaders/PhongInstanced.vert", "resources/shaders/Phong.frag");
 
 	// Add a model attribute.
 	std::shared_ptr<Engine::Attribute::Model> model =
@@ -22,7 +22,7 @@ void LaserFactory::CreateGameObject(std::shared_ptr<Engine::GameObject> gameObje
 
 	// Add a shader program attribute.
 	gameObject->CreateAttribute<Engine::Attribute::ShaderProgram>(
-		"resources/shaders/Phong.vert",
+		"resources/shaders/PhongInstanced.vert",
 		"resources/shaders/Phong.frag"
 	);
 
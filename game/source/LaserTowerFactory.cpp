@@ -36,7 +36,7 @@ void LaserTowerFactory::CreateGameObject(std::shared_ptr<Engine::GameObject> gam
 
 	// Add a shader program to the base.
 	gameObject->CreateAttribute<Engine::Attribute::ShaderProgram>(
-		"resources/shaders/Phong.vert",
+		"resources/shaders/PhongInstanced.vert",
 		"resources/shaders/Phong.frag"
 	);
 
@@ -53,7 +53,7 @@ void LaserTowerFactory::CreateGameObject(std::shared_ptr<Engine::GameObject> gam
 
 	// Add a shader program attribute to the turret.
 	turret->CreateAttribute<Engine::Attribute::ShaderProgram>(
-		"resources/shaders/Phong.vert",
+		"resources/shaders/PhongInstanced.vert",
 		"resources/shaders/Phong.frag"
 	);
 
@@ -11,6 +11,8 @@
 #include <Engine/Event/WindowResizeEvent.hpp>
 #include <Engine/Event/PushSceneEvent.hpp>
 
+#include "GameScene.hpp"
+
 LoadingScene::LoadingScene(std::shared_ptr<Engine::Window> window,
 	std::shared_ptr<Engine::ResourceManager> resourceManager,
 	std::shared_ptr<Engine::EventDispatcher> sceneStackEventDispatcher)
@@ -24,8 +26,8 @@ LoadingScene::LoadingScene(std::shared_ptr<Engine::Window> window,
 , m_nebulaBackground2()
 , m_mouseButtonPressedSubscription(0)
 , m_windowResizeSubscription(0)
-, m_resourceLoadingRequestCount(0)
-, m_resourceLoadingCompleteCount(0)
+, m_resourceBundle()
+, m_uiShader(resourceManager->GetShaderProgramHandle("resources/shaders/UI.vert", "resources/shaders/UI.frag"))
 {
 	// Nothing to do.
 }
@@ -42,13 +44,16 @@ void LoadingScene::OnCreate()
 	SubscribeForEvents();
 
 	// Load shader for rendering the User Interface.
+	// Note: The assets for this scene are needed straight away, so they are
+	// loaded with a high priority, ahead of the assets for the Game Scene.
 	GetResourceManager()->LoadShaderProgram(
 		"resources/shaders/UI.vert",
 		"resources/shaders/UI.frag",
 		[this](const Engine::Event::ResourceLoadedEvent<Engine::ShaderProgram>& event)
 		{
 			// Nothing to do.
-		}
+		},
+		Engine::ResourcePriority::High
 	);
 
 	// Load textures for the scene background.
@@ -59,7 +64,8 @@ void LoadingScene::OnCreate()
 			event.GetResource()->SetRepeat(true);
 			m_starsBackground1.SetTexture(event.GetResource());
 			m_starsBackground2.SetTexture(event.GetResource());
-		}
+		},
+		Engine::ResourcePriority::High
 	);
 	GetResourceManager()->LoadTexture(
 		"resources/images/LoadingSceneBackgroundNebula.png",
@@ -68,7 +74,8 @@ void LoadingScene::OnCreate()
 			event.GetResource()->SetRepeat(true);
 			m_nebulaBackground1.SetTexture(event.GetResource());
 			m_nebulaBackground2.SetTexture(event.GetResource());
-		}
+		},
+		Engine::ResourcePriority::High
 	);
 
 	// Load texture for the start game button.
@@ -77,7 +84,8 @@ void LoadingScene::OnCreate()
 		[this](const Engine::Event::ResourceLoadedEvent<Engine::Texture>& event)
 		{
 			m_startButton.SetTexture(event.GetResource());
-		}
+		},
+		Engine::ResourcePriority::High
 	);
 
 	// Load texture for the title image.
@@ -87,7 +95,8 @@ void LoadingScene::OnCreate()
 		{
 			m_titleImage.SetTexture(event.GetResource());
 			m_titleImage.SetFillColor(glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
-		}
+		},
+		Engine::ResourcePriority::High
 	);
 
 	// Setup loading bar UI element.
@@ -118,310 +127,21 @@ void LoadingScene::OnCreate()
 	PositionUI();
 
 	// Load music for this scene.
-	m_resourceLoadingRequestCount += 1;
 	GetResourceManager()->LoadAudio(
 		"resources/audio/Soliloquy.wav",
 		[this](const Engine::Event::ResourceLoadedEvent<Engine::IAudioSource>& event)
 		{
-			m_resourceLoadingCompleteCount += 1;
 			Engine::Audio::GetInstance().Play(event.GetResource());
-		}
-	);
-
-	// Load music for the Game Scene.
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadAudio(
-		"resources/audio/HeroicDemise.wav",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::IAudioSource>& event)
-		{
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
-
-	// Load sound effects for this scene.
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadAudio(
-		"resources/audio/ButtonSelect.wav",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::IAudioSource>& event)
-		{
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
-
-	// Load sound effects for the Game Scene.
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadAudio(
-		"resources/audio/SmallExplosion.wav",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::IAudioSource>& event)
-		{
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadAudio(
-		"resources/audio/RocketExplosion.wav",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::IAudioSource>& event)
-		{
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadAudio(
-		"resources/audio/RocketLaunch.wav",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::IAudioSource>& event)
-		{
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadAudio(
-		"resources/audio/MissileExplosion.wav",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::IAudioSource>& event)
-		{
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadAudio(
-		"resources/audio/MissileLaunch.wav",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::IAudioSource>& event)
-		{
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
-
-	// Shader programs to load.
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadShaderProgram("resources/shaders/Phong.vert", "resources/shaders/Phong.frag",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::ShaderProgram>& event)
-		{
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadShaderProgram("resources/shaders/Phong.vert", "resources/shaders/Cloud.frag",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::ShaderProgram>& event)
-		{
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
-
-	// Load the tank model.
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadModel("resources/models/tank/Tank.dae",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::Model>& event)
-		{
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
-
-	// Load heavy bot model.
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadModel("resources/models/heavybot/AnimatedHeavyBot.dae",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::Model>& event)
-		{
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
-
-	// Load scout model.
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadModel("resources/models/scout/Scout.dae",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::Model>& event)
-		{
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
-
-	// Load the tower range model.
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadModel("resources/models/range/Range.dae",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::Model>& event)
-		{
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
-
-	// Load the laser tower models.
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadModel("resources/models/lasertower/LaserTowerBase.dae",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::Model>& event)
-		{
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadModel("resources/models/lasertower/LaserTowerTurret.dae",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::Model>& event)
-		{
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadModel("resources/models/lasertower/Laser.dae",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::Model>& event)
-		{
-			m_resourceLoadingCompleteCount += 1;
-		}
+		},
+		Engine::ResourcePriority::High
 	);
 
-	// Load the rocket launcher models.
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadModel("resources/models/rocketlauncher/RocketLauncherBase.dae",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::Model>& event)
-		{
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadModel("resources/models/rocketlauncher/RocketLauncherTurret.dae",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::Model>& event)
-		{
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadModel("resources/models/rocketlauncher/Rocket.dae",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::Model>& event)
-		{
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
-
-	// Load the wall model.
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadModel("resources/models/wall/Wall.dae",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::Model>& event)
-		{
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
-
-	// Load the missile silo models.
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadModel("resources/models/missilesilo/MissileSilo.dae",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::Model>& event)
-		{
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadModel("resources/models/missilesilo/Missile.dae",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::Model>& event)
-		{
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
-
-	// Load the explosion cloud model.
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadModel("resources/models/explosion/Cloud.dae",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::Model>& event)
-		{
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
-
-	// Load the map.
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadModel("resources/maps/outlands/Map.obj",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::Model>& event)
-		{
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
-
-	// Load texture for the "build laser tower" button.
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadTexture("resources/images/BuildLaserTowerButton.png",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::Texture>& event)
-		{
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
-
-	// Load texture for the "build rocket launcher" button.
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadTexture("resources/images/BuildRocketLauncherButton.png",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::Texture>& event)
-		{
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
-
-	// Load texture for the "delete tower" button.
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadTexture("resources/images/DeleteButton.png",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::Texture>& event)
-		{
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
-
-	// Load texture for the "build wall" button.
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadTexture("resources/images/BuildWallButton.png",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::Texture>& event)
-		{
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
-
-	// Load texture for the "build missile silo" button.
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadTexture("resources/images/BuildMissileSiloButton.png",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::Texture>& event)
-		{
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
-
-	// Load texture for the "lives remaining" icon.
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadTexture("resources/images/Heart.png",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::Texture>& event)
-		{
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
-
-	// Load texture for the "metal remaining" icon.
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadTexture("resources/images/Metal.png",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::Texture>& event)
-		{
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
-
-	// Load textures used by the map.
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadTexture("resources/maps/outlands/HeavyDutyConcrete.png",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::Texture>& event)
-		{
-			event.GetResource()->SetSmooth(true);
-			event.GetResource()->SetRepeat(true);
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadTexture("resources/maps/outlands/Asphalt.png",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::Texture>& event)
-		{
-			event.GetResource()->SetSmooth(true);
-			event.GetResource()->SetRepeat(true);
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
-	m_resourceLoadingRequestCount += 1;
-	GetResourceManager()->LoadTexture("resources/maps/outlands/TerrainTexture.png",
-		[this](const Engine::Event::ResourceLoadedEvent<Engine::Texture>& event)
-		{
-			event.GetResource()->SetSmooth(true);
-			event.GetResource()->SetRepeat(true);
-			m_resourceLoadingCompleteCount += 1;
-		}
-	);
+	// Load the sound effects for this scene, along with everything that the
+	// Game Scene needs.
+	Engine::ResourceManifest manifest;
+	manifest.AddAudio("resources/audio/ButtonSelect.wav");
+	manifest.Append(GameScene::GetResourceManifest());
+	m_resourceBundle = GetResourceManager()->LoadBundle(manifest);
 }
 
 void LoadingScene::OnSuspend()
@@ -442,12 +162,8 @@ void LoadingScene::OnResume()
 
 void LoadingScene::OnUpdate(double deltaTime)
 {
-	// Calculate the fraction completion.
-	assert(m_resourceLoadingRequestCount > 0);
-	const float completion = static_cast<float>(m_resourceLoadingCompleteCount) / m_resourceLoadingRequestCount;
-
 	// Update the loading bar.
-	m_loadingBar.SetWidth(GetWindow()->GetWidth() * completion);
+	m_loadingBar.SetWidth(GetWindow()->GetWidth() * m_resourceBundle->GetProgress());
 
 	// Move the background elements.
 	const float starsBackgroundSpeed = -20.0f;
@@ -499,7 +215,7 @@ void LoadingScene::OnUpdate(double deltaTime)
 void LoadingScene::OnDrawUI()
 {
 	// Get the UI shader.
-	std::shared_ptr<Engine::ShaderProgram> uiShader = GetResourceManager()->GetShaderProgram("resources/shaders/UI.vert", "resources/shaders/UI.frag");
+	std::shared_ptr<Engine::ShaderProgram> uiShader = GetResourceManager()->GetShaderProgram(m_uiShader);
 
 	// Draw the background elements first.
 	DrawShape(m_starsBackground1, uiShader);
@@ -509,7 +225,7 @@ void LoadingScene::OnDrawUI()
 
 	// Now draw either the loading bar or the start game button, depending on
 	// whether all of the resources have been loaded.
-	if (m_resourceLoadingCompleteCount != m_resourceLoadingRequestCount)
+	if (!m_resourceBundle->IsComplete())
 	{
 		DrawShape(m_loadingBar, uiShader);
 	}
@@ -33,7 +33,7 @@ void MissileFactory::CreateGameObject(std::shared_ptr<Engine::GameObject> gameOb
 
 	// Add a shader program.
 	gameObject->CreateAttribute<Engine::Attribute::ShaderProgram>(
-		"resources/shaders/Phong.vert",
+		"resources/shaders/PhongInstanced.vert",
 		"resources/shaders/Phong.frag"
 	);
 
@@ -39,7 +39,7 @@ void MissileSiloFactory::CreateGameObject(std::shared_ptr<Engine::GameObject> ga
 	transform->SetScale(scale);
 
 	// Add a shader program.
-	gameObject->CreateAttribute<Engine::Attribute::ShaderProgram>("resources/shaders/Phong.vert", "resources/shaders/Phong.frag");
+	gameObject->CreateAttribute<Engine::Attribute::ShaderProgram>("resources/shaders/PhongInstanced.vert", "resources/shaders/Phong.frag");
 
 	// Add a model attribute.
 	std::shared_ptr<Engine::Attribute::Model> model =
@@ -28,7 +28,7 @@ void RangeFactory::CreateGameObject(std::shared_ptr<Engine::GameObject> gameObje
 
 	// Add a shader program attribute to the Game Object.
 	gameObject->CreateAttribute<Engine::Attribute::ShaderProgram>(
-		"resources/shaders/Phong.vert",
+		"resources/shaders/PhongInstanced.vert",
 		"resources/shaders/Phong.frag"
 	);
 
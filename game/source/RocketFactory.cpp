@@ -30,7 +30,7 @@ void RocketFactory::CreateGameObject(std::shared_ptr<Engine::GameObject> gameObj
 
 	// Add a shader program to the rocket.
 	gameObject->CreateAttribute<Engine::Attribute::ShaderProgram>(
-		"resources/shaders/Phong.vert",
+		"resources/shaders/PhongInstanced.vert",
 		"resources/shaders/Phong.frag"
 	);
 
@@ -35,7 +35,7 @@ void RocketLauncherFactory::CreateGameObject(std::shared_ptr<Engine::GameObject>
 	baseTransform->SetScale(20.0f);
 
 	// Add a shader program to the base.
-	gameObject->CreateAttribute<Engine::Attribute::ShaderProgram>("resources/shaders/Phong.vert", "resources/shaders/Phong.frag");
+	gameObject->CreateAttribute<Engine::Attribute::ShaderProgram>("resources/shaders/PhongInstanced.vert", "resources/shaders/Phong.frag");
 
 	// Add a model attribute to the base.
 	gameObject->CreateAttribute<Engine::Attribute::Model>("resources/models/rocketlauncher/RocketLauncherBase.dae");
@@ -49,7 +49,7 @@ void RocketLauncherFactory::CreateGameObject(std::shared_ptr<Engine::GameObject>
 	turretTransform->SetLocalPosition(glm::vec3(0.0f, 20.0f, 0.0f));
 
 	// Add a shader program attribute to the turret.
-	turret->CreateAttribute<Engine::Attribute::ShaderProgram>("resources/shaders/Phong.vert", "resources/shaders/Phong.frag");
+	turret->CreateAttribute<Engine::Attribute::ShaderProgram>("resources/shaders/PhongInstanced.vert", "resources/shaders/Phong.frag");
 
 	// Add a model attribute to the turret.
 	turret->CreateAttribute<Engine::Attribute::Model>("resources/models/rocketlauncher/RocketLauncherTurret.dae");
@@ -38,7 +38,7 @@ void TankFactory::CreateGameObject(std::shared_ptr<Engine::GameObject> gameObjec
 	transform->SetPosition(m_playingSurface->GetPositionForCell(m_initialCell) - glm::vec3(50.0f, 0.0, 0.0f));
 
 	// Add a shader program.
-	gameObject->CreateAttribute<Engine::Attribute::ShaderProgram>("resources/shaders/Phong.vert", "resources/shaders/Phong.frag");
+	gameObject->CreateAttribute<Engine::Attribute::ShaderProgram>("resources/shaders/PhongInstanced.vert", "resources/shaders/Phong.frag");
 
 	// Add a model attribute.
 	gameObject->CreateAttribute<Engine::Attribute::Model>("resources/models/tank/Tank.dae");
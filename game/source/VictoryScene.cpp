@@ -11,6 +11,7 @@ VictoryScene::VictoryScene(std::shared_ptr<Engine::Window> window,
 , m_victoryLabel()
 , m_timeRemaining(5.0f)
 , m_windowResizeSubscription(0)
+, m_uiShader(resourceManager->GetShaderProgramHandle("resources/shaders/UI.vert", "resources/shaders/UI.frag"))
 {
 	// Nothing to do.
 }
@@ -59,11 +60,7 @@ void VictoryScene::OnUpdate(double deltaTime)
 void VictoryScene::OnDrawUI()
 {
 	// Get the UI shader.
-	std::shared_ptr<Engine::ShaderProgram> uiShader =
-		GetResourceManager()->GetShaderProgram(
-			"resources/shaders/UI.vert",
-			"resources/shaders/UI.frag"
-		);
+	std::shared_ptr<Engine::ShaderProgram> uiShader = GetResourceManager()->GetShaderProgram(m_uiShader);
 
 	// Draw the victory label.
 	DrawShape(m_victoryLabel, uiShader);
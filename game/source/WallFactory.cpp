@@ -22,7 +22,7 @@ void WallFactory::CreateGameObject(std::shared_ptr<Engine::GameObject> gameObjec
 	transform->SetScale(20.0f);
 
 	// Add a shader program attribute.
-	gameObject->CreateAttribute<Engine::Attribute::ShaderProgram>("resources/shaders/Phong.vert", "resources/shaders/Phong.frag");
+	gameObject->CreateAttribute<Engine::Attribute::ShaderProgram>("resources/shaders/PhongInstanced.vert", "resources/shaders/Phong.frag");
 
 	// Add a model attribute.
 	gameObject->CreateAttribute<Engine::Attribute::Model>("resources/models/wall/Wall.dae");
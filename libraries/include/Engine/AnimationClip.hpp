@@ -0,0 +1,263 @@
+#ifndef ANIMATIONCLIP_H
+#define	ANIMATIONCLIP_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+#include <glm/gtx/quaternion.hpp>
+
+namespace Engine
+{
+	/**
+	 * Named animation for the nodes of a model.
+	 *
+	 * A clip holds a track of keyframes for each node that it animates.
+	 * Nodes are identified by their index in the model's flattened node tree,
+	 * so a clip only holds the keyframes, never a copy of the nodes. Any
+	 * number of clips can share one model.
+	 *
+	 * Keyframes are stored compactly. Translations and scales are quantized
+	 * to 16 bits per component over the range covered by their track, and
+	 * rotations are stored as quaternions with 16-bit normalized components.
+	 * Each keyframe takes 24 bytes instead of the 48 bytes needed for full
+	 * precision.
+	 */
+	class AnimationClip
+	{
+	public:
+		/**
+		 * Compact keyframe.
+		 */
+		struct Key
+		{
+			/**
+			 * Time after the start of the clip (in seconds).
+			 */
+			float time;
+
+			/**
+			 * Local translation, quantized over the track's translation
+			 * range.
+			 */
+			std::uint16_t translation[3];
+
+			/**
+			 * Local rotation as a quaternion in x, y, z, w order, with each
+			 * component mapped from [-1, 1] to [-32767, 32767].
+			 */
+			std::int16_t rotation[4];
+
+			/**
+			 * Local scale, quantized over the track's scale range.
+			 */
+			std::uint16_t scale[3];
+		};
+
+		/**
+		 * Keyframes for a single node.
+		 */
+		struct Track
+		{
+			/**
+			 * Index of the animated node in the model's flattened node tree.
+			 */
+			unsigned int node;
+
+			/**
+			 * Index of the track's first keyframe in the clip's keyframes.
+			 * Keyframes are stored in strictly increasing order of time.
+			 */
+			unsigned int firstKey;
+
+			/**
+			 * Number of keyframes in the track (at least one).
+			 */
+			unsigned int keyCount;
+
+			/**
+			 * Smallest translation in the track.
+			 */
+			glm::vec3 translationOrigin;
+
+			/**
+			 * Size of the range of translations in the track.
+			 */
+			glm::vec3 translationExtent;
+
+			/**
+			 * Smallest scale in the track.
+			 */
+			glm::vec3 scaleOrigin;
+
+			/**
+			 * Size of the range of scales in the track.
+			 */
+			glm::vec3 scaleExtent;
+		};
+
+		/**
+		 * Constructor.
+		 *
+		 * @param name Name for the clip.
+		 * @param duration Duration of the clip (in seconds).
+		 */
+		AnimationClip(std::string name, double duration);
+
+		/**
+		 * Destructor.
+		 */
+		~AnimationClip();
+
+		/**
+		 * Returns the name of the clip.
+		 *
+		 * @return Clip name.
+		 */
+		const std::string& GetName() const;
+
+		/**
+		 * Returns the duration of the clip.
+		 *
+		 * @return Clip duration (in seconds).
+		 */
+		double GetDuration() const;
+
+		/**
+		 * Returns the time of the last keyframe in any track.
+		 *
+		 * @return Time of the last keyframe (in seconds).
+		 */
+		double GetLastKeyTime() const;
+
+		/**
+		 * Returns the tracks.
+		 *
+		 * @return Tracks, in the order that they were added.
+		 */
+		const std::vector<Track>& GetTracks() const;
+
+		/**
+		 * Returns the keyframes of all of the tracks.
+		 *
+		 * @return Keyframes, with each track's keyframes stored contiguously.
+		 */
+		const std::vector<Key>& GetKeys() const;
+
+		/**
+		 * Returns the track that animates the specified node.
+		 *
+		 * @param node Index of the node in the flattened node tree.
+		 * @return Pointer to the track, or a nullptr if the clip does not
+		 * animate the node.
+		 */
+		const Track* FindTrack(unsigned int node) const;
+
+		/**
+		 * Returns the index of the track's last keyframe at or before the
+		 * specified time, found by binary search. The first keyframe is
+		 * returned for times before the start of the clip.
+		 *
+		 * @param track The track.
+		 * @param time Time after the start of the clip (in seconds).
+		 * @return Keyframe index, relative to the track's first keyframe.
+		 */
+		unsigned int FindKey(const Track& track, double time) const;
+
+		/**
+		 * Calculates the node's local transformation matrix at the specified
+		 * time. Translations and scales are linearly interpolated between the
+		 * surrounding keyframes, and rotations are spherically interpolated.
+		 * Times outside of the clip use the first or last keyframe.
+		 *
+		 * @param track The node's track.
+		 * @param time Time after the start of the clip (in seconds).
+		 * @return Local transformation matrix.
+		 */
+		glm::mat4 EvaluateTrack(const Track& track, double time) const;
+
+		/**
+		 * Quantizes and adds the keyframes for a node. The arrays must all
+		 * have the same, non-zero, length.
+		 *
+		 * @param node Index of the node in the flattened node tree.
+		 * @param times Keyframe times (in seconds), in strictly increasing
+		 * order.
+		 * @param translations Local translation at each keyframe.
+		 * @param rotations Local rotation at each keyframe.
+		 * @param scales Local scale at each keyframe.
+		 */
+		void AddTrack(unsigned int node, const std::vector<double>& times,
+			const std::vector<glm::vec3>& translations,
+			const std::vector<glm::quat>& rotations,
+			const std::vector<glm::vec3>& scales);
+
+		/**
+		 * Adds keyframes for a node that have already been quantized, such as
+		 * those read from a baked model file.
+		 *
+		 * @param track The track. The first keyframe index is filled in by
+		 * the clip.
+		 * @param keys Pointer to the track's keyframes.
+		 */
+		void AddTrack(Track track, const Key* keys);
+
+		/**
+		 * Returns the bytes of main memory used by the clip.
+		 *
+		 * @return Bytes of main memory.
+		 */
+		std::size_t GetCPUMemoryUsage() const;
+
+		/**
+		 * Decodes the translation of a keyframe.
+		 *
+		 * @param track The keyframe's track.
+		 * @param key The keyframe.
+		 * @return Local translation.
+		 */
+		static glm::vec3 DecodeTranslation(const Track& track, const Key& key);
+
+		/**
+		 * Decodes the rotation of a keyframe.
+		 *
+		 * @param key The keyframe.
+		 * @return Local rotation.
+		 */
+		static glm::quat DecodeRotation(const Key& key);
+
+		/**
+		 * Decodes the scale of a keyframe.
+		 *
+		 * @param track The keyframe's track.
+		 * @param key The keyframe.
+		 * @return Local scale.
+		 */
+		static glm::vec3 DecodeScale(const Track& track, const Key& key);
+
+	private:
+		/**
+		 * Clip name.
+		 */
+		std::string m_name;
+
+		/**
+		 * Clip duration (in seconds).
+		 */
+		double m_duration;
+
+		/**
+		 * Tracks.
+		 */
+		std::vector<Track> m_tracks;
+
+		/**
+		 * Keyframes of all of the tracks.
+		 */
+		std::vector<Key> m_keys;
+	};
+}
+
+#endif
@@ -48,6 +48,21 @@ namespace Engine
 			 */
 			std::string GetPath() const;
 
+			/**
+			 * Returns the handle to the model resource.
+			 *
+			 * @return Handle to the model resource.
+			 */
+			ResourceHandle<Engine::Model> GetResourceHandle() const;
+
+			/**
+			 * Returns a shared pointer to the model resource.
+			 *
+			 * @return Shared pointer to the model resource, or a nullptr if it
+			 * has not been loaded.
+			 */
+			std::shared_ptr<Engine::Model> GetResource() const;
+
 			/**
 			 * Returns true if the model should be rendered.
 			 *
@@ -62,6 +77,25 @@ namespace Engine
 			 */
 			void SetVisible(bool visible);
 
+			/**
+			 * Returns the animation clip being played.
+			 *
+			 * @return Index of the animation clip in the model's clip
+			 * library.
+			 */
+			unsigned int GetAnimationClip() const;
+
+			/**
+			 * Selects the animation clip to play and restarts the animation.
+			 * Clips can be found by name with @see
+			 * Engine::Model::FindAnimationClip. An invalid clip shows the
+			 * model in its bind pose.
+			 *
+			 * @param clip Index of the animation clip in the model's clip
+			 * library.
+			 */
+			void SetAnimationClip(unsigned int clip);
+
 			/**
 			 * Returns the current animation time.
 			 *
@@ -82,9 +116,10 @@ namespace Engine
 			void AdvanceAnimation(double deltaTime);
 
 			/**
-			 * Returns the duration of the animation.
+			 * Returns the duration of the animation clip being played.
 			 *
-			 * @return Animation duration.
+			 * @return Animation duration (in seconds), or zero if the model
+			 * has not been loaded.
 			 */
 			double GetAnimationDuration() const;
 
@@ -108,11 +143,21 @@ namespace Engine
 			 */
 			std::string m_filepath;
 
+			/**
+			 * Handle to the model resource, resolved on construction.
+			 */
+			ResourceHandle<Engine::Model> m_resource;
+
 			/**
 			 * Whether the model should be rendered.
 			 */
 			bool m_visible;
 
+			/**
+			 * Animation clip being played.
+			 */
+			unsigned int m_animationClip;
+
 			/**
 			 * Current animation time.
 			 */
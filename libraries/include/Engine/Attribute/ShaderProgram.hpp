@@ -3,11 +3,14 @@
 
 #include <string>
 #include <memory>
+#include <vector>
+#include <cstdint>
 
 #include <Engine/Attribute/IAttribute.hpp>
 #include <Engine/Window.hpp>
 #include <Engine/ResourceManager.hpp>
 #include <Engine/EventDispatcher.hpp>
+#include <Engine/UniformHandle.hpp>
 
 namespace Engine
 {
@@ -57,6 +60,13 @@ namespace Engine
 			 */
 			std::string GetFragmentShaderPath() const;
 
+			/**
+			 * Returns the handle to the shader program resource.
+			 *
+			 * @return Handle to the shader program resource.
+			 */
+			ResourceHandle<Engine::ShaderProgram> GetResourceHandle() const;
+
 			/**
 			 * Returns a shared pointer to the shader program resource.
 			 *
@@ -73,12 +83,69 @@ namespace Engine
 			/**
 			 * Sets a named float value in the shader.
 			 *
+			 * For an instanced shader program, a value named after one of the
+			 * program's per-instance values (@see
+			 * Engine::ShaderProgram::GetInstanceValues) is drawn per instance.
+			 * Any other value is a uniform shared by the whole instanced
+			 * draw, so game objects only share a draw while they set the
+			 * same values for such uniforms.
+			 *
 			 * @param name Name of the float uniform in the shader.
 			 * @param value Value for the uniform.
 			 */
 			void SetFloat(std::string name, float value);
 
+			/**
+			 * Checks whether another attribute sets the same values for the
+			 * uniforms that the shader program uses, so that game objects
+			 * with either attribute can be drawn with the same uniforms.
+			 * Per-instance values are not compared.
+			 *
+			 * @param other The other attribute.
+			 * @param shaderProgram The shader program resource that both
+			 * attributes refer to.
+			 * @return True if the uniforms are the same.
+			 */
+			bool HasSameUniforms(ShaderProgram& other, Engine::ShaderProgram& shaderProgram);
+
+			/**
+			 * Copies the values that an instanced shader program reads per
+			 * instance (@see Engine::ShaderProgram::GetInstanceValues), in
+			 * order, from the named float values.
+			 *
+			 * @param shaderProgram The shader program resource.
+			 * @param values Array of @see
+			 * Engine::ShaderProgram::MaxInstanceValues values, which are
+			 * zero for the values that have not been set.
+			 */
+			void GetInstanceValues(Engine::ShaderProgram& shaderProgram, float* values);
+
 		private:
+			/**
+			 * Resolves the uniform handles and instance values for the shader
+			 * program, unless they have already been resolved for it.
+			 *
+			 * @param shaderProgram The shader program resource.
+			 */
+			void Resolve(Engine::ShaderProgram& shaderProgram);
+
+			/**
+			 * Floating point value to be set in the shader.
+			 */
+			struct FloatUniform
+			{
+				/**
+				 * Value for the uniform.
+				 */
+				float value;
+
+				/**
+				 * Handle to the uniform in the shader program that the
+				 * handles were last resolved for.
+				 */
+				UniformHandle handle;
+			};
+
 			/**
 			 * Path to the vertex shader.
 			 */
@@ -89,10 +156,37 @@ namespace Engine
 			 */
 			std::string m_fragmentShaderFilepath;
 
+			/**
+			 * Handle to the shader program resource, resolved on
+			 * construction.
+			 */
+			ResourceHandle<Engine::ShaderProgram> m_resource;
+
 			/**
 			 * Named floating point values to be set in the shader.
 			 */
-			std::unordered_map<std::string, float> m_floatUniforms;
+			std::unordered_map<std::string, FloatUniform> m_floatUniforms;
+
+			/**
+			 * Named floating point values that the shader program uses as
+			 * uniforms, in order of their uniform location. These point into
+			 * m_floatUniforms.
+			 */
+			std::vector<const FloatUniform*> m_usedUniforms;
+
+			/**
+			 * Value read by each of the shader program's per-instance values,
+			 * or NULL if the value has not been set. These point into
+			 * m_floatUniforms, whose elements are never removed.
+			 */
+			const float* m_instanceValues[Engine::ShaderProgram::MaxInstanceValues];
+
+			/**
+			 * Link serial (@see Engine::ShaderProgram::GetLinkSerial) of the
+			 * shader program that the uniform handles and instance values
+			 * were resolved for, or zero if they need to be resolved again.
+			 */
+			std::uint64_t m_resolvedLinkSerial;
 		};
 	}
 }
@@ -0,0 +1,209 @@
+#ifndef BAKEDMODELFORMAT_H
+#define	BAKEDMODELFORMAT_H
+
+#include <cstdint>
+
+namespace Engine
+{
+	/**
+	 * Layout of baked model files.
+	 *
+	 * A baked model holds exactly the data that @see Model builds from an
+	 * ASSIMP import, so that it can be loaded without ASSIMP. The file starts
+	 * with a @see Header followed by tightly packed arrays of fixed-size
+	 * records. Records refer to each other by index and to variable-length
+	 * data by byte offset, never by pointer, so the file can be memory mapped
+	 * and read in place.
+	 *
+	 * Every section starts on an 8 byte boundary. All values are stored in
+	 * the byte order of the machine that baked the file (little endian on
+	 * all supported platforms). Matrices are stored column-major, as in GLM.
+	 */
+	namespace BakedModelFormat
+	{
+		/**
+		 * Identifies a baked model file.
+		 */
+		const char Magic[4] = {'T', 'R', 'M', 'B'};
+
+		/**
+		 * Current format version. This must be incremented whenever the
+		 * layout, or the processing applied to imported models, changes.
+		 * Files with a different version are rejected and the source model
+		 * is imported instead.
+		 */
+		const std::uint32_t Version = 5;
+
+		/**
+		 * Alignment of each section (in bytes).
+		 */
+		const std::uint32_t SectionAlignment = 8;
+
+		/**
+		 * File header.
+		 */
+		struct Header
+		{
+			char magic[4];
+			std::uint32_t version;
+
+			std::uint32_t materialCount;
+			std::uint32_t materialsOffset;
+
+			std::uint32_t nodeCount;
+			std::uint32_t nodesOffset;
+
+			std::uint32_t meshCount;
+			std::uint32_t meshesOffset;
+
+			std::uint32_t clipCount;
+			std::uint32_t clipsOffset;
+
+			std::uint32_t trackCount;
+			std::uint32_t tracksOffset;
+
+			std::uint32_t keyframeCount;
+			std::uint32_t keyframesOffset;
+
+			/**
+			 * Strings are stored back to back, without terminators.
+			 */
+			std::uint32_t stringsOffset;
+			std::uint32_t stringsSize;
+		};
+
+		/**
+		 * Reference to a string in the strings section.
+		 */
+		struct String
+		{
+			std::uint32_t offset;
+			std::uint32_t length;
+		};
+
+		/**
+		 * Material record.
+		 */
+		struct Material
+		{
+			String name;
+			float diffuseColor[3];
+			float specularColor[3];
+			float ambientColor[3];
+			float emissiveColor[3];
+			float shininess;
+
+			/**
+			 * Path to the diffuse texture relative to the directory that
+			 * contains the model, or an empty string if there is none.
+			 */
+			String diffuseTexturePath;
+		};
+
+		/**
+		 * Node record.
+		 *
+		 * Nodes are stored in depth-first order, so a node's parent is always
+		 * stored before it. The root node comes first.
+		 */
+		struct Node
+		{
+			String name;
+
+			/**
+			 * Index of the parent node, or -1 for the root node.
+			 */
+			std::int32_t parentIndex;
+
+			float bindTransformationMatrix[16];
+
+			/**
+			 * The node's meshes are stored contiguously.
+			 */
+			std::uint32_t firstMesh;
+			std::uint32_t meshCount;
+		};
+
+		/**
+		 * Mesh record.
+		 *
+		 * The vertex data offsets are absolute byte offsets into the file.
+		 * Positions, normals and texture coordinates are vertexCount
+		 * consecutive 3 component float vectors. Indices are indexCount
+		 * 32-bit unsigned integers.
+		 */
+		struct Mesh
+		{
+			std::uint32_t materialIndex;
+			std::uint32_t vertexCount;
+			std::uint32_t indexCount;
+			std::uint32_t positionsOffset;
+			std::uint32_t normalsOffset;
+			std::uint32_t textureCoordinatesOffset;
+			std::uint32_t indicesOffset;
+
+			/**
+			 * Number of indices of each lower level of detail, stored back
+			 * to back as 32-bit unsigned integers. Levels that were not
+			 * generated have no indices.
+			 */
+			std::uint32_t lodIndexCounts[2];
+			std::uint32_t lodIndicesOffset;
+		};
+
+		/**
+		 * Animation clip record.
+		 *
+		 * A clip's tracks are stored contiguously.
+		 */
+		struct Clip
+		{
+			String name;
+			double duration;
+			std::uint32_t firstTrack;
+			std::uint32_t trackCount;
+		};
+
+		/**
+		 * Animation track record, as held by @see AnimationClip::Track.
+		 *
+		 * The node is identified by its index in the nodes section. A track's
+		 * keyframes are stored contiguously.
+		 */
+		struct Track
+		{
+			std::uint32_t nodeIndex;
+			std::uint32_t firstKeyframe;
+			std::uint32_t keyframeCount;
+			float translationOrigin[3];
+			float translationExtent[3];
+			float scaleOrigin[3];
+			float scaleExtent[3];
+		};
+
+		/**
+		 * Keyframe record, quantized as described by @see
+		 * AnimationClip::Key.
+		 *
+		 * A track's keyframes are stored in strictly increasing order of
+		 * time. Rotations are stored as quaternions in x, y, z, w order.
+		 */
+		struct Keyframe
+		{
+			float time;
+			std::uint16_t translation[3];
+			std::int16_t rotation[4];
+			std::uint16_t scale[3];
+		};
+
+		static_assert(sizeof(Header) == 64, "Unexpected padding in BakedModelFormat::Header");
+		static_assert(sizeof(Material) == 68, "Unexpected padding in BakedModelFormat::Material");
+		static_assert(sizeof(Node) == 84, "Unexpected padding in BakedModelFormat::Node");
+		static_assert(sizeof(Mesh) == 40, "Unexpected padding in BakedModelFormat::Mesh");
+		static_assert(sizeof(Clip) == 24, "Unexpected padding in BakedModelFormat::Clip");
+		static_assert(sizeof(Track) == 60, "Unexpected padding in BakedModelFormat::Track");
+		static_assert(sizeof(Keyframe) == 24, "Unexpected padding in BakedModelFormat::Keyframe");
+	}
+}
+
+#endif
@@ -0,0 +1,206 @@
+#ifndef BOUNDEDMPSCQUEUE_H
+#define	BOUNDEDMPSCQUEUE_H
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <utility>
+
+#include <Engine/NonCopyable.hpp>
+
+namespace Engine
+{
+	/**
+	 * Bounded lock-free multiple-producer single-consumer queue.
+	 *
+	 * The queue is a ring buffer in which every cell carries a sequence number
+	 * that tells producers and the consumer whether the cell is free or holds
+	 * a value for the current lap of the ring. Producers claim cells with a
+	 * single compare-and-swap on the enqueue position; the consumer never
+	 * contends with producers.
+	 *
+	 * @note Push may be called from any thread. Pop and Empty may only be
+	 * called from the single consumer thread.
+	 */
+	template <typename T>
+	class BoundedMPSCQueue : private NonCopyable
+	{
+	public:
+		/**
+		 * Constructor.
+		 *
+		 * @param capacity Maximum number of values that the queue can hold.
+		 * This must be a power of two.
+		 */
+		explicit BoundedMPSCQueue(std::size_t capacity)
+		: m_cells(new Cell[capacity])
+		, m_mask(capacity - 1)
+		, m_enqueuePosition(0)
+		, m_padding()
+		, m_dequeuePosition(0)
+		{
+			assert(capacity >= 2 && (capacity & (capacity - 1)) == 0);
+
+			for (std::size_t i = 0; i < capacity; ++i)
+			{
+				m_cells[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		/**
+		 * Destructor.
+		 */
+		~BoundedMPSCQueue()
+		{
+			// Nothing to do.
+		}
+
+		/**
+		 * Tries to push the supplied value onto the back of the queue.
+		 *
+		 * @param value Value to push onto the queue.
+		 * @return True if the value was pushed, false if the queue is full.
+		 */
+		bool TryPush(T&& value)
+		{
+			Cell* cell = nullptr;
+			std::size_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+
+			for (;;)
+			{
+				cell = &m_cells[position & m_mask];
+				const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+				const std::intptr_t difference = static_cast<std::intptr_t>(sequence) -
+					static_cast<std::intptr_t>(position);
+
+				if (difference == 0)
+				{
+					// The cell is free for this lap. Try to claim it.
+					if (m_enqueuePosition.compare_exchange_weak(position, position + 1,
+						std::memory_order_relaxed))
+					{
+						break;
+					}
+				}
+				else if (difference < 0)
+				{
+					// The consumer has not yet released the cell from the
+					// previous lap. The queue is full.
+					return false;
+				}
+				else
+				{
+					// Another producer claimed the cell first.
+					position = m_enqueuePosition.load(std::memory_order_relaxed);
+				}
+			}
+
+			// Store the value and publish it to the consumer.
+			cell->value = std::move(value);
+			cell->sequence.store(position + 1, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 * Tries to pop the value at the front of the queue.
+		 *
+		 * @param value Receives the popped value.
+		 * @return True if a value was popped, false if the queue is empty.
+		 */
+		bool TryPop(T& value)
+		{
+			Cell& cell = m_cells[m_dequeuePosition & m_mask];
+			if (!IsPublished(cell))
+			{
+				return false;
+			}
+
+			// Take the value and release the cell for the next lap.
+			value = std::move(cell.value);
+			cell.value = T();
+			cell.sequence.store(m_dequeuePosition + m_mask + 1, std::memory_order_release);
+			++m_dequeuePosition;
+			return true;
+		}
+
+		/**
+		 * Returns true if the queue is empty.
+		 *
+		 * @return True if the queue is empty.
+		 */
+		bool Empty() const
+		{
+			return !IsPublished(m_cells[m_dequeuePosition & m_mask]);
+		}
+
+	private:
+		/**
+		 * Assumed cache line size (in bytes).
+		 */
+		static const std::size_t CacheLineSize = 64;
+
+		/**
+		 * Ring buffer cell.
+		 */
+		struct Cell
+		{
+			/**
+			 * Sequence number used to synchronise producers and the consumer.
+			 */
+			std::atomic<std::size_t> sequence;
+
+			/**
+			 * Stored value.
+			 */
+			T value;
+		};
+
+		/**
+		 * Returns true if a producer has published a value in the cell at the
+		 * current dequeue position.
+		 *
+		 * @param cell Cell at the current dequeue position.
+		 * @return True if the cell holds a value.
+		 */
+		bool IsPublished(const Cell& cell) const
+		{
+			const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+			return static_cast<std::intptr_t>(sequence) -
+				static_cast<std::intptr_t>(m_dequeuePosition + 1) >= 0;
+		}
+
+	private:
+		/**
+		 * Ring buffer cells.
+		 */
+		std::unique_ptr<Cell[]> m_cells;
+
+		/**
+		 * Mask used to map positions to cell indices.
+		 */
+		const std::size_t m_mask;
+
+		/**
+		 * Position of the next cell to be claimed by a producer.
+		 */
+		std::atomic<std::size_t> m_enqueuePosition;
+
+		/**
+		 * Keeps the enqueue and dequeue positions on separate cache lines to
+		 * avoid false sharing between producers and the consumer.
+		 *
+		 * @note Padding is used rather than alignas, since C++11 operator new
+		 * does not honour extended alignments.
+		 */
+		char m_padding[CacheLineSize];
+
+		/**
+		 * Position of the next cell to be read by the consumer.
+		 */
+		std::size_t m_dequeuePosition;
+	};
+}
+
+#endif
@@ -5,6 +5,7 @@
 #include <glm/gtx/quaternion.hpp>
 
 #include <Engine/Event/IEvent.hpp>
+#include <Engine/Event/CoalescingPolicy.hpp>
 
 namespace Engine
 {
@@ -41,6 +42,22 @@ namespace Engine
 			 */
 			glm::quat m_delta;
 		};
+
+		/**
+		 * Rotations are composed, with the incoming rotation applied after the
+		 * pending rotation.
+		 */
+		template <>
+		struct CoalescingTraits<AncestorTransformRotatedEvent>
+		{
+			static const CoalescingPolicy Policy = CoalescingPolicy::Merge;
+
+			static AncestorTransformRotatedEvent Merge(const AncestorTransformRotatedEvent& pending,
+				const AncestorTransformRotatedEvent& incoming)
+			{
+				return AncestorTransformRotatedEvent(incoming.GetDelta() * pending.GetDelta());
+			}
+		};
 	}
 }
 
@@ -4,6 +4,7 @@
 #include <glm/glm.hpp>
 
 #include <Engine/Event/IEvent.hpp>
+#include <Engine/Event/CoalescingPolicy.hpp>
 
 namespace Engine
 {
@@ -40,6 +41,21 @@ namespace Engine
 			 */
 			glm::vec3 m_delta;
 		};
+
+		/**
+		 * Scale factors are multiplied together.
+		 */
+		template <>
+		struct CoalescingTraits<AncestorTransformScaledEvent>
+		{
+			static const CoalescingPolicy Policy = CoalescingPolicy::Merge;
+
+			static AncestorTransformScaledEvent Merge(const AncestorTransformScaledEvent& pending,
+				const AncestorTransformScaledEvent& incoming)
+			{
+				return AncestorTransformScaledEvent(pending.GetDelta() * incoming.GetDelta());
+			}
+		};
 	}
 }
 
@@ -4,6 +4,7 @@
 #include <glm/glm.hpp>
 
 #include <Engine/Event/IEvent.hpp>
+#include <Engine/Event/CoalescingPolicy.hpp>
 
 namespace Engine
 {
@@ -40,6 +41,21 @@ namespace Engine
 			 */
 			glm::vec3 m_delta;
 		};
+
+		/**
+		 * Translations are additive, so pending translations are summed.
+		 */
+		template <>
+		struct CoalescingTraits<AncestorTransformTranslatedEvent>
+		{
+			static const CoalescingPolicy Policy = CoalescingPolicy::Merge;
+
+			static AncestorTransformTranslatedEvent Merge(const AncestorTransformTranslatedEvent& pending,
+				const AncestorTransformTranslatedEvent& incoming)
+			{
+				return AncestorTransformTranslatedEvent(pending.GetDelta() + incoming.GetDelta());
+			}
+		};
 	}
 }
 
@@ -0,0 +1,194 @@
+#ifndef COALESCINGPOLICY_H
+#define	COALESCINGPOLICY_H
+
+#include <memory>
+#include <queue>
+#include <set>
+#include <utility>
+
+namespace Engine
+{
+	namespace Event
+	{
+		/**
+		 * Policies that determine how an event is combined with events of the
+		 * same type that are already waiting in an Event Dispatcher's queue.
+		 */
+		enum class CoalescingPolicy
+		{
+			/**
+			 * Every enqueued event is delivered (default).
+			 */
+			None,
+
+			/**
+			 * Only the most recently enqueued event is delivered. The event
+			 * retains the queue position of the first pending event.
+			 */
+			KeepLatest,
+
+			/**
+			 * Pending events are combined into a single event using
+			 * CoalescingTraits<EventType>::Merge.
+			 */
+			Merge,
+
+			/**
+			 * An event is discarded if an event with an equal key, as returned
+			 * by CoalescingTraits<EventType>::GetKey, is already pending.
+			 */
+			UniqueByKey
+		};
+
+		/**
+		 * Declares the coalescing policy for an event type.
+		 *
+		 * Event types that should be coalesced must specialize this template
+		 * in the header that declares the event. Specializations for the
+		 * Merge policy must provide:
+		 *
+		 *     static EventType Merge(const EventType& pending, const EventType& incoming);
+		 *
+		 * Specializations for the UniqueByKey policy must provide a KeyType
+		 * typedef that is less-than comparable and:
+		 *
+		 *     static KeyType GetKey(const EventType& event);
+		 */
+		template <typename EventType>
+		struct CoalescingTraits
+		{
+			static const CoalescingPolicy Policy = CoalescingPolicy::None;
+		};
+
+		/**
+		 * Applies the coalescing policy for an event type to the queue of
+		 * pending events held by a specific dispatcher.
+		 */
+		template <typename EventType, CoalescingPolicy Policy = CoalescingTraits<EventType>::Policy>
+		class Coalescer;
+
+		/**
+		 * Coalescer for events that are never coalesced.
+		 */
+		template <typename EventType>
+		class Coalescer<EventType, CoalescingPolicy::None>
+		{
+		public:
+			/**
+			 * Adds the event to the queue.
+			 *
+			 * @param queue Queue of pending events.
+			 * @param event Event being enqueued.
+			 * @return True if a new entry was added to the queue.
+			 */
+			bool Enqueue(std::queue<std::shared_ptr<EventType>>& queue, std::shared_ptr<EventType>&& event)
+			{
+				queue.push(std::move(event));
+				return true;
+			}
+
+			/**
+			 * Notifies the coalescer that the event has been removed from the
+			 * queue.
+			 *
+			 * @param event The removed event.
+			 */
+			void Release(const EventType& event)
+			{
+				// Nothing to do.
+			}
+		};
+
+		/**
+		 * Coalescer for events that replace any pending event.
+		 */
+		template <typename EventType>
+		class Coalescer<EventType, CoalescingPolicy::KeepLatest>
+		{
+		public:
+			bool Enqueue(std::queue<std::shared_ptr<EventType>>& queue, std::shared_ptr<EventType>&& event)
+			{
+				// At most one event of this type is ever pending.
+				if (!queue.empty())
+				{
+					queue.back() = std::move(event);
+					return false;
+				}
+
+				queue.push(std::move(event));
+				return true;
+			}
+
+			void Release(const EventType& event)
+			{
+				// Nothing to do.
+			}
+		};
+
+		/**
+		 * Coalescer for events that are merged into any pending event.
+		 */
+		template <typename EventType>
+		class Coalescer<EventType, CoalescingPolicy::Merge>
+		{
+		public:
+			bool Enqueue(std::queue<std::shared_ptr<EventType>>& queue, std::shared_ptr<EventType>&& event)
+			{
+				// At most one event of this type is ever pending.
+				if (!queue.empty())
+				{
+					queue.back() = std::make_shared<EventType>(
+						CoalescingTraits<EventType>::Merge(*queue.back(), *event)
+					);
+					return false;
+				}
+
+				queue.push(std::move(event));
+				return true;
+			}
+
+			void Release(const EventType& event)
+			{
+				// Nothing to do.
+			}
+		};
+
+		/**
+		 * Coalescer for events that are discarded when an event with the
+		 * same key is already pending.
+		 */
+		template <typename EventType>
+		class Coalescer<EventType, CoalescingPolicy::UniqueByKey>
+		{
+		public:
+			/**
+			 * Key type definition.
+			 */
+			typedef typename CoalescingTraits<EventType>::KeyType KeyType;
+
+			bool Enqueue(std::queue<std::shared_ptr<EventType>>& queue, std::shared_ptr<EventType>&& event)
+			{
+				if (m_pendingKeys.insert(CoalescingTraits<EventType>::GetKey(*event)).second)
+				{
+					queue.push(std::move(event));
+					return true;
+				}
+
+				return false;
+			}
+
+			void Release(const EventType& event)
+			{
+				m_pendingKeys.erase(CoalescingTraits<EventType>::GetKey(event));
+			}
+
+		private:
+			/**
+			 * Keys of the events that are currently pending.
+			 */
+			std::set<KeyType> m_pendingKeys;
+		};
+	}
+}
+
+#endif
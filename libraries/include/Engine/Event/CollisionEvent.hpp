@@ -3,8 +3,10 @@
 
 #include <string>
 #include <memory>
+#include <tuple>
 
 #include <Engine/Event/IEvent.hpp>
+#include <Engine/Event/CoalescingPolicy.hpp>
 #include <Engine/GameObject.hpp>
 
 namespace Engine
@@ -25,8 +27,8 @@ namespace Engine
 			 * geometry that was involved in the collision.
 			 */
 			CollisionEvent(std::shared_ptr<GameObject> otherGameObject,
-				const std::string otherBoundingGeometryTag,
-				const std::string thisBoundingGeometryTag);
+				std::string otherBoundingGeometryTag,
+				std::string thisBoundingGeometryTag);
 
 			/**
 			 * Destructor.
@@ -76,6 +78,28 @@ namespace Engine
 			 */
 			std::string m_thisBoundingGeometryTag;
 		};
+
+		/**
+		 * A pair of Game Objects may be found to collide several times before
+		 * the event queue is processed. Only the first collision between a
+		 * given pair of bounding geometries is delivered.
+		 */
+		template <>
+		struct CoalescingTraits<CollisionEvent>
+		{
+			static const CoalescingPolicy Policy = CoalescingPolicy::UniqueByKey;
+
+			typedef std::tuple<GameObject::ID, std::string, std::string> KeyType;
+
+			static KeyType GetKey(const CollisionEvent& event)
+			{
+				return KeyType(
+					event.GetOtherGameObject()->GetId(),
+					event.GetOtherBoundingGeometryTag(),
+					event.GetThisBoundingGeometryTag()
+				);
+			}
+		};
 	}
 }
 
@@ -7,6 +7,7 @@
 
 #include <Engine/Event/IEvent.hpp>
 #include <Engine/Event/ResourceLoadedEvent.hpp>
+#include <Engine/ResourcePriority.hpp>
 
 namespace Engine
 {
@@ -21,10 +22,12 @@ namespace Engine
 			 * @param name Name used to identify the resource.
 			 * @param filepath Filepath Path to the audio file.
 			 * @param callback Callback function.
+			 * @param priority Loading priority.
 			 */
 			LoadAudioResourceEvent(std::string name,
 				std::string filepath,
-				std::function<void(const ResourceLoadedEvent<IAudioSource>&)> callback);
+				std::function<void(const ResourceLoadedEvent<IAudioSource>&)> callback,
+				ResourcePriority priority);
 
 			/**
 			 * Destructor.
@@ -51,6 +54,13 @@ namespace Engine
 			 */
 			std::function<void(const ResourceLoadedEvent<IAudioSource>&)> GetCallback() const;
 
+			/**
+			 * Returns the priority with which the resource should be loaded.
+			 *
+			 * @return Loading priority.
+			 */
+			ResourcePriority GetPriority() const;
+
 		private:
 			/**
 			 * The resource name.
@@ -66,6 +76,11 @@ namespace Engine
 			 * The callback function.
 			 */
 			std::function<void(const ResourceLoadedEvent<IAudioSource>&)> m_callback;
+
+			/**
+			 * Loading priority.
+			 */
+			ResourcePriority m_priority;
 		};
 	}
 }
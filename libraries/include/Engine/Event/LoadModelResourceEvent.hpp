@@ -6,6 +6,7 @@
 
 #include <Engine/Event/IEvent.hpp>
 #include <Engine/Event/ResourceLoadedEvent.hpp>
+#include <Engine/ResourcePriority.hpp>
 
 namespace Engine
 {
@@ -20,9 +21,11 @@ namespace Engine
 			 * @param name Name used to identify the resource.
 			 * @param filepath Filepath Path to the model file.
 			 * @param callback Callback function.
+			 * @param priority Loading priority.
 			 */
 			LoadModelResourceEvent(std::string name, std::string filepath,
-				std::function<void(const ResourceLoadedEvent<Model>&)> callback);
+				std::function<void(const ResourceLoadedEvent<Model>&)> callback,
+				ResourcePriority priority);
 
 			/**
 			 * Destructor.
@@ -49,6 +52,13 @@ namespace Engine
 			 */
 			std::function<void(const ResourceLoadedEvent<Model>&)> GetCallback() const;
 
+			/**
+			 * Returns the priority with which the resource should be loaded.
+			 *
+			 * @return Loading priority.
+			 */
+			ResourcePriority GetPriority() const;
+
 		private:
 			/**
 			 * Name to identify the resource.
@@ -64,6 +74,11 @@ namespace Engine
 			 * Callback function.
 			 */
 			std::function<void(const ResourceLoadedEvent<Model>&)> m_callback;
+
+			/**
+			 * Loading priority.
+			 */
+			ResourcePriority m_priority;
 		};
 	}
 }
@@ -6,6 +6,7 @@
 
 #include <Engine/Event/IEvent.hpp>
 #include <Engine/Event/ResourceLoadedEvent.hpp>
+#include <Engine/ResourcePriority.hpp>
 #include <Engine/ShaderProgram.hpp>
 
 namespace Engine
@@ -22,10 +23,12 @@ namespace Engine
 			 * @param vertexShaderFilepath Path to the vertex shader.
 			 * @param fragmentShaderFilepath Path to the fragment shader.
 			 * @param callback Callback function.
+			 * @param priority Loading priority.
 			 */
-			LoadShaderProgramResourceEvent(const std::string name,
+			LoadShaderProgramResourceEvent(std::string name,
 				std::string vertexShaderFilepath, std::string fragmentShaderFilepath,
-				std::function<void(const ResourceLoadedEvent<ShaderProgram>&)> callback);
+				std::function<void(const ResourceLoadedEvent<ShaderProgram>&)> callback,
+				ResourcePriority priority);
 
 			/**
 			 * Destructor.
@@ -59,6 +62,13 @@ namespace Engine
 			 */
 			std::function<void(const ResourceLoadedEvent<ShaderProgram>&)> GetCallback() const;
 
+			/**
+			 * Returns the priority with which the resource should be loaded.
+			 *
+			 * @return Loading priority.
+			 */
+			ResourcePriority GetPriority() const;
+
 		private:
 			/**
 			 * Name to identify the resource.
@@ -79,6 +89,11 @@ namespace Engine
 			 * Callback function.
 			 */
 			std::function<void(const ResourceLoadedEvent<ShaderProgram>&)> m_callback;
+
+			/**
+			 * Loading priority.
+			 */
+			ResourcePriority m_priority;
 		};
 	}
 }
@@ -5,6 +5,7 @@
 
 #include <Engine/Event/IEvent.hpp>
 #include <Engine/Event/ResourceLoadedEvent.hpp>
+#include <Engine/ResourcePriority.hpp>
 #include <Engine/Texture.hpp>
 
 namespace Engine
@@ -20,10 +21,12 @@ namespace Engine
 			 * @param name Name used to identify the resource.
 			 * @param filepath Filepath Path to the texture file.
 			 * @param callback Callback function.
+			 * @param priority Loading priority.
 			 */
 			LoadTextureResourceEvent(std::string name,
 				std::string filepath,
-				std::function<void(const ResourceLoadedEvent<Texture>&)> callback);
+				std::function<void(const ResourceLoadedEvent<Texture>&)> callback,
+				ResourcePriority priority);
 
 			/**
 			 * Destructor.
@@ -50,6 +53,13 @@ namespace Engine
 			 */
 			std::function<void(const ResourceLoadedEvent<Texture>&)> GetCallback() const;
 
+			/**
+			 * Returns the priority with which the resource should be loaded.
+			 *
+			 * @return Loading priority.
+			 */
+			ResourcePriority GetPriority() const;
+
 		private:
 			/**
 			 * The resource name.
@@ -65,6 +75,11 @@ namespace Engine
 			 * The callback function.
 			 */
 			std::function<void(const ResourceLoadedEvent<Texture>&)> m_callback;
+
+			/**
+			 * Loading priority.
+			 */
+			ResourcePriority m_priority;
 		};
 	}
 }
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <functional>
+#include <utility>
 
 #include <Engine/Event/IEvent.hpp>
 #include <Engine/Model.hpp>
@@ -26,10 +27,10 @@ namespace Engine
 			ResourceLoadedEvent(std::string name, bool loadedSuccessfully,
 				std::shared_ptr<ResourceType> resource,
 				std::function<void(const ResourceLoadedEvent&)> callback)
-			: m_name(name)
+			: m_name(std::move(name))
 			, m_loadedSuccessfully(loadedSuccessfully)
-			, m_resource(resource)
-			, m_callback(callback)
+			, m_resource(std::move(resource))
+			, m_callback(std::move(callback))
 			{
 				// Nothing to do.
 			}
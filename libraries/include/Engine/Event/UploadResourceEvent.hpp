@@ -0,0 +1,49 @@
+#ifndef UPLOADRESOURCEEVENT_H
+#define	UPLOADRESOURCEEVENT_H
+
+#include <functional>
+
+#include <Engine/Event/IEvent.hpp>
+
+namespace Engine
+{
+	namespace Event
+	{
+		/**
+		 * Sent from a decoding worker to the loading thread once a resource
+		 * has been decoded. The upload function sends the decoded data to the
+		 * graphics card and notifies the game thread.
+		 */
+		class UploadResourceEvent : public IEvent
+		{
+		public:
+			/**
+			 * Constructor.
+			 *
+			 * @param upload Function to execute on the loading thread.
+			 */
+			UploadResourceEvent(std::function<void()> upload);
+
+			/**
+			 * Destructor.
+			 */
+			virtual ~UploadResourceEvent();
+
+			/**
+			 * Returns the function that should be executed on the loading
+			 * thread.
+			 *
+			 * @return Upload function.
+			 */
+			const std::function<void()>& GetUpload() const;
+
+		private:
+			/**
+			 * Upload function.
+			 */
+			std::function<void()> m_upload;
+		};
+	}
+}
+
+#endif
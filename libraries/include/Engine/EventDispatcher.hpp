@@ -8,9 +8,11 @@
 #include <cassert>
 #include <functional>
 #include <typeindex>
+#include <utility>
 
 #include <Engine/NonCopyable.hpp>
 #include <Engine/Event/IEvent.hpp>
+#include <Engine/Event/CoalescingPolicy.hpp>
 
 /**
  * Creates callback function from the passed member function.
@@ -72,34 +74,43 @@ namespace Engine
 		/**
 		 * Immediately dispatch an event to subscribers.
 		 *
+		 * @note The arguments are perfectly forwarded to the event
+		 * constructor, so rvalue payloads are moved rather than copied.
+		 *
 		 * @param args... Event constructor arguments.
 		 */
 		template <typename EventType, typename... Arguments>
-		void Dispatch(const Arguments... args)
+		void Dispatch(Arguments&&... args)
 		{
 			std::shared_ptr<SpecificDispatcher<EventType>> dispatcher = GetSpecificDispatcher<EventType>();
 			assert(dispatcher);
-			dispatcher->Dispatch(args...);
+			dispatcher->Dispatch(std::forward<Arguments>(args)...);
 		}
 
 		/**
 		 * Queue an event to be dispatched to subscribers on the next Update
 		 * call.
 		 *
+		 * @note The event is constructed in place from the perfectly forwarded
+		 * arguments. It may be coalesced with a pending event of the same
+		 * type, as declared by Event::CoalescingTraits<EventType>.
+		 *
 		 * @param args... Event constructor arguments.
 		 */
 		template <typename EventType, typename... Arguments>
-		void Enqueue(const Arguments... args)
+		void Enqueue(Arguments&&... args)
 		{
 			// Get the dispatcher for the event type.
 			std::shared_ptr<SpecificDispatcher<EventType>> dispatcher = GetSpecificDispatcher<EventType>();
 			assert(dispatcher);
 
-			// Enqueue the event on the specific dispatcher.
-			dispatcher->Enqueue(args...);
-
-			// Record the event in the order list.
-			m_eventOrder.emplace(typeid(EventType));
+			// Enqueue the event on the specific dispatcher and record the
+			// event in the order list, unless it was coalesced with an event
+			// that is already pending.
+			if (dispatcher->Enqueue(std::forward<Arguments>(args)...))
+			{
+				m_eventOrder.emplace(typeid(EventType));
+			}
 		}
 
 		/**
@@ -147,6 +158,7 @@ namespace Engine
 			 */
 			SpecificDispatcher()
 			: m_eventQueue()
+			, m_coalescer()
 			, m_callbacks()
 			{
 				// Nothing to do.
@@ -195,12 +207,12 @@ namespace Engine
 			 * @param args... Event constructor arguments.
 			 */
 			template <typename... Arguments>
-			void Dispatch(const Arguments... args)
+			void Dispatch(Arguments&&... args)
 			{
-				EventType event(args...);
+				const EventType event(std::forward<Arguments>(args)...);
 				for (auto iter = m_callbacks.begin(); iter != m_callbacks.end(); ++iter)
 				{
-					std::function<void(EventType& event)> callback = iter->second;
+					const std::function<void(const EventType&)>& callback = iter->second;
 					assert(callback);
 					callback(event);
 				}
@@ -211,11 +223,13 @@ namespace Engine
 			 * call.
 			 *
 			 * @param args... Event constructor arguments.
+			 * @return True if a new entry was added to the queue, false if the
+			 * event was coalesced with a pending event.
 			 */
 			template <typename... Arguments>
-			void Enqueue(const Arguments... args)
+			bool Enqueue(Arguments&&... args)
 			{
-				m_eventQueue.push(std::make_shared<EventType>(args...));
+				return m_coalescer.Enqueue(m_eventQueue, std::make_shared<EventType>(std::forward<Arguments>(args)...));
 			}
 
 			/**
@@ -229,11 +243,12 @@ namespace Engine
 					// Retrieve and remove the first event in the queue.
 					std::shared_ptr<EventType> event = m_eventQueue.front();
 					m_eventQueue.pop();
+					m_coalescer.Release(*event);
 
 					// Publish the event to all subscribers.
 					for (auto iter = m_callbacks.begin(); iter != m_callbacks.end(); ++iter)
 					{
-						std::function<void(const EventType& event)> callback = iter->second;
+						const std::function<void(const EventType&)>& callback = iter->second;
 						callback(*event);
 					}
 				}
@@ -245,6 +260,11 @@ namespace Engine
 			 */
 			std::queue<std::shared_ptr<EventType>> m_eventQueue;
 
+			/**
+			 * Applies the coalescing policy for the event type.
+			 */
+			Event::Coalescer<EventType> m_coalescer;
+
 			/**
 			 * Event callback handlers.
 			 */
@@ -0,0 +1,68 @@
+#ifndef FRUSTUM_H
+#define	FRUSTUM_H
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <Engine/Plane.hpp>
+
+namespace Engine
+{
+	/**
+	 * Volume of space that is visible through a camera, bounded by six
+	 * planes whose normals point inwards.
+	 */
+	class Frustum
+	{
+	public:
+		/**
+		 * Constructor. Extracts the planes from a combined projection and
+		 * view matrix, so that the frustum is in the world space.
+		 *
+		 * @param viewProjectionMatrix Projection matrix multiplied by the
+		 * view matrix.
+		 */
+		Frustum(const glm::mat4& viewProjectionMatrix);
+
+		/**
+		 * Destructor.
+		 */
+		~Frustum();
+
+		/**
+		 * Returns the planes that bound the frustum.
+		 *
+		 * @return The left, right, bottom, top, near and far planes.
+		 */
+		const std::vector<Plane>& GetPlanes() const;
+
+		/**
+		 * Checks whether a sphere is at least partly inside the frustum.
+		 *
+		 * @param center Center of the sphere.
+		 * @param radius Radius of the sphere.
+		 * @return False if the sphere is entirely outside the frustum.
+		 */
+		bool IntersectsSphere(const glm::vec3& center, float radius) const;
+
+		/**
+		 * Checks whether an axis-aligned box is at least partly inside the
+		 * frustum. Boxes near the frustum's corners may be reported as
+		 * intersecting when they are just outside.
+		 *
+		 * @param minimum Minimum corner of the box.
+		 * @param maximum Maximum corner of the box.
+		 * @return False if the box is entirely outside the frustum.
+		 */
+		bool IntersectsBox(const glm::vec3& minimum, const glm::vec3& maximum) const;
+
+	private:
+		/**
+		 * Planes bounding the frustum.
+		 */
+		std::vector<Plane> m_planes;
+	};
+}
+
+#endif
@@ -5,6 +5,7 @@
 #include <vector>
 #include <unordered_map>
 #include <typeindex>
+#include <utility>
 #include <cassert>
 
 #include <Engine/NonCopyable.hpp>
@@ -114,9 +115,9 @@ namespace Engine
 		 * @param args... Event constructor arguments.
 		 */
 		template <typename EventType, typename... Arguments>
-		void EnqueueEvent(Arguments... args)
+		void EnqueueEvent(Arguments&&... args)
 		{
-			m_eventDispatcher->Enqueue<EventType>(args...);
+			m_eventDispatcher->Enqueue<EventType>(std::forward<Arguments>(args)...);
 		}
 
 		/**
@@ -126,9 +127,9 @@ namespace Engine
 		 * @param args... Event constructor arguments.
 		 */
 		template <typename EventType, typename... Arguments>
-		void DispatchEvent(Arguments... args)
+		void DispatchEvent(Arguments&&... args)
 		{
-			m_eventDispatcher->Dispatch<EventType>(args...);
+			m_eventDispatcher->Dispatch<EventType>(std::forward<Arguments>(args)...);
 		}
 
 		/**
@@ -138,7 +139,7 @@ namespace Engine
 		 * @param args... Event constructor arguments.
 		 */
 		template <typename EventType, typename... Arguments>
-		void BroadcastEnqueue(const Arguments... args)
+		void BroadcastEnqueue(const Arguments&... args)
 		{
 			EnqueueEvent<EventType>(args...);
 			DescendantBroadcastEnqueue<EventType>(args...);
@@ -151,7 +152,7 @@ namespace Engine
 		 * @param args... Event constructor arguments.
 		 */
 		template <typename EventType, typename... Arguments>
-		void BroadcastDispatch(const Arguments... args)
+		void BroadcastDispatch(const Arguments&... args)
 		{
 			DispatchEvent<EventType>(args...);
 			DescendantBroadcastDispatch<EventType>(args...);
@@ -163,7 +164,7 @@ namespace Engine
 		 * @param args... Event constructor arguments.
 		 */
 		template <typename EventType, typename... Arguments>
-		void DescendantBroadcastEnqueue(const Arguments... args)
+		void DescendantBroadcastEnqueue(const Arguments&... args)
 		{
 			for (unsigned int i = 0; i < GetChildCount(); ++i)
 			{
@@ -177,7 +178,7 @@ namespace Engine
 		 * @param args... Event constructor arguments.
 		 */
 		template <typename EventType, typename... Arguments>
-		void DescendantBroadcastDispatch(const Arguments... args)
+		void DescendantBroadcastDispatch(const Arguments&... args)
 		{
 			for (unsigned int i = 0; i < GetChildCount(); ++i)
 			{
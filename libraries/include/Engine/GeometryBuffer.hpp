@@ -0,0 +1,239 @@
+#ifndef GEOMETRYBUFFER_H
+#define	GEOMETRYBUFFER_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <GL/glew.h>
+
+#include <Engine/NonCopyable.hpp>
+#include <Engine/RangeAllocator.hpp>
+#include <Engine/VertexFormat.hpp>
+
+namespace Engine
+{
+	/**
+	 * Engine-wide store for the vertices and indices of static meshes.
+	 *
+	 * Meshes are sub-allocated from large shared buffers, grouped into pages
+	 * that each hold a single vertex layout. Every page has one Vertex Array
+	 * Object, so consecutive meshes on the same page are drawn without
+	 * rebinding anything, using glDrawElementsBaseVertex() with the offsets of
+	 * the mesh's allocation.
+	 *
+	 * Allocations are made on the loading thread and the Vertex Array Objects
+	 * are created on the render thread (they are not shared between
+	 * contexts), so access to the pages is synchronised.
+	 */
+	class GeometryBuffer : private NonCopyable
+	{
+	public:
+		/**
+		 * Page identifier of an empty allocation.
+		 */
+		static const unsigned int InvalidPage = ~0u;
+
+		/**
+		 * Size of the vertex buffer of each page (in bytes). Meshes too large
+		 * for a page are given a page of their own.
+		 */
+		static const std::size_t PageVertexBufferSize = 4 * 1024 * 1024;
+
+		/**
+		 * Size of the index buffer of each page (in bytes).
+		 */
+		static const std::size_t PageIndexBufferSize = 2 * 1024 * 1024;
+
+		/**
+		 * Alignment of the indices in the index buffers (in bytes), so that
+		 * both 16-bit and 32-bit indices can be stored.
+		 */
+		static const std::size_t IndexAlignment = 4;
+
+		/**
+		 * Location of a mesh's vertices and indices.
+		 */
+		struct Allocation
+		{
+			/**
+			 * Page that holds the mesh, or InvalidPage if nothing is
+			 * allocated.
+			 */
+			unsigned int page;
+
+			/**
+			 * Layout of the vertices.
+			 */
+			VertexFormat::Layout layout;
+
+			/**
+			 * Index of the first vertex in the page's vertex buffer. This is
+			 * added to every index when drawing.
+			 */
+			std::size_t baseVertex;
+
+			/**
+			 * Number of vertices.
+			 */
+			std::size_t vertexCount;
+
+			/**
+			 * Offset of the first index in the page's index buffer (in
+			 * bytes).
+			 */
+			std::size_t indexOffset;
+
+			/**
+			 * Size of the indices (in bytes).
+			 */
+			std::size_t indexSize;
+
+			/**
+			 * Constructor.
+			 */
+			Allocation();
+		};
+
+		/**
+		 * Returns the geometry buffer.
+		 *
+		 * @return Reference to the single geometry buffer instance.
+		 */
+		static GeometryBuffer& GetInstance();
+
+		/**
+		 * Allocates space for a mesh and uploads its vertices and indices.
+		 * Must be called with an OpenGL context current.
+		 *
+		 * @param layout Layout of the vertices.
+		 * @param vertices Interleaved vertices.
+		 * @param vertexCount Number of vertices.
+		 * @param indices Vertex indices, relative to the first vertex of the
+		 * mesh.
+		 * @param indexSize Size of the indices (in bytes).
+		 * @return Location of the mesh. Nothing is allocated for a mesh
+		 * without vertices or indices.
+		 */
+		Allocation Upload(VertexFormat::Layout layout,
+			const void* vertices, std::size_t vertexCount,
+			const void* indices, std::size_t indexSize);
+
+		/**
+		 * Returns the space used by a mesh to the pages it was allocated
+		 * from. This does not touch OpenGL, so it may be called from any
+		 * thread.
+		 *
+		 * @param allocation Location returned by Upload().
+		 */
+		void Free(const Allocation& allocation);
+
+		/**
+		 * Returns the Vertex Array Object for a page, creating it if
+		 * necessary. Must only be called from the render thread.
+		 *
+		 * @param page Page identifier.
+		 * @return Vertex Array Object identifier.
+		 */
+		GLuint GetVertexArray(unsigned int page);
+
+		/**
+		 * Returns the number of pages that have been created.
+		 *
+		 * @return Number of pages.
+		 */
+		unsigned int GetPageCount() const;
+
+		/**
+		 * Returns the bytes of graphics memory used by the pages.
+		 *
+		 * @return Bytes of graphics memory.
+		 */
+		std::size_t GetGPUMemoryUsage() const;
+
+	private:
+		/**
+		 * Shared vertex and index buffers for meshes with one vertex layout.
+		 */
+		struct Page
+		{
+			/**
+			 * Layout of the vertices in the page.
+			 */
+			VertexFormat::Layout layout;
+
+			/**
+			 * Vertex buffer.
+			 */
+			GLuint vertexBuffer;
+
+			/**
+			 * Index buffer.
+			 */
+			GLuint indexBuffer;
+
+			/**
+			 * Allocates the vertex buffer, in vertices.
+			 */
+			RangeAllocator vertexAllocator;
+
+			/**
+			 * Allocates the index buffer, in bytes.
+			 */
+			RangeAllocator indexAllocator;
+
+			/**
+			 * Vertex Array Object, created on the render thread.
+			 */
+			GLuint vertexArray;
+
+			/**
+			 * Constructor.
+			 *
+			 * @param layout Layout of the vertices.
+			 * @param vertexCapacity Number of vertices in the vertex buffer.
+			 * @param indexCapacity Size of the index buffer (in bytes).
+			 */
+			Page(VertexFormat::Layout layout, std::size_t vertexCapacity, std::size_t indexCapacity);
+		};
+
+		/**
+		 * Constructor.
+		 */
+		GeometryBuffer();
+
+		/**
+		 * Destructor.
+		 *
+		 * The buffers are not deleted, because the OpenGL contexts have been
+		 * destroyed by the time that static objects are. They are released
+		 * with the contexts.
+		 */
+		~GeometryBuffer();
+
+		/**
+		 * Creates a page and its buffers.
+		 *
+		 * @param layout Layout of the vertices.
+		 * @param vertexCount Minimum number of vertices that the page must
+		 * hold.
+		 * @param indexSize Minimum size of the index buffer (in bytes).
+		 * @return Identifier of the new page.
+		 */
+		unsigned int CreatePage(VertexFormat::Layout layout, std::size_t vertexCount, std::size_t indexSize);
+
+	private:
+		/**
+		 * Pages, indexed by page identifier.
+		 */
+		std::vector<std::unique_ptr<Page>> m_pages;
+
+		/**
+		 * Guards the pages.
+		 */
+		mutable std::mutex m_mutex;
+	};
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define	ISCENE_H
 
 #include <memory>
+#include <utility>
 
 #include <Engine/NonCopyable.hpp>
 #include <Engine/Window.hpp>
@@ -38,9 +39,9 @@ namespace Engine
 		 * @param args... Event constructor arguments.
 		 */
 		template <typename EventType, typename... Arguments>
-		void EnqueueEvent(Arguments... args)
+		void EnqueueEvent(Arguments&&... args)
 		{
-			m_eventDispatcher->Enqueue<EventType>(args...);
+			m_eventDispatcher->Enqueue<EventType>(std::forward<Arguments>(args)...);
 		}
 
 		/**
@@ -49,9 +50,9 @@ namespace Engine
 		 * @param args... Event constructor arguments.
 		 */
 		template <typename EventType, typename... Arguments>
-		void DispatchEvent(Arguments... args)
+		void DispatchEvent(Arguments&&... args)
 		{
-			m_eventDispatcher->Dispatch<EventType>(args...);
+			m_eventDispatcher->Dispatch<EventType>(std::forward<Arguments>(args)...);
 		}
 
 		/**
@@ -100,6 +101,15 @@ namespace Engine
 		 */
 		virtual void OnDrawUI() = 0;
 
+		/**
+		 * Returns the identifier for the scene's resource group. Resources
+		 * added to the group are released when the scene is popped off the
+		 * scene stack.
+		 *
+		 * @return Resource group identifier.
+		 */
+		ResourceManager::GroupID GetResourceGroup() const;
+
 	protected:
 		/**
 		 * Implement this method to perform actions on each state update.
@@ -158,6 +168,11 @@ namespace Engine
 		 */
 		std::shared_ptr<ResourceManager> m_resourceManager;
 
+		/**
+		 * Resource group for the scene.
+		 */
+		ResourceManager::GroupID m_resourceGroup;
+
 		/**
 		 * Shared pointer to the scene stack's event dispatcher.
 		 */
@@ -0,0 +1,83 @@
+#ifndef MEMORYMAPPEDFILE_H
+#define	MEMORYMAPPEDFILE_H
+
+#include <string>
+#include <cstddef>
+
+#include <Engine/NonCopyable.hpp>
+
+namespace Engine
+{
+	/**
+	 * Read-only view of a file mapped into the address space of the process.
+	 *
+	 * The operating system pages the file in on demand, so opening a large
+	 * file is cheap and only the parts that are actually read are loaded.
+	 */
+	class MemoryMappedFile : private NonCopyable
+	{
+	public:
+		/**
+		 * Constructor.
+		 */
+		MemoryMappedFile();
+
+		/**
+		 * Destructor.
+		 *
+		 * Unmaps the file if it is open.
+		 */
+		~MemoryMappedFile();
+
+		/**
+		 * Maps the specified file into memory. Any previously mapped file is
+		 * unmapped first.
+		 *
+		 * @param filepath Path to the file to map.
+		 * @return True if the file was successfully mapped. Empty files
+		 * cannot be mapped.
+		 */
+		bool Open(std::string filepath);
+
+		/**
+		 * Unmaps the file.
+		 */
+		void Close();
+
+		/**
+		 * Returns true if a file is currently mapped.
+		 *
+		 * @return True if a file is mapped.
+		 */
+		bool IsOpen() const;
+
+		/**
+		 * Returns a pointer to the start of the mapped file. The mapping is
+		 * page aligned.
+		 *
+		 * @return Pointer to the file contents, or a nullptr if no file is
+		 * mapped.
+		 */
+		const unsigned char* GetData() const;
+
+		/**
+		 * Returns the size of the mapped file.
+		 *
+		 * @return Size of the file (in bytes).
+		 */
+		std::size_t GetSize() const;
+
+	private:
+		/**
+		 * Start of the mapping.
+		 */
+		const unsigned char* m_data;
+
+		/**
+		 * Size of the mapping (in bytes).
+		 */
+		std::size_t m_size;
+	};
+}
+
+#endif
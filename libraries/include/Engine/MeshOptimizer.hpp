@@ -0,0 +1,83 @@
+#ifndef MESHOPTIMIZER_H
+#define	MESHOPTIMIZER_H
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace Engine
+{
+	/**
+	 * Reorders the triangles and vertices of indexed triangle meshes so that
+	 * they are drawn faster, without changing what is drawn.
+	 *
+	 * Triangles are first ordered for the post-transform vertex cache (Tom
+	 * Forsyth's linear-speed algorithm), then split into clusters that are
+	 * drawn outward facing first to reduce overdraw (Sander, Nehab and
+	 * Barczak), and finally vertices are stored in the order that they are
+	 * first used so that vertex fetches read memory sequentially.
+	 */
+	namespace MeshOptimizer
+	{
+		/**
+		 * Number of vertices in the FIFO post-transform vertex cache that
+		 * the cache miss ratio is measured with.
+		 */
+		const unsigned int DefaultCacheSize = 16;
+
+		/**
+		 * Returns the average cache miss ratio (ACMR) of a mesh: the number
+		 * of vertices transformed per triangle drawn with a FIFO
+		 * post-transform vertex cache. This lies between about 0.5 for a
+		 * perfectly ordered regular grid and 3 when no vertex is reused.
+		 *
+		 * @param indices Vertex indices, three per triangle.
+		 * @param vertexCount Number of vertices.
+		 * @param cacheSize Number of vertices that the cache holds.
+		 * @return Average cache miss ratio, or zero if there are no
+		 * triangles.
+		 */
+		float CalculateAcmr(const std::vector<unsigned int>& indices, std::size_t vertexCount, unsigned int cacheSize);
+
+		/**
+		 * Reorders triangles so that their vertices are reused from the
+		 * post-transform vertex cache as often as possible. The winding of
+		 * each triangle is kept.
+		 *
+		 * @param indices Vertex indices, three per triangle.
+		 * @param vertexCount Number of vertices.
+		 * @return Reordered vertex indices.
+		 */
+		std::vector<unsigned int> OptimizeVertexCache(const std::vector<unsigned int>& indices, std::size_t vertexCount);
+
+		/**
+		 * Reorders clusters of triangles, previously ordered for the vertex
+		 * cache, so that outward facing clusters are drawn first and hide
+		 * the clusters behind them. Clusters are split where doing so keeps
+		 * the cache miss ratio of the mesh within the specified threshold.
+		 *
+		 * @param positions Vertex positions.
+		 * @param indices Vertex indices, three per triangle, in vertex cache
+		 * order.
+		 * @param threshold Largest factor by which the cache miss ratio may
+		 * grow, such as 1.05 for 5%.
+		 * @return Reordered vertex indices.
+		 */
+		std::vector<unsigned int> OptimizeOverdraw(const std::vector<glm::vec3>& positions,
+			const std::vector<unsigned int>& indices, float threshold);
+
+		/**
+		 * Returns a new index for every vertex such that vertices are stored
+		 * in the order that the indices first use them. Vertices that are
+		 * never used are moved to the end.
+		 *
+		 * @param indices Vertex indices.
+		 * @param vertexCount Number of vertices.
+		 * @return New index of each vertex.
+		 */
+		std::vector<unsigned int> GenerateVertexFetchRemap(const std::vector<unsigned int>& indices, std::size_t vertexCount);
+	}
+}
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef MESHSIMPLIFIER_H
+#define	MESHSIMPLIFIER_H
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace Engine
+{
+	/**
+	 * Reduces the triangle count of indexed triangle meshes for lower levels
+	 * of detail.
+	 *
+	 * Edges are collapsed in order of increasing quadric error (Garland and
+	 * Heckbert), always onto one of the edge's existing vertices, so the
+	 * simplified triangles index the original vertices and no new vertex data
+	 * is needed. Vertices that share a position, such as those along texture
+	 * seams, are collapsed together so that no cracks open up. Edges on the
+	 * border of the mesh are weighted to keep the silhouette, and collapses
+	 * that would flip a triangle are rejected.
+	 */
+	namespace MeshSimplifier
+	{
+		/**
+		 * Simplifies a mesh to about the specified number of indices. The
+		 * result may have more indices than requested when no further edge
+		 * can be collapsed.
+		 *
+		 * @param positions Vertex positions.
+		 * @param indices Vertex indices, three per triangle.
+		 * @param targetIndexCount Number of indices to simplify to.
+		 * @return Vertex indices of the simplified triangles.
+		 */
+		std::vector<unsigned int> Simplify(const std::vector<glm::vec3>& positions,
+			const std::vector<unsigned int>& indices, std::size_t targetIndexCount);
+	}
+}
+
+#endif
@@ -5,6 +5,8 @@
 #include <vector>
 #include <map>
 #include <memory>
+#include <cstddef>
+#include <cstdint>
 
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
@@ -17,9 +19,14 @@
 #include <assimp/postprocess.h>
 
 #include <Engine/NonCopyable.hpp>
+#include <Engine/AnimationClip.hpp>
+#include <Engine/GeometryBuffer.hpp>
+#include <Engine/ResourceHandle.hpp>
 
 namespace Engine
 {
+	class Texture;
+
 	class Model : private NonCopyable
 	{
 	public:
@@ -43,6 +50,13 @@ namespace Engine
 			 */
 			void SetName(const std::string name);
 
+			/**
+			 * Returns the name of the material.
+			 *
+			 * @return Material name.
+			 */
+			std::string GetName() const;
+
 			/**
 			 * Returns the diffuse color for the material.
 			 *
@@ -127,6 +141,21 @@ namespace Engine
 			 */
 			void SetDiffuseTexturePath(std::string diffuseTexturePath);
 
+			/**
+			 * Returns the handle to the diffuse texture for the material.
+			 *
+			 * @return Handle to the diffuse texture. The handle is invalid
+			 * until it has been resolved by the resource manager.
+			 */
+			ResourceHandle<Texture> GetDiffuseTexture() const;
+
+			/**
+			 * Sets the handle to the diffuse texture for the material.
+			 *
+			 * @param diffuseTexture Handle to the diffuse texture.
+			 */
+			void SetDiffuseTexture(ResourceHandle<Texture> diffuseTexture);
+
 		private:
 			/**
 			 * Name (may not be unique).
@@ -162,111 +191,126 @@ namespace Engine
 			 * Path to the diffuse texture.
 			 */
 			std::string m_diffuseTexturePath;
+
+			/**
+			 * Handle to the diffuse texture.
+			 */
+			ResourceHandle<Texture> m_diffuseTexture;
 		};
 
 		/**
 		 * Node.
 		 *
 		 * Nodes have a transformation matrix, which transforms
-		 * vectors in the node space to the model space, and
-		 * zero or more keyframes. They can also contain meshes.
+		 * vectors in the node space to the model space. They can
+		 * also contain meshes. Nodes are animated by the model's
+		 * animation clips.
 		 */
 		class Node : private NonCopyable, public std::enable_shared_from_this<Node>
 		{
 		public:
 			/**
-			 * Keyframe.
+			 * Mesh.
 			 *
-			 * Represents an animation keyframe. This contains a time
-			 * at which the keyframe occurs after the start of the
-			 * animation in addition to the node's transformation
-			 * matrix to be used at that time.
+			 * Meshes contain vertices and faces.
 			 */
-			class Keyframe : private NonCopyable
+			class Mesh : private NonCopyable
 			{
 			public:
 				/**
 				 * Constructor.
-				 *
-				 * @param time Time at which the keyframe occurs in seconds
-				 * after the start of the animation.
-				 * @param transformationMatrix Transformation matrix for the
-				 * node at the keyframe time.
 				 */
-				Keyframe(double time, const glm::mat4& transformationMatrix);
+				Mesh();
 
 				/**
 				 * Destructor.
 				 */
-				~Keyframe();
+				~Mesh();
 
 				/**
-				 * Returns the time (in seconds) after the start of the
-				 * animation at which the keyframe is scheduled.
+				 * Returns the number of indices in the mesh.
 				 *
-				 * @return Scheduled time (in seconds).
+				 * @return Number of indices.
 				 */
-				double GetTime() const;
+				unsigned int GetIndicesCount() const;
 
 				/**
-				 * Returns the local transformation matrix for the node at the
-				 * keyframe.
+				 * Returns the number of vertices in the mesh.
 				 *
-				 * @return Node's local transformation matrix at the keyframe.
+				 * @return Number of vertices.
 				 */
-				const glm::mat4& GetLocalTransformationMatrix() const;
+				unsigned int GetVerticesCount() const;
 
 				/**
-				 * Transforms the keyframe by the specified transformation
-				 * matrix.
+				 * Returns the bytes of main memory used by the vertex data.
 				 *
-				 * @param transform Transformation matrix to apply.
+				 * @return Bytes of main memory.
 				 */
-				void Transform(const glm::mat4& transform);
+				std::size_t GetCPUMemoryUsage() const;
 
-			private:
 				/**
-				 * Time at which the keyframe occurs (in seconds)
+				 * Returns the size of the interleaved vertices that the
+				 * vertex data is uploaded as, within its material group.
+				 *
+				 * @see VertexFormat
+				 *
+				 * @return Size of the vertex buffer (in bytes).
 				 */
-				double m_time;
+				std::size_t GetVertexBufferSize() const;
 
 				/**
-				 * Local transformation matrix for the node.
+				 * Returns the size of the index buffer that the vertex indices
+				 * of every level of detail are uploaded as.
+				 *
+				 * @return Size of the index buffer (in bytes).
 				 */
-				glm::mat4 m_transformationMatrix;
-			};
+				std::size_t GetIndexBufferSize() const;
 
-			/**
-			 * Mesh.
-			 *
-			 * Meshes contain vertices and faces.
-			 */
-			class Mesh : private NonCopyable
-			{
-			public:
 				/**
-				 * Constructor.
+				 * Returns the number of levels of detail, including the full
+				 * detail mesh.
+				 *
+				 * @return Number of levels of detail (at least one).
 				 */
-				Mesh();
+				unsigned int GetLodCount() const;
 
 				/**
-				 * Destructor.
+				 * Returns the vertex indices of a level of detail. Every
+				 * level indexes the same vertices.
+				 *
+				 * @param lod Level of detail, where zero is full detail.
+				 * @return Vertex indices.
 				 */
-				~Mesh();
+				const std::vector<unsigned int>& GetLodIndices(unsigned int lod) const;
 
 				/**
-				 * Returns the number of indices in the mesh.
+				 * Reorders the triangles for the vertex cache and to reduce
+				 * overdraw, then reorders the vertices into the order that
+				 * they are used. This discards the lower levels of detail,
+				 * so it must be done before generating them.
 				 *
-				 * @return Number of indices.
+				 * @see MeshOptimizer
 				 */
-				unsigned int GetIndicesCount() const;
+				void Optimize();
 
 				/**
-				 * Returns the number of vertices in the mesh.
+				 * Generates the lower levels of detail by simplifying the
+				 * mesh, replacing any previous ones. Each level has about
+				 * half of the triangles of the level before it, ordered for
+				 * the vertex cache. Levels that would barely reduce the
+				 * triangle count are not generated.
 				 *
-				 * @return Number of vertices.
+				 * @see MeshSimplifier
 				 */
-				unsigned int GetVerticesCount() const;
+				void GenerateLods();
+
+				/**
+				 * Replaces the lower levels of detail.
+				 *
+				 * @param lodIndices Vertex indices of each level of detail
+				 * after the full detail mesh.
+				 */
+				void SetLodIndices(std::vector<std::vector<unsigned int>> lodIndices);
 
 				/**
 				 * Returns a shared pointer to the mesh's material.
@@ -276,12 +320,6 @@ namespace Engine
 				 */
 				std::shared_ptr<Material> GetMaterial() const;
 
-				/**
-				 * Updates the VBOs in the mesh by sending over
-				 * the vertex data.
-				 */
-				void UpdateBuffers() const;
-
 				/**
 				 * Sets the material for the mesh.
 				 *
@@ -328,63 +366,78 @@ namespace Engine
 				const glm::vec3& GetVertexPosition(unsigned int index) const;
 
 				/**
-				 * Returns the Vertex Array Object identifier for the mesh.
+				 * Returns a reference to the vertex positions.
 				 *
-				 * @return Vertex Array Object identifier.
+				 * @return Vertex positions.
 				 */
-				GLuint GetVAO();
+				const std::vector<glm::vec3>& GetVertexPositions() const;
 
-			private:
 				/**
-				 * Pointer to the material that should be applied to
-				 * the mesh.
+				 * Returns a reference to the vertex normals.
+				 *
+				 * @return Vertex normals.
 				 */
-				std::shared_ptr<Material> m_material;
+				const std::vector<glm::vec3>& GetVertexNormals() const;
 
 				/**
-				 * Vertex positions.
+				 * Returns a reference to the vertex texture coordinates.
+				 *
+				 * @return Vertex texture coordinates.
 				 */
-				std::vector<glm::vec3> m_positions;
+				const std::vector<glm::vec3>& GetVertexTextureCoordinates() const;
 
 				/**
-				 * Vertex normals.
+				 * Returns a reference to the vertex indices.
+				 *
+				 * @return Vertex indices.
 				 */
-				std::vector<glm::vec3> m_normals;
+				const std::vector<unsigned int>& GetVertexIndices() const;
 
 				/**
-				 * Vertex texture coordinates.
+				 * Replaces all of the vertex data in the mesh.
+				 *
+				 * @param positions Vertex positions.
+				 * @param normals Vertex normals.
+				 * @param textureCoordinates Vertex texture coordinates.
+				 * @param indices Vertex indices.
 				 */
-				std::vector<glm::vec3> m_textureCoordinates;
+				void SetVertexData(std::vector<glm::vec3> positions,
+					std::vector<glm::vec3> normals,
+					std::vector<glm::vec3> textureCoordinates,
+					std::vector<unsigned int> indices);
 
+			private:
 				/**
-				 * Vertex indices.
+				 * Pointer to the material that should be applied to
+				 * the mesh.
 				 */
-				std::vector<unsigned int> m_indices;
+				std::shared_ptr<Material> m_material;
 
 				/**
-				 * VBO for vertex positions.
+				 * Vertex positions.
 				 */
-				GLuint m_positionVBO;
+				std::vector<glm::vec3> m_positions;
 
 				/**
-				 * VBO for vertex normals.
+				 * Vertex normals.
 				 */
-				GLuint m_normalVBO;
+				std::vector<glm::vec3> m_normals;
 
 				/**
-				 * VBO for the vertex texture coordinates.
+				 * Vertex texture coordinates.
 				 */
-				GLuint m_textureCoordinatesVBO;
+				std::vector<glm::vec3> m_textureCoordinates;
 
 				/**
-				 * VBO for the faces.
+				 * Vertex indices.
 				 */
-				GLuint m_indexVBO;
+				std::vector<unsigned int> m_indices;
 
 				/**
-				 * Vertex Array Object.
+				 * Vertex indices of each level of detail after the full
+				 * detail mesh.
 				 */
-				GLuint m_VAO;
+				std::vector<std::vector<unsigned int>> m_lodIndices;
 			};
 
 			/**
@@ -459,29 +512,21 @@ namespace Engine
 			const glm::mat4& GetLocalBindTransformationMatrix() const;
 
 			/**
-			 * Calculates the node's local transformation matrix at the
-			 * specified time.
+			 * Returns the transformation applied to the node's animated local
+			 * transformation matrices by @see Transform.
 			 *
-			 * @param time Time for the transformation matrix (in seconds).
+			 * @return Animation transformation matrix.
 			 */
-			const glm::mat4 GetLocalTransformationMatrix(double time) const;
+			const glm::mat4& GetAnimationTransformationMatrix() const;
 
 			/**
 			 * Transforms the node by the specfied transformation matrix. This
-			 * transform is applied to the bind pose and any keyframes.
+			 * transform is applied to the bind pose and any animation.
 			 *
 			 * @param transform Transformation matrix to apply.
 			 */
 			void Transform(const glm::mat4& transform);
 
-			/**
-			 * Adds a keyframe to the node.
-			 *
-			 * @param keyframe Shared pointer to the keyframe to add to the
-			 * node.
-			 */
-			void AddKeyframe(std::shared_ptr<Keyframe> keyframe);
-
 			/**
 			 * Adds a mesh to the node.
 			 *
@@ -508,9 +553,9 @@ namespace Engine
 			glm::mat4 m_bindTransformationMatrix;
 
 			/**
-			 * Keyframes.
+			 * Transformation applied to the animation by @see Transform.
 			 */
-			std::vector<std::shared_ptr<Keyframe>> m_keyframes;
+			glm::mat4 m_animationTransformationMatrix;
 
 			/**
 			 * Child nodes.
@@ -523,6 +568,175 @@ namespace Engine
 			std::vector<std::shared_ptr<Mesh>> m_meshes;
 		};
 
+		/**
+		 * Node of the flattened node tree.
+		 *
+		 * The node tree is flattened into a list in depth-first order when
+		 * the model is loaded, so that it can be evaluated with a linear pass
+		 * instead of a recursive walk. Parents always come before their
+		 * children.
+		 */
+		struct FlatNode
+		{
+			/**
+			 * Index of the parent node in the list, or -1 for the root node.
+			 */
+			std::int32_t parentIndex;
+
+			/**
+			 * Index of the node's first mesh in the flattened mesh list.
+			 */
+			unsigned int firstMesh;
+
+			/**
+			 * Number of meshes in the node.
+			 */
+			unsigned int meshCount;
+
+			/**
+			 * Are the node and all of its ancestors unanimated by every
+			 * clip? The transformation matrix of a static node never
+			 * changes.
+			 */
+			bool isStatic;
+
+			/**
+			 * The node's transformation matrix to the model space if the
+			 * node is static. Otherwise, the node's local bind pose
+			 * transformation matrix, used by clips that do not animate it.
+			 */
+			glm::mat4 transformationMatrix;
+
+			/**
+			 * Transformation applied to the node's animated local
+			 * transformation matrices.
+			 */
+			glm::mat4 animationTransformationMatrix;
+
+			/**
+			 * Index of the node in the list of palette nodes, or
+			 * InvalidPaletteIndex if the node has no meshes.
+			 */
+			unsigned int paletteIndex;
+		};
+
+		/**
+		 * Largest number of levels of detail per mesh, including the full
+		 * detail mesh.
+		 */
+		static const unsigned int MaxLodCount = 3;
+
+		/**
+		 * Meshes that share a material and a node palette, merged so that
+		 * they can be drawn with a single call. Each vertex holds the index
+		 * of its node within the palette, and the vertex shader selects the
+		 * node's transformation matrix from the palette.
+		 */
+		struct MaterialGroup
+		{
+			/**
+			 * Mesh of a node that is merged into the group.
+			 */
+			struct Part
+			{
+				/**
+				 * Index of the node in the flattened node tree.
+				 */
+				unsigned int node;
+
+				/**
+				 * Index of the mesh in the flattened mesh list.
+				 */
+				unsigned int mesh;
+			};
+
+			/**
+			 * Material that is applied to every part.
+			 */
+			std::shared_ptr<Material> material;
+
+			/**
+			 * Index of the node palette. Palette p holds the transformation
+			 * matrices of palette nodes p * MaxPaletteNodes onwards.
+			 */
+			unsigned int palette;
+
+			/**
+			 * Parts, in the order that their vertices are merged.
+			 */
+			std::vector<Part> parts;
+
+			/**
+			 * Layout of the merged vertices.
+			 */
+			VertexFormat::Layout layout;
+
+			/**
+			 * Number of merged vertices.
+			 */
+			unsigned int vertexCount;
+
+			/**
+			 * Number of merged indices, for every level of detail.
+			 */
+			unsigned int indexCount;
+
+			/**
+			 * Number of levels of detail. Parts with fewer levels use their
+			 * lowest level of detail for the remaining levels.
+			 */
+			unsigned int lodCount;
+
+			/**
+			 * Index of the first merged index of each level of detail.
+			 */
+			unsigned int lodFirstIndex[MaxLodCount];
+
+			/**
+			 * Number of merged indices of each level of detail.
+			 */
+			unsigned int lodIndexCount[MaxLodCount];
+
+			/**
+			 * Type of the uploaded indices. Groups with few enough vertices
+			 * use 16-bit indices.
+			 */
+			GLenum indexType;
+
+			/**
+			 * Location of the uploaded vertices and indices.
+			 */
+			GeometryBuffer::Allocation allocation;
+		};
+
+		/**
+		 * Palette index for nodes without meshes.
+		 */
+		static const unsigned int InvalidPaletteIndex = ~0u;
+
+		/**
+		 * Largest number of node transformation matrices passed to the
+		 * vertex shader for a single draw. This must match the size of the
+		 * nodeTransformations array in the shaders.
+		 *
+		 * The palette changes with every draw, so it stays a plain uniform
+		 * array rather than joining the per-frame uniform buffer. Its 512
+		 * components leave room for the other uniforms within the 1024
+		 * vertex uniform components that OpenGL 3.1 guarantees.
+		 */
+		static const unsigned int MaxPaletteNodes = 32;
+
+		/**
+		 * Animation clip index that refers to no clip.
+		 */
+		static const unsigned int InvalidAnimationClip = ~0u;
+
+		/**
+		 * Rate at which the animation clips are baked into the pose cache (in
+		 * frames per second).
+		 */
+		static const unsigned int PoseSampleRate = 60;
+
 		/**
 		 * Constructor.
 		 */
@@ -541,11 +755,217 @@ namespace Engine
 		const std::shared_ptr<Node> GetRootNode() const;
 
 		/**
-		 * Returns the animation duration.
+		 * Returns the flattened node tree.
+		 *
+		 * @return Nodes in depth-first order.
+		 */
+		const std::vector<FlatNode>& GetFlatNodes() const;
+
+		/**
+		 * Returns the meshes of all of the nodes, in the order of the
+		 * flattened node tree.
+		 *
+		 * @see FlatNode::firstMesh
+		 *
+		 * @return Shared pointers to the meshes.
+		 */
+		const std::vector<std::shared_ptr<Node::Mesh>>& GetFlatMeshes() const;
+
+		/**
+		 * Returns the indices of the nodes that have meshes, in the order
+		 * of the flattened node tree. Node palettes are consecutive runs of
+		 * up to MaxPaletteNodes of these.
+		 *
+		 * @see FlatNode::paletteIndex
+		 *
+		 * @return Indices of the nodes in the flattened node tree.
+		 */
+		const std::vector<unsigned int>& GetPaletteNodes() const;
+
+		/**
+		 * Returns the material groups, ordered by node palette.
+		 *
+		 * @return Material groups.
+		 */
+		const std::vector<MaterialGroup>& GetMaterialGroups() const;
+
+		/**
+		 * Returns the number of animation clips in the model's clip library.
+		 *
+		 * @return Number of animation clips.
+		 */
+		unsigned int GetAnimationClipCount() const;
+
+		/**
+		 * Returns the animation clip at the specified index.
+		 *
+		 * @param clip Index of the animation clip.
+		 * @return Reference to the animation clip.
+		 */
+		const AnimationClip& GetAnimationClip(unsigned int clip) const;
+
+		/**
+		 * Returns the index of the animation clip with the specified name.
+		 *
+		 * @param name Name of the animation clip.
+		 * @return Index of the first animation clip with the name, or @see
+		 * InvalidAnimationClip if there is no such clip.
+		 */
+		unsigned int FindAnimationClip(const std::string& name) const;
+
+		/**
+		 * Calculates the transformation matrix from each node's space to the
+		 * model space at the specified time in an animation clip, in a single
+		 * pass over the flattened node tree. Only animated nodes are
+		 * evaluated; static nodes use the matrices calculated when the model
+		 * was loaded.
+		 *
+		 * @param clip Index of the animation clip. An invalid index gives the
+		 * bind pose.
+		 * @param time Animation time (in seconds).
+		 * @param transformations Receives the transformation matrix for each
+		 * node in the flattened node tree.
+		 */
+		void EvaluateNodeTransformations(unsigned int clip, double time, std::vector<glm::mat4>& transformations) const;
+
+		/**
+		 * Loads the keyframes of an ASSIMP animation channel. The position,
+		 * rotation and scaling keys are merged in a single pass, so that there
+		 * is a keyframe at every time at which any of them has a key.
+		 *
+		 * @param channel Pointer to the ASSIMP animation channel.
+		 * @param speedInTicksPerSecond Speed of the animation.
+		 * @param times Receives the keyframe times (in seconds).
+		 * @param translations Receives the translation at each keyframe.
+		 * @param rotations Receives the rotation at each keyframe.
+		 * @param scales Receives the scale at each keyframe.
+		 */
+		static void LoadChannelKeyframes(const aiNodeAnim* channel, double speedInTicksPerSecond,
+			std::vector<double>& times, std::vector<glm::vec3>& translations,
+			std::vector<glm::quat>& rotations, std::vector<glm::vec3>& scales);
+
+		/**
+		 * Returns the number of frames in the pose cache for an animation
+		 * clip. Every clip is baked into the cache at @see PoseSampleRate
+		 * when the model is loaded, so that every instance playing it shares
+		 * the same transformations.
+		 *
+		 * @param clip Index of the animation clip. An invalid index refers to
+		 * the bind pose, which has a single frame.
+		 * @return Number of frames.
+		 */
+		unsigned int GetPoseFrameCount(unsigned int clip) const;
+
+		/**
+		 * Returns the transformation matrices from each node's space to the
+		 * model space at the baked frame nearest to the specified time in an
+		 * animation clip. This costs the same however many nodes are
+		 * animated.
 		 *
-		 * @return Animation duration (in seconds).
+		 * @param clip Index of the animation clip. An invalid index gives the
+		 * bind pose.
+		 * @param time Animation time (in seconds).
+		 * @return Pointer to the transformation matrix for each node in the
+		 * flattened node tree, or a nullptr if the model has no nodes.
 		 */
-		const double GetAnimationDuration() const;
+		const glm::mat4* GetPose(unsigned int clip, double time) const;
+
+		/**
+		 * Returns the index of the baked frame that @see GetPose returns for
+		 * the specified time in an animation clip.
+		 *
+		 * @param clip Index of the animation clip. An invalid index refers to
+		 * the bind pose, which has a single frame.
+		 * @param time Animation time (in seconds).
+		 * @return Frame index, less than @see GetPoseFrameCount.
+		 */
+		unsigned int GetPoseFrame(unsigned int clip, double time) const;
+
+		/**
+		 * Blends the transformation matrices of the two baked frames either
+		 * side of the specified time in an animation clip. This is smoother
+		 * than @see GetPose for animations played back slowly.
+		 *
+		 * @param clip Index of the animation clip. An invalid index gives the
+		 * bind pose.
+		 * @param time Animation time (in seconds).
+		 * @param transformations Receives the transformation matrix for each
+		 * node in the flattened node tree.
+		 */
+		void BlendPose(unsigned int clip, double time, std::vector<glm::mat4>& transformations) const;
+
+		/**
+		 * Returns the number of materials in the model.
+		 *
+		 * @return Number of materials.
+		 */
+		unsigned int GetMaterialCount() const;
+
+		/**
+		 * Returns a shared pointer to the material at the specified index.
+		 *
+		 * @param index Index of the material.
+		 * @return Shared pointer to the material.
+		 */
+		std::shared_ptr<Material> GetMaterial(unsigned int index) const;
+
+		/**
+		 * Returns the bytes of main memory used by the vertex data of all
+		 * of the meshes in the model.
+		 *
+		 * @return Bytes of main memory.
+		 */
+		std::size_t GetCPUMemoryUsage() const;
+
+		/**
+		 * Returns the bytes of graphics memory used by the buffers of all of
+		 * the meshes in the model.
+		 *
+		 * @return Bytes of graphics memory.
+		 */
+		std::size_t GetGPUMemoryUsage() const;
+
+		/**
+		 * Returns the minimum corner of an axis-aligned box that bounds the
+		 * model in every pose of every animation clip.
+		 *
+		 * @return Minimum corner of the bounding box, in the model space.
+		 */
+		const glm::vec3& GetBoundingBoxMinimum() const;
+
+		/**
+		 * Returns the maximum corner of an axis-aligned box that bounds the
+		 * model in every pose of every animation clip.
+		 *
+		 * @return Maximum corner of the bounding box, in the model space.
+		 */
+		const glm::vec3& GetBoundingBoxMaximum() const;
+
+		/**
+		 * Returns the center of a sphere that bounds the model in every
+		 * pose of every animation clip.
+		 *
+		 * @return Center of the bounding sphere, in the model space.
+		 */
+		const glm::vec3& GetBoundingSphereCenter() const;
+
+		/**
+		 * Returns the radius of a sphere that bounds the model in every pose
+		 * of every animation clip.
+		 *
+		 * @return Radius of the bounding sphere, or zero if the model has no
+		 * vertices.
+		 */
+		float GetBoundingSphereRadius() const;
+
+		/**
+		 * Returns the duration of an animation clip.
+		 *
+		 * @param clip Index of the animation clip.
+		 * @return Animation duration (in seconds), or zero for an invalid
+		 * index.
+		 */
+		double GetAnimationDuration(unsigned int clip) const;
 
 		/**
 		 * Loads the model from a file.
@@ -555,6 +975,87 @@ namespace Engine
 		 */
 		bool LoadFromFile(std::string filepath);
 
+		/**
+		 * Loads the model from a file without sending any data to the
+		 * graphics card. No OpenGL calls are made, so this may be called from
+		 * any thread. @see UpdateBuffers must be called from a thread with an
+		 * OpenGL context before the model is rendered.
+		 *
+		 * @param filepath Path to the model file.
+		 * @return True if the model was successfully loaded.
+		 */
+		bool Decode(std::string filepath);
+
+		/**
+		 * Loads the model from a source model file that has already been
+		 * read into memory. As with @see Decode, no OpenGL calls are made.
+		 *
+		 * @param data Pointer to the file contents.
+		 * @param size Size of the file contents (in bytes).
+		 * @param filepath Path to the model file. This determines the file
+		 * format and where textures are found.
+		 * @return True if the model was successfully loaded.
+		 */
+		bool Decode(const unsigned char* data, std::size_t size, std::string filepath);
+
+		/**
+		 * Loads the model from a baked model file, without using ASSIMP. As
+		 * with @see Decode, no OpenGL calls are made.
+		 *
+		 * @param filepath Path to the baked model file.
+		 * @return True if the model was successfully loaded.
+		 */
+		bool DecodeBaked(std::string filepath);
+
+		/**
+		 * Loads the model from a baked model file that has already been read
+		 * into memory.
+		 *
+		 * @param data Pointer to the file contents. This must be 8 byte
+		 * aligned.
+		 * @param size Size of the file contents (in bytes).
+		 * @param filepath Path to the baked model file. This determines where
+		 * textures are found.
+		 * @return True if the model was successfully loaded.
+		 */
+		bool DecodeBaked(const unsigned char* data, std::size_t size, std::string filepath);
+
+		/**
+		 * Writes the model to a baked model file, which can later be loaded
+		 * with @see DecodeBaked. This must be called before the model is
+		 * transformed.
+		 *
+		 * @param filepath Path to the baked model file to write.
+		 * @return True if the file was successfully written.
+		 */
+		bool SaveBaked(std::string filepath) const;
+
+		/**
+		 * Returns the path to the baked model file for the specified source
+		 * model file. The baked file sits next to the source file.
+		 *
+		 * @param filepath Path to the source model file.
+		 * @return Path to the baked model file.
+		 */
+		static std::string GetBakedFilepath(std::string filepath);
+
+		/**
+		 * Returns true if there is a baked model file for the specified source
+		 * model file that is at least as new as the source file. A baked file
+		 * without a source file is always considered to be up to date.
+		 *
+		 * @param filepath Path to the source model file.
+		 * @return True if the baked model file should be loaded instead of the
+		 * source model file.
+		 */
+		static bool IsBakedFileUpToDate(std::string filepath);
+
+		/**
+		 * Sends the merged vertex data for each material group over to the
+		 * graphics card.
+		 */
+		void UpdateBuffers();
+
 		/**
 		 * Transforms the model.
 		 *
@@ -580,6 +1081,17 @@ namespace Engine
 		 */
 		std::shared_ptr<Node> FindNodeByName(std::string name);
 
+		/**
+		 * Loads the model from a scene imported by ASSIMP.
+		 *
+		 * @param assimpScene Pointer to the ASSIMP scene, or a nullptr if the
+		 * import failed.
+		 * @param importer The ASSIMP importer that imported the scene.
+		 * @param filepath Path to the model file.
+		 * @return True if the model was successfully loaded.
+		 */
+		bool LoadScene(const aiScene* assimpScene, const Assimp::Importer& importer, std::string filepath);
+
 		/**
 		 * Loads all the materials.
 		 *
@@ -601,12 +1113,44 @@ namespace Engine
 		void LoadNode(const aiNode* assimpNode, const aiScene* assimpScene, std::shared_ptr<Node> parentNode);
 
 		/**
-		 * Loads all the keyframes for all of the nodes in the model.
+		 * Loads every animation in the scene into the clip library.
 		 *
 		 * @param assimpScene Pointer to the ASSIMP scene in which the nodes
 		 * are contained.
 		 */
-		void LoadNodeKeyframes(const aiScene* assimpScene);
+		void LoadAnimationClips(const aiScene* assimpScene);
+
+		/**
+		 * Rebuilds the flattened node tree, the material groups and the pose
+		 * cache from the node tree. This must be called whenever the node
+		 * tree changes, and is followed by @see UpdateBuffers.
+		 */
+		void Flatten();
+
+		/**
+		 * Recalculates the transformation matrices of the flattened node
+		 * tree from the node tree, then the pose cache and bounds. This must
+		 * be called whenever the nodes' transformations change but the node
+		 * tree itself does not.
+		 */
+		void UpdateNodeTransformations();
+
+		/**
+		 * Groups the meshes of the flattened node tree by node palette and
+		 * material, releasing any previous upload of the groups.
+		 */
+		void GroupMeshes();
+
+		/**
+		 * Bakes the bind pose and every animation clip into the pose cache.
+		 */
+		void BakePoses();
+
+		/**
+		 * Calculates the bounding box and sphere from the meshes of every
+		 * node in every pose in the pose cache.
+		 */
+		void CalculateBounds();
 
 		/**
 		 * Returns the local position for the node corresponding to the
@@ -614,11 +1158,13 @@ namespace Engine
 		 *
 		 * @param channel Pointer to the ASSIMP animation channel for
 		 * the node.
+		 * @param nextKeyIndex Index of the first position key after the
+		 * specified time.
 		 * @param timeInTicks Time after the start of the animation,
 		 * in ticks, for which to calculate the node's local position.
 		 * @return Node's local position at the specified time.
 		 */
-		static glm::vec3 DetermineNodeLocalPositionAtTime(const aiNodeAnim* channel, double timeInTicks);
+		static glm::vec3 DetermineNodeLocalPositionAtTime(const aiNodeAnim* channel, unsigned int nextKeyIndex, double timeInTicks);
 
 		/**
 		 * Returns the local rotation for the node corresponding to the
@@ -626,11 +1172,13 @@ namespace Engine
 		 *
 		 * @param channel Pointer to the ASSIMP animation channel for
 		 * the node.
+		 * @param nextKeyIndex Index of the first rotation key after the
+		 * specified time.
 		 * @param timeInTicks Time after the start of the animation,
 		 * in ticks, for which to calculate the node's local rotation.
 		 * @return Node's local rotation at the specified time.
 		 */
-		static glm::quat DetermineNodeLocalRotationAtTime(const aiNodeAnim* channel, double timeInTicks);
+		static glm::quat DetermineNodeLocalRotationAtTime(const aiNodeAnim* channel, unsigned int nextKeyIndex, double timeInTicks);
 
 		/**
 		 * Returns the local scale for the node corresponding to the
@@ -638,11 +1186,13 @@ namespace Engine
 		 *
 		 * @param channel Pointer to the ASSIMP animation channel for
 		 * the node.
+		 * @param nextKeyIndex Index of the first scale key after the
+		 * specified time.
 		 * @param timeInTicks Time after the start of the animation,
 		 * in ticks, for which to calculate the node's local scale.
 		 * @return Node's local scale at the specified time.
 		 */
-		static glm::vec3 DetermineNodeLocalScaleAtTime(const aiNodeAnim* channel, double timeInTicks);
+		static glm::vec3 DetermineNodeLocalScaleAtTime(const aiNodeAnim* channel, unsigned int nextKeyIndex, double timeInTicks);
 
 		/**
 		 * Converts an ASSIMP aiMatrix4x4 to a glm::mat4.
@@ -680,14 +1230,67 @@ namespace Engine
 		std::shared_ptr<Node> m_rootNode;
 
 		/**
-		 * Materials.
+		 * Flattened node tree.
 		 */
-		std::vector<std::shared_ptr<Material>> m_materials;
+		std::vector<FlatNode> m_flatNodes;
+
+		/**
+		 * Meshes, in the order of the flattened node tree.
+		 */
+		std::vector<std::shared_ptr<Node::Mesh>> m_flatMeshes;
 
 		/**
-		 * Animation
+		 * Indices of the nodes with meshes in the flattened node tree.
 		 */
-		double m_animationDuration;
+		std::vector<unsigned int> m_paletteNodes;
+
+		/**
+		 * Material groups.
+		 */
+		std::vector<MaterialGroup> m_materialGroups;
+
+		/**
+		 * Animation clip library.
+		 */
+		std::vector<AnimationClip> m_clips;
+
+		/**
+		 * Pose cache for each animation clip, holding the transformation
+		 * matrix for every node in the flattened node tree at each baked
+		 * frame, frame after frame.
+		 */
+		std::vector<std::vector<glm::mat4>> m_poses;
+
+		/**
+		 * Transformation matrix for every node in the flattened node tree in
+		 * the bind pose.
+		 */
+		std::vector<glm::mat4> m_bindPose;
+
+		/**
+		 * Minimum corner of the bounding box.
+		 */
+		glm::vec3 m_boundingBoxMinimum;
+
+		/**
+		 * Maximum corner of the bounding box.
+		 */
+		glm::vec3 m_boundingBoxMaximum;
+
+		/**
+		 * Center of the bounding sphere.
+		 */
+		glm::vec3 m_boundingSphereCenter;
+
+		/**
+		 * Radius of the bounding sphere.
+		 */
+		float m_boundingSphereRadius;
+
+		/**
+		 * Materials.
+		 */
+		std::vector<std::shared_ptr<Material>> m_materials;
 	};
 }
 
@@ -48,6 +48,31 @@ namespace Engine
 		 */
 		~Plane();
 
+		/**
+		 * Returns the unit normal to the plane.
+		 *
+		 * @return Unit normal vector.
+		 */
+		const glm::vec3& GetNormal() const;
+
+		/**
+		 * Returns the distance of the plane from the origin, along the
+		 * normal.
+		 *
+		 * @return Distance from the origin.
+		 */
+		float GetDistance() const;
+
+		/**
+		 * Calculates the signed distance from the plane to a point. The
+		 * distance is positive for points on the side that the normal
+		 * points to.
+		 *
+		 * @param point The point.
+		 * @return Signed distance to the point.
+		 */
+		float GetSignedDistance(const glm::vec3& point) const;
+
 		/**
 		 * Calculates the distance along the ray at which the ray intersect
 		 * the plane. Returns false if the ray and plane are parallel and
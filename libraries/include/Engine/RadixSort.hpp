@@ -0,0 +1,71 @@
+#ifndef RADIXSORT_H
+#define	RADIXSORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Engine
+{
+	/**
+	 * Sorts values by an unsigned 64-bit key in ascending order, keeping the
+	 * order of values with equal keys.
+	 *
+	 * This is a least significant digit radix sort over the key's 8 bytes,
+	 * so it takes linear time. The first pass counts every digit, and passes
+	 * over bytes that are the same in every key are skipped.
+	 *
+	 * @param values Values to sort. Each must have a std::uint64_t member
+	 * named key.
+	 * @param scratch Buffer for the sort to use, which is resized to fit the
+	 * values. Keeping it between calls avoids reallocating it.
+	 */
+	template <typename T>
+	void RadixSort(std::vector<T>& values, std::vector<T>& scratch)
+	{
+		const std::size_t byteCount = sizeof(std::uint64_t);
+		const std::size_t digitCount = 256;
+		if (values.size() < 2)
+		{
+			return;
+		}
+
+		// Count the digits of every byte in one pass.
+		std::vector<std::size_t> counts(byteCount * digitCount, 0);
+		for (const T& value : values)
+		{
+			for (std::size_t b = 0; b < byteCount; ++b)
+			{
+				++counts[b * digitCount + ((value.key >> (b * 8)) & 0xFF)];
+			}
+		}
+
+		scratch.resize(values.size());
+		for (std::size_t b = 0; b < byteCount; ++b)
+		{
+			std::size_t* offsets = &counts[b * digitCount];
+			if (offsets[(values[0].key >> (b * 8)) & 0xFF] == values.size())
+			{
+				continue;
+			}
+
+			// Turn the counts into the first position of each digit, then
+			// scatter the values in their current order.
+			std::size_t position = 0;
+			for (std::size_t d = 0; d < digitCount; ++d)
+			{
+				const std::size_t count = offsets[d];
+				offsets[d] = position;
+				position += count;
+			}
+
+			for (const T& value : values)
+			{
+				scratch[offsets[(value.key >> (b * 8)) & 0xFF]++] = value;
+			}
+			values.swap(scratch);
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef RANGEALLOCATOR_H
+#define	RANGEALLOCATOR_H
+
+#include <cstddef>
+#include <map>
+
+namespace Engine
+{
+	/**
+	 * Hands out ranges of a fixed capacity (e.g. a region of a GPU buffer).
+	 * Free ranges are kept ordered by offset, allocations take the first free
+	 * range that fits, and freed ranges are merged with their neighbours.
+	 *
+	 * The allocator only does the bookkeeping, so it does not matter what
+	 * the units are, as long as they are used consistently.
+	 */
+	class RangeAllocator
+	{
+	public:
+		/**
+		 * Constructor.
+		 *
+		 * @param capacity Size of the range that is allocated from.
+		 */
+		RangeAllocator(std::size_t capacity);
+
+		/**
+		 * Destructor.
+		 */
+		~RangeAllocator();
+
+		/**
+		 * Allocates a range.
+		 *
+		 * @param size Size of the range. Must be greater than zero.
+		 * @param alignment The offset of the range will be a multiple of
+		 * this. Must be greater than zero.
+		 * @param offset Receives the offset of the range.
+		 * @return True if the range was allocated, false if there is no free
+		 * range large enough.
+		 */
+		bool Allocate(std::size_t size, std::size_t alignment, std::size_t& offset);
+
+		/**
+		 * Returns a range to the allocator.
+		 *
+		 * @param offset Offset of the range, as returned by Allocate().
+		 * @param size Size of the range, as passed to Allocate().
+		 */
+		void Free(std::size_t offset, std::size_t size);
+
+		/**
+		 * Returns the size of the range that is allocated from.
+		 *
+		 * @return Capacity.
+		 */
+		std::size_t GetCapacity() const;
+
+		/**
+		 * Returns the total size of the free ranges. Fragmentation may stop
+		 * an allocation of this size from succeeding.
+		 *
+		 * @return Free size.
+		 */
+		std::size_t GetFreeSize() const;
+
+		/**
+		 * Returns the number of free ranges.
+		 *
+		 * @return Number of free ranges.
+		 */
+		std::size_t GetFreeRangeCount() const;
+
+	private:
+		/**
+		 * Size of the range that is allocated from.
+		 */
+		std::size_t m_capacity;
+
+		/**
+		 * Total size of the free ranges.
+		 */
+		std::size_t m_freeSize;
+
+		/**
+		 * Sizes of the free ranges, keyed by offset.
+		 */
+		std::map<std::size_t, std::size_t> m_freeRanges;
+	};
+}
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <vector>
+#include <cstdint>
 
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
@@ -10,12 +11,20 @@
 
 #include <Engine/NonCopyable.hpp>
 #include <Engine/ResourceManager.hpp>
+#include <Engine/GeometryBuffer.hpp>
 #include <Engine/GameObject.hpp>
+#include <Engine/Frustum.hpp>
 #include <Engine/Model.hpp>
 #include <Engine/ShaderProgram.hpp>
+#include <Engine/UniformHandle.hpp>
 
 namespace Engine
 {
+	namespace Attribute
+	{
+		class ShaderProgram;
+	}
+
 	class Renderer : private NonCopyable
 	{
 	public:
@@ -33,11 +42,77 @@ namespace Engine
 
 		/**
 		 * Returns the number of draw calls performed to render the last frame.
+		 * Models drawn with an instanced shader program share draw calls
+		 * with the other instances of the same model.
 		 *
 		 * @return Number of draw calls made to render the last frame.
 		 */
 		unsigned int GetDrawCount() const;
 
+		/**
+		 * Returns the number of times that a Vertex Array Object was bound to
+		 * render the last frame. Meshes are drawn from shared geometry buffer
+		 * pages, so this is usually far fewer than the number of draw calls.
+		 *
+		 * @return Number of Vertex Array Object binds made to render the last
+		 * frame.
+		 */
+		unsigned int GetVertexArrayBindCount() const;
+
+		/**
+		 * Returns the number of triangles drawn to render the last frame.
+		 * Models that appear small on the screen are drawn with fewer
+		 * triangles.
+		 *
+		 * @return Number of triangles drawn to render the last frame.
+		 */
+		unsigned int GetTriangleCount() const;
+
+		/**
+		 * Returns the number of game objects that were left out of the last
+		 * frame because their models were outside the camera's view.
+		 *
+		 * @return Number of game objects culled from the last frame.
+		 */
+		unsigned int GetCulledObjectCount() const;
+
+		/**
+		 * Returns the number of game objects whose models were drawn to
+		 * render the last frame.
+		 *
+		 * @return Number of game objects drawn in the last frame.
+		 */
+		unsigned int GetDrawnObjectCount() const;
+
+		/**
+		 * Checks whether any part of a model, in any pose, may be within a
+		 * frustum.
+		 *
+		 * @param model The model.
+		 * @param modelMatrix Transformation matrix from the model space to
+		 * the world space.
+		 * @param frustum The frustum, in the world space.
+		 * @return False if the model is entirely outside the frustum.
+		 */
+		static bool IsVisible(const Model& model, const glm::mat4& modelMatrix, const Frustum& frustum);
+
+		/**
+		 * Selects the level of detail to draw a model at, from the size of
+		 * its projected bounding sphere.
+		 *
+		 * @param model The model.
+		 * @param modelMatrix Transformation matrix from the model space to
+		 * the world space.
+		 * @param viewMatrix Transformation matrix from the world space to
+		 * the view space.
+		 * @param projectionMatrix Projection matrix.
+		 * @return Level of detail, where zero is full detail.
+		 */
+		static unsigned int SelectLod(const Model& model,
+			const glm::mat4& modelMatrix,
+			const glm::mat4& viewMatrix,
+			const glm::mat4& projectionMatrix);
+
 		/**
 		 * Renders the specified game scene.
 		 *
@@ -49,6 +124,167 @@ namespace Engine
 			std::shared_ptr<GameObject> cameraGameObject);
 
 	private:
+		/**
+		 * Game object to render this frame, with everything needed to render
+		 * it looked up once.
+		 */
+		struct RenderItem
+		{
+			/**
+			 * Sort key, packing the render pass, shader program, texture,
+			 * model, level of detail, animation clip and frame, and depth
+			 * from the most to the least significant bits.
+			 */
+			std::uint64_t key;
+
+			/**
+			 * Shader program attribute of the game object.
+			 */
+			Attribute::ShaderProgram* shaderProgramAttribute;
+
+			/**
+			 * Shader program to render with.
+			 */
+			ShaderProgram* shaderProgram;
+
+			/**
+			 * Model to render.
+			 */
+			Model* model;
+
+			/**
+			 * Transformation matrices of the model's nodes, from the model's
+			 * pose cache.
+			 */
+			const glm::mat4* pose;
+
+			/**
+			 * Animation clip that the pose is from, or @see
+			 * Model::InvalidAnimationClip for the bind pose.
+			 */
+			unsigned int clip;
+
+			/**
+			 * Frame of the animation clip that the pose is from.
+			 */
+			unsigned int frame;
+
+			/**
+			 * Level of detail to render.
+			 */
+			unsigned int lod;
+
+			/**
+			 * Transformation matrix from the model space to the world space.
+			 */
+			glm::mat4 modelMatrix;
+		};
+
+		/**
+		 * Values that are the same for every object in a frame, laid out to
+		 * match the std140 FrameUniforms block of the shaders.
+		 */
+		struct FrameUniforms
+		{
+			/**
+			 * The projection matrix.
+			 */
+			glm::mat4 projectionMatrix;
+
+			/**
+			 * The view matrix.
+			 */
+			glm::mat4 viewMatrix;
+
+			/**
+			 * Position of the directional light, in the first three
+			 * components.
+			 */
+			glm::vec4 lightPosition;
+
+			/**
+			 * Color of the directional light multiplied by its intensity, in
+			 * the first three components.
+			 */
+			glm::vec4 lightColor;
+
+			/**
+			 * Current time (seconds).
+			 */
+			float currentTime;
+
+			/**
+			 * Padding to the size of the block.
+			 */
+			float padding[3];
+		};
+
+		/**
+		 * Per-instance data streamed to instanced shader programs, laid out
+		 * for the i_modelMatrix, i_normalMatrix and per-instance value vertex
+		 * attributes.
+		 */
+		struct InstanceData
+		{
+			/**
+			 * Transformation matrix from the model space to the world space.
+			 */
+			glm::mat4 modelMatrix;
+
+			/**
+			 * Columns of the normal matrix, each padded to four floats.
+			 */
+			glm::vec4 normalMatrix[3];
+
+			/**
+			 * Per-instance values, in the order of the shader program's
+			 * instance values.
+			 */
+			float values[ShaderProgram::MaxInstanceValues];
+		};
+
+		/**
+		 * Handles to the uniforms that the renderer sets for each model and
+		 * material group, resolved when the renderer switches to a shader
+		 * program.
+		 */
+		struct ModelUniforms
+		{
+			UniformHandle modelMatrix;
+			UniformHandle normalMatrix;
+			UniformHandle nodeTransformations;
+			UniformHandle materialDiffuseColor;
+			UniformHandle materialSpecularColor;
+			UniformHandle materialAmbientColor;
+			UniformHandle materialEmissiveColor;
+			UniformHandle materialShininess;
+			UniformHandle useTexture;
+			UniformHandle diffuseTextureUnit;
+		};
+
+		/**
+		 * Run of render items that are drawn together.
+		 */
+		struct RenderBatch
+		{
+			/**
+			 * Index of the first render item in the render list.
+			 */
+			std::size_t firstItem;
+
+			/**
+			 * Index of the first item's instance data in the instance
+			 * buffer.
+			 */
+			std::size_t firstInstance;
+
+			/**
+			 * Number of instances to draw, or zero to draw the first item
+			 * alone without instancing.
+			 */
+			unsigned int instanceCount;
+		};
+
 		/**
 		 * Populates the render list by determining whether the specified
 		 * Game Object should be rendered and then recursively checks any child
@@ -56,39 +292,122 @@ namespace Engine
 		 *
 		 * @param gameObject Shared pointer to the Game Object to check whether
 		 * it should be added to the render list.
+		 * @param projectionMatrix The projection matrix.
+		 * @param viewMatrix The view matrix.
+		 * @param frustum Volume of the world that the camera can see. Game
+		 * Objects whose models are outside of it are not rendered.
+		 */
+		void PopulateRenderList(std::shared_ptr<GameObject> gameObject,
+			const glm::mat4& projectionMatrix,
+			const glm::mat4& viewMatrix,
+			const Frustum& frustum);
+
+		/**
+		 * Splits the sorted render list into batches. Consecutive items that
+		 * use the same instanced shader program, model, pose and level of
+		 * detail form one batch, and their instance data is uploaded to the
+		 * instance buffer.
 		 */
-		void PopulateRenderList(std::shared_ptr<GameObject> gameObject);
+		void BuildRenderBatches();
 
 		/**
-		 * Renders the specified game object.
+		 * Starts using a shader program, and resolves the handles to the
+		 * uniforms that the renderer sets.
+		 *
+		 * @param shaderProgram The shader program.
+		 */
+		void UseShaderProgram(ShaderProgram& shaderProgram);
+
+		/**
+		 * Returns the directional light that lights the scene, reusing the
+		 * one found in previous frames while it is alive.
+		 *
+		 * @param gameObjects Reference to the game objects list.
+		 * @return Shared pointer to the directional light game object, or
+		 * NULL if the scene has none.
+		 */
+		std::shared_ptr<GameObject> FindDirectionalLight(std::map<GameObject::ID, std::shared_ptr<GameObject>>& gameObjects);
+
+		/**
+		 * Uploads the values that are the same for every game object in the
+		 * frame to the frame uniform buffer, and binds it for every shader
+		 * program.
 		 *
-		 * @param gameObject Shared pointer to the game object that should be
-		 * rendered.
 		 * @param projectionMatrix The projection matrix.
 		 * @param viewMatrix The view matrix.
-		 * @param directionalLights Vector of shared pointers to directional
-		 * light game objects.
+		 * @param directionalLight Shared pointer to the directional light
+		 * game object, which may be NULL.
 		 */
-		void RenderGameObject(std::shared_ptr<GameObject> gameObject,
-			const glm::mat4& projectionMatrix,
+		void UploadFrameUniforms(const glm::mat4& projectionMatrix,
 			const glm::mat4& viewMatrix,
-			const std::vector<std::shared_ptr<GameObject>>& directionalLights);
+			std::shared_ptr<GameObject> directionalLight);
+
+		/**
+		 * Renders the model of a render item without instancing. The item's
+		 * shader program must already be in use.
+		 *
+		 * @param item The render item.
+		 */
+		void RenderItemModel(const RenderItem& item);
 
 		/**
-		 * Recursively renders a node and all of its children.
+		 * Renders the meshes of every node in a model, with one draw call
+		 * per material group.
 		 *
-		 * @param node Pointer to the top node to start rendering.
-		 * @param parentAccumulatedTransformation Transformation matrix
-		 * for the specified node's parent, which takes a vector from the parent
-		 * node space to the model space.
-		 * @param animationTime Time after the start of the animation to render.
-		 * @param shaderProgram Shared pointer to the shader program to use for
-		 * rendering the node.
+		 * @param model The model to render.
+		 * @param pose Transformation matrices of the model's nodes.
+		 * @param lod Level of detail to render.
+		 * @param shaderProgram The shader program to use for rendering the
+		 * model.
+		 * @param firstInstance Index of the first instance's data in the
+		 * instance buffer.
+		 * @param instanceCount Number of instances to draw, or zero to draw
+		 * without instancing.
 		 */
-		void RenderNode(std::shared_ptr<Model::Node> node,
-			const glm::mat4& parentAccumulatedTransformation,
-			double animationTime,
-			std::shared_ptr<ShaderProgram> shaderProgram);
+		void RenderModel(const Model& model,
+			const glm::mat4* pose,
+			unsigned int lod,
+			ShaderProgram& shaderProgram,
+			std::size_t firstInstance,
+			unsigned int instanceCount);
+
+		/**
+		 * Renders a material group with its material. The group's node
+		 * palette must already have been passed to the shader.
+		 *
+		 * @param group The material group to render.
+		 * @param lod Level of detail to render. Groups with fewer levels are
+		 * rendered at their lowest level of detail.
+		 * @param shaderProgram The shader program to use for rendering the
+		 * group.
+		 * @param firstInstance Index of the first instance's data in the
+		 * instance buffer.
+		 * @param instanceCount Number of instances to draw, or zero to draw
+		 * without instancing.
+		 */
+		void RenderMaterialGroup(const Model::MaterialGroup& group,
+			unsigned int lod,
+			ShaderProgram& shaderProgram,
+			std::size_t firstInstance,
+			unsigned int instanceCount);
+
+		/**
+		 * Points the per-instance vertex attributes of a shader program at
+		 * the instance buffer, in the bound Vertex Array Object.
+		 *
+		 * @param shaderProgram The instanced shader program.
+		 * @param firstInstance Index of the first instance's data in the
+		 * instance buffer.
+		 */
+		void EnableInstanceAttributes(const ShaderProgram& shaderProgram, std::size_t firstInstance);
+
+		/**
+		 * Disables the per-instance vertex attributes of a shader program
+		 * in the bound Vertex Array Object.
+		 *
+		 * @param shaderProgram The instanced shader program.
+		 */
+		void DisableInstanceAttributes(const ShaderProgram& shaderProgram);
 
 	private:
 		/**
@@ -97,20 +416,88 @@ namespace Engine
 		std::shared_ptr<ResourceManager> m_resourceManager;
 
 		/**
-		 * Holds shared pointers to all of the Game Objects that need to be
+		 * Holds the render items of all of the Game Objects that need to be
 		 * rendered.
 		 */
-		std::vector<std::shared_ptr<GameObject>> m_renderList;
+		std::vector<RenderItem> m_renderList;
+
+		/**
+		 * Scratch buffer for sorting the render list.
+		 */
+		std::vector<RenderItem> m_sortScratch;
+
+		/**
+		 * Batches of the sorted render list.
+		 */
+		std::vector<RenderBatch> m_renderBatches;
+
+		/**
+		 * Instance data of every instanced batch in the frame.
+		 */
+		std::vector<InstanceData> m_instanceData;
+
+		/**
+		 * Vertex Buffer Object that the instance data is streamed to, or
+		 * zero until it is first needed.
+		 */
+		GLuint m_instanceBuffer;
+
+		/**
+		 * Uniform Buffer Object holding the frame uniforms, or zero until it
+		 * is first needed.
+		 */
+		GLuint m_frameUniformBuffer;
+
+		/**
+		 * The directional light found in previous frames.
+		 */
+		std::weak_ptr<GameObject> m_directionalLight;
 
 		/**
 		 * The shader program currently being used.
 		 */
-		std::shared_ptr<ShaderProgram> m_currentShaderProgram;
+		ShaderProgram* m_currentShaderProgram;
+
+		/**
+		 * Handles to the uniforms of the shader program currently being used.
+		 */
+		ModelUniforms m_uniforms;
+
+		/**
+		 * The geometry buffer page whose Vertex Array Object is bound.
+		 */
+		unsigned int m_currentGeometryPage;
 
 		/**
 		 * Counter for the number of draw calls performed.
 		 */
 		unsigned int m_drawCount;
+
+		/**
+		 * Counter for the number of Vertex Array Object binds performed.
+		 */
+		unsigned int m_vertexArrayBindCount;
+
+		/**
+		 * Counter for the number of triangles drawn.
+		 */
+		unsigned int m_triangleCount;
+
+		/**
+		 * Counter for the number of game objects culled.
+		 */
+		unsigned int m_culledObjectCount;
+
+		/**
+		 * Counter for the number of game objects drawn.
+		 */
+		unsigned int m_drawnObjectCount;
+
+		/**
+		 * Transformation matrices of the node palette being passed to the
+		 * shader.
+		 */
+		std::vector<glm::mat4> m_nodePalette;
 	};
 }
 
@@ -0,0 +1,221 @@
+#ifndef RESOURCEBUNDLE_H
+#define	RESOURCEBUNDLE_H
+
+#include <vector>
+#include <functional>
+#include <future>
+#include <cstddef>
+
+#include <Engine/NonCopyable.hpp>
+#include <Engine/ResourceManifest.hpp>
+
+namespace Engine
+{
+	/**
+	 * Tracks the loading of the resources listed in a manifest.
+	 *
+	 * Bundles are created by @see ResourceManager::LoadBundle, which hands
+	 * the resources over to the loader a few at a time, highest priority
+	 * first, so that a large bundle does not hold up resources that are
+	 * requested after it, and so that the rest of the bundle can be
+	 * cancelled.
+	 *
+	 * @note Apart from the future, a bundle should only be used from the main
+	 * game thread.
+	 */
+	class ResourceBundle : private NonCopyable
+	{
+	public:
+		/**
+		 * State of a request for a resource.
+		 */
+		enum class RequestStatus
+		{
+			Loading,
+			Loaded,
+			Failed
+		};
+
+		/**
+		 * Maximum number of the bundle's resources that are handed over to
+		 * the loader at once.
+		 */
+		static const unsigned int MaxRequestsInFlight = 8;
+
+		/**
+		 * Constructor.
+		 *
+		 * @param manifest Resources to load.
+		 * @param getSize Function returning the size of a resource's files
+		 * (in bytes), which is used to measure progress.
+		 */
+		ResourceBundle(const ResourceManifest& manifest,
+			std::function<std::size_t(const ResourceManifest::Entry&)> getSize);
+
+		/**
+		 * Destructor.
+		 */
+		~ResourceBundle();
+
+		/**
+		 * Checks on the requests in flight and then hands over more
+		 * resources, highest priority first, until the limit on requests in
+		 * flight is reached.
+		 *
+		 * @param getStatus Function returning the state of the request for a
+		 * resource.
+		 * @param request Function that requests a resource.
+		 */
+		void Update(std::function<RequestStatus(const ResourceManifest::Entry&)> getStatus,
+			std::function<void(const ResourceManifest::Entry&)> request);
+
+		/**
+		 * Stops handing resources over to the loader. Resources that have
+		 * already been requested still finish loading.
+		 */
+		void Cancel();
+
+		/**
+		 * Returns true if Cancel() has been called.
+		 *
+		 * @return True if the bundle has been cancelled.
+		 */
+		bool IsCancelled() const;
+
+		/**
+		 * Returns true once every resource has finished loading, or the
+		 * bundle has been cancelled and every request in flight has
+		 * finished.
+		 *
+		 * @return True if the bundle is complete.
+		 */
+		bool IsComplete() const;
+
+		/**
+		 * Returns a future that becomes ready when the bundle is complete.
+		 * Its value is true if every resource was loaded successfully.
+		 *
+		 * @note Bundles are updated by the main game thread, so waiting on the
+		 * future from the main game thread will never return.
+		 *
+		 * @return Completion future.
+		 */
+		std::shared_future<bool> GetFuture() const;
+
+		/**
+		 * Returns the number of resources in the bundle.
+		 *
+		 * @return Number of resources.
+		 */
+		unsigned int GetResourceCount() const;
+
+		/**
+		 * Returns the number of resources that have been loaded.
+		 *
+		 * @return Number of loaded resources.
+		 */
+		unsigned int GetLoadedCount() const;
+
+		/**
+		 * Returns the number of resources that failed to load.
+		 *
+		 * @return Number of failed resources.
+		 */
+		unsigned int GetFailedCount() const;
+
+		/**
+		 * Returns the total size of the resources' files.
+		 *
+		 * @return Total size (in bytes).
+		 */
+		std::size_t GetTotalBytes() const;
+
+		/**
+		 * Returns the size of the files of the resources that have finished
+		 * loading, whether successfully or not.
+		 *
+		 * @return Size (in bytes).
+		 */
+		std::size_t GetLoadedBytes() const;
+
+		/**
+		 * Returns the fraction of the bundle that has finished loading, by
+		 * size.
+		 *
+		 * @return Progress, between 0 and 1.
+		 */
+		float GetProgress() const;
+
+	private:
+		/**
+		 * Resolves the completion future if the bundle has just become
+		 * complete.
+		 */
+		void CheckComplete();
+
+	private:
+		/**
+		 * Resources to load, highest priority first.
+		 */
+		std::vector<ResourceManifest::Entry> m_entries;
+
+		/**
+		 * Size of each resource's files (in bytes).
+		 */
+		std::vector<std::size_t> m_sizes;
+
+		/**
+		 * Indices of the resources that have been requested but have not
+		 * finished loading.
+		 */
+		std::vector<unsigned int> m_requestsInFlight;
+
+		/**
+		 * Index of the next resource to request.
+		 */
+		unsigned int m_nextRequest;
+
+		/**
+		 * Number of resources that have been loaded.
+		 */
+		unsigned int m_loadedCount;
+
+		/**
+		 * Number of resources that failed to load.
+		 */
+		unsigned int m_failedCount;
+
+		/**
+		 * Total size of the resources' files (in bytes).
+		 */
+		std::size_t m_totalBytes;
+
+		/**
+		 * Size of the files of the resources that have finished loading (in
+		 * bytes).
+		 */
+		std::size_t m_loadedBytes;
+
+		/**
+		 * Has the bundle been cancelled?
+		 */
+		bool m_cancelled;
+
+		/**
+		 * Has the completion future been resolved?
+		 */
+		bool m_complete;
+
+		/**
+		 * Promise behind the completion future.
+		 */
+		std::promise<bool> m_promise;
+
+		/**
+		 * Completion future.
+		 */
+		std::shared_future<bool> m_future;
+	};
+}
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef RESOURCEGROUPID_H
+#define	RESOURCEGROUPID_H
+
+namespace Engine
+{
+	/**
+	 * Identifier for a group of resources that are kept loaded together.
+	 *
+	 * @see ResourceManager::CreateGroup
+	 */
+	typedef unsigned int ResourceGroupID;
+
+	/**
+	 * Group for resources that are kept for the lifetime of the resource
+	 * manager. This group is never released.
+	 */
+	const ResourceGroupID PersistentResourceGroup = 0;
+}
+
+#endif
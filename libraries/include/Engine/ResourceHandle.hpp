@@ -0,0 +1,94 @@
+#ifndef RESOURCEHANDLE_H
+#define	RESOURCEHANDLE_H
+
+#include <cstdint>
+
+namespace Engine
+{
+	/**
+	 * Typed handle to a resource held by the @see ResourceManager.
+	 *
+	 * A handle is an index into the resource manager's table of resources of
+	 * the same type. Handles are resolved from resource paths once, and can
+	 * then be used to fetch the resource without any string operations. A
+	 * handle stays valid for the lifetime of the resource manager, whether or
+	 * not its resource has finished loading.
+	 */
+	template <typename ResourceType>
+	class ResourceHandle
+	{
+	public:
+		/**
+		 * Index type.
+		 */
+		typedef std::uint32_t Index;
+
+		/**
+		 * Index of a handle that does not refer to any resource.
+		 */
+		static const Index InvalidIndex = 0xFFFFFFFF;
+
+		/**
+		 * Constructor for an invalid handle.
+		 */
+		ResourceHandle()
+		: m_index(InvalidIndex)
+		{
+			// Nothing to do.
+		}
+
+		/**
+		 * Constructor.
+		 *
+		 * @param index Index of the resource in the resource table.
+		 */
+		explicit ResourceHandle(Index index)
+		: m_index(index)
+		{
+			// Nothing to do.
+		}
+
+		/**
+		 * Returns true if the handle refers to a resource.
+		 *
+		 * @return True if the handle is valid.
+		 */
+		bool IsValid() const
+		{
+			return m_index != InvalidIndex;
+		}
+
+		/**
+		 * Returns the index of the resource in the resource table.
+		 *
+		 * @return Resource index.
+		 */
+		Index GetIndex() const
+		{
+			return m_index;
+		}
+
+		bool operator==(const ResourceHandle& other) const
+		{
+			return m_index == other.m_index;
+		}
+
+		bool operator!=(const ResourceHandle& other) const
+		{
+			return m_index != other.m_index;
+		}
+
+		bool operator<(const ResourceHandle& other) const
+		{
+			return m_index < other.m_index;
+		}
+
+	private:
+		/**
+		 * Index of the resource in the resource table.
+		 */
+		Index m_index;
+	};
+}
+
+#endif
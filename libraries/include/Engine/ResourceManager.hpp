@@ -4,12 +4,26 @@
 #include <string>
 #include <memory>
 #include <unordered_map>
+#include <set>
+#include <utility>
+#include <vector>
+#include <ostream>
 #include <functional>
 #include <thread>
+#include <atomic>
+#include <chrono>
 
 #include <Engine/NonCopyable.hpp>
 #include <Engine/Window.hpp>
 #include <Engine/ThreadEventReceiver.hpp>
+#include <Engine/WorkerPool.hpp>
+#include <Engine/ResourcePriority.hpp>
+#include <Engine/ResourceGroupID.hpp>
+#include <Engine/ResourcePack.hpp>
+#include <Engine/ResourceHandle.hpp>
+#include <Engine/ResourceTable.hpp>
+#include <Engine/ResourceManifest.hpp>
+#include <Engine/ResourceBundle.hpp>
 
 #include <Engine/ShaderProgram.hpp>
 #include <Engine/Model.hpp>
@@ -20,6 +34,7 @@
 #include <Engine/Event/LoadShaderProgramResourceEvent.hpp>
 #include <Engine/Event/LoadTextureResourceEvent.hpp>
 #include <Engine/Event/LoadAudioResourceEvent.hpp>
+#include <Engine/Event/UploadResourceEvent.hpp>
 
 namespace Engine
 {
@@ -27,6 +42,15 @@ namespace Engine
 	 * Performs the actual loading.
 	 * The ResourceLoader::Run() method should be the entry point
 	 * for the loading thread.
+	 *
+	 * Loading is split into two stages. Files are read and decoded into plain
+	 * vertex, pixel and sample buffers by a pool of worker threads, in order
+	 * of request priority. The decoded buffers are then sent to the graphics
+	 * card by the loading thread, which is the only loader thread with an
+	 * OpenGL context.
+	 *
+	 * Files are read from the resource pack, if one is open and contains
+	 * them, and otherwise from the file system.
 	 */
 	class ResourceLoader : private NonCopyable
 	{
@@ -38,9 +62,12 @@ namespace Engine
 		 * receiver.
 		 * @param loadingWindow Shared pointer to the window with the OpenGL
 		 * context used for loading resources.
+		 * @param resourcePackPath Path to the resource pack to serve
+		 * resources from. Resources are only loaded from individual files if
+		 * the path is empty or the pack does not exist.
 		 */
 		ResourceLoader(std::shared_ptr<ThreadEventReceiver> gameThreadReceiver,
-			std::shared_ptr<Window> loadingWindow);
+			std::shared_ptr<Window> loadingWindow, std::string resourcePackPath);
 
 		/**
 		 * Destructor.
@@ -59,6 +86,41 @@ namespace Engine
 		 */
 		ThreadEventReceiver& GetReceiver();
 
+		/**
+		 * Limits the time that the loading thread spends processing requests
+		 * in each frame period. Once the budget is used up, the loading
+		 * thread sleeps for the remainder of the frame period so that GL
+		 * uploads on the shared context do not starve the render thread.
+		 *
+		 * @note This may be called from any thread.
+		 *
+		 * @param budget Processing time per frame period, or zero to process
+		 * requests as fast as possible (default).
+		 */
+		void SetFrameBudget(std::chrono::microseconds budget);
+
+		/**
+		 * Returns the size of a file in the resource pack or, failing that,
+		 * on the file system.
+		 *
+		 * @note This may be called from any thread.
+		 *
+		 * @param filepath Path to the file.
+		 * @return Size of the file (in bytes), or zero if it does not exist.
+		 */
+		std::size_t GetFileSize(const std::string& filepath) const;
+
+		/**
+		 * Returns the size of the file that a model would be loaded from,
+		 * which is the baked model if it is used.
+		 *
+		 * @note This may be called from any thread.
+		 *
+		 * @param filepath Path to the model file.
+		 * @return Size of the file (in bytes), or zero if it does not exist.
+		 */
+		std::size_t GetModelFileSize(const std::string& filepath) const;
+
 		/**
 		 * Handles LoadModelResourceEvents by loading the requested
 		 * model.
@@ -99,6 +161,16 @@ namespace Engine
 		 */
 		void HandleLoadAudioResourceEvent(const Event::LoadAudioResourceEvent& event);
 
+		/**
+		 * Handles UploadResourceEvents by sending a decoded resource over to
+		 * the graphics card.
+		 *
+		 * @note This method is executed from the loading thread.
+		 *
+		 * @param event Reference to the event.
+		 */
+		void HandleUploadResourceEvent(const Event::UploadResourceEvent& event);
+
 		/**
 		 * Handles StopThreadEvents by setting a flag to return out of
 		 * the loading thread entry method.
@@ -108,11 +180,35 @@ namespace Engine
 		void HandleStopThreadEvent(const Event::StopThreadEvent& event);
 
 	private:
+		/**
+		 * Reads a shader source file from the resource pack or, failing
+		 * that, from the file system.
+		 *
+		 * @note This may be called from any thread.
+		 *
+		 * @param filepath Path to the shader source file.
+		 * @param source Receives the shader source.
+		 * @return True if the source was read successfully.
+		 */
+		bool ReadShaderSource(const std::string& filepath, std::string& source) const;
+
+	private:
+		/**
+		 * Frame period used when throttling the loading thread.
+		 */
+		static const std::chrono::microseconds FramePeriod;
+
 		/**
 		 * Should the loading thread be terminated?
 		 */
 		bool m_terminateLoadingThread;
 
+		/**
+		 * Processing time budget per frame period (in microseconds). Zero
+		 * disables throttling.
+		 */
+		std::atomic<long long> m_frameBudget;
+
 		/**
 		 * Event receiver for the loading thread.
 		 */
@@ -150,10 +246,30 @@ namespace Engine
 		 */
 		ThreadEventReceiver::SubscriptionID m_loadAudioSubscription;
 
+		/**
+		 * Subscription identifier for the UploadResourceEvent subscription.
+		 */
+		ThreadEventReceiver::SubscriptionID m_uploadSubscription;
+
 		/**
 		 * Subscription identifier for the StopThreadEvent subscription.
 		 */
 		ThreadEventReceiver::SubscriptionID m_stopThreadSubscription;
+
+		/**
+		 * Resource pack that resources are read from. This is opened before
+		 * the loading thread starts and is not modified afterwards, so the
+		 * workers may read from it freely.
+		 */
+		ResourcePack m_resourcePack;
+
+		/**
+		 * Worker threads that decode resources.
+		 *
+		 * @note This is declared last so that the workers are stopped before
+		 * the event receivers that they publish to are destroyed.
+		 */
+		WorkerPool m_workerPool;
 	};
 
 	/**
@@ -161,18 +277,53 @@ namespace Engine
 	 * This class also holds pointers to any loaded resources.
 	 * This class starts the loading thread.
 	 *
+	 * Loaded resources are kept while they are referenced, either by a
+	 * resource group or through @see AddReference. Resources that are no
+	 * longer referenced stay loaded until a memory budget is exceeded, at
+	 * which point they are evicted least recently used first.
+	 *
 	 * @note The actual loading is performed by the ResourceLoader
 	 * class.
 	 */
 	class ResourceManager : private NonCopyable
 	{
 	public:
+		/**
+		 * Resource group identifier.
+		 */
+		typedef ResourceGroupID GroupID;
+
+		/**
+		 * Group for resources that are kept for the lifetime of the resource
+		 * manager. This group is never released.
+		 */
+		static const GroupID PersistentGroup = PersistentResourceGroup;
+
+		/**
+		 * Memory used by the resident resources of each type.
+		 */
+		struct MemoryReport
+		{
+			ResourceUsage shaderPrograms;
+			ResourceUsage models;
+			ResourceUsage textures;
+			ResourceUsage audioSources;
+		};
+
+		/**
+		 * Path to the resource pack that is used if it exists.
+		 */
+		static const char* const DefaultResourcePackPath;
+
 		/**
 		 * Constructor.
 		 *
 		 * @param Shared pointer to the window to use for the loading thread.
+		 * @param resourcePackPath Path to the resource pack to load resources
+		 * from, if it exists.
 		 */
-		ResourceManager(std::shared_ptr<Window> loadingWindow);
+		ResourceManager(std::shared_ptr<Window> loadingWindow,
+			std::string resourcePackPath = DefaultResourcePackPath);
 
 		/**
 		 * Destructor.
@@ -180,10 +331,113 @@ namespace Engine
 		~ResourceManager();
 
 		/**
-		 * Processes events in game thread event receiver.
+		 * Processes events in game thread event receiver, hands more of each
+		 * bundle's resources over to the loader, and evicts unreferenced
+		 * resources if a memory budget has been exceeded.
 		 */
 		void Update();
 
+		/**
+		 * Sets the memory budgets. Resources that are not referenced are
+		 * evicted, least recently used first, while either budget is
+		 * exceeded.
+		 *
+		 * @param cpuBytes Main memory budget (in bytes), or zero for no
+		 * limit (default).
+		 * @param gpuBytes Graphics memory budget (in bytes), or zero for no
+		 * limit (default).
+		 */
+		void SetMemoryBudget(std::size_t cpuBytes, std::size_t gpuBytes);
+
+		/**
+		 * Returns the memory used by the resident resources of each type.
+		 *
+		 * @return Memory report.
+		 */
+		MemoryReport GetMemoryReport() const;
+
+		/**
+		 * Writes the memory report to the stream as a table.
+		 *
+		 * @param stream Output stream.
+		 */
+		void PrintMemoryReport(std::ostream& stream) const;
+
+		/**
+		 * Creates an empty resource group. Resources in the group are
+		 * referenced until the group is released.
+		 *
+		 * @return Identifier for the group.
+		 */
+		GroupID CreateGroup();
+
+		/**
+		 * Releases the references held by a resource group and destroys the
+		 * group.
+		 *
+		 * @param group Identifier for the group.
+		 */
+		void ReleaseGroup(GroupID group);
+
+		/**
+		 * Adds a resource to a group, unless it is already in the group. The
+		 * group references the resource, as with @see AddReference, so a
+		 * resource that has been evicted is requested again.
+		 *
+		 * @param group Identifier for the group.
+		 * @param handle Handle to the resource.
+		 */
+		void AddToGroup(GroupID group, ResourceHandle<ShaderProgram> handle);
+		void AddToGroup(GroupID group, ResourceHandle<Model> handle);
+		void AddToGroup(GroupID group, ResourceHandle<Texture> handle);
+		void AddToGroup(GroupID group, ResourceHandle<IAudioSource> handle);
+
+		/**
+		 * Adds a reference to a resource, which prevents it from being
+		 * evicted. A resource that has already been evicted is requested
+		 * again.
+		 *
+		 * @param handle Handle to the resource.
+		 */
+		void AddReference(ResourceHandle<ShaderProgram> handle);
+		void AddReference(ResourceHandle<Model> handle);
+		void AddReference(ResourceHandle<Texture> handle);
+		void AddReference(ResourceHandle<IAudioSource> handle);
+
+		/**
+		 * Removes a reference to a resource.
+		 *
+		 * @param handle Handle to the resource.
+		 */
+		void ReleaseReference(ResourceHandle<ShaderProgram> handle);
+		void ReleaseReference(ResourceHandle<Model> handle);
+		void ReleaseReference(ResourceHandle<Texture> handle);
+		void ReleaseReference(ResourceHandle<IAudioSource> handle);
+
+		/**
+		 * Limits the time that the loading thread spends processing requests
+		 * in each frame period.
+		 *
+		 * @see ResourceLoader::SetFrameBudget
+		 *
+		 * @param budget Processing time per frame period, or zero to process
+		 * requests as fast as possible (default).
+		 */
+		void SetLoadingFrameBudget(std::chrono::microseconds budget);
+
+		/**
+		 * Loads the resources listed in a manifest. The resources are handed
+		 * over to the loader a few at a time, highest priority first, as
+		 * earlier ones finish loading. Resources that have already been
+		 * loaded, or requested, are not loaded again but are still added to
+		 * the groups given in the manifest.
+		 *
+		 * @param manifest Resources to load.
+		 * @return Bundle through which the progress of the loading can be
+		 * followed, or the loading cancelled.
+		 */
+		std::shared_ptr<ResourceBundle> LoadBundle(const ResourceManifest& manifest);
+
 		/**
 		 * Loads a shader program given paths to the vertex and fragment shader
 		 * source files.
@@ -191,75 +445,187 @@ namespace Engine
 		 * @param vertexShaderFilepath Path to the vertex shader.
 		 * @param fragmentShaderFilepath Path to the fragment shader.
 		 * @param callback Callback function.
+		 * @param priority Loading priority.
+		 * @param group Group to add the shader program to.
 		 */
 		void LoadShaderProgram(std::string vertexShaderFilepath,
 			std::string fragmentShaderFilepath,
-			std::function<void(const Event::ResourceLoadedEvent<ShaderProgram>&)> callback);
+			std::function<void(const Event::ResourceLoadedEvent<ShaderProgram>&)> callback,
+			ResourcePriority priority = ResourcePriority::Normal,
+			GroupID group = PersistentGroup);
+
+		/**
+		 * Returns the handle to the shader program specified by the provided
+		 * vertex and fragment shader file paths. The shader program does not
+		 * need to have been loaded, or requested, yet.
+		 *
+		 * @param vertexShaderFilepath Path to the vertex shader.
+		 * @param fragmentShaderFilepath Path to the fragment shader.
+		 * @return Handle to the shader program.
+		 */
+		ResourceHandle<ShaderProgram> GetShaderProgramHandle(const std::string& vertexShaderFilepath,
+			const std::string& fragmentShaderFilepath);
+
+		/**
+		 * Returns a shared pointer to the shader program specified by the
+		 * provided handle.
+		 *
+		 * @param handle Handle to the shader program.
+		 * @return Shared pointer to the shader program, or a nullptr if it has
+		 * not been loaded.
+		 */
+		std::shared_ptr<ShaderProgram> GetShaderProgram(ResourceHandle<ShaderProgram> handle) const;
 
 		/**
 		 * Returns a shared pointer to the shader program specified by the
 		 * provided vertex and fragment shader file paths.
 		 *
+		 * @note Prefer resolving a handle once with @see
+		 * GetShaderProgramHandle for repeated lookups.
+		 *
 		 * @param vertexShaderFilepath Path to the vertex shader.
 		 * @param fragmentShaderFilepath Path to the fragment shader.
 		 * @return Shared pointer to the shader program.
 		 */
-		std::shared_ptr<ShaderProgram> GetShaderProgram(std::string vertexShaderFilepath,
-			std::string fragmentShaderFilepath);
+		std::shared_ptr<ShaderProgram> GetShaderProgram(const std::string& vertexShaderFilepath,
+			const std::string& fragmentShaderFilepath) const;
 
 		/**
-		 * Loads a 3D model from the specified file.
+		 * Loads a 3D model from the specified file. If a baked version of
+		 * the model (@see Model::GetBakedFilepath) exists and is up to date,
+		 * it is loaded instead.
 		 *
 		 * @param filepath Path to the model file.
 		 * @param onCompleteCallback Callback function.
+		 * @param priority Loading priority.
+		 * @param group Group to add the model to.
 		 */
 		void LoadModel(std::string filepath,
-			std::function<void(const Event::ResourceLoadedEvent<Model>&)> callback);
+			std::function<void(const Event::ResourceLoadedEvent<Model>&)> callback,
+			ResourcePriority priority = ResourcePriority::Normal,
+			GroupID group = PersistentGroup);
+
+		/**
+		 * Returns the handle to the model specified by the provided model file
+		 * path. The model does not need to have been loaded, or requested,
+		 * yet.
+		 *
+		 * @param filepath Path to the model file.
+		 * @return Handle to the model.
+		 */
+		ResourceHandle<Model> GetModelHandle(const std::string& filepath);
+
+		/**
+		 * Returns a shared pointer to the model specified by the provided
+		 * handle.
+		 *
+		 * @param handle Handle to the model.
+		 * @return Shared pointer to the model, or a nullptr if it has not
+		 * been loaded.
+		 */
+		std::shared_ptr<Model> GetModel(ResourceHandle<Model> handle) const;
 
 		/**
-		 * Returns a shared pointer to the model specified by the provided file
-		 * path.
+		 * Returns a shared pointer to the model specified by the provided
+		 * model file path.
+		 *
+		 * @note Prefer resolving a handle once with @see GetModelHandle for
+		 * repeated lookups.
 		 *
 		 * @param filepath Path to the model file.
 		 * @return Shared pointer to the model.
 		 */
-		std::shared_ptr<Model> GetModel(std::string filepath);
+		std::shared_ptr<Model> GetModel(const std::string& filepath) const;
 
 		/**
 		 * Loads a texture from the specified image file.
 		 *
 		 * @param filepath Path to the image file.
 		 * @param onCompleteCallback Callback function.
+		 * @param priority Loading priority.
+		 * @param group Group to add the texture to.
 		 */
 		void LoadTexture(std::string filepath,
-			std::function<void(const Event::ResourceLoadedEvent<Texture>&)> callback);
+			std::function<void(const Event::ResourceLoadedEvent<Texture>&)> callback,
+			ResourcePriority priority = ResourcePriority::Normal,
+			GroupID group = PersistentGroup);
+
+		/**
+		 * Returns the handle to the texture specified by the provided image file
+		 * path. The texture does not need to have been loaded, or requested,
+		 * yet.
+		 *
+		 * @param filepath Path to the image file.
+		 * @return Handle to the texture.
+		 */
+		ResourceHandle<Texture> GetTextureHandle(const std::string& filepath);
+
+		/**
+		 * Returns a shared pointer to the texture specified by the provided
+		 * handle.
+		 *
+		 * @param handle Handle to the texture.
+		 * @return Shared pointer to the texture, or a nullptr if it has not
+		 * been loaded.
+		 */
+		std::shared_ptr<Texture> GetTexture(ResourceHandle<Texture> handle) const;
 
 		/**
 		 * Returns a shared pointer to the texture specified by the provided
 		 * image file path.
 		 *
+		 * @note Prefer resolving a handle once with @see GetTextureHandle for
+		 * repeated lookups.
+		 *
 		 * @param filepath Path to the image file.
 		 * @return Shared pointer to the texture.
 		 */
-		std::shared_ptr<Texture> GetTexture(std::string filepath);
+		std::shared_ptr<Texture> GetTexture(const std::string& filepath) const;
 
 		/**
 		 * Loads a audio source from the specified audio file.
 		 *
 		 * @param filepath Path to the audio file.
 		 * @param onCompleteCallback Callback function.
+		 * @param priority Loading priority.
+		 * @param group Group to add the audio source to.
 		 */
 		void LoadAudio(std::string filepath,
-			std::function<void(const Event::ResourceLoadedEvent<IAudioSource>&)> callback);
+			std::function<void(const Event::ResourceLoadedEvent<IAudioSource>&)> callback,
+			ResourcePriority priority = ResourcePriority::Normal,
+			GroupID group = PersistentGroup);
+
+		/**
+		 * Returns the handle to the audio source specified by the provided audio file
+		 * path. The audio source does not need to have been loaded, or requested,
+		 * yet.
+		 *
+		 * @param filepath Path to the audio file.
+		 * @return Handle to the audio source.
+		 */
+		ResourceHandle<IAudioSource> GetAudioHandle(const std::string& filepath);
+
+		/**
+		 * Returns a shared pointer to the audio source specified by the provided
+		 * handle.
+		 *
+		 * @param handle Handle to the audio source.
+		 * @return Shared pointer to the audio source, or a nullptr if it has not
+		 * been loaded.
+		 */
+		std::shared_ptr<IAudioSource> GetAudio(ResourceHandle<IAudioSource> handle) const;
 
 		/**
-		 * Returns a shared pointer to the audio source specified by the
-		 * provided audio file path.
+		 * Returns a shared pointer to the audio source specified by the provided
+		 * audio file path.
+		 *
+		 * @note Prefer resolving a handle once with @see GetAudioHandle for
+		 * repeated lookups.
 		 *
 		 * @param filepath Path to the audio file.
 		 * @return Shared pointer to the audio source.
 		 */
-		std::shared_ptr<IAudioSource> GetAudio(std::string filepath);
+		std::shared_ptr<IAudioSource> GetAudio(const std::string& filepath) const;
 
 		/**
 		 * Handles ResourceLoadedEvents for models by executing the
@@ -302,6 +668,66 @@ namespace Engine
 		void HandleAudioResourceLoadedEvent(const Event::ResourceLoadedEvent<IAudioSource>& event);
 
 	private:
+		/**
+		 * Resources referenced by a resource group.
+		 */
+		struct ResourceGroup
+		{
+			std::set<ResourceHandle<ShaderProgram>> shaderPrograms;
+			std::set<ResourceHandle<Model>> models;
+			std::set<ResourceHandle<Texture>> textures;
+			std::set<ResourceHandle<IAudioSource>> audioSources;
+		};
+
+		/**
+		 * Checks on a bundle's requests in flight and hands more of its
+		 * resources over to the loader.
+		 *
+		 * @param bundle The bundle.
+		 */
+		void UpdateBundle(ResourceBundle& bundle);
+
+		/**
+		 * Returns the state of the request for a resource listed in a
+		 * manifest.
+		 *
+		 * @param entry Manifest entry for the resource.
+		 * @return State of the request.
+		 */
+		ResourceBundle::RequestStatus GetRequestStatus(const ResourceManifest::Entry& entry) const;
+
+		/**
+		 * Requests a resource listed in a manifest, unless it has already
+		 * been requested, and adds it to the entry's group.
+		 *
+		 * @param entry Manifest entry for the resource.
+		 */
+		void RequestEntry(const ResourceManifest::Entry& entry);
+
+		/**
+		 * Evicts unreferenced resources, least recently used first, until
+		 * the memory budgets are met.
+		 */
+		void EnforceMemoryBudget();
+
+		/**
+		 * Evicts a model and releases its references to its textures.
+		 *
+		 * @param handle Handle to the model.
+		 */
+		void EvictModel(ResourceHandle<Model> handle);
+
+		/**
+		 * Requests an evicted resource again, so that adding a reference to
+		 * an evicted resource brings it back.
+		 *
+		 * @param handle Handle to the evicted resource.
+		 */
+		void Reload(ResourceHandle<ShaderProgram> handle);
+		void Reload(ResourceHandle<Model> handle);
+		void Reload(ResourceHandle<Texture> handle);
+		void Reload(ResourceHandle<IAudioSource> handle);
+
 		/**
 		 * Returns the unique name that should identify the shader program
 		 * specified by the provided vertex and fragment shader file paths.
@@ -347,24 +773,62 @@ namespace Engine
 		std::shared_ptr<ThreadEventReceiver> m_gameThreadEventReceiver;
 
 		/**
-		 * Loaded shader programs.
+		 * Shader programs.
+		 */
+		ResourceTable<ShaderProgram> m_shaderPrograms;
+
+		/**
+		 * Vertex and fragment shader file paths of each requested shader
+		 * program, by handle index, which are needed to reload the shader
+		 * program after it has been evicted.
+		 */
+		std::unordered_map<ResourceHandle<ShaderProgram>::Index, std::pair<std::string, std::string>> m_shaderProgramFilepaths;
+
+		/**
+		 * Models.
+		 */
+		ResourceTable<Model> m_models;
+
+		/**
+		 * Textures.
+		 */
+		ResourceTable<Texture> m_textures;
+
+		/**
+		 * Audio sources.
+		 */
+		ResourceTable<IAudioSource> m_audioSources;
+
+		/**
+		 * Resource groups.
+		 */
+		std::unordered_map<GroupID, ResourceGroup> m_groups;
+
+		/**
+		 * Bundles that are still loading.
+		 */
+		std::vector<std::shared_ptr<ResourceBundle>> m_bundles;
+
+		/**
+		 * Identifier for the next group to be created.
 		 */
-		std::unordered_map<std::string, std::shared_ptr<ShaderProgram>> m_shaderPrograms;
+		GroupID m_nextGroupID;
 
 		/**
-		 * Loaded models.
+		 * Main memory budget (in bytes), or zero for no limit.
 		 */
-		std::unordered_map<std::string, std::shared_ptr<Model>> m_models;
+		std::size_t m_cpuMemoryBudget;
 
 		/**
-		 * Loaded textures.
+		 * Graphics memory budget (in bytes), or zero for no limit.
 		 */
-		std::unordered_map<std::string, std::shared_ptr<Texture>> m_textures;
+		std::size_t m_gpuMemoryBudget;
 
 		/**
-		 * Loaded audio sources.
+		 * Number of updates, used to order resources by when they were last
+		 * used.
 		 */
-		std::unordered_map<std::string, std::shared_ptr<IAudioSource>> m_audioSources;
+		std::uint64_t m_clock;
 
 		/**
 		 * The resource loader.
@@ -0,0 +1,161 @@
+#ifndef RESOURCEMANIFEST_H
+#define	RESOURCEMANIFEST_H
+
+#include <string>
+#include <vector>
+
+#include <Engine/ResourcePriority.hpp>
+#include <Engine/ResourceGroupID.hpp>
+
+namespace Engine
+{
+	/**
+	 * List of the resources that something (e.g. a scene) depends on, which
+	 * can be loaded together as a bundle with @see ResourceManager::LoadBundle.
+	 */
+	class ResourceManifest
+	{
+	public:
+		/**
+		 * Types of resource.
+		 */
+		enum class Kind
+		{
+			ShaderProgram,
+			Model,
+			Texture,
+			Audio
+		};
+
+		/**
+		 * Resource listed in the manifest.
+		 */
+		struct Entry
+		{
+			/**
+			 * Type of resource.
+			 */
+			Kind kind;
+
+			/**
+			 * Path to the resource file. This is the vertex shader for shader
+			 * programs.
+			 */
+			std::string path;
+
+			/**
+			 * Path to the fragment shader for shader programs. This is empty
+			 * for other types of resource.
+			 */
+			std::string secondaryPath;
+
+			/**
+			 * Loading priority.
+			 */
+			ResourcePriority priority;
+
+			/**
+			 * Group to add the resource to.
+			 */
+			ResourceGroupID group;
+		};
+
+		/**
+		 * Constructor.
+		 */
+		ResourceManifest();
+
+		/**
+		 * Destructor.
+		 */
+		~ResourceManifest();
+
+		/**
+		 * Adds a shader program to the manifest.
+		 *
+		 * @param vertexShaderFilepath Path to the vertex shader.
+		 * @param fragmentShaderFilepath Path to the fragment shader.
+		 * @param priority Loading priority.
+		 * @param group Group to add the shader program to.
+		 */
+		void AddShaderProgram(std::string vertexShaderFilepath,
+			std::string fragmentShaderFilepath,
+			ResourcePriority priority = ResourcePriority::Normal,
+			ResourceGroupID group = PersistentResourceGroup);
+
+		/**
+		 * Adds a model to the manifest.
+		 *
+		 * @param filepath Path to the model file.
+		 * @param priority Loading priority.
+		 * @param group Group to add the model to.
+		 */
+		void AddModel(std::string filepath,
+			ResourcePriority priority = ResourcePriority::Normal,
+			ResourceGroupID group = PersistentResourceGroup);
+
+		/**
+		 * Adds a texture to the manifest.
+		 *
+		 * @param filepath Path to the image file.
+		 * @param priority Loading priority.
+		 * @param group Group to add the texture to.
+		 */
+		void AddTexture(std::string filepath,
+			ResourcePriority priority = ResourcePriority::Normal,
+			ResourceGroupID group = PersistentResourceGroup);
+
+		/**
+		 * Adds an audio source to the manifest.
+		 *
+		 * @param filepath Path to the audio file.
+		 * @param priority Loading priority.
+		 * @param group Group to add the audio source to.
+		 */
+		void AddAudio(std::string filepath,
+			ResourcePriority priority = ResourcePriority::Normal,
+			ResourceGroupID group = PersistentResourceGroup);
+
+		/**
+		 * Adds all of the entries in another manifest to this one.
+		 *
+		 * @param manifest The other manifest.
+		 */
+		void Append(const ResourceManifest& manifest);
+
+		/**
+		 * Returns the entries, in the order in which they were added.
+		 *
+		 * @return The entries.
+		 */
+		const std::vector<Entry>& GetEntries() const;
+
+		/**
+		 * Returns the number of entries.
+		 *
+		 * @return Number of entries.
+		 */
+		unsigned int GetEntryCount() const;
+
+	private:
+		/**
+		 * Adds an entry to the manifest.
+		 *
+		 * @param kind Type of resource.
+		 * @param path Path to the resource file.
+		 * @param secondaryPath Path to the fragment shader, or empty.
+		 * @param priority Loading priority.
+		 * @param group Group to add the resource to.
+		 */
+		void AddEntry(Kind kind, std::string path, std::string secondaryPath,
+			ResourcePriority priority, ResourceGroupID group);
+
+	private:
+		/**
+		 * The entries.
+		 */
+		std::vector<Entry> m_entries;
+	};
+}
+
+#endif
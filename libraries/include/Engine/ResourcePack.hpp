@@ -0,0 +1,173 @@
+#ifndef RESOURCEPACK_H
+#define	RESOURCEPACK_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include <Engine/NonCopyable.hpp>
+#include <Engine/MemoryMappedFile.hpp>
+#include <Engine/ResourcePackFormat.hpp>
+
+namespace Engine
+{
+	/**
+	 * Read-only archive of resources, memory mapped from a single file built
+	 * by @see ResourcePackWriter.
+	 *
+	 * Once opened, a resource pack may be read from any number of threads
+	 * at once.
+	 */
+	class ResourcePack : private NonCopyable
+	{
+	public:
+		/**
+		 * Contents of a single resource.
+		 *
+		 * Resources that are stored uncompressed are not copied; the blob
+		 * points straight into the mapped pack, and is only valid while the
+		 * pack remains open. Compressed resources are decompressed into a
+		 * buffer owned by the blob.
+		 */
+		class Blob
+		{
+		public:
+			/**
+			 * Constructor.
+			 */
+			Blob();
+
+			/**
+			 * Returns a pointer to the resource data.
+			 *
+			 * @return Pointer to the resource data.
+			 */
+			const unsigned char* GetData() const;
+
+			/**
+			 * Returns the size of the resource.
+			 *
+			 * @return Size of the resource (in bytes).
+			 */
+			std::size_t GetSize() const;
+
+		private:
+			friend class ResourcePack;
+
+			/**
+			 * Pointer to the resource data.
+			 */
+			const unsigned char* m_data;
+
+			/**
+			 * Size of the resource data (in bytes).
+			 */
+			std::size_t m_size;
+
+			/**
+			 * Decompressed data, for compressed resources.
+			 */
+			std::vector<unsigned char> m_buffer;
+		};
+
+		/**
+		 * Constructor.
+		 */
+		ResourcePack();
+
+		/**
+		 * Destructor.
+		 */
+		~ResourcePack();
+
+		/**
+		 * Maps the specified resource pack into memory and validates its
+		 * index.
+		 *
+		 * @param filepath Path to the resource pack file.
+		 * @return True if the resource pack was opened successfully.
+		 */
+		bool Open(std::string filepath);
+
+		/**
+		 * Returns true if a resource pack is open.
+		 *
+		 * @return True if a resource pack is open.
+		 */
+		bool IsOpen() const;
+
+		/**
+		 * Returns the number of resources in the pack.
+		 *
+		 * @return Number of resources.
+		 */
+		unsigned int GetResourceCount() const;
+
+		/**
+		 * Returns true if the pack contains the resource with the specified
+		 * path.
+		 *
+		 * @param path Path to the resource, as given to the packer.
+		 * @return True if the resource is in the pack.
+		 */
+		bool Contains(const std::string& path) const;
+
+		/**
+		 * Returns the uncompressed size of the resource with the specified
+		 * path, without reading it.
+		 *
+		 * @param path Path to the resource, as given to the packer.
+		 * @param size Receives the size (in bytes).
+		 * @return True if the resource is in the pack.
+		 */
+		bool GetSize(const std::string& path, std::size_t& size) const;
+
+		/**
+		 * Reads the resource with the specified path.
+		 *
+		 * @param path Path to the resource, as given to the packer.
+		 * @param blob Receives the resource contents.
+		 * @return True if the resource is in the pack and was read
+		 * successfully. False is always returned if no pack is open.
+		 */
+		bool Read(const std::string& path, Blob& blob) const;
+
+		/**
+		 * Returns the hash used to identify the resource with the specified
+		 * path. A leading "./" is ignored.
+		 *
+		 * @param path Path to the resource.
+		 * @return 64-bit FNV-1a hash of the path.
+		 */
+		static std::uint64_t HashPath(const std::string& path);
+
+	private:
+		/**
+		 * Binary searches the index for the resource with the specified path.
+		 *
+		 * @param path Path to the resource.
+		 * @return Pointer to the index entry, or a nullptr if there is no
+		 * such resource.
+		 */
+		const ResourcePackFormat::Entry* FindEntry(const std::string& path) const;
+
+	private:
+		/**
+		 * The mapped pack file.
+		 */
+		MemoryMappedFile m_file;
+
+		/**
+		 * Index entries, sorted by path hash.
+		 */
+		const ResourcePackFormat::Entry* m_entries;
+
+		/**
+		 * Number of index entries.
+		 */
+		std::uint32_t m_entryCount;
+	};
+}
+
+#endif
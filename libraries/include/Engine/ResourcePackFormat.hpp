@@ -0,0 +1,97 @@
+#ifndef RESOURCEPACKFORMAT_H
+#define	RESOURCEPACKFORMAT_H
+
+#include <cstdint>
+
+namespace Engine
+{
+	/**
+	 * Layout of resource pack files.
+	 *
+	 * A resource pack starts with a @see Header, which is immediately
+	 * followed by the index: an array of @see Entry records sorted by path
+	 * hash. The resource data follows the index. Each resource starts on a
+	 * @see BlobAlignment byte boundary and is stored either as is or
+	 * compressed as a single LZ4 block.
+	 *
+	 * Paths are not stored. A resource is found by hashing its path and
+	 * binary searching the index, so the pack can be memory mapped and read
+	 * in place. The packer rejects paths with colliding hashes.
+	 *
+	 * All values are stored in the byte order of the machine that built the
+	 * pack (little endian on all supported platforms).
+	 */
+	namespace ResourcePackFormat
+	{
+		/**
+		 * Identifies a resource pack file.
+		 */
+		const char Magic[4] = {'T', 'R', 'P', 'K'};
+
+		/**
+		 * Current format version. Packs with a different version are
+		 * rejected.
+		 */
+		const std::uint32_t Version = 1;
+
+		/**
+		 * Alignment of each resource (in bytes).
+		 */
+		const std::uint64_t BlobAlignment = 16;
+
+		/**
+		 * Resource compression methods.
+		 */
+		enum class Compression : std::uint32_t
+		{
+			None = 0,
+			LZ4 = 1
+		};
+
+		/**
+		 * File header.
+		 */
+		struct Header
+		{
+			char magic[4];
+			std::uint32_t version;
+			std::uint32_t entryCount;
+			std::uint32_t reserved;
+			std::uint64_t indexOffset;
+		};
+
+		/**
+		 * Index entry.
+		 */
+		struct Entry
+		{
+			/**
+			 * 64-bit FNV-1a hash of the resource path.
+			 */
+			std::uint64_t pathHash;
+
+			/**
+			 * Absolute byte offset of the stored data.
+			 */
+			std::uint64_t offset;
+
+			/**
+			 * Size of the stored (possibly compressed) data in bytes.
+			 */
+			std::uint64_t storedSize;
+
+			/**
+			 * Size of the resource once decompressed, in bytes.
+			 */
+			std::uint64_t size;
+
+			Compression compression;
+			std::uint32_t reserved;
+		};
+
+		static_assert(sizeof(Header) == 24, "Unexpected padding in ResourcePackFormat::Header");
+		static_assert(sizeof(Entry) == 40, "Unexpected padding in ResourcePackFormat::Entry");
+	}
+}
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef RESOURCEPACKWRITER_H
+#define	RESOURCEPACKWRITER_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+
+#include <Engine/NonCopyable.hpp>
+#include <Engine/ResourcePackFormat.hpp>
+
+namespace Engine
+{
+	/**
+	 * Builds a resource pack file that can be read by @see ResourcePack.
+	 */
+	class ResourcePackWriter : private NonCopyable
+	{
+	public:
+		/**
+		 * Constructor.
+		 */
+		ResourcePackWriter();
+
+		/**
+		 * Destructor.
+		 */
+		~ResourcePackWriter();
+
+		/**
+		 * Adds a resource to the pack.
+		 *
+		 * @param path Path by which the resource will be loaded.
+		 * @param data Resource contents.
+		 * @param compress Try to compress the resource with LZ4? The resource
+		 * is stored uncompressed if compression does not save enough space to
+		 * be worth decompressing.
+		 * @return True if the resource was added. False is returned if the
+		 * path, or its hash, is already in the pack.
+		 */
+		bool Add(std::string path, std::vector<unsigned char> data, bool compress);
+
+		/**
+		 * Reads a file and adds it to the pack, using the file path as the
+		 * resource path.
+		 *
+		 * @param filepath Path to the file.
+		 * @param compress Try to compress the resource with LZ4?
+		 * @return True if the file was read and added.
+		 */
+		bool AddFile(std::string filepath, bool compress);
+
+		/**
+		 * Returns the number of resources added so far.
+		 *
+		 * @return Number of resources.
+		 */
+		unsigned int GetResourceCount() const;
+
+		/**
+		 * Writes the pack to disk.
+		 *
+		 * @param filepath Path to the pack file to write.
+		 * @return True if the pack was written successfully.
+		 */
+		bool Save(std::string filepath) const;
+
+	private:
+		/**
+		 * Resource waiting to be written.
+		 */
+		struct PendingResource
+		{
+			ResourcePackFormat::Entry entry;
+			std::vector<unsigned char> data;
+		};
+
+		/**
+		 * Resources, keyed by path hash so that they are written in index
+		 * order.
+		 */
+		std::map<std::uint64_t, PendingResource> m_resources;
+
+		/**
+		 * Resource path for each hash, used to report collisions.
+		 */
+		std::map<std::uint64_t, std::string> m_paths;
+	};
+}
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef RESOURCEPRIORITY_H
+#define	RESOURCEPRIORITY_H
+
+namespace Engine
+{
+	/**
+	 * Priorities for resource loading requests. Requests with a higher
+	 * priority are decoded before requests with a lower priority, regardless
+	 * of the order in which they were made.
+	 */
+	enum class ResourcePriority : unsigned int
+	{
+		/**
+		 * Resources that are not needed until later (e.g. the next scene).
+		 */
+		Low = 0,
+
+		/**
+		 * Default priority.
+		 */
+		Normal = 1,
+
+		/**
+		 * Resources that are needed to draw what is currently on screen.
+		 */
+		High = 2
+	};
+}
+
+#endif
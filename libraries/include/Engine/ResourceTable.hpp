@@ -0,0 +1,460 @@
+#ifndef RESOURCETABLE_H
+#define	RESOURCETABLE_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+
+#include <Engine/NonCopyable.hpp>
+#include <Engine/ResourceHandle.hpp>
+
+namespace Engine
+{
+	/**
+	 * Memory used by the resident resources of a single type.
+	 */
+	struct ResourceUsage
+	{
+		ResourceUsage()
+		: residentCount(0)
+		, referencedCount(0)
+		, cpuBytes(0)
+		, gpuBytes(0)
+		{
+			// Nothing to do.
+		}
+
+		/**
+		 * Number of loaded resources.
+		 */
+		unsigned int residentCount;
+
+		/**
+		 * Number of loaded resources that are referenced, and so cannot be
+		 * evicted.
+		 */
+		unsigned int referencedCount;
+
+		/**
+		 * Bytes of main memory used by the loaded resources.
+		 */
+		std::size_t cpuBytes;
+
+		/**
+		 * Bytes of graphics memory used by the loaded resources.
+		 */
+		std::size_t gpuBytes;
+	};
+
+	/**
+	 * Table of resources of a single type, addressed by @see ResourceHandle.
+	 *
+	 * Resource names are interned into slots the first time that they are
+	 * seen, either when the resource is requested or when a handle to it is
+	 * resolved. Slots are never removed, so handles remain valid. Looking up a
+	 * resource by its handle is a single array access.
+	 *
+	 * Each slot counts the references to its resource and records when the
+	 * resource was last used, so that loaded resources that are no longer
+	 * referenced can be evicted least recently used first.
+	 */
+	template <typename ResourceType>
+	class ResourceTable : private NonCopyable
+	{
+	public:
+		/**
+		 * Handle type for the resources in the table.
+		 */
+		typedef ResourceHandle<ResourceType> Handle;
+
+		/**
+		 * Constructor.
+		 */
+		ResourceTable()
+		: m_slots()
+		, m_indices()
+		, m_clock(0)
+		{
+			// Nothing to do.
+		}
+
+		/**
+		 * Destructor.
+		 */
+		~ResourceTable()
+		{
+			// Nothing to do.
+		}
+
+		/**
+		 * Returns the handle for the named resource, adding an empty slot for
+		 * the resource if the name has not been seen before.
+		 *
+		 * @param name Unique name for the resource.
+		 * @return Handle to the resource.
+		 */
+		Handle Intern(const std::string& name)
+		{
+			auto iter = m_indices.find(name);
+			if (iter != m_indices.end())
+			{
+				return Handle(iter->second);
+			}
+
+			const typename Handle::Index index = static_cast<typename Handle::Index>(m_slots.size());
+			assert(index != Handle::InvalidIndex);
+
+			m_slots.push_back(Slot());
+			m_slots.back().name = name;
+			m_indices.emplace(name, index);
+			return Handle(index);
+		}
+
+		/**
+		 * Returns the handle for the named resource, without adding a slot.
+		 *
+		 * @param name Unique name for the resource.
+		 * @return Handle to the resource, or an invalid handle if the name has
+		 * not been interned.
+		 */
+		Handle Find(const std::string& name) const
+		{
+			auto iter = m_indices.find(name);
+			return (iter != m_indices.end()) ? Handle(iter->second) : Handle();
+		}
+
+		/**
+		 * Returns the name that the resource was interned with.
+		 *
+		 * @param handle Handle to the resource.
+		 * @return Unique name for the resource.
+		 */
+		const std::string& GetName(Handle handle) const
+		{
+			assert(handle.GetIndex() < m_slots.size());
+			return m_slots[handle.GetIndex()].name;
+		}
+
+		/**
+		 * Returns the resource referred to by the handle, and marks the
+		 * resource as used at the current time.
+		 *
+		 * @param handle Handle to the resource.
+		 * @return Shared pointer to the resource, or a nullptr if the handle is
+		 * invalid or the resource has not been loaded.
+		 */
+		std::shared_ptr<ResourceType> Get(Handle handle) const
+		{
+			if (handle.GetIndex() < m_slots.size())
+			{
+				const Slot& slot = m_slots[handle.GetIndex()];
+				slot.lastUsed = m_clock;
+				return slot.resource;
+			}
+			else
+			{
+				return nullptr;
+			}
+		}
+
+		/**
+		 * Stores a loaded resource.
+		 *
+		 * @param handle Handle to the resource.
+		 * @param resource Shared pointer to the resource.
+		 * @param cpuBytes Bytes of main memory used by the resource.
+		 * @param gpuBytes Bytes of graphics memory used by the resource.
+		 */
+		void Set(Handle handle, std::shared_ptr<ResourceType> resource,
+			std::size_t cpuBytes = 0, std::size_t gpuBytes = 0)
+		{
+			assert(handle.GetIndex() < m_slots.size());
+			Slot& slot = m_slots[handle.GetIndex()];
+			slot.resource = resource;
+			slot.cpuBytes = resource ? cpuBytes : 0;
+			slot.gpuBytes = resource ? gpuBytes : 0;
+			slot.lastUsed = m_clock;
+		}
+
+		/**
+		 * Drops the table's pointer to a loaded resource that is no longer
+		 * referenced, so that it may be requested again.
+		 *
+		 * @param handle Handle to the resource.
+		 * @return True if the resource was evicted.
+		 */
+		bool Evict(Handle handle)
+		{
+			if (!IsEvictable(handle))
+			{
+				return false;
+			}
+
+			Slot& slot = m_slots[handle.GetIndex()];
+			slot.resource = nullptr;
+			slot.requested = false;
+			slot.evicted = true;
+			slot.cpuBytes = 0;
+			slot.gpuBytes = 0;
+			return true;
+		}
+
+		/**
+		 * Returns true if the resource was evicted and has not been requested
+		 * since, in which case it must be requested again before it is next
+		 * used.
+		 *
+		 * @param handle Handle to the resource.
+		 * @return True if the resource needs to be reloaded.
+		 */
+		bool IsEvicted(Handle handle) const
+		{
+			return handle.GetIndex() < m_slots.size() && m_slots[handle.GetIndex()].evicted;
+		}
+
+		/**
+		 * Returns true if the resource is loaded and not referenced.
+		 *
+		 * @param handle Handle to the resource.
+		 * @return True if the resource may be evicted.
+		 */
+		bool IsEvictable(Handle handle) const
+		{
+			return handle.GetIndex() < m_slots.size()
+				&& m_slots[handle.GetIndex()].resource
+				&& m_slots[handle.GetIndex()].references == 0;
+		}
+
+		/**
+		 * Adds a reference to the resource, which prevents it from being
+		 * evicted.
+		 *
+		 * @param handle Handle to the resource.
+		 * @return True if the resource was evicted, and must be requested
+		 * again for the reference to be of use (@see IsEvicted).
+		 */
+		bool AddReference(Handle handle)
+		{
+			assert(handle.GetIndex() < m_slots.size());
+			Slot& slot = m_slots[handle.GetIndex()];
+			++slot.references;
+			return slot.evicted;
+		}
+
+		/**
+		 * Removes a reference to the resource. The resource may be evicted
+		 * once it has no references.
+		 *
+		 * @param handle Handle to the resource.
+		 */
+		void ReleaseReference(Handle handle)
+		{
+			assert(handle.GetIndex() < m_slots.size());
+			Slot& slot = m_slots[handle.GetIndex()];
+			assert(slot.references > 0);
+			--slot.references;
+			slot.lastUsed = m_clock;
+		}
+
+		/**
+		 * Returns the number of references to the resource.
+		 *
+		 * @param handle Handle to the resource.
+		 * @return Reference count.
+		 */
+		unsigned int GetReferenceCount(Handle handle) const
+		{
+			return (handle.GetIndex() < m_slots.size()) ? m_slots[handle.GetIndex()].references : 0;
+		}
+
+		/**
+		 * Returns the time at which the resource was last used.
+		 *
+		 * @param handle Handle to the resource.
+		 * @return Time of last use, @see SetClock.
+		 */
+		std::uint64_t GetLastUsed(Handle handle) const
+		{
+			assert(handle.GetIndex() < m_slots.size());
+			return m_slots[handle.GetIndex()].lastUsed;
+		}
+
+		/**
+		 * Returns the bytes of main memory used by the resource.
+		 *
+		 * @param handle Handle to the resource.
+		 * @return Bytes of main memory, or zero if the resource is not loaded.
+		 */
+		std::size_t GetCPUBytes(Handle handle) const
+		{
+			assert(handle.GetIndex() < m_slots.size());
+			return m_slots[handle.GetIndex()].cpuBytes;
+		}
+
+		/**
+		 * Returns the bytes of graphics memory used by the resource.
+		 *
+		 * @param handle Handle to the resource.
+		 * @return Bytes of graphics memory, or zero if the resource is not
+		 * loaded.
+		 */
+		std::size_t GetGPUBytes(Handle handle) const
+		{
+			assert(handle.GetIndex() < m_slots.size());
+			return m_slots[handle.GetIndex()].gpuBytes;
+		}
+
+		/**
+		 * Sets the current time, which is recorded against resources as they
+		 * are used.
+		 *
+		 * @param clock Current time. This may be any monotonic counter, such
+		 * as a frame number.
+		 */
+		void SetClock(std::uint64_t clock)
+		{
+			m_clock = clock;
+		}
+
+		/**
+		 * Returns the memory used by the loaded resources in the table.
+		 *
+		 * @return Resource usage.
+		 */
+		ResourceUsage GetUsage() const
+		{
+			ResourceUsage usage;
+			for (const Slot& slot : m_slots)
+			{
+				if (slot.resource)
+				{
+					++usage.residentCount;
+					usage.referencedCount += (slot.references > 0) ? 1 : 0;
+					usage.cpuBytes += slot.cpuBytes;
+					usage.gpuBytes += slot.gpuBytes;
+				}
+			}
+
+			return usage;
+		}
+
+		/**
+		 * Returns true if the resource has been requested, whether or not it
+		 * has finished loading.
+		 *
+		 * @param handle Handle to the resource.
+		 * @return True if the resource has been requested.
+		 */
+		bool IsRequested(Handle handle) const
+		{
+			return handle.GetIndex() < m_slots.size() && m_slots[handle.GetIndex()].requested;
+		}
+
+		/**
+		 * Sets whether the resource has been requested.
+		 *
+		 * @param handle Handle to the resource.
+		 * @param requested Has the resource been requested?
+		 */
+		void SetRequested(Handle handle, bool requested)
+		{
+			assert(handle.GetIndex() < m_slots.size());
+			Slot& slot = m_slots[handle.GetIndex()];
+			slot.requested = requested;
+			slot.evicted = slot.evicted && !requested;
+		}
+
+		/**
+		 * Returns the number of interned resources.
+		 *
+		 * @return Number of slots in the table.
+		 */
+		unsigned int GetCount() const
+		{
+			return m_slots.size();
+		}
+
+	private:
+		/**
+		 * Slot for a single resource.
+		 */
+		struct Slot
+		{
+			Slot()
+			: name()
+			, resource()
+			, requested(false)
+			, evicted(false)
+			, references(0)
+			, cpuBytes(0)
+			, gpuBytes(0)
+			, lastUsed(0)
+			{
+				// Nothing to do.
+			}
+
+			/**
+			 * Unique name for the resource.
+			 */
+			std::string name;
+
+			/**
+			 * The resource, or a nullptr if it has not been loaded.
+			 */
+			std::shared_ptr<ResourceType> resource;
+
+			/**
+			 * Whether the resource has been requested.
+			 */
+			bool requested;
+
+			/**
+			 * Whether the resource was evicted and has not been requested
+			 * since.
+			 */
+			bool evicted;
+
+			/**
+			 * Number of references to the resource.
+			 */
+			unsigned int references;
+
+			/**
+			 * Bytes of main memory used by the resource.
+			 */
+			std::size_t cpuBytes;
+
+			/**
+			 * Bytes of graphics memory used by the resource.
+			 */
+			std::size_t gpuBytes;
+
+			/**
+			 * Time at which the resource was last used. Updated by lookups,
+			 * which are otherwise const.
+			 */
+			mutable std::uint64_t lastUsed;
+		};
+
+		/**
+		 * Resource slots, indexed by handle.
+		 */
+		std::vector<Slot> m_slots;
+
+		/**
+		 * Slot index for each resource name.
+		 */
+		std::unordered_map<std::string, typename Handle::Index> m_indices;
+
+		/**
+		 * Current time.
+		 */
+		std::uint64_t m_clock;
+	};
+}
+
+#endif
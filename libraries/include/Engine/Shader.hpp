@@ -43,6 +43,27 @@ namespace Engine
 		 */
 		bool LoadFromFile(std::string filename);
 
+		/**
+		 * Reads the shader source code from the specified file. No OpenGL
+		 * calls are made, so this may be called from any thread.
+		 *
+		 * @param filename Path to the shader source code file.
+		 * @param source Receives the shader source code.
+		 * @return True if the source code was read successfully.
+		 */
+		static bool ReadSourceFile(const std::string& filename, std::string& source);
+
+		/**
+		 * Initializes the shader from the supplied source code and attempts
+		 * to compile it.
+		 *
+		 * @param source Shader source code.
+		 * @param filename Path to the file that the source code was read
+		 * from (used for error messages).
+		 * @return True if the shader was compiled successfully.
+		 */
+		bool Compile(std::string source, const std::string& filename);
+
 		/**
 		 * Returns the type of the shader.
 		 *
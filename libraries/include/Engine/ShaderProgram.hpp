@@ -1,18 +1,65 @@
 #ifndef SHADERPROGRAM_H
 #define	SHADERPROGRAM_H
 
+#include <string>
 #include <unordered_map>
+#include <vector>
+#include <atomic>
+#include <cstdint>
 
 #include <glm/glm.hpp>
 
 #include <Engine/NonCopyable.hpp>
 #include <Engine/Shader.hpp>
+#include <Engine/UniformHandle.hpp>
 
 namespace Engine
 {
 	class ShaderProgram : private NonCopyable
 	{
 	public:
+		/**
+		 * Attribute location of the per-instance model matrix, i_modelMatrix,
+		 * which takes four locations.
+		 */
+		static const GLuint InstanceModelMatrixLocation = 5;
+
+		/**
+		 * Attribute location of the per-instance normal matrix,
+		 * i_normalMatrix, which takes three locations.
+		 */
+		static const GLuint InstanceNormalMatrixLocation = 9;
+
+		/**
+		 * Largest number of per-instance floating point values that a shader
+		 * program may read.
+		 */
+		static const unsigned int MaxInstanceValues = 4;
+
+		/**
+		 * Uniform buffer binding point of the FrameUniforms block, which
+		 * holds the values that are the same for every object in a frame.
+		 */
+		static const GLuint FrameUniformBlockBinding = 0;
+
+		/**
+		 * Per-instance floating point value read by an instanced shader
+		 * program. A float vertex attribute named i_timeLeftFraction, for example,
+		 * takes the place of the uniform timeLeftFraction.
+		 */
+		struct InstanceValue
+		{
+			/**
+			 * Name of the uniform that the value replaces.
+			 */
+			std::string name;
+
+			/**
+			 * Attribute location of the value.
+			 */
+			GLint location;
+		};
+
 		/**
 		 * Constructor.
 		 */
@@ -43,57 +90,98 @@ namespace Engine
 		void Use() const;
 
 		/**
-		 * Sets the uniform specified by the provided name with the 4x4 matrix
-		 * of floating point values.
+		 * Returns a handle to the uniform with the provided name. Locations
+		 * are cached by the name's hash, so each is usually only queried from
+		 * OpenGL once. Callers that set a uniform often should keep the handle
+		 * rather than resolve it again.
 		 *
-		 * @param name Name for the uniform to set.
+		 * @param name Name of the uniform.
+		 * @return Handle to the uniform, which is invalid if the program
+		 * does not use it.
+		 */
+		UniformHandle GetUniformHandle(const UniformName& name);
+
+		/**
+		 * Sets the uniform specified by the provided handle with the 4x4
+		 * matrix of floating point values.
+		 *
+		 * @param uniform Handle to the uniform to set.
 		 * @param matrix Matrix value to assign to the uniform.
 		 */
-		void SetUniformMatrix4fv(std::string name, const glm::mat4& matrix);
+		void SetUniformMatrix4fv(UniformHandle uniform, const glm::mat4& matrix);
 
 		/**
-		 * Sets the uniform specified by the provided name with the 3x3 matrix
-		 * of floating point values.
+		 * Sets the uniform array specified by the provided handle with 4x4
+		 * matrices of floating point values, starting at the first element.
 		 *
-		 * @param name Name for the uniform to set.
+		 * @param uniform Handle to the uniform array to set.
+		 * @param matrices Pointer to the matrices to assign to the uniform.
+		 * @param count Number of matrices.
+		 */
+		void SetUniformMatrix4fv(UniformHandle uniform, const glm::mat4* matrices, unsigned int count);
+
+		/**
+		 * Sets the uniform specified by the provided handle with the 3x3
+		 * matrix of floating point values.
+		 *
+		 * @param uniform Handle to the uniform to set.
 		 * @param matrix Matrix value to assign to the uniform.
 		 */
-		void SetUniformMatrix3fv(std::string name, const glm::mat3& matrix);
+		void SetUniformMatrix3fv(UniformHandle uniform, const glm::mat3& matrix);
 
 		/**
-		 * Sets the uniform specified by the provided name with the 3-dimensional
-		 * vector of floating point values.
+		 * Sets the uniform specified by the provided handle with the
+		 * 3-dimensional vector of floating point values.
 		 *
-		 * @param name Name for the uniform to set.
-		 * @param matrix Vector value to assign to the uniform.
+		 * @param uniform Handle to the uniform to set.
+		 * @param vector Vector value to assign to the uniform.
 		 */
-		void SetUniform3fv(std::string name, const glm::vec3& vector);
+		void SetUniform3fv(UniformHandle uniform, const glm::vec3& vector);
 
 		/**
-		 * Sets the uniform specified by the provided name with the floating
-		 * point value.
+		 * Sets the uniform specified by the provided handle with the
+		 * floating point value.
 		 *
-		 * @param name Name for the uniform to set.
-		 * @param matrix Floating point value to assign to the uniform.
+		 * @param uniform Handle to the uniform to set.
+		 * @param value Floating point value to assign to the uniform.
 		 */
-		void SetUniform1f(std::string name, float value);
+		void SetUniform1f(UniformHandle uniform, float value);
 
 		/**
-		 * Sets the uniform specified by the provided name with the integer
+		 * Sets the uniform specified by the provided handle with the integer
 		 * value.
 		 *
-		 * @param name Name for the uniform to set.
-		 * @param matrix Integer value to assign to the uniform.
+		 * @param uniform Handle to the uniform to set.
+		 * @param value Integer value to assign to the uniform.
+		 */
+		void SetUniform1i(UniformHandle uniform, int value);
+
+		/**
+		 * Checks whether the program reads its model and normal matrices
+		 * from per-instance vertex attributes, rather than uniforms, so that
+		 * many instances can be drawn with one draw call.
+		 *
+		 * @return True if the program is instanced.
 		 */
-		void SetUniform1i(std::string name, int value);
+		bool IsInstanced() const;
 
 		/**
-		 * Returns the location of the uniform specified by the provided name.
+		 * Returns the per-instance floating point values that the program
+		 * reads, in the order that they are stored in each instance.
 		 *
-		 * @param name Name for the uniform.
-		 * @return Uniform location.
+		 * @return Per-instance values.
 		 */
-		GLint GetUniformLocation(std::string name);
+		const std::vector<InstanceValue>& GetInstanceValues() const;
+
+		/**
+		 * Returns a serial number that is unique to each successful link of
+		 * any shader program. Values resolved for a program, such as uniform
+		 * handles, stay valid for as long as its link serial is unchanged,
+		 * even if a reloaded program reuses the same memory.
+		 *
+		 * @return Link serial, or zero if the program has not been linked.
+		 */
+		std::uint64_t GetLinkSerial() const;
 
 		/**
 		 * Returns the OpenGL identifier for the shader program.
@@ -108,10 +196,31 @@ namespace Engine
 		 */
 		GLuint m_id;
 
+		/**
+		 * Serial number of the program's last successful link.
+		 */
+		std::uint64_t m_linkSerial;
+
 		/**
 		 * Cache for uniform locations.
 		 */
-		std::unordered_map<std::string, GLint> m_uniformLocationCache;
+		UniformLocationCache m_uniformLocationCache;
+
+		/**
+		 * Whether the program is instanced.
+		 */
+		bool m_instanced;
+
+		/**
+		 * Per-instance floating point values that the program reads.
+		 */
+		std::vector<InstanceValue> m_instanceValues;
+
+		/**
+		 * Serial number for the next successful link. Programs are linked
+		 * on the loading thread.
+		 */
+		static std::atomic<std::uint64_t> s_nextLinkSerial;
 	};
 }
 
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <vector>
+#include <cstddef>
 
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
@@ -44,6 +45,19 @@ namespace Engine
 		 */
 		void Create(unsigned int width, unsigned int height, unsigned char* pixelData);
 
+		/**
+		 * Initializes a texture of the specified dimensions, taking ownership
+		 * of the supplied pixels.
+		 *
+		 * @note Pixels should be supplied in the same form as for the
+		 * pixel data array above.
+		 *
+		 * @param width Width for the texture.
+		 * @param height Height for the texture.
+		 * @param pixels Pixels that compose the texture.
+		 */
+		void Create(unsigned int width, unsigned int height, std::vector<unsigned char>&& pixels);
+
 		/**
 		 * Pastes the contents of the source texture at the specified
 		 * offset coordinates.
@@ -62,6 +76,41 @@ namespace Engine
 		 */
 		bool LoadFromFile(std::string filepath);
 
+		/**
+		 * Decodes an image file into pixels suitable for @see Create. No
+		 * OpenGL calls are made, so this may be called from any thread.
+		 *
+		 * @param filepath Path to the image file.
+		 * @param width Receives the image width.
+		 * @param height Receives the image height.
+		 * @param pixels Receives the decoded pixels.
+		 * @return True if the image was decoded successfully.
+		 */
+		static bool DecodeFile(const std::string& filepath, unsigned int& width,
+			unsigned int& height, std::vector<unsigned char>& pixels);
+
+		/**
+		 * Decodes an image file that has already been read into memory. As
+		 * with @see DecodeFile, no OpenGL calls are made.
+		 *
+		 * @param data Pointer to the file contents.
+		 * @param size Size of the file contents (in bytes).
+		 * @param filepath Path to the image file, used in error messages.
+		 * @param width Receives the image width.
+		 * @param height Receives the image height.
+		 * @param pixels Receives the decoded pixels.
+		 * @return True if the image was decoded successfully.
+		 */
+		static bool DecodeMemory(const unsigned char* data, std::size_t size,
+			const std::string& filepath, unsigned int& width, unsigned int& height,
+			std::vector<unsigned char>& pixels);
+
+		/**
+		 * Immediately passes the texture to OpenGL, so that it is ready for
+		 * use in other contexts that share the current context's objects.
+		 */
+		void Upload();
+
 		/**
 		 * Returns the texture's width.
 		 *
@@ -83,6 +132,20 @@ namespace Engine
 		 */
 		glm::vec2 GetDimensions() const;
 
+		/**
+		 * Returns the bytes of main memory used by the texture's pixels.
+		 *
+		 * @return Bytes of main memory.
+		 */
+		std::size_t GetCPUMemoryUsage() const;
+
+		/**
+		 * Returns the bytes of graphics memory used by the texture object.
+		 *
+		 * @return Bytes of graphics memory.
+		 */
+		std::size_t GetGPUMemoryUsage() const;
+
 		/**
 		 * Sets whether the texture should be repeated (tiled).
 		 *
@@ -110,6 +173,24 @@ namespace Engine
 		 */
 		void Update();
 
+		/**
+		 * Takes the pixels decoded by STB_Image, which are freed.
+		 *
+		 * @param data Pointer to the decoded pixels, or a nullptr if
+		 * decoding failed.
+		 * @param imageWidth Decoded image width.
+		 * @param imageHeight Decoded image height.
+		 * @param channels Number of channels in the decoded image.
+		 * @param filepath Path to the image file, used in error messages.
+		 * @param width Receives the image width.
+		 * @param height Receives the image height.
+		 * @param pixels Receives the decoded pixels.
+		 * @return True if the image was decoded successfully.
+		 */
+		static bool TakeDecodedImage(unsigned char* data, int imageWidth, int imageHeight,
+			int channels, const std::string& filepath, unsigned int& width,
+			unsigned int& height, std::vector<unsigned char>& pixels);
+
 	private:
 		/**
 		 * True if the OpenGL texture object needs to be updated.
@@ -2,14 +2,19 @@
 #define	THREADEVENTRECEIVER_H
 
 #include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <thread>
 #include <memory>
-#include <queue>
-#include <deque>
+#include <functional>
 #include <typeindex>
 #include <map>
 #include <cassert>
+#include <utility>
 
 #include <Engine/NonCopyable.hpp>
+#include <Engine/BoundedMPSCQueue.hpp>
 #include <Engine/Event/IEvent.hpp>
 
 #ifndef CALLBACK
@@ -43,104 +48,22 @@ namespace Engine
 		};
 	}
 
-	/**
-	 * Thread-safe event queue.
-	 */
-	template <typename EventType>
-	class ThreadSafeEventQueue : private NonCopyable
-	{
-	public:
-		/**
-		 * Constructor.
-		 */
-		ThreadSafeEventQueue()
-		: m_queueMutex()
-		, m_queue()
-		{
-			// Nothing to do.
-		}
-
-		/**
-		 * Destructor.
-		 */
-		~ThreadSafeEventQueue()
-		{
-			// Nothing to do.
-		}
-
-		/**
-		 * Pushes the supplied event onto the queue.
-		 *
-		 * @param message Event to push onto the queue.
-		 */
-		void Push(std::shared_ptr<EventType> event)
-		{
-			std::lock_guard<std::mutex> lock(m_queueMutex);
-
-			// Wrap the posted event in a WrappedEvent
-			// and store a pointer to this WrappedMessage in the queue.
-			m_queue.push(event);
-		}
-
-		/**
-		 * Pops the top event off the queue and returns a shared
-		 * pointer to that event.
-		 *
-		 * @return Shared pointer to the popped message.
-		 */
-		std::shared_ptr<EventType> Pop()
-		{
-			std::unique_lock<std::mutex> lock(m_queueMutex);
-
-			if (!m_queue.empty())
-			{
-				// Pop and return a shared pointer to the top message
-				// on the queue.
-				std::shared_ptr<EventType> top = m_queue.front();
-				m_queue.pop();
-				return top;
-			}
-			else
-			{
-				// Can't pop from an empty queue.
-				assert(0);
-				return nullptr; // Stop the compiler from complaining.
-			}
-		}
-
-		/**
-		 * Returns true if the queue is empty.
-		 *
-		 * @return True if the queue is empty.
-		 */
-		bool Empty()
-		{
-			// Note: Mutex is unlocked in the destructor
-			// of the std::lock_guard.
-			std::lock_guard<std::mutex> lock(m_queueMutex);
-			return m_queue.empty();
-		}
-
-	private:
-		/**
-		 * Mutex to guard access to the internal queue
-		 * data structure.
-		 */
-		std::mutex m_queueMutex;
-
-		/**
-		 * The actual queue.
-		 * This stores pointers to BaseMessage instances.
-		 */
-		std::queue<std::shared_ptr<EventType>> m_queue;
-	};
-
 	/**
 	 * Thread-safe event dispatcher.
 	 *
-	 * Clients can enqueue events and subscribe to receive events of a specifed
-	 * type. The @see Update method notifies subscribers by processing events in
-	 * the order in which the events were enqueued.
+	 * Any thread can enqueue events. A single receiving thread subscribes to
+	 * receive events of a specifed type and calls the @see Update, @see
+	 * ProcessSingleEvent or @see Wait methods, which notify subscribers in the
+	 * order in which the events were enqueued. StopThreadEvents are delivered
+	 * ahead of all other queued events.
+	 *
+	 * Enqueued events are held in bounded lock-free queues, so producers never
+	 * block each other or the receiving thread. A producer only waits if the
+	 * queue is full, until the receiving thread has made room or has stopped
+	 * receiving events (see @see Stop).
+	 *
+	 * @note Subscribe and Unsubscribe must only be called from the receiving
+	 * thread, or before any events are enqueued.
 	 */
 	class ThreadEventReceiver : private NonCopyable
 	{
@@ -150,14 +73,29 @@ namespace Engine
 		 */
 		typedef unsigned int SubscriptionID;
 
+		/**
+		 * Default maximum number of events that can be queued at once.
+		 */
+		static const std::size_t DefaultCapacity = 1024;
+
 		/**
 		 * Constructor.
+		 *
+		 * @param capacity Maximum number of events that can be queued at once.
+		 * This must be a power of two.
 		 */
-		ThreadEventReceiver()
+		ThreadEventReceiver(std::size_t capacity = DefaultCapacity)
 		: m_nextSubscriptionId(1)
 		, m_receivers()
-		, m_eventOrder()
-		, m_eventOrderMutex()
+		, m_eventQueue(capacity)
+		, m_priorityEventQueue(PriorityCapacity)
+		, m_receiverWaiting(0)
+		, m_wakeupMutex()
+		, m_wakeupCondition()
+		, m_stopped(false)
+		, m_producersWaiting(0)
+		, m_spaceMutex()
+		, m_spaceCondition()
 		{
 			// Nothing to do.
 		}
@@ -202,98 +140,137 @@ namespace Engine
 
 		/**
 		 * Enqueues an event of the specified type to be broadcast to
-		 * subscribers.
+		 * subscribers. This may be called from any thread.
 		 *
 		 * @param args... Event constructor arguments.
+		 * @return True if the event was queued, false if the queue was full
+		 * and the receiving thread has stopped receiving events.
 		 */
 		template<typename EventType, typename... Arguments>
-		void Enqueue(const Arguments... args)
+		bool Enqueue(Arguments&&... args)
 		{
-			// Enqueue the event with the relevant specific receiver.
-			std::shared_ptr<SpecificThreadEventReceiver<EventType>> receiver =
-				GetSpecificReceiver<EventType>();
-			receiver->Enqueue(args...);
-
-			// Note: Mutex is unlocked in the destructor
-			// of the std::lock_guard.
-			std::lock_guard<std::mutex> lock(m_eventOrderMutex);
-
-			// Record the event in the order list.
-			std::type_index eventType = typeid(EventType);
-			if (eventType == typeid(Event::StopThreadEvent))
+			// Construct the event on the producing thread. The receiving
+			// thread resolves the subscribers for the event type, so that
+			// producers never touch the receivers map.
+			QueuedEvent queuedEvent;
+			queuedEvent.event = std::make_shared<EventType>(std::forward<Arguments>(args)...);
+			queuedEvent.publish = &ThreadEventReceiver::Publish<EventType>;
+
+			// StopThreadEvents jump the queue.
+			BoundedMPSCQueue<QueuedEvent>& queue =
+				(std::type_index(typeid(EventType)) == std::type_index(typeid(Event::StopThreadEvent))) ?
+				m_priorityEventQueue : m_eventQueue;
+
+			// Wait for the receiving thread to make room if the queue is full,
+			// unless it will never make room.
+			while (!queue.TryPush(std::move(queuedEvent)))
 			{
-				m_eventOrder.emplace_front(eventType);
+				if (m_stopped.load(std::memory_order_acquire))
+				{
+					return false;
+				}
+
+				// The timeout bounds the wait should the receiving thread make
+				// room just before we start waiting.
+				std::unique_lock<std::mutex> lock(m_spaceMutex);
+				m_producersWaiting.fetch_add(1, std::memory_order_acq_rel);
+				m_spaceCondition.wait_for(lock, SpaceWaitTimeout);
+				m_producersWaiting.fetch_sub(1, std::memory_order_acq_rel);
 			}
-			else
+
+			// Wake the receiving thread if it is waiting for events.
+			// Note: Both this thread and Wait perform a read-modify-write on
+			// the flag, so either we see that the receiver is waiting, or the
+			// receiver synchronises with us and sees our event.
+			if (m_receiverWaiting.fetch_add(0, std::memory_order_acq_rel) != 0)
 			{
-				m_eventOrder.emplace_back(eventType);
+				std::lock_guard<std::mutex> lock(m_wakeupMutex);
+				m_wakeupCondition.notify_one();
 			}
+
+			return true;
+		}
+
+		/**
+		 * Marks the receiving thread as no longer receiving events. Producers
+		 * that find the queue full then drop their events rather than wait
+		 * for room that will never be made. Call this when the receiving
+		 * thread stops processing events, such as during shutdown.
+		 *
+		 * @note This may be called from any thread.
+		 */
+		void Stop()
+		{
+			m_stopped.store(true, std::memory_order_release);
+
+			std::lock_guard<std::mutex> lock(m_spaceMutex);
+			m_spaceCondition.notify_all();
 		}
 
 		/**
 		 * Processes a single event by notifying subscribers that are subscribed
 		 * to receive the top event currently queued.
+		 *
+		 * @note This must only be called from the receiving thread.
+		 *
+		 * @return True if an event was processed.
 		 */
-		void ProcessSingleEvent()
+		bool ProcessSingleEvent()
 		{
-			if (!m_eventOrder.empty())
+			QueuedEvent queuedEvent;
+			if (m_priorityEventQueue.TryPop(queuedEvent) || m_eventQueue.TryPop(queuedEvent))
 			{
-				std::shared_ptr<ISpecificThreadEventReceiver> receiver = nullptr;
-
-				// Scope for mutex releasing.
+				// Wake producers that are waiting for room in the queue.
+				if (m_producersWaiting.load(std::memory_order_acquire) != 0)
 				{
-					// Note: Mutex is unlocked in the destructor
-					// of the std::lock_guard.
-					std::lock_guard<std::mutex> lock(m_eventOrderMutex);
-
-					// Get the type of the next event to process from the event
-					// order list.
-					const std::type_index eventType = m_eventOrder.front();
-					m_eventOrder.pop_front();
-
-					// Process the first event in the specific listener for the
-					// event type matching the determined next event.
-					auto iter = m_receivers.find(eventType);
-					assert(iter != m_receivers.end());
-					receiver = iter->second;
+					std::lock_guard<std::mutex> lock(m_spaceMutex);
+					m_spaceCondition.notify_all();
 				}
 
-				// Process the event.
-				if (receiver) receiver->ProcessSingleEvent();
+				queuedEvent.publish(*this, queuedEvent.event.get());
+				return true;
 			}
+
+			return false;
 		}
 
 		/**
 		 * Notifies subscribers that are subscribed to receive events currently
 		 * queued.
+		 *
+		 * @note This must only be called from the receiving thread.
 		 */
 		void Update()
 		{
-			while (!m_eventOrder.empty())
+			while (ProcessSingleEvent())
 			{
-				std::shared_ptr<ISpecificThreadEventReceiver> receiver = nullptr;
+				// Keep going until the queues are drained.
+			}
+		}
 
-				// Scope for mutex releasing.
-				{
-					// Note: Mutex is unlocked in the destructor
-					// of the std::lock_guard.
-					std::lock_guard<std::mutex> lock(m_eventOrderMutex);
-
-					// Get the type of the next event to process from the event
-					// order list.
-					const std::type_index eventType = m_eventOrder.front();
-					m_eventOrder.pop_front();
-
-					// Process the first event in the specific listener for the
-					// event type matching the determined next event.
-					auto iter = m_receivers.find(eventType);
-					assert(iter != m_receivers.end());
-					receiver = iter->second;
-				}
+		/**
+		 * Blocks the receiving thread until at least one event is queued.
+		 *
+		 * @note This must only be called from the receiving thread.
+		 */
+		void Wait()
+		{
+			std::unique_lock<std::mutex> lock(m_wakeupMutex);
+			m_receiverWaiting.exchange(1, std::memory_order_acq_rel);
+			m_wakeupCondition.wait(lock, [this]() { return HasQueuedEvents(); });
+			m_receiverWaiting.store(0, std::memory_order_relaxed);
+		}
 
-				// Process the event.
-				if (receiver) receiver->ProcessSingleEvent();
-			}
+		/**
+		 * Returns true if there are events waiting to be processed.
+		 *
+		 * @note This must only be called from the receiving thread.
+		 *
+		 * @return True if events are queued.
+		 */
+		bool HasQueuedEvents() const
+		{
+			return !m_priorityEventQueue.Empty() || !m_eventQueue.Empty();
 		}
 
 	protected:
@@ -307,11 +284,6 @@ namespace Engine
 			 * Destructor.
 			 */
 			virtual ~ISpecificThreadEventReceiver();
-
-			/**
-			 * Processes a single event by notifying subscribers of the event.
-			 */
-			virtual void ProcessSingleEvent() = 0;
 		};
 
 		/**
@@ -330,8 +302,7 @@ namespace Engine
 			 * Constructor.
 			 */
 			SpecificThreadEventReceiver()
-			: m_eventQueue()
-			, m_subscribers()
+			: m_subscribers()
 			{
 				// Nothing to do.
 			}
@@ -374,42 +345,20 @@ namespace Engine
 			}
 
 			/**
-			 * Queues an event to be broadcast to subscribers.
+			 * Notifies subscribers of the event.
 			 *
-			 * @param args... Event constructor arguments.
+			 * @param event Reference to the event.
 			 */
-			template<typename... Arguments>
-			void Enqueue(const Arguments... args)
+			void Publish(const EventType& event)
 			{
-				m_eventQueue.Push(std::make_shared<EventType>(args...));
-			}
-
-			/**
-			 * Notifies subscribers that are subscribed to receive
-			 * the top event queued.
-			 */
-			virtual void ProcessSingleEvent()
-			{
-				if (!m_eventQueue.Empty())
+				for (auto iter = m_subscribers.begin(); iter != m_subscribers.end(); ++iter)
 				{
-					// Pop and return the top event on the queue.
-					std::shared_ptr<EventType> event = m_eventQueue.Pop();
-
-					// Publish the event to all subscribers.
-					for (auto iter = m_subscribers.begin(); iter != m_subscribers.end(); ++iter)
-					{
-						Callback callback = iter->second;
-						callback(*event);
-					}
+					const Callback& callback = iter->second;
+					callback(event);
 				}
 			}
 
 		private:
-			/**
-			 * The thread safe event queue for the receiver.
-			 */
-			ThreadSafeEventQueue<EventType> m_eventQueue;
-
 			/**
 			 * Subscriber callback functions.
 			 */
@@ -445,6 +394,54 @@ namespace Engine
 			}
 		}
 
+	private:
+		/**
+		 * Maximum number of StopThreadEvents that can be queued at once.
+		 */
+		static const std::size_t PriorityCapacity = 8;
+
+		/**
+		 * Longest time that a producer waits for room in a full queue before
+		 * trying again.
+		 */
+		static const std::chrono::milliseconds SpaceWaitTimeout;
+
+		/**
+		 * Event waiting in the queue, together with the function that
+		 * publishes it to the subscribers for its type.
+		 */
+		struct QueuedEvent
+		{
+			QueuedEvent()
+			: event()
+			, publish(nullptr)
+			{
+				// Nothing to do.
+			}
+
+			/**
+			 * The event.
+			 */
+			std::shared_ptr<void> event;
+
+			/**
+			 * Publishes the event to subscribers.
+			 */
+			void (*publish)(ThreadEventReceiver&, const void*);
+		};
+
+		/**
+		 * Publishes a type-erased event to the subscribers for its type.
+		 *
+		 * @param receiver The receiver to publish the event on.
+		 * @param event Pointer to the event.
+		 */
+		template <typename EventType>
+		static void Publish(ThreadEventReceiver& receiver, const void* event)
+		{
+			receiver.GetSpecificReceiver<EventType>()->Publish(*static_cast<const EventType*>(event));
+		}
+
 	private:
 		/**
 		 * Next subscription identifier to use.
@@ -457,14 +454,51 @@ namespace Engine
 		std::map<std::type_index, std::shared_ptr<ISpecificThreadEventReceiver>> m_receivers;
 
 		/**
-		 * Stores the order in which the events were enqueued.
+		 * Events in the order in which they were enqueued.
+		 */
+		BoundedMPSCQueue<QueuedEvent> m_eventQueue;
+
+		/**
+		 * StopThreadEvents, which are processed before all other events.
+		 */
+		BoundedMPSCQueue<QueuedEvent> m_priorityEventQueue;
+
+		/**
+		 * Non-zero while the receiving thread is blocked in Wait.
+		 */
+		std::atomic<unsigned int> m_receiverWaiting;
+
+		/**
+		 * Mutex used only to put the receiving thread to sleep and wake it.
+		 */
+		std::mutex m_wakeupMutex;
+
+		/**
+		 * Signalled when an event is enqueued while the receiving thread is
+		 * waiting.
+		 */
+		std::condition_variable m_wakeupCondition;
+
+		/**
+		 * Set once the receiving thread has stopped receiving events.
+		 */
+		std::atomic<bool> m_stopped;
+
+		/**
+		 * Number of producers waiting for room in a full queue.
+		 */
+		std::atomic<unsigned int> m_producersWaiting;
+
+		/**
+		 * Mutex used only to put producers to sleep while a queue is full.
 		 */
-		std::deque<std::type_index> m_eventOrder;
+		std::mutex m_spaceMutex;
 
 		/**
-		 * Mutex to guard access to event order data structure.
+		 * Signalled when the receiving thread makes room in a queue, or stops
+		 * receiving events.
 		 */
-		std::mutex m_eventOrderMutex;
+		std::condition_variable m_spaceCondition;
 	};
 }
 
@@ -0,0 +1,238 @@
+#ifndef UNIFORMHANDLE_H
+#define	UNIFORMHANDLE_H
+
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+
+#include <GL/glew.h>
+
+namespace Engine
+{
+	/**
+	 * Computes the 32-bit FNV-1a hash of a uniform name. This is constexpr,
+	 * so the names of the engine's built-in uniforms are hashed at compile
+	 * time.
+	 *
+	 * @param name Null terminated uniform name.
+	 * @param hash Hash of the characters before the name.
+	 * @return Hash of the name.
+	 */
+	constexpr std::uint32_t HashUniformName(const char* name, std::uint32_t hash = 2166136261u)
+	{
+		return (*name == '\0') ? hash
+			: HashUniformName(name + 1, (hash ^ static_cast<std::uint8_t>(*name)) * 16777619u);
+	}
+
+	/**
+	 * Name of a uniform together with its hash, which shader programs use to
+	 * look up the uniform's location without comparing strings.
+	 */
+	class UniformName
+	{
+	public:
+		/**
+		 * Constructor.
+		 *
+		 * @param name Null terminated uniform name, which must outlive the
+		 * uniform name object.
+		 */
+		constexpr UniformName(const char* name)
+		: m_name(name)
+		, m_hash(HashUniformName(name))
+		{
+			// Nothing to do.
+		}
+
+		/**
+		 * Returns the uniform name.
+		 *
+		 * @return Null terminated uniform name.
+		 */
+		constexpr const char* GetName() const
+		{
+			return m_name;
+		}
+
+		/**
+		 * Returns the hash of the uniform name.
+		 *
+		 * @return Hash of the name.
+		 */
+		constexpr std::uint32_t GetHash() const
+		{
+			return m_hash;
+		}
+
+	private:
+		/**
+		 * Uniform name.
+		 */
+		const char* m_name;
+
+		/**
+		 * Hash of the uniform name.
+		 */
+		std::uint32_t m_hash;
+	};
+
+	/**
+	 * Location of a uniform in a shader program, resolved once so that the
+	 * uniform can then be set without looking it up.
+	 */
+	class UniformHandle
+	{
+	public:
+		/**
+		 * Constructor for a handle to no uniform.
+		 */
+		UniformHandle()
+		: m_location(-1)
+		{
+			// Nothing to do.
+		}
+
+		/**
+		 * Constructor.
+		 *
+		 * @param location Uniform location, or -1 if the shader program
+		 * does not use the uniform.
+		 */
+		explicit UniformHandle(GLint location)
+		: m_location(location)
+		{
+			// Nothing to do.
+		}
+
+		/**
+		 * Checks whether the shader program uses the uniform. Setting a
+		 * uniform through an invalid handle does nothing.
+		 *
+		 * @return True if the handle refers to a uniform.
+		 */
+		bool IsValid() const
+		{
+			return m_location >= 0;
+		}
+
+		/**
+		 * Returns the uniform location.
+		 *
+		 * @return Uniform location, or -1 for no uniform.
+		 */
+		GLint GetLocation() const
+		{
+			return m_location;
+		}
+
+	private:
+		/**
+		 * Uniform location.
+		 */
+		GLint m_location;
+	};
+
+	/**
+	 * Cache of uniform locations, keyed by the hashes of the uniforms' names.
+	 * Each entry keeps its name, so that a name whose hash collides with a
+	 * cached one is never given the other uniform's location.
+	 */
+	class UniformLocationCache
+	{
+	public:
+		/**
+		 * Constructor.
+		 */
+		UniformLocationCache()
+		: m_entries()
+		{
+			// Nothing to do.
+		}
+
+		/**
+		 * Looks up the cached location of a uniform.
+		 *
+		 * @param name Name of the uniform.
+		 * @param location Set to the uniform location if it is cached.
+		 * @return True if the location of the uniform is cached.
+		 */
+		bool Find(const UniformName& name, GLint& location) const
+		{
+			auto iter = m_entries.find(name.GetHash());
+			if (iter != m_entries.end() && iter->second.name == name.GetName())
+			{
+				location = iter->second.location;
+				return true;
+			}
+
+			return false;
+		}
+
+		/**
+		 * Caches the location of a uniform. Only the first of several names
+		 * with the same hash is cached; the others must be looked up each
+		 * time.
+		 *
+		 * @param name Name of the uniform.
+		 * @param location Uniform location, or -1 for no uniform.
+		 */
+		void Insert(const UniformName& name, GLint location)
+		{
+			Entry entry;
+			entry.name = name.GetName();
+			entry.location = location;
+			m_entries.emplace(name.GetHash(), entry);
+		}
+
+		/**
+		 * Removes every cached location.
+		 */
+		void Clear()
+		{
+			m_entries.clear();
+		}
+
+	private:
+		/**
+		 * Cached location of a uniform.
+		 */
+		struct Entry
+		{
+			/**
+			 * Name of the uniform.
+			 */
+			std::string name;
+
+			/**
+			 * Uniform location.
+			 */
+			GLint location;
+		};
+
+		/**
+		 * Cached locations, keyed by the hashes of their names.
+		 */
+		std::unordered_map<std::uint32_t, Entry> m_entries;
+	};
+
+	/**
+	 * Names of the uniforms that the engine sets.
+	 */
+	namespace BuiltinUniforms
+	{
+		constexpr UniformName ModelMatrix("modelMatrix");
+		constexpr UniformName NormalMatrix("normalMatrix");
+		constexpr UniformName NodeTransformations("nodeTransformations");
+		constexpr UniformName MaterialDiffuseColor("material.diffuseColor");
+		constexpr UniformName MaterialSpecularColor("material.specularColor");
+		constexpr UniformName MaterialAmbientColor("material.ambientColor");
+		constexpr UniformName MaterialEmissiveColor("material.emissiveColor");
+		constexpr UniformName MaterialShininess("material.shininess");
+		constexpr UniformName UseTexture("useTexture");
+		constexpr UniformName DiffuseTextureUnit("diffuseTextureUnit");
+		constexpr UniformName ModelViewProjectionMatrix("modelViewProjectionMatrix");
+		constexpr UniformName TextureUnit("textureUnit");
+	}
+}
+
+#endif
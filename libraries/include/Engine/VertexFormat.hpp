@@ -0,0 +1,123 @@
+#ifndef VERTEXFORMAT_H
+#define	VERTEXFORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+namespace Engine
+{
+	/**
+	 * Layouts of the interleaved vertices that model meshes are uploaded in.
+	 *
+	 * Positions are kept as 32-bit floats. Normals are octahedral encoded
+	 * into two 16-bit signed normalized integers and decoded by the vertex
+	 * shader. Texture coordinates are stored as half floats when they are
+	 * small enough to keep sub-texel precision, and as floats otherwise (e.g.
+	 * for textures tiled across a map). Each vertex also holds the index of
+	 * its node in the model's node palette, so that all of the meshes that
+	 * share a material can be drawn together.
+	 */
+	namespace VertexFormat
+	{
+		/**
+		 * Vertex with half float texture coordinates.
+		 */
+		struct Compact
+		{
+			float position[3];
+			std::int16_t normal[2];
+			std::uint16_t textureCoordinates[2];
+			std::uint16_t node;
+			std::uint16_t padding;
+		};
+
+		/**
+		 * Vertex with float texture coordinates.
+		 */
+		struct Wide
+		{
+			float position[3];
+			std::int16_t normal[2];
+			float textureCoordinates[2];
+			std::uint16_t node;
+			std::uint16_t padding;
+		};
+
+		/**
+		 * Identifies one of the vertex layouts.
+		 */
+		enum class Layout
+		{
+			Compact,
+			Wide
+		};
+
+		static_assert(sizeof(Compact) == 24, "Compact vertices must be tightly packed");
+		static_assert(sizeof(Wide) == 28, "Wide vertices must be tightly packed");
+
+		/**
+		 * Largest magnitude of texture coordinate that is stored as a half
+		 * float. Half floats have a precision of 1/1024 between 1 and 2,
+		 * which is under a texel for textures up to 1024 pixels across.
+		 */
+		const float MaxCompactTextureCoordinate = 2.0f;
+
+		/**
+		 * Returns the size of a vertex in the specified layout.
+		 *
+		 * @param layout Vertex layout.
+		 * @return Size of a vertex (in bytes).
+		 */
+		std::size_t GetVertexSize(Layout layout);
+
+		/**
+		 * Returns true if every texture coordinate can be stored as a half
+		 * float.
+		 *
+		 * @param textureCoordinates Texture coordinates (only x and y are
+		 * used).
+		 * @param count Number of texture coordinates.
+		 * @return True if the compact layout can be used.
+		 */
+		bool FitsCompact(const glm::vec3* textureCoordinates, unsigned int count);
+
+		/**
+		 * Octahedral encodes a unit vector into two 16-bit signed normalized
+		 * integers.
+		 *
+		 * @param normal Unit vector.
+		 * @param encoded Receives the encoded vector.
+		 */
+		void EncodeNormal(const glm::vec3& normal, std::int16_t encoded[2]);
+
+		/**
+		 * Decodes a unit vector encoded by EncodeNormal(). This mirrors the
+		 * decoding done by the vertex shader.
+		 *
+		 * @param encoded Encoded vector.
+		 * @return Unit vector.
+		 */
+		glm::vec3 DecodeNormal(const std::int16_t encoded[2]);
+
+		/**
+		 * Converts a float to a half float, rounding to the nearest
+		 * representable value.
+		 *
+		 * @param value Float.
+		 * @return Bits of the half float.
+		 */
+		std::uint16_t EncodeHalf(float value);
+
+		/**
+		 * Converts a half float to a float.
+		 *
+		 * @param value Bits of the half float.
+		 * @return Float.
+		 */
+		float DecodeHalf(std::uint16_t value);
+	}
+}
+
+#endif
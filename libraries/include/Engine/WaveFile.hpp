@@ -3,6 +3,8 @@
 
 #include <string>
 #include <vector>
+#include <istream>
+#include <cstddef>
 
 #include <Engine/IAudioSource.hpp>
 
@@ -69,6 +71,27 @@ namespace Engine
 		 */
 		bool LoadFromFile(std::string filepath);
 
+		/**
+		 * Loads the audio source from a file that has already been read into
+		 * memory.
+		 *
+		 * @param data Pointer to the file contents.
+		 * @param size Size of the file contents (in bytes).
+		 * @param filepath Path to the audio file, used in error messages.
+		 * @return True if the audio source was loaded successfully.
+		 */
+		bool LoadFromMemory(const unsigned char* data, std::size_t size, std::string filepath);
+
+	private:
+		/**
+		 * Reads the audio source from the specified stream.
+		 *
+		 * @param file Stream positioned at the start of the file.
+		 * @param filepath Path to the audio file, used in error messages.
+		 * @return True if the audio source was loaded successfully.
+		 */
+		bool Load(std::istream& file, const std::string& filepath);
+
 	private:
 		/**
 		 * Number of channels used.
@@ -0,0 +1,147 @@
+#ifndef WORKERPOOL_H
+#define	WORKERPOOL_H
+
+#include <functional>
+#include <queue>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include <Engine/NonCopyable.hpp>
+
+namespace Engine
+{
+	/**
+	 * Fixed-size pool of worker threads that execute submitted tasks.
+	 *
+	 * Tasks with a higher priority are started before tasks with a lower
+	 * priority. Tasks with equal priorities are started in the order in which
+	 * they were submitted.
+	 *
+	 * @note Tasks must not touch OpenGL state. Workers do not own a context.
+	 */
+	class WorkerPool : private NonCopyable
+	{
+	public:
+		/**
+		 * Task type definition.
+		 */
+		typedef std::function<void()> Task;
+
+		/**
+		 * Constructor.
+		 *
+		 * @param threadCount Number of worker threads to start. Must be
+		 * greater than zero.
+		 */
+		explicit WorkerPool(unsigned int threadCount = GetDefaultThreadCount());
+
+		/**
+		 * Destructor.
+		 *
+		 * Tasks that have not yet started are discarded. Tasks that are being
+		 * executed are allowed to finish.
+		 */
+		~WorkerPool();
+
+		/**
+		 * Submits a task to be executed by one of the worker threads. This
+		 * may be called from any thread.
+		 *
+		 * @param priority Task priority. Higher priorities are started first.
+		 * @param task The task to execute.
+		 */
+		void Submit(unsigned int priority, Task task);
+
+		/**
+		 * Returns the number of worker threads.
+		 *
+		 * @return Number of worker threads.
+		 */
+		unsigned int GetThreadCount() const;
+
+		/**
+		 * Returns the number of worker threads that should be used on this
+		 * machine. One core is left for the game thread.
+		 *
+		 * @return Default number of worker threads.
+		 */
+		static unsigned int GetDefaultThreadCount();
+
+	private:
+		/**
+		 * Task waiting to be executed.
+		 */
+		struct PendingTask
+		{
+			/**
+			 * Task priority.
+			 */
+			unsigned int priority;
+
+			/**
+			 * Submission order, used to keep tasks of equal priority in
+			 * first-in first-out order.
+			 */
+			unsigned long long sequence;
+
+			/**
+			 * The task.
+			 */
+			Task task;
+
+			/**
+			 * Orders pending tasks so that the task to start next is at the
+			 * top of a std::priority_queue.
+			 */
+			bool operator<(const PendingTask& other) const
+			{
+				if (priority != other.priority)
+				{
+					return priority < other.priority;
+				}
+
+				return sequence > other.sequence;
+			}
+		};
+
+		/**
+		 * Worker thread entry point.
+		 */
+		void Run();
+
+	private:
+		/**
+		 * Tasks waiting to be executed.
+		 */
+		std::priority_queue<PendingTask> m_tasks;
+
+		/**
+		 * Sequence number for the next submitted task.
+		 */
+		unsigned long long m_nextSequence;
+
+		/**
+		 * Should the worker threads terminate?
+		 */
+		bool m_terminate;
+
+		/**
+		 * Protects the task queue and the terminate flag.
+		 */
+		std::mutex m_mutex;
+
+		/**
+		 * Signalled when a task is submitted or the pool is terminating.
+		 */
+		std::condition_variable m_condition;
+
+		/**
+		 * The worker threads.
+		 */
+		std::vector<std::thread> m_threads;
+	};
+}
+
+#endif
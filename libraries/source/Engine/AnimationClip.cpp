@@ -0,0 +1,248 @@
+#include <Engine/AnimationClip.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include <glm/gtx/transform.hpp>
+
+namespace Engine
+{
+	namespace
+	{
+		/**
+		 * Largest quantized translation or scale component.
+		 */
+		const float RangeScale = 65535.0f;
+
+		/**
+		 * Largest quantized rotation component.
+		 */
+		const float RotationScale = 32767.0f;
+
+		/**
+		 * Quantizes a vector over a range.
+		 *
+		 * @param value The vector.
+		 * @param origin Smallest value in the range.
+		 * @param extent Size of the range.
+		 * @param quantized Receives the quantized components.
+		 */
+		void QuantizeRange(const glm::vec3& value, const glm::vec3& origin,
+			const glm::vec3& extent, std::uint16_t quantized[3])
+		{
+			for (int i = 0; i < 3; ++i)
+			{
+				const float normalized = (extent[i] > 0.0f) ? (value[i] - origin[i]) / extent[i] : 0.0f;
+				quantized[i] = static_cast<std::uint16_t>(std::round(glm::clamp(normalized, 0.0f, 1.0f) * RangeScale));
+			}
+		}
+
+		/**
+		 * Restores a vector quantized over a range.
+		 *
+		 * @param quantized The quantized components.
+		 * @param origin Smallest value in the range.
+		 * @param extent Size of the range.
+		 * @return The vector.
+		 */
+		glm::vec3 DequantizeRange(const std::uint16_t quantized[3],
+			const glm::vec3& origin, const glm::vec3& extent)
+		{
+			return origin + extent * glm::vec3(quantized[0], quantized[1], quantized[2]) / RangeScale;
+		}
+	}
+
+	AnimationClip::AnimationClip(std::string name, double duration)
+	: m_name(name)
+	, m_duration(duration)
+	, m_tracks()
+	, m_keys()
+	{
+		// Nothing to do.
+	}
+
+	AnimationClip::~AnimationClip()
+	{
+		// Nothing to do.
+	}
+
+	const std::string& AnimationClip::GetName() const
+	{
+		return m_name;
+	}
+
+	double AnimationClip::GetDuration() const
+	{
+		return m_duration;
+	}
+
+	double AnimationClip::GetLastKeyTime() const
+	{
+		double lastKeyTime = 0.0;
+		for (auto iter = m_tracks.begin(); iter != m_tracks.end(); ++iter)
+		{
+			lastKeyTime = std::max(lastKeyTime, static_cast<double>(m_keys[iter->firstKey + iter->keyCount - 1].time));
+		}
+
+		return lastKeyTime;
+	}
+
+	const std::vector<AnimationClip::Track>& AnimationClip::GetTracks() const
+	{
+		return m_tracks;
+	}
+
+	const std::vector<AnimationClip::Key>& AnimationClip::GetKeys() const
+	{
+		return m_keys;
+	}
+
+	const AnimationClip::Track* AnimationClip::FindTrack(unsigned int node) const
+	{
+		for (auto iter = m_tracks.begin(); iter != m_tracks.end(); ++iter)
+		{
+			if (iter->node == node)
+			{
+				return &*iter;
+			}
+		}
+
+		return nullptr;
+	}
+
+	unsigned int AnimationClip::FindKey(const Track& track, double time) const
+	{
+		assert(track.keyCount > 0);
+
+		// Find the first keyframe after the time. The keyframe before it is
+		// the one we want.
+		const Key* first = &m_keys[track.firstKey];
+		const Key* last = first + track.keyCount;
+		const Key* next = std::upper_bound(first, last, time,
+			[](double t, const Key& key) { return t < key.time; });
+		return (next == first) ? 0 : static_cast<unsigned int>(next - first) - 1;
+	}
+
+	glm::mat4 AnimationClip::EvaluateTrack(const Track& track, double time) const
+	{
+		// Find the keyframe at or before the time.
+		const unsigned int k = FindKey(track, time);
+		const Key& key = m_keys[track.firstKey + k];
+		glm::vec3 translation = DecodeTranslation(track, key);
+		glm::quat rotation = DecodeRotation(key);
+		glm::vec3 scale = DecodeScale(track, key);
+
+		// Interpolate towards the next keyframe, unless the time is outside
+		// of the clip.
+		if (k + 1 < track.keyCount && time > key.time)
+		{
+			const Key& nextKey = m_keys[track.firstKey + k + 1];
+			const float factor = static_cast<float>((time - key.time) / (nextKey.time - key.time));
+
+			// Take the shortest path between the rotations.
+			glm::quat nextRotation = DecodeRotation(nextKey);
+			if (glm::dot(rotation, nextRotation) < 0.0f)
+			{
+				nextRotation = -nextRotation;
+			}
+
+			translation = glm::mix(translation, DecodeTranslation(track, nextKey), factor);
+			rotation = glm::slerp(rotation, nextRotation, factor);
+			scale = glm::mix(scale, DecodeScale(track, nextKey), factor);
+		}
+
+		return glm::translate(translation)
+			* glm::toMat4(rotation)
+			* glm::scale(scale);
+	}
+
+	void AnimationClip::AddTrack(unsigned int node, const std::vector<double>& times,
+		const std::vector<glm::vec3>& translations,
+		const std::vector<glm::quat>& rotations,
+		const std::vector<glm::vec3>& scales)
+	{
+		assert(!times.empty());
+		assert(translations.size() == times.size());
+		assert(rotations.size() == times.size());
+		assert(scales.size() == times.size());
+
+		// Find the ranges to quantize the translations and scales over.
+		glm::vec3 translationMin = translations[0];
+		glm::vec3 translationMax = translations[0];
+		glm::vec3 scaleMin = scales[0];
+		glm::vec3 scaleMax = scales[0];
+		for (unsigned int k = 1; k < times.size(); ++k)
+		{
+			translationMin = glm::min(translationMin, translations[k]);
+			translationMax = glm::max(translationMax, translations[k]);
+			scaleMin = glm::min(scaleMin, scales[k]);
+			scaleMax = glm::max(scaleMax, scales[k]);
+		}
+
+		Track track;
+		track.node = node;
+		track.firstKey = m_keys.size();
+		track.keyCount = times.size();
+		track.translationOrigin = translationMin;
+		track.translationExtent = translationMax - translationMin;
+		track.scaleOrigin = scaleMin;
+		track.scaleExtent = scaleMax - scaleMin;
+
+		for (unsigned int k = 0; k < times.size(); ++k)
+		{
+			assert(k == 0 || times[k] > times[k - 1]);
+
+			Key key;
+			key.time = static_cast<float>(times[k]);
+			QuantizeRange(translations[k], track.translationOrigin, track.translationExtent, key.translation);
+			QuantizeRange(scales[k], track.scaleOrigin, track.scaleExtent, key.scale);
+
+			const glm::quat rotation = glm::normalize(rotations[k]);
+			key.rotation[0] = static_cast<std::int16_t>(std::round(rotation.x * RotationScale));
+			key.rotation[1] = static_cast<std::int16_t>(std::round(rotation.y * RotationScale));
+			key.rotation[2] = static_cast<std::int16_t>(std::round(rotation.z * RotationScale));
+			key.rotation[3] = static_cast<std::int16_t>(std::round(rotation.w * RotationScale));
+
+			m_keys.push_back(key);
+		}
+
+		m_tracks.push_back(track);
+	}
+
+	void AnimationClip::AddTrack(Track track, const Key* keys)
+	{
+		assert(track.keyCount > 0);
+
+		track.firstKey = m_keys.size();
+		m_keys.insert(m_keys.end(), keys, keys + track.keyCount);
+		m_tracks.push_back(track);
+	}
+
+	std::size_t AnimationClip::GetCPUMemoryUsage() const
+	{
+		return sizeof(AnimationClip) + m_name.capacity()
+			+ m_tracks.capacity() * sizeof(Track)
+			+ m_keys.capacity() * sizeof(Key);
+	}
+
+	glm::vec3 AnimationClip::DecodeTranslation(const Track& track, const Key& key)
+	{
+		return DequantizeRange(key.translation, track.translationOrigin, track.translationExtent);
+	}
+
+	glm::quat AnimationClip::DecodeRotation(const Key& key)
+	{
+		return glm::normalize(glm::quat(
+			key.rotation[3] / RotationScale,
+			key.rotation[0] / RotationScale,
+			key.rotation[1] / RotationScale,
+			key.rotation[2] / RotationScale
+		));
+	}
+
+	glm::vec3 AnimationClip::DecodeScale(const Track& track, const Key& key)
+	{
+		return DequantizeRange(key.scale, track.scaleOrigin, track.scaleExtent);
+	}
+}
@@ -47,6 +47,38 @@ namespace Engine
 			exit(1); // Critical failure!
 		}
 
+		// Meshes are drawn from shared geometry buffers, which needs base
+		// vertex draws (OpenGL 3.2 or ARB_draw_elements_base_vertex).
+		if (!GLEW_VERSION_3_2 && !GLEW_ARB_draw_elements_base_vertex)
+		{
+			std::cerr << "ERROR: OpenGL 3.2 or ARB_draw_elements_base_vertex is required" << std::endl;
+			exit(1); // Critical failure!
+		}
+
+		// Per-frame camera, time and light values are shared by every shader
+		// program through a uniform buffer (OpenGL 3.1 or
+		// ARB_uniform_buffer_object).
+		if (!GLEW_VERSION_3_1 && !GLEW_ARB_uniform_buffer_object)
+		{
+			std::cerr << "ERROR: OpenGL 3.1 or ARB_uniform_buffer_object is required" << std::endl;
+			exit(1); // Critical failure!
+		}
+
+		// Repeated models are drawn with hardware instancing, which needs
+		// instanced draws (OpenGL 3.1 or ARB_draw_instanced) and per-instance
+		// attributes (OpenGL 3.3 or ARB_instanced_arrays).
+		if (!GLEW_VERSION_3_1 && !GLEW_ARB_draw_instanced)
+		{
+			std::cerr << "ERROR: OpenGL 3.1 or ARB_draw_instanced is required" << std::endl;
+			exit(1); // Critical failure!
+		}
+
+		if (!GLEW_VERSION_3_3 && !GLEW_ARB_instanced_arrays)
+		{
+			std::cerr << "ERROR: OpenGL 3.3 or ARB_instanced_arrays is required" << std::endl;
+			exit(1); // Critical failure!
+		}
+
 		// Create the resource manager.
 		m_resourceManager = std::shared_ptr<ResourceManager>(new ResourceManager(loadingWindow));
 
@@ -12,16 +12,19 @@ namespace Engine
 				std::string filepath)
 		: IAttribute(window, resourceManager, sceneEventDispatcher, gameObjectEventDispatcher, gameObject)
 		, m_filepath(filepath)
+		, m_resource(resourceManager->GetModelHandle(filepath))
 		, m_visible(true)
+		, m_animationClip(0)
 		, m_currentAnimationTime(0)
 		, m_loop(false)
 		{
-			// Nothing to do.
+			// Keep the model loaded while the attribute exists.
+			resourceManager->AddReference(m_resource);
 		}
 
 		Model::~Model()
 		{
-			// Nothing to do.
+			GetResourceManager()->ReleaseReference(m_resource);
 		}
 
 		std::string Model::GetPath() const
@@ -29,6 +32,16 @@ namespace Engine
 			return m_filepath;
 		}
 
+		ResourceHandle<Engine::Model> Model::GetResourceHandle() const
+		{
+			return m_resource;
+		}
+
+		std::shared_ptr<Engine::Model> Model::GetResource() const
+		{
+			return GetResourceManager()->GetModel(m_resource);
+		}
+
 		bool Model::GetVisible() const
 		{
 			return m_visible;
@@ -39,6 +52,17 @@ namespace Engine
 			m_visible = visible;
 		}
 
+		unsigned int Model::GetAnimationClip() const
+		{
+			return m_animationClip;
+		}
+
+		void Model::SetAnimationClip(unsigned int clip)
+		{
+			m_animationClip = clip;
+			RestartAnimation();
+		}
+
 		double Model::GetCurrentAnimationTime() const
 		{
 			return m_currentAnimationTime;
@@ -63,8 +87,8 @@ namespace Engine
 
 		double Model::GetAnimationDuration() const
 		{
-			std::shared_ptr<Engine::Model> modelResource = GetResourceManager()->GetModel(m_filepath);
-			return modelResource->GetAnimationDuration();
+			std::shared_ptr<Engine::Model> modelResource = GetResource();
+			return modelResource ? modelResource->GetAnimationDuration(m_animationClip) : 0.0;
 		}
 
 		bool Model::GetLoopAnimation() const
@@ -1,5 +1,7 @@
 #include <Engine/Attribute/ShaderProgram.hpp>
 
+#include <algorithm>
+
 namespace Engine
 {
 	namespace Attribute
@@ -14,14 +16,19 @@ namespace Engine
 		: IAttribute(window, resourceManager, sceneEventDispatcher, gameObjectEventDispatcher, gameObject)
 		, m_vertexShaderFilepath(vertexShaderFilepath)
 		, m_fragmentShaderFilepath(fragmentShaderFilepath)
+		, m_resource(resourceManager->GetShaderProgramHandle(vertexShaderFilepath, fragmentShaderFilepath))
 		, m_floatUniforms()
+		, m_usedUniforms()
+		, m_instanceValues()
+		, m_resolvedLinkSerial(0)
 		{
-			// Nothing to do.
+			// Keep the shader program loaded while the attribute exists.
+			resourceManager->AddReference(m_resource);
 		}
 
 		ShaderProgram::~ShaderProgram()
 		{
-			// Nothing to do.
+			GetResourceManager()->ReleaseReference(m_resource);
 		}
 
 		std::string ShaderProgram::GetVertexShaderPath() const
@@ -34,9 +41,14 @@ namespace Engine
 			return m_fragmentShaderFilepath;
 		}
 
+		ResourceHandle<Engine::ShaderProgram> ShaderProgram::GetResourceHandle() const
+		{
+			return m_resource;
+		}
+
 		std::shared_ptr<Engine::ShaderProgram> ShaderProgram::GetResource() const
 		{
-			return GetResourceManager()->GetShaderProgram(m_vertexShaderFilepath, m_fragmentShaderFilepath);
+			return GetResourceManager()->GetShaderProgram(m_resource);
 		}
 
 		void ShaderProgram::ApplyUniforms()
@@ -44,17 +56,102 @@ namespace Engine
 			std::shared_ptr<Engine::ShaderProgram> shaderProgram = GetResource();
 			if (shaderProgram)
 			{
+				Resolve(*shaderProgram);
+
 				// Send floating point uniforms to the shader program.
-				for (auto iter = m_floatUniforms.begin(); iter != m_floatUniforms.end(); ++iter)
+				for (const FloatUniform* uniform : m_usedUniforms)
 				{
-					shaderProgram->SetUniform1f(iter->first, iter->second);
+					shaderProgram->SetUniform1f(uniform->handle, uniform->value);
 				}
 			}
 		}
 
 		void ShaderProgram::SetFloat(std::string name, float value)
 		{
-			m_floatUniforms[name] = value;
+			auto iter = m_floatUniforms.find(name);
+			if (iter != m_floatUniforms.end())
+			{
+				iter->second.value = value;
+			}
+			else
+			{
+				// Resolve the new uniform's handle with the others.
+				FloatUniform uniform;
+				uniform.value = value;
+				m_floatUniforms[name] = uniform;
+				m_resolvedLinkSerial = 0;
+			}
+		}
+
+		bool ShaderProgram::HasSameUniforms(ShaderProgram& other, Engine::ShaderProgram& shaderProgram)
+		{
+			Resolve(shaderProgram);
+			other.Resolve(shaderProgram);
+
+			if (m_usedUniforms.size() != other.m_usedUniforms.size())
+			{
+				return false;
+			}
+
+			// Both lists are in order of uniform location.
+			for (std::size_t u = 0; u < m_usedUniforms.size(); ++u)
+			{
+				if (m_usedUniforms[u]->handle.GetLocation() != other.m_usedUniforms[u]->handle.GetLocation()
+					|| m_usedUniforms[u]->value != other.m_usedUniforms[u]->value)
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		void ShaderProgram::GetInstanceValues(Engine::ShaderProgram& shaderProgram, float* values)
+		{
+			Resolve(shaderProgram);
+
+			for (unsigned int v = 0; v < Engine::ShaderProgram::MaxInstanceValues; ++v)
+			{
+				values[v] = m_instanceValues[v] ? *m_instanceValues[v] : 0.0f;
+			}
+		}
+
+		void ShaderProgram::Resolve(Engine::ShaderProgram& shaderProgram)
+		{
+			// Resolve the uniform handles and instance values once for each
+			// link of the shader program.
+			if (shaderProgram.GetLinkSerial() == m_resolvedLinkSerial)
+			{
+				return;
+			}
+
+			// Per-instance values are vertex attributes, so an instanced
+			// program has no uniforms by their names.
+			m_usedUniforms.clear();
+			for (auto iter = m_floatUniforms.begin(); iter != m_floatUniforms.end(); ++iter)
+			{
+				iter->second.handle = shaderProgram.GetUniformHandle(iter->first.c_str());
+				if (iter->second.handle.IsValid())
+				{
+					m_usedUniforms.push_back(&iter->second);
+				}
+			}
+
+			std::sort(m_usedUniforms.begin(), m_usedUniforms.end(),
+				[](const FloatUniform* one, const FloatUniform* two)
+				{
+					return one->handle.GetLocation() < two->handle.GetLocation();
+				}
+			);
+
+			const std::vector<Engine::ShaderProgram::InstanceValue>& instanceValues = shaderProgram.GetInstanceValues();
+			for (unsigned int v = 0; v < Engine::ShaderProgram::MaxInstanceValues; ++v)
+			{
+				auto iter = (v < instanceValues.size()) ? m_floatUniforms.find(instanceValues[v].name) : m_floatUniforms.end();
+				m_instanceValues[v] = (iter != m_floatUniforms.end()) ? &iter->second.value : nullptr;
+			}
+
+			m_resolvedLinkSerial = shaderProgram.GetLinkSerial();
 		}
 	}
 }
@@ -1,12 +1,14 @@
 #include <Engine/Event/ChildGameObjectAttachedEvent.hpp>
 
+#include <utility>
+
 namespace Engine
 {
 	namespace Event
 	{
 		ChildGameObjectAttachedEvent::ChildGameObjectAttachedEvent(std::shared_ptr<GameObject> child)
 		: IEvent()
-		, m_child(child)
+		, m_child(std::move(child))
 		{
 			// Nothing to do.
 		}
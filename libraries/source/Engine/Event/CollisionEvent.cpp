@@ -1,16 +1,18 @@
 #include <Engine/Event/CollisionEvent.hpp>
 
+#include <utility>
+
 namespace Engine
 {
 	namespace Event
 	{
 		CollisionEvent::CollisionEvent(std::shared_ptr<GameObject> otherGameObject,
-				const std::string otherBoundingGeometryTag,
-				const std::string thisBoundingGeometryTag)
+				std::string otherBoundingGeometryTag,
+				std::string thisBoundingGeometryTag)
 		: IEvent()
-		, m_otherGameObject(otherGameObject)
-		, m_otherBoundingGeometryTag(otherBoundingGeometryTag)
-		, m_thisBoundingGeometryTag(thisBoundingGeometryTag)
+		, m_otherGameObject(std::move(otherGameObject))
+		, m_otherBoundingGeometryTag(std::move(otherBoundingGeometryTag))
+		, m_thisBoundingGeometryTag(std::move(thisBoundingGeometryTag))
 		{
 			// Nothing to do.
 		}
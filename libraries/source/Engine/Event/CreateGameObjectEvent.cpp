@@ -1,18 +1,20 @@
 #include <Engine/Event/CreateGameObjectEvent.hpp>
 
+#include <utility>
+
 namespace Engine
 {
 	namespace Event
 	{
 		CreateGameObjectEvent::CreateGameObjectEvent(std::function<void(std::shared_ptr<GameObject>)> callback)
 		: m_factory(nullptr)
-		, m_callback(callback)
+		, m_callback(std::move(callback))
 		{
 			// Nothing to do.
 		}
 
 		CreateGameObjectEvent::CreateGameObjectEvent(std::shared_ptr<const Engine::IGameObjectFactory> factory)
-		: m_factory(factory)
+		: m_factory(std::move(factory))
 		, m_callback([](std::shared_ptr<GameObject>){})
 		{
 			// Nothing to do.
@@ -20,8 +22,8 @@ namespace Engine
 
 		CreateGameObjectEvent::CreateGameObjectEvent(std::shared_ptr<const Engine::IGameObjectFactory> factory,
 			std::function<void(std::shared_ptr<GameObject>)> callback)
-		: m_factory(factory)
-		, m_callback(callback)
+		: m_factory(std::move(factory))
+		, m_callback(std::move(callback))
 		{
 			// Nothing to do.
 		}
@@ -1,15 +1,19 @@
 #include <Engine/Event/LoadAudioResourceEvent.hpp>
 
+#include <utility>
+
 namespace Engine
 {
 	namespace Event
 	{
 		LoadAudioResourceEvent::LoadAudioResourceEvent(std::string name,
 			std::string filepath,
-			std::function<void(const ResourceLoadedEvent<IAudioSource>&)> callback)
-		: m_name(name)
-		, m_filepath(filepath)
-		, m_callback(callback)
+			std::function<void(const ResourceLoadedEvent<IAudioSource>&)> callback,
+			ResourcePriority priority)
+		: m_name(std::move(name))
+		, m_filepath(std::move(filepath))
+		, m_callback(std::move(callback))
+		, m_priority(priority)
 		{
 			// Nothing to do.
 		}
@@ -33,5 +37,10 @@ namespace Engine
 		{
 			return m_callback;
 		}
+
+		ResourcePriority LoadAudioResourceEvent::GetPriority() const
+		{
+			return m_priority;
+		}
 	}
 }
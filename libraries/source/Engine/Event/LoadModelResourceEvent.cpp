@@ -1,14 +1,18 @@
 #include <Engine/Event/LoadModelResourceEvent.hpp>
 
+#include <utility>
+
 namespace Engine
 {
 	namespace Event
 	{
 		LoadModelResourceEvent::LoadModelResourceEvent(std::string name,
-			std::string filepath, std::function<void(const ResourceLoadedEvent<Model>&)> callback)
-		: m_name(name)
-		, m_filepath(filepath)
-		, m_callback(callback)
+			std::string filepath, std::function<void(const ResourceLoadedEvent<Model>&)> callback,
+			ResourcePriority priority)
+		: m_name(std::move(name))
+		, m_filepath(std::move(filepath))
+		, m_callback(std::move(callback))
+		, m_priority(priority)
 		{
 			// Nothing to do.
 		}
@@ -32,5 +36,10 @@ namespace Engine
 		{
 			return m_callback;
 		}
+
+		ResourcePriority LoadModelResourceEvent::GetPriority() const
+		{
+			return m_priority;
+		}
 	}
 }
@@ -1,16 +1,20 @@
 #include <Engine/Event/LoadShaderProgramResourceEvent.hpp>
 
+#include <utility>
+
 namespace Engine
 {
 	namespace Event
 	{
 		LoadShaderProgramResourceEvent::LoadShaderProgramResourceEvent(std::string name,
 			std::string vertexShaderFilepath, std::string fragmentShaderFilepath,
-			std::function<void(const ResourceLoadedEvent<ShaderProgram>&)> callback)
-		: m_name(name)
-		, m_vertexShaderPath(vertexShaderFilepath)
-		, m_fragmentShaderPath(fragmentShaderFilepath)
-		, m_callback(callback)
+			std::function<void(const ResourceLoadedEvent<ShaderProgram>&)> callback,
+			ResourcePriority priority)
+		: m_name(std::move(name))
+		, m_vertexShaderPath(std::move(vertexShaderFilepath))
+		, m_fragmentShaderPath(std::move(fragmentShaderFilepath))
+		, m_callback(std::move(callback))
+		, m_priority(priority)
 		{
 			// Nothing to do.
 		}
@@ -39,5 +43,10 @@ namespace Engine
 		{
 			return m_callback;
 		}
+
+		ResourcePriority LoadShaderProgramResourceEvent::GetPriority() const
+		{
+			return m_priority;
+		}
 	}
 }
@@ -1,11 +1,13 @@
 #include <Engine/Event/PushSceneEvent.hpp>
 
+#include <utility>
+
 namespace Engine
 {
 	namespace Event
 	{
 		PushSceneEvent::PushSceneEvent(std::string sceneName)
-		: m_sceneName(sceneName)
+		: m_sceneName(std::move(sceneName))
 		{
 			// Nothing to do.
 		}
@@ -0,0 +1,25 @@
+#include <Engine/Event/UploadResourceEvent.hpp>
+
+#include <utility>
+
+namespace Engine
+{
+	namespace Event
+	{
+		UploadResourceEvent::UploadResourceEvent(std::function<void()> upload)
+		: m_upload(std::move(upload))
+		{
+			// Nothing to do.
+		}
+
+		UploadResourceEvent::~UploadResourceEvent()
+		{
+			// Nothing to do.
+		}
+
+		const std::function<void()>& UploadResourceEvent::GetUpload() const
+		{
+			return m_upload;
+		}
+	}
+}
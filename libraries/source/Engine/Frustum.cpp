@@ -0,0 +1,76 @@
+#include <Engine/Frustum.hpp>
+
+namespace Engine
+{
+	Frustum::Frustum(const glm::mat4& viewProjectionMatrix)
+	: m_planes()
+	{
+		// A point is inside the clip volume when -w <= x, y, z <= w, so each
+		// plane is the last row of the matrix plus or minus another row
+		// (Gribb and Hartmann).
+		const glm::vec4 rows[4] = {
+			glm::vec4(viewProjectionMatrix[0][0], viewProjectionMatrix[1][0], viewProjectionMatrix[2][0], viewProjectionMatrix[3][0]),
+			glm::vec4(viewProjectionMatrix[0][1], viewProjectionMatrix[1][1], viewProjectionMatrix[2][1], viewProjectionMatrix[3][1]),
+			glm::vec4(viewProjectionMatrix[0][2], viewProjectionMatrix[1][2], viewProjectionMatrix[2][2], viewProjectionMatrix[3][2]),
+			glm::vec4(viewProjectionMatrix[0][3], viewProjectionMatrix[1][3], viewProjectionMatrix[2][3], viewProjectionMatrix[3][3])
+		};
+
+		m_planes.reserve(6);
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			for (float sign = 1.0f; sign >= -1.0f; sign -= 2.0f)
+			{
+				// The plane holds the points where dot(normal, p) + w is
+				// zero.
+				const glm::vec4 plane = rows[3] + rows[axis] * sign;
+				const glm::vec3 normal(plane);
+				const float length = glm::length(normal);
+				m_planes.push_back(Plane(normal, -plane.w / length));
+			}
+		}
+	}
+
+	Frustum::~Frustum()
+	{
+		// Nothing to do.
+	}
+
+	const std::vector<Plane>& Frustum::GetPlanes() const
+	{
+		return m_planes;
+	}
+
+	bool Frustum::IntersectsSphere(const glm::vec3& center, float radius) const
+	{
+		for (const Plane& plane : m_planes)
+		{
+			if (plane.GetSignedDistance(center) < -radius)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool Frustum::IntersectsBox(const glm::vec3& minimum, const glm::vec3& maximum) const
+	{
+		for (const Plane& plane : m_planes)
+		{
+			// The box is outside if its corner furthest along the normal is.
+			const glm::vec3& normal = plane.GetNormal();
+			const glm::vec3 corner(
+				(normal.x >= 0.0f) ? maximum.x : minimum.x,
+				(normal.y >= 0.0f) ? maximum.y : minimum.y,
+				(normal.z >= 0.0f) ? maximum.z : minimum.z
+			);
+
+			if (plane.GetSignedDistance(corner) < 0.0f)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,234 @@
+#include <Engine/GeometryBuffer.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace Engine
+{
+	GeometryBuffer::Allocation::Allocation()
+	: page(InvalidPage)
+	, layout(VertexFormat::Layout::Compact)
+	, baseVertex(0)
+	, vertexCount(0)
+	, indexOffset(0)
+	, indexSize(0)
+	{
+		// Nothing to do.
+	}
+
+	GeometryBuffer::Page::Page(VertexFormat::Layout layout, std::size_t vertexCapacity, std::size_t indexCapacity)
+	: layout(layout)
+	, vertexBuffer(0)
+	, indexBuffer(0)
+	, vertexAllocator(vertexCapacity)
+	, indexAllocator(indexCapacity)
+	, vertexArray(0)
+	{
+		// Nothing to do.
+	}
+
+	GeometryBuffer& GeometryBuffer::GetInstance()
+	{
+		static GeometryBuffer instance;
+		return instance;
+	}
+
+	GeometryBuffer::GeometryBuffer()
+	: m_pages()
+	, m_mutex()
+	{
+		// Nothing to do.
+	}
+
+	GeometryBuffer::~GeometryBuffer()
+	{
+		// Nothing to do.
+	}
+
+	GeometryBuffer::Allocation GeometryBuffer::Upload(VertexFormat::Layout layout,
+		const void* vertices, std::size_t vertexCount,
+		const void* indices, std::size_t indexSize)
+	{
+		Allocation allocation;
+		if (vertexCount == 0 || indexSize == 0)
+		{
+			return allocation;
+		}
+
+		allocation.layout = layout;
+		allocation.vertexCount = vertexCount;
+		allocation.indexSize = indexSize;
+
+		Page* page = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			// Take the first page with the same layout that has room for both
+			// the vertices and the indices.
+			for (unsigned int p = 0; p < m_pages.size() && !page; ++p)
+			{
+				Page* candidate = m_pages[p].get();
+				if (candidate->layout != layout
+					|| !candidate->vertexAllocator.Allocate(vertexCount, 1, allocation.baseVertex))
+				{
+					continue;
+				}
+
+				if (!candidate->indexAllocator.Allocate(indexSize, IndexAlignment, allocation.indexOffset))
+				{
+					candidate->vertexAllocator.Free(allocation.baseVertex, vertexCount);
+					continue;
+				}
+
+				allocation.page = p;
+				page = candidate;
+			}
+
+			// Otherwise start a new page, which is always large enough.
+			if (!page)
+			{
+				allocation.page = CreatePage(layout, vertexCount, indexSize);
+				page = m_pages[allocation.page].get();
+
+				bool allocated = page->vertexAllocator.Allocate(vertexCount, 1, allocation.baseVertex);
+				allocated = page->indexAllocator.Allocate(indexSize, IndexAlignment, allocation.indexOffset) && allocated;
+				assert(allocated);
+			}
+		}
+
+		// The buffer names never change once a page has been created, so the
+		// data can be uploaded without holding the lock. Both buffers are
+		// bound to GL_ARRAY_BUFFER, since binding an element array buffer
+		// would change whichever Vertex Array Object is bound.
+		const std::size_t vertexSize = VertexFormat::GetVertexSize(layout);
+		glBindBuffer(GL_ARRAY_BUFFER, page->vertexBuffer);
+		glBufferSubData(GL_ARRAY_BUFFER, allocation.baseVertex * vertexSize, vertexCount * vertexSize, vertices);
+		glBindBuffer(GL_ARRAY_BUFFER, page->indexBuffer);
+		glBufferSubData(GL_ARRAY_BUFFER, allocation.indexOffset, indexSize, indices);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		return allocation;
+	}
+
+	void GeometryBuffer::Free(const Allocation& allocation)
+	{
+		if (allocation.page == InvalidPage)
+		{
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		assert(allocation.page < m_pages.size());
+		Page* page = m_pages[allocation.page].get();
+		page->vertexAllocator.Free(allocation.baseVertex, allocation.vertexCount);
+		page->indexAllocator.Free(allocation.indexOffset, allocation.indexSize);
+	}
+
+	GLuint GeometryBuffer::GetVertexArray(unsigned int pageId)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		assert(pageId < m_pages.size());
+		Page* page = m_pages[pageId].get();
+		if (page->vertexArray > 0)
+		{
+			return page->vertexArray;
+		}
+
+		// Generate the VAO.
+		glGenVertexArrays(1, &page->vertexArray);
+		assert(page->vertexArray > 0);
+
+		// Bind the VAO.
+		glBindVertexArray(page->vertexArray);
+
+		// Bind the vertex buffer to the VAO.
+		glBindBuffer(GL_ARRAY_BUFFER, page->vertexBuffer);
+
+		// Positions are the first attribute passed to the shader (index 0),
+		// and the octahedral encoded normals are the second (index 1). They
+		// sit at the same offsets in both layouts.
+		const GLsizei stride = VertexFormat::GetVertexSize(page->layout);
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride,
+			reinterpret_cast<const GLvoid*>(offsetof(VertexFormat::Compact, position)));
+		glEnableVertexAttribArray(1);
+		glVertexAttribPointer(1, 2, GL_SHORT, GL_TRUE, stride,
+			reinterpret_cast<const GLvoid*>(offsetof(VertexFormat::Compact, normal)));
+
+		// Texture coordinates are the fourth attribute (index 3).
+		glEnableVertexAttribArray(3);
+		if (page->layout == VertexFormat::Layout::Wide)
+		{
+			glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, stride,
+				reinterpret_cast<const GLvoid*>(offsetof(VertexFormat::Wide, textureCoordinates)));
+		}
+		else
+		{
+			glVertexAttribPointer(3, 2, GL_HALF_FLOAT, GL_FALSE, stride,
+				reinterpret_cast<const GLvoid*>(offsetof(VertexFormat::Compact, textureCoordinates)));
+		}
+
+		// Node palette indices are the fifth attribute (index 4), passed to
+		// the shader as integers.
+		glEnableVertexAttribArray(4);
+		glVertexAttribIPointer(4, 1, GL_UNSIGNED_SHORT, stride,
+			reinterpret_cast<const GLvoid*>((page->layout == VertexFormat::Layout::Wide)
+				? offsetof(VertexFormat::Wide, node) : offsetof(VertexFormat::Compact, node)));
+
+		// Bind the index buffer to the VAO.
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, page->indexBuffer);
+
+		// Unbind the VAO.
+		glBindVertexArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		return page->vertexArray;
+	}
+
+	unsigned int GeometryBuffer::GetPageCount() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_pages.size();
+	}
+
+	std::size_t GeometryBuffer::GetGPUMemoryUsage() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		std::size_t bytes = 0;
+		for (auto iter = m_pages.begin(); iter != m_pages.end(); ++iter)
+		{
+			bytes += (*iter)->vertexAllocator.GetCapacity() * VertexFormat::GetVertexSize((*iter)->layout)
+				+ (*iter)->indexAllocator.GetCapacity();
+		}
+
+		return bytes;
+	}
+
+	unsigned int GeometryBuffer::CreatePage(VertexFormat::Layout layout, std::size_t vertexCount, std::size_t indexSize)
+	{
+		const std::size_t vertexSize = VertexFormat::GetVertexSize(layout);
+		const std::size_t vertexCapacity = std::max(PageVertexBufferSize / vertexSize, vertexCount);
+		const std::size_t indexCapacity = std::max(static_cast<std::size_t>(PageIndexBufferSize), indexSize);
+
+		std::unique_ptr<Page> page(new Page(layout, vertexCapacity, indexCapacity));
+
+		// Reserve the buffers. The contents are filled in as meshes are
+		// allocated.
+		glGenBuffers(1, &page->vertexBuffer);
+		glGenBuffers(1, &page->indexBuffer);
+		assert(page->vertexBuffer > 0);
+		assert(page->indexBuffer > 0);
+
+		glBindBuffer(GL_ARRAY_BUFFER, page->vertexBuffer);
+		glBufferData(GL_ARRAY_BUFFER, vertexCapacity * vertexSize, nullptr, GL_STATIC_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, page->indexBuffer);
+		glBufferData(GL_ARRAY_BUFFER, indexCapacity, nullptr, GL_STATIC_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		m_pages.push_back(std::move(page));
+		return m_pages.size() - 1;
+	}
+}
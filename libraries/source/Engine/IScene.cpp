@@ -7,6 +7,7 @@ namespace Engine
 		std::shared_ptr<EventDispatcher> sceneStackEventDispatcher)
 	: m_window(window)
 	, m_resourceManager(resourceManager)
+	, m_resourceGroup(resourceManager->CreateGroup())
 	, m_sceneStackEventDispatcher(sceneStackEventDispatcher)
 	, m_eventDispatcher(std::make_shared<EventDispatcher>())
 	, m_userInterfaceRenderer(window, resourceManager)
@@ -36,6 +37,11 @@ namespace Engine
 		m_userInterfaceRenderer.RenderShape(shape, shaderProgram);
 	}
 
+	ResourceManager::GroupID IScene::GetResourceGroup() const
+	{
+		return m_resourceGroup;
+	}
+
 	std::shared_ptr<Window> IScene::GetWindow() const
 	{
 		return m_window;
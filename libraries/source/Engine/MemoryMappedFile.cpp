@@ -0,0 +1,86 @@
+#include <Engine/MemoryMappedFile.hpp>
+
+#include <iostream>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace Engine
+{
+	MemoryMappedFile::MemoryMappedFile()
+	: m_data(nullptr)
+	, m_size(0)
+	{
+		// Nothing to do.
+	}
+
+	MemoryMappedFile::~MemoryMappedFile()
+	{
+		Close();
+	}
+
+	bool MemoryMappedFile::Open(std::string filepath)
+	{
+		// Unmap any previously mapped file.
+		Close();
+
+		const int fileDescriptor = open(filepath.c_str(), O_RDONLY);
+		if (fileDescriptor < 0)
+		{
+			std::cerr << "ERROR: Unable to open file \"" << filepath << "\"" << std::endl;
+			return false;
+		}
+
+		// Determine the size of the file.
+		struct stat fileStatus;
+		if (fstat(fileDescriptor, &fileStatus) != 0 || fileStatus.st_size <= 0)
+		{
+			std::cerr << "ERROR: Unable to map empty file \"" << filepath << "\"" << std::endl;
+			close(fileDescriptor);
+			return false;
+		}
+
+		const std::size_t size = static_cast<std::size_t>(fileStatus.st_size);
+		void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+
+		// Note: The mapping remains valid after the file descriptor is closed.
+		close(fileDescriptor);
+
+		if (data == MAP_FAILED)
+		{
+			std::cerr << "ERROR: Unable to map file \"" << filepath << "\"" << std::endl;
+			return false;
+		}
+
+		m_data = static_cast<const unsigned char*>(data);
+		m_size = size;
+		return true;
+	}
+
+	void MemoryMappedFile::Close()
+	{
+		if (m_data)
+		{
+			munmap(const_cast<unsigned char*>(m_data), m_size);
+			m_data = nullptr;
+			m_size = 0;
+		}
+	}
+
+	bool MemoryMappedFile::IsOpen() const
+	{
+		return m_data != nullptr;
+	}
+
+	const unsigned char* MemoryMappedFile::GetData() const
+	{
+		return m_data;
+	}
+
+	std::size_t MemoryMappedFile::GetSize() const
+	{
+		return m_size;
+	}
+}
@@ -0,0 +1,452 @@
+#include <Engine/MeshOptimizer.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace Engine
+{
+	namespace MeshOptimizer
+	{
+		namespace
+		{
+			/**
+			 * Number of vertices in the least recently used cache that
+			 * vertex cache optimization models.
+			 */
+			const unsigned int ModelledCacheSize = 32;
+
+			/**
+			 * Rate at which the score of a cached vertex falls off with its
+			 * position in the cache.
+			 */
+			const float CacheDecayPower = 1.5f;
+
+			/**
+			 * Score of the vertices of the most recently drawn triangle.
+			 * These are scored lower than the next few vertices in the cache
+			 * so that strips do not simply turn back on themselves.
+			 */
+			const float LastTriangleScore = 0.75f;
+
+			/**
+			 * Scale and power of the score given to vertices with few
+			 * remaining triangles, so that lone triangles are drawn before
+			 * they are left behind.
+			 */
+			const float ValenceBoostScale = 2.0f;
+			const float ValenceBoostPower = 0.5f;
+
+			/**
+			 * Number of remaining triangles above which the valence boost is
+			 * no longer looked up, but clamped.
+			 */
+			const unsigned int MaxScoredValence = 32;
+
+			/**
+			 * Marks a vertex that is not in the cache, or that has not yet
+			 * been remapped.
+			 */
+			const unsigned int Unassigned = ~0u;
+
+			/**
+			 * Scores of vertices in vertex cache optimization.
+			 */
+			class VertexScoreTable
+			{
+			public:
+				/**
+				 * Constructor.
+				 */
+				VertexScoreTable()
+				{
+					for (unsigned int p = 0; p < ModelledCacheSize; ++p)
+					{
+						m_cacheScores[p] = (p < 3) ? LastTriangleScore
+							: std::pow(1.0f - static_cast<float>(p - 3) / (ModelledCacheSize - 3), CacheDecayPower);
+					}
+
+					m_valenceScores[0] = 0.0f;
+					for (unsigned int v = 1; v <= MaxScoredValence; ++v)
+					{
+						m_valenceScores[v] = ValenceBoostScale * std::pow(static_cast<float>(v), -ValenceBoostPower);
+					}
+				}
+
+				/**
+				 * Returns the score of a vertex.
+				 *
+				 * @param cachePosition Position of the vertex in the cache,
+				 * or Unassigned if it is not cached.
+				 * @param remainingTriangles Number of triangles that use the
+				 * vertex and have not yet been drawn.
+				 * @return Score of the vertex, or -1 if it has no remaining
+				 * triangles.
+				 */
+				float Get(unsigned int cachePosition, unsigned int remainingTriangles) const
+				{
+					if (remainingTriangles == 0)
+					{
+						return -1.0f;
+					}
+
+					const float cacheScore = (cachePosition < ModelledCacheSize) ? m_cacheScores[cachePosition] : 0.0f;
+					return cacheScore + m_valenceScores[std::min(remainingTriangles, MaxScoredValence)];
+				}
+
+			private:
+				/**
+				 * Score of each position in the cache.
+				 */
+				float m_cacheScores[ModelledCacheSize];
+
+				/**
+				 * Score of each number of remaining triangles.
+				 */
+				float m_valenceScores[MaxScoredValence + 1];
+			};
+
+			/**
+			 * Draws a triangle with the FIFO vertex cache that the cache miss
+			 * ratio is measured with.
+			 *
+			 * @param indices Vertex indices, three per triangle.
+			 * @param triangle Index of the triangle.
+			 * @param stamps Time at which each vertex was inserted into the
+			 * cache.
+			 * @param time Current time, advanced by each miss.
+			 * @return Number of the triangle's vertices that missed the
+			 * cache.
+			 */
+			unsigned int DrawCachedTriangle(const std::vector<unsigned int>& indices, std::size_t triangle,
+				std::vector<std::size_t>& stamps, std::size_t& time)
+			{
+				unsigned int misses = 0;
+				for (std::size_t i = triangle * 3; i < triangle * 3 + 3; ++i)
+				{
+					if (time - stamps[indices[i]] > DefaultCacheSize)
+					{
+						stamps[indices[i]] = time++;
+						++misses;
+					}
+				}
+
+				return misses;
+			}
+
+			/**
+			 * Empties the FIFO vertex cache that the cache miss ratio is
+			 * measured with.
+			 *
+			 * @param time Current time, advanced past every vertex in the
+			 * cache.
+			 */
+			void ClearCache(std::size_t& time)
+			{
+				time += DefaultCacheSize + 1;
+			}
+		}
+
+		float CalculateAcmr(const std::vector<unsigned int>& indices, std::size_t vertexCount, unsigned int cacheSize)
+		{
+			const std::size_t triangleCount = indices.size() / 3;
+			if (triangleCount == 0)
+			{
+				return 0.0f;
+			}
+
+			// A vertex stays in the FIFO cache until the cache size more
+			// vertices have been inserted after it.
+			std::vector<std::size_t> stamps(vertexCount, 0);
+			std::size_t time = cacheSize + 1;
+			std::size_t misses = 0;
+			for (unsigned int index : indices)
+			{
+				if (time - stamps[index] > cacheSize)
+				{
+					stamps[index] = time++;
+					++misses;
+				}
+			}
+
+			return static_cast<float>(misses) / triangleCount;
+		}
+
+		std::vector<unsigned int> OptimizeVertexCache(const std::vector<unsigned int>& indices, std::size_t vertexCount)
+		{
+			static const VertexScoreTable scoreTable;
+
+			const std::size_t triangleCount = indices.size() / 3;
+			std::vector<unsigned int> result;
+			result.reserve(triangleCount * 3);
+			if (triangleCount == 0)
+			{
+				return result;
+			}
+
+			// Gather the triangles that use each vertex. The remaining
+			// triangles of a vertex are kept at the front of its range.
+			std::vector<unsigned int> remaining(vertexCount, 0);
+			for (std::size_t i = 0; i < triangleCount * 3; ++i)
+			{
+				++remaining[indices[i]];
+			}
+			std::vector<unsigned int> firstAdjacency(vertexCount + 1, 0);
+			std::partial_sum(remaining.begin(), remaining.end(), firstAdjacency.begin() + 1);
+			std::vector<unsigned int> adjacency(triangleCount * 3);
+			std::vector<unsigned int> cursors(firstAdjacency.begin(), firstAdjacency.end() - 1);
+			for (std::size_t i = 0; i < triangleCount * 3; ++i)
+			{
+				adjacency[cursors[indices[i]]++] = static_cast<unsigned int>(i / 3);
+			}
+
+			std::vector<unsigned int> cachePositions(vertexCount, Unassigned);
+			std::vector<float> vertexScores(vertexCount);
+			for (std::size_t v = 0; v < vertexCount; ++v)
+			{
+				vertexScores[v] = scoreTable.Get(Unassigned, remaining[v]);
+			}
+
+			std::vector<float> triangleScores(triangleCount);
+			for (std::size_t t = 0; t < triangleCount; ++t)
+			{
+				triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+			}
+			std::vector<bool> drawn(triangleCount, false);
+
+			std::vector<unsigned int> cache;
+			std::vector<unsigned int> nextCache;
+			cache.reserve(ModelledCacheSize + 3);
+			nextCache.reserve(ModelledCacheSize + 3);
+
+			// Start with the best triangle in the mesh, and from then on
+			// choose among the triangles of the cached vertices. When none of
+			// those remain, continue with the next triangle not yet drawn.
+			std::size_t bestTriangle = std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin();
+			std::size_t nextUndrawn = 0;
+			while (result.size() < triangleCount * 3)
+			{
+				if (bestTriangle == triangleCount)
+				{
+					while (drawn[nextUndrawn])
+					{
+						++nextUndrawn;
+					}
+					bestTriangle = nextUndrawn;
+				}
+
+				// Draw the triangle, removing it from its vertices' remaining
+				// triangles.
+				drawn[bestTriangle] = true;
+				nextCache.clear();
+				for (std::size_t i = bestTriangle * 3; i < bestTriangle * 3 + 3; ++i)
+				{
+					const unsigned int vertex = indices[i];
+					result.push_back(vertex);
+					nextCache.push_back(vertex);
+
+					unsigned int* first = &adjacency[firstAdjacency[vertex]];
+					unsigned int* last = first + remaining[vertex];
+					std::iter_swap(std::find(first, last, static_cast<unsigned int>(bestTriangle)), last - 1);
+					--remaining[vertex];
+				}
+
+				// Move the triangle's vertices to the front of the cache.
+				for (unsigned int vertex : cache)
+				{
+					if (vertex != nextCache[0] && vertex != nextCache[1] && vertex != nextCache[2])
+					{
+						nextCache.push_back(vertex);
+					}
+				}
+				cache.swap(nextCache);
+
+				// Rescore the vertices whose position in the cache changed,
+				// including those that fell out of it, and their triangles.
+				for (unsigned int p = 0; p < cache.size(); ++p)
+				{
+					const unsigned int vertex = cache[p];
+					cachePositions[vertex] = (p < ModelledCacheSize) ? p : Unassigned;
+
+					const float score = scoreTable.Get(cachePositions[vertex], remaining[vertex]);
+					const float change = score - vertexScores[vertex];
+					vertexScores[vertex] = score;
+					for (unsigned int a = firstAdjacency[vertex]; a < firstAdjacency[vertex] + remaining[vertex]; ++a)
+					{
+						triangleScores[adjacency[a]] += change;
+					}
+				}
+				if (cache.size() > ModelledCacheSize)
+				{
+					cache.resize(ModelledCacheSize);
+				}
+
+				bestTriangle = triangleCount;
+				float bestScore = -1.0f;
+				for (unsigned int vertex : cache)
+				{
+					for (unsigned int a = firstAdjacency[vertex]; a < firstAdjacency[vertex] + remaining[vertex]; ++a)
+					{
+						if (triangleScores[adjacency[a]] > bestScore)
+						{
+							bestScore = triangleScores[adjacency[a]];
+							bestTriangle = adjacency[a];
+						}
+					}
+				}
+			}
+
+			return result;
+		}
+
+		std::vector<unsigned int> OptimizeOverdraw(const std::vector<glm::vec3>& positions,
+			const std::vector<unsigned int>& indices, float threshold)
+		{
+			const std::size_t triangleCount = indices.size() / 3;
+			if (triangleCount == 0)
+			{
+				return std::vector<unsigned int>();
+			}
+
+			// A triangle that misses on every vertex starts a new strip of
+			// the cache optimized order, so the mesh can be reordered there
+			// at no cost.
+			std::vector<std::size_t> stamps(positions.size(), 0);
+			std::size_t time = 0;
+			ClearCache(time);
+
+			std::vector<std::size_t> hardClusters;
+			for (std::size_t t = 0; t < triangleCount; ++t)
+			{
+				if (DrawCachedTriangle(indices, t, stamps, time) == 3 || t == 0)
+				{
+					hardClusters.push_back(t);
+				}
+			}
+			hardClusters.push_back(triangleCount);
+
+			// Split each of those further wherever the triangles so far, drawn
+			// from an empty cache, have a cache miss ratio within the threshold
+			// of the whole.
+			std::vector<std::size_t> clusters;
+			for (std::size_t h = 0; h + 1 < hardClusters.size(); ++h)
+			{
+				const std::size_t first = hardClusters[h];
+				const std::size_t last = hardClusters[h + 1];
+
+				ClearCache(time);
+				std::size_t hardMisses = 0;
+				for (std::size_t t = first; t < last; ++t)
+				{
+					hardMisses += DrawCachedTriangle(indices, t, stamps, time);
+				}
+				const float limit = threshold * hardMisses / (last - first);
+
+				std::size_t start = first;
+				while (start < last)
+				{
+					clusters.push_back(start);
+					ClearCache(time);
+
+					std::size_t clusterMisses = 0;
+					std::size_t end = start;
+					while (end < last)
+					{
+						clusterMisses += DrawCachedTriangle(indices, end++, stamps, time);
+						if (clusterMisses <= limit * (end - start))
+						{
+							break;
+						}
+					}
+					start = end;
+				}
+			}
+			clusters.push_back(triangleCount);
+
+			// Find the area weighted centroid and normal of each cluster, and
+			// of the mesh.
+			const std::size_t clusterCount = clusters.size() - 1;
+			std::vector<glm::vec3> clusterCentroids(clusterCount, glm::vec3(0.0f));
+			std::vector<glm::vec3> clusterNormals(clusterCount, glm::vec3(0.0f));
+			glm::vec3 meshCentroid(0.0f);
+			float meshArea = 0.0f;
+			for (std::size_t c = 0; c < clusterCount; ++c)
+			{
+				float clusterArea = 0.0f;
+				for (std::size_t t = clusters[c]; t < clusters[c + 1]; ++t)
+				{
+					const glm::vec3& a = positions[indices[t * 3]];
+					const glm::vec3& b = positions[indices[t * 3 + 1]];
+					const glm::vec3& d = positions[indices[t * 3 + 2]];
+					const glm::vec3 normal = glm::cross(b - a, d - a);
+					const float area = glm::length(normal);
+
+					clusterCentroids[c] += (a + b + d) * (area / 3.0f);
+					clusterNormals[c] += normal;
+					clusterArea += area;
+				}
+
+				meshCentroid += clusterCentroids[c];
+				meshArea += clusterArea;
+				if (clusterArea > 0.0f)
+				{
+					clusterCentroids[c] /= clusterArea;
+				}
+			}
+			if (meshArea > 0.0f)
+			{
+				meshCentroid /= meshArea;
+			}
+
+			// Clusters that face away from the middle of the mesh, furthest
+			// out, are the most likely to hide others.
+			std::vector<float> clusterScores(clusterCount, 0.0f);
+			for (std::size_t c = 0; c < clusterCount; ++c)
+			{
+				const float normalLength = glm::length(clusterNormals[c]);
+				if (normalLength > 0.0f)
+				{
+					clusterScores[c] = glm::dot(clusterCentroids[c] - meshCentroid, clusterNormals[c]) / normalLength;
+				}
+			}
+
+			std::vector<std::size_t> order(clusterCount);
+			std::iota(order.begin(), order.end(), 0);
+			std::stable_sort(order.begin(), order.end(), [&clusterScores](std::size_t a, std::size_t b) {
+				return clusterScores[a] > clusterScores[b];
+			});
+
+			std::vector<unsigned int> result;
+			result.reserve(triangleCount * 3);
+			for (std::size_t c : order)
+			{
+				result.insert(result.end(), indices.begin() + clusters[c] * 3, indices.begin() + clusters[c + 1] * 3);
+			}
+
+			return result;
+		}
+
+		std::vector<unsigned int> GenerateVertexFetchRemap(const std::vector<unsigned int>& indices, std::size_t vertexCount)
+		{
+			std::vector<unsigned int> remap(vertexCount, Unassigned);
+			unsigned int nextVertex = 0;
+			for (unsigned int index : indices)
+			{
+				if (remap[index] == Unassigned)
+				{
+					remap[index] = nextVertex++;
+				}
+			}
+
+			for (unsigned int& vertex : remap)
+			{
+				if (vertex == Unassigned)
+				{
+					vertex = nextVertex++;
+				}
+			}
+
+			return remap;
+		}
+	}
+}
@@ -0,0 +1,425 @@
+#include <Engine/MeshSimplifier.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <unordered_map>
+
+namespace Engine
+{
+	namespace MeshSimplifier
+	{
+		namespace
+		{
+			/**
+			 * Weight of the planes that keep border edges in place, relative
+			 * to the planes of the triangles.
+			 */
+			const float BorderWeight = 10.0f;
+
+			/**
+			 * Smallest cosine of the angle that a collapse may turn a
+			 * triangle through.
+			 */
+			const float MinNormalCosine = 0.25f;
+
+			/**
+			 * Symmetric 4x4 matrix that measures the sum of the squared
+			 * distances from a point to a set of weighted planes.
+			 */
+			struct Quadric
+			{
+				double a00, a01, a02, a03;
+				double a11, a12, a13;
+				double a22, a23;
+				double a33;
+			};
+
+			/**
+			 * Candidate edge collapse.
+			 */
+			struct Collapse
+			{
+				double cost;
+				unsigned int from;
+				unsigned int to;
+			};
+
+			/**
+			 * Adds a weighted plane to a quadric.
+			 *
+			 * @param quadric The quadric.
+			 * @param normal Unit normal of the plane.
+			 * @param distance Distance of the plane from the origin, such
+			 * that dot(normal, p) + distance is zero for points on the plane.
+			 * @param weight Weight of the plane.
+			 */
+			void AddPlane(Quadric& quadric, const glm::vec3& normal, float distance, float weight)
+			{
+				const double a = normal.x;
+				const double b = normal.y;
+				const double c = normal.z;
+				const double d = distance;
+				const double w = weight;
+
+				quadric.a00 += w * a * a;
+				quadric.a01 += w * a * b;
+				quadric.a02 += w * a * c;
+				quadric.a03 += w * a * d;
+				quadric.a11 += w * b * b;
+				quadric.a12 += w * b * c;
+				quadric.a13 += w * b * d;
+				quadric.a22 += w * c * c;
+				quadric.a23 += w * c * d;
+				quadric.a33 += w * d * d;
+			}
+
+			/**
+			 * Adds one quadric to another.
+			 *
+			 * @param quadric Receives the sum.
+			 * @param other Quadric to add.
+			 */
+			void Accumulate(Quadric& quadric, const Quadric& other)
+			{
+				quadric.a00 += other.a00;
+				quadric.a01 += other.a01;
+				quadric.a02 += other.a02;
+				quadric.a03 += other.a03;
+				quadric.a11 += other.a11;
+				quadric.a12 += other.a12;
+				quadric.a13 += other.a13;
+				quadric.a22 += other.a22;
+				quadric.a23 += other.a23;
+				quadric.a33 += other.a33;
+			}
+
+			/**
+			 * Returns the error of a point under a quadric.
+			 *
+			 * @param quadric The quadric.
+			 * @param point The point.
+			 * @return Weighted sum of squared distances to the planes.
+			 */
+			double Evaluate(const Quadric& quadric, const glm::vec3& point)
+			{
+				const double x = point.x;
+				const double y = point.y;
+				const double z = point.z;
+
+				const double error = quadric.a00 * x * x + 2.0 * quadric.a01 * x * y + 2.0 * quadric.a02 * x * z + 2.0 * quadric.a03 * x
+					+ quadric.a11 * y * y + 2.0 * quadric.a12 * y * z + 2.0 * quadric.a13 * y
+					+ quadric.a22 * z * z + 2.0 * quadric.a23 * z
+					+ quadric.a33;
+
+				// Rounding can make the error slightly negative.
+				return std::max(error, 0.0);
+			}
+
+			/**
+			 * Returns a key that identifies an undirected edge.
+			 *
+			 * @param a Index of one end of the edge.
+			 * @param b Index of the other end of the edge.
+			 * @return Edge key.
+			 */
+			std::uint64_t EdgeKey(unsigned int a, unsigned int b)
+			{
+				return (static_cast<std::uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+			}
+
+			/**
+			 * Returns true if moving a vertex would flip, collapse or sharply
+			 * turn any of its triangles that are not removed by the move.
+			 *
+			 * @param positions Vertex positions.
+			 * @param triangles Vertex indices of the triangles.
+			 * @param adjacentTriangles Triangles around the vertex.
+			 * @param adjacentTriangleCount Number of triangles around the
+			 * vertex.
+			 * @param from Index of the vertex to move.
+			 * @param to Index of the vertex to move onto.
+			 * @return True if the move should be rejected.
+			 */
+			bool CollapseFlips(const std::vector<glm::vec3>& positions,
+				const std::vector<unsigned int>& triangles,
+				const unsigned int* adjacentTriangles, unsigned int adjacentTriangleCount,
+				unsigned int from, unsigned int to)
+			{
+				for (unsigned int i = 0; i < adjacentTriangleCount; ++i)
+				{
+					const unsigned int* triangle = &triangles[adjacentTriangles[i] * 3];
+					if (triangle[0] == to || triangle[1] == to || triangle[2] == to)
+					{
+						continue;
+					}
+
+					glm::vec3 corners[3];
+					glm::vec3 movedCorners[3];
+					for (int c = 0; c < 3; ++c)
+					{
+						corners[c] = positions[triangle[c]];
+						movedCorners[c] = positions[(triangle[c] == from) ? to : triangle[c]];
+					}
+
+					const glm::vec3 normal = glm::cross(corners[1] - corners[0], corners[2] - corners[0]);
+					const glm::vec3 movedNormal = glm::cross(movedCorners[1] - movedCorners[0], movedCorners[2] - movedCorners[0]);
+					const float dot = glm::dot(normal, movedNormal);
+					if (dot <= 0.0f || dot < MinNormalCosine * glm::length(normal) * glm::length(movedNormal))
+					{
+						return true;
+					}
+				}
+
+				return false;
+			}
+		}
+
+		std::vector<unsigned int> Simplify(const std::vector<glm::vec3>& positions,
+			const std::vector<unsigned int>& indices, std::size_t targetIndexCount)
+		{
+			const unsigned int vertexCount = positions.size();
+
+			// Weld the vertices that share a position onto the first of them,
+			// so that seams are collapsed as one.
+			std::vector<unsigned int> order(vertexCount);
+			std::iota(order.begin(), order.end(), 0);
+			std::sort(order.begin(), order.end(),
+				[&positions](unsigned int a, unsigned int b)
+				{
+					const glm::vec3& pa = positions[a];
+					const glm::vec3& pb = positions[b];
+					return (pa.x != pb.x) ? pa.x < pb.x : (pa.y != pb.y) ? pa.y < pb.y : (pa.z != pb.z) ? pa.z < pb.z : a < b;
+				}
+			);
+
+			std::vector<unsigned int> weld(vertexCount);
+			for (unsigned int i = 0; i < vertexCount; ++i)
+			{
+				const bool shared = i > 0 && positions[order[i]] == positions[order[i - 1]];
+				weld[order[i]] = shared ? weld[order[i - 1]] : order[i];
+			}
+
+			// Keep the original vertex of each corner, alongside the welded
+			// vertex, so that uncollapsed corners keep their attributes.
+			std::vector<unsigned int> triangles;
+			std::vector<unsigned int> corners;
+			triangles.reserve(indices.size());
+			corners.reserve(indices.size());
+			for (std::size_t i = 0; i + 2 < indices.size(); i += 3)
+			{
+				const unsigned int a = weld[indices[i]];
+				const unsigned int b = weld[indices[i + 1]];
+				const unsigned int c = weld[indices[i + 2]];
+				if (a != b && b != c && a != c)
+				{
+					triangles.insert(triangles.end(), {a, b, c});
+					corners.insert(corners.end(), {indices[i], indices[i + 1], indices[i + 2]});
+				}
+			}
+
+			// Each vertex starts with the planes of its triangles, weighted by
+			// area.
+			std::vector<Quadric> quadrics(vertexCount, Quadric());
+			std::unordered_map<std::uint64_t, unsigned int> edgeUses;
+			for (std::size_t t = 0; t < triangles.size(); t += 3)
+			{
+				const glm::vec3& p0 = positions[triangles[t]];
+				const glm::vec3 normal = glm::cross(positions[triangles[t + 1]] - p0, positions[triangles[t + 2]] - p0);
+				const float length = glm::length(normal);
+				if (length > 0.0f)
+				{
+					const glm::vec3 unitNormal = normal / length;
+					for (int c = 0; c < 3; ++c)
+					{
+						AddPlane(quadrics[triangles[t + c]], unitNormal, -glm::dot(unitNormal, p0), length * 0.5f);
+					}
+				}
+
+				for (int c = 0; c < 3; ++c)
+				{
+					++edgeUses[EdgeKey(triangles[t + c], triangles[t + (c + 1) % 3])];
+				}
+			}
+
+			// Hold border edges in place with planes through the edge,
+			// perpendicular to its triangle.
+			for (std::size_t t = 0; t < triangles.size(); t += 3)
+			{
+				const glm::vec3& p0 = positions[triangles[t]];
+				const glm::vec3 normal = glm::cross(positions[triangles[t + 1]] - p0, positions[triangles[t + 2]] - p0);
+				for (int c = 0; c < 3; ++c)
+				{
+					const unsigned int a = triangles[t + c];
+					const unsigned int b = triangles[t + (c + 1) % 3];
+					if (edgeUses[EdgeKey(a, b)] != 1)
+					{
+						continue;
+					}
+
+					const glm::vec3 edge = positions[b] - positions[a];
+					const glm::vec3 borderNormal = glm::cross(edge, normal);
+					const float length = glm::length(borderNormal);
+					if (length > 0.0f)
+					{
+						const glm::vec3 unitNormal = borderNormal / length;
+						const float distance = -glm::dot(unitNormal, positions[a]);
+						const float weight = BorderWeight * glm::dot(edge, edge);
+						AddPlane(quadrics[a], unitNormal, distance, weight);
+						AddPlane(quadrics[b], unitNormal, distance, weight);
+					}
+				}
+			}
+
+			// Collapse the cheapest edges in passes. Each pass collapses edges
+			// whose surroundings are untouched by the other collapses in the
+			// pass, so the costs and flip tests stay valid.
+			std::vector<std::uint64_t> edges;
+			std::vector<Collapse> collapses;
+			std::vector<unsigned int> triangleOffsets;
+			std::vector<unsigned int> adjacentTriangles;
+			std::vector<unsigned int> remap(vertexCount);
+			std::vector<bool> locked;
+			while (triangles.size() > targetIndexCount)
+			{
+				// Find the unique edges and the cheaper direction to collapse
+				// each of them in.
+				edges.clear();
+				for (std::size_t t = 0; t < triangles.size(); t += 3)
+				{
+					for (int c = 0; c < 3; ++c)
+					{
+						edges.push_back(EdgeKey(triangles[t + c], triangles[t + (c + 1) % 3]));
+					}
+				}
+				std::sort(edges.begin(), edges.end());
+				edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+				collapses.clear();
+				for (std::uint64_t key : edges)
+				{
+					const unsigned int a = static_cast<unsigned int>(key >> 32);
+					const unsigned int b = static_cast<unsigned int>(key & 0xFFFFFFFFu);
+					Quadric quadric = quadrics[a];
+					Accumulate(quadric, quadrics[b]);
+
+					const double costToB = Evaluate(quadric, positions[b]);
+					const double costToA = Evaluate(quadric, positions[a]);
+					const Collapse collapse = (costToB <= costToA)
+						? Collapse{costToB, a, b}
+						: Collapse{costToA, b, a};
+					collapses.push_back(collapse);
+				}
+				std::sort(collapses.begin(), collapses.end(),
+					[](const Collapse& one, const Collapse& two) { return one.cost < two.cost; });
+
+				// Find the triangles around each vertex.
+				triangleOffsets.assign(vertexCount + 1, 0);
+				for (unsigned int index : triangles)
+				{
+					++triangleOffsets[index + 1];
+				}
+				std::partial_sum(triangleOffsets.begin(), triangleOffsets.end(), triangleOffsets.begin());
+				adjacentTriangles.resize(triangles.size());
+				{
+					std::vector<unsigned int> cursors(triangleOffsets.begin(), triangleOffsets.end() - 1);
+					for (std::size_t i = 0; i < triangles.size(); ++i)
+					{
+						adjacentTriangles[cursors[triangles[i]]++] = i / 3;
+					}
+				}
+
+				// Apply as many collapses as are needed, cheapest first.
+				const std::size_t trianglesToRemove = (triangles.size() - targetIndexCount + 2) / 3;
+				std::size_t removedTriangles = 0;
+				unsigned int appliedCollapses = 0;
+				std::iota(remap.begin(), remap.end(), 0);
+				locked.assign(vertexCount, false);
+				for (const Collapse& collapse : collapses)
+				{
+					if (removedTriangles >= trianglesToRemove)
+					{
+						break;
+					}
+
+					if (locked[collapse.from] || locked[collapse.to])
+					{
+						continue;
+					}
+
+					const unsigned int* fromTriangles = &adjacentTriangles[triangleOffsets[collapse.from]];
+					const unsigned int fromTriangleCount = triangleOffsets[collapse.from + 1] - triangleOffsets[collapse.from];
+					if (CollapseFlips(positions, triangles, fromTriangles, fromTriangleCount, collapse.from, collapse.to))
+					{
+						continue;
+					}
+
+					remap[collapse.from] = collapse.to;
+					Accumulate(quadrics[collapse.to], quadrics[collapse.from]);
+					++appliedCollapses;
+
+					// Lock the surroundings of both ends, and count the
+					// triangles that share the edge.
+					const unsigned int ends[2] = {collapse.from, collapse.to};
+					for (unsigned int end : ends)
+					{
+						for (unsigned int i = triangleOffsets[end]; i < triangleOffsets[end + 1]; ++i)
+						{
+							const unsigned int* triangle = &triangles[adjacentTriangles[i] * 3];
+							locked[triangle[0]] = true;
+							locked[triangle[1]] = true;
+							locked[triangle[2]] = true;
+						}
+					}
+					for (unsigned int i = 0; i < fromTriangleCount; ++i)
+					{
+						const unsigned int* triangle = &triangles[fromTriangles[i] * 3];
+						if (triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to)
+						{
+							++removedTriangles;
+						}
+					}
+				}
+
+				if (appliedCollapses == 0)
+				{
+					break;
+				}
+
+				// Move the collapsed corners and drop the triangles that have
+				// become degenerate.
+				std::size_t kept = 0;
+				for (std::size_t t = 0; t < triangles.size(); t += 3)
+				{
+					const unsigned int a = remap[triangles[t]];
+					const unsigned int b = remap[triangles[t + 1]];
+					const unsigned int c = remap[triangles[t + 2]];
+					if (a == b || b == c || a == c)
+					{
+						continue;
+					}
+
+					triangles[kept] = a;
+					triangles[kept + 1] = b;
+					triangles[kept + 2] = c;
+					corners[kept] = corners[t];
+					corners[kept + 1] = corners[t + 1];
+					corners[kept + 2] = corners[t + 2];
+					kept += 3;
+				}
+				triangles.resize(kept);
+				corners.resize(kept);
+			}
+
+			// Corners that were never moved keep their original vertex.
+			// Moved corners take the vertex they were collapsed onto.
+			std::vector<unsigned int> result(triangles.size());
+			for (std::size_t i = 0; i < triangles.size(); ++i)
+			{
+				result[i] = (triangles[i] == weld[corners[i]]) ? corners[i] : triangles[i];
+			}
+
+			return result;
+		}
+	}
+}
@@ -1,25 +1,368 @@
 #include <Engine/Model.hpp>
 
 #include <iostream>
-#include <set>
+#include <fstream>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+
+#include <sys/stat.h>
 
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
 #include <glm/gtx/transform.hpp>
 
+#include <Engine/BakedModelFormat.hpp>
+#include <Engine/MemoryMappedFile.hpp>
+#include <Engine/MeshOptimizer.hpp>
+#include <Engine/MeshSimplifier.hpp>
+#include <Engine/VertexFormat.hpp>
+
 namespace Engine
 {
+	static_assert(sizeof(glm::vec3) == 3 * sizeof(float), "Baked vertex data requires tightly packed glm::vec3");
+	static_assert(sizeof(glm::mat4) == 16 * sizeof(float), "Baked matrices require tightly packed glm::mat4");
+	static_assert(sizeof(unsigned int) == sizeof(std::uint32_t), "Baked indices require 32-bit unsigned int");
+	static_assert(sizeof(BakedModelFormat::Mesh::lodIndexCounts) / sizeof(std::uint32_t) == Model::MaxLodCount - 1,
+		"Baked meshes must hold every lower level of detail");
+
+	const unsigned int Model::InvalidAnimationClip;
+	const unsigned int Model::MaxLodCount;
+
+	namespace
+	{
+		/**
+		 * Extension used for baked model files.
+		 */
+		const char* const BakedModelExtension = ".model";
+
+		/**
+		 * Smallest number of triangles in a mesh for which lower levels of
+		 * detail are generated.
+		 */
+		const unsigned int MinLodTriangleCount = 64;
+
+		/**
+		 * Largest fraction of the previous level's indices that a level of
+		 * detail may keep. Levels that simplify less than this are not worth
+		 * drawing.
+		 */
+		const float MaxLodIndexRatio = 0.75f;
+
+		/**
+		 * Largest factor by which reordering triangles to reduce overdraw
+		 * may increase a mesh's vertex cache miss ratio.
+		 */
+		const float OverdrawThreshold = 1.05f;
+
+		/**
+		 * Moves each vertex attribute to its new index.
+		 *
+		 * @param values Attribute values, one per vertex.
+		 * @param remap New index of each vertex.
+		 */
+		void RemapVertices(std::vector<glm::vec3>& values, const std::vector<unsigned int>& remap)
+		{
+			std::vector<glm::vec3> remapped(values.size());
+			for (std::size_t v = 0; v < values.size(); ++v)
+			{
+				remapped[remap[v]] = values[v];
+			}
+			values.swap(remapped);
+		}
+
+		/**
+		 * ASSIMP post-processing steps applied to imported models.
+		 */
+		const unsigned int ImportFlags = aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_JoinIdenticalVertices | aiProcess_RemoveRedundantMaterials | aiProcess_FlipUVs | aiProcess_OptimizeGraph | aiProcess_OptimizeMeshes;
+
+		/**
+		 * Builds a baked model file in memory.
+		 */
+		class BakedModelWriter
+		{
+		public:
+			BakedModelWriter()
+			: m_buffer(sizeof(BakedModelFormat::Header), 0)
+			, m_strings()
+			{
+				// Nothing to do.
+				// Note: Room is reserved for the header, which is written last.
+			}
+
+			/**
+			 * Appends an array to the file, starting on a section boundary.
+			 *
+			 * @param data Pointer to the first element.
+			 * @param count Number of elements.
+			 * @return Offset of the array in the file.
+			 */
+			template <typename T>
+			std::uint32_t Append(const T* data, std::size_t count)
+			{
+				m_buffer.resize((m_buffer.size() + BakedModelFormat::SectionAlignment - 1)
+					& ~static_cast<std::size_t>(BakedModelFormat::SectionAlignment - 1), 0);
+
+				const std::size_t offset = m_buffer.size();
+				if (count > 0)
+				{
+					const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+					m_buffer.insert(m_buffer.end(), bytes, bytes + sizeof(T) * count);
+				}
+
+				return static_cast<std::uint32_t>(offset);
+			}
+
+			/**
+			 * Adds a string to the strings section.
+			 *
+			 * @param string The string to add.
+			 * @return Reference to the string.
+			 */
+			BakedModelFormat::String AddString(const std::string& string)
+			{
+				BakedModelFormat::String reference;
+				reference.offset = static_cast<std::uint32_t>(m_strings.size());
+				reference.length = static_cast<std::uint32_t>(string.size());
+				m_strings += string;
+				return reference;
+			}
+
+			/**
+			 * Appends the strings section, fills in the header and writes the
+			 * file to disk.
+			 *
+			 * @param header File header. The strings section fields are filled
+			 * in by the writer.
+			 * @param filepath Path to the file to write.
+			 * @return True if the file was successfully written.
+			 */
+			bool Save(BakedModelFormat::Header header, const std::string& filepath)
+			{
+				header.stringsOffset = Append(m_strings.data(), m_strings.size());
+				header.stringsSize = static_cast<std::uint32_t>(m_strings.size());
+				std::memcpy(&m_buffer[0], &header, sizeof(header));
+
+				std::ofstream file(filepath, std::ios::out | std::ios::binary | std::ios::trunc);
+				if (!file.is_open())
+				{
+					return false;
+				}
+
+				file.write(reinterpret_cast<const char*>(&m_buffer[0]), m_buffer.size());
+				return file.good();
+			}
+
+		private:
+			/**
+			 * File contents.
+			 */
+			std::vector<unsigned char> m_buffer;
+
+			/**
+			 * Contents of the strings section.
+			 */
+			std::string m_strings;
+		};
+
+		/**
+		 * Bounds-checked access to the contents of a baked model file.
+		 */
+		class BakedModelReader
+		{
+		public:
+			BakedModelReader(const unsigned char* data, std::size_t size, const BakedModelFormat::Header& header)
+			: m_data(data)
+			, m_size(size)
+			, m_strings(nullptr)
+			, m_stringsSize(0)
+			{
+				if (Contains(header.stringsOffset, header.stringsSize))
+				{
+					m_strings = reinterpret_cast<const char*>(m_data + header.stringsOffset);
+					m_stringsSize = header.stringsSize;
+				}
+			}
+
+			/**
+			 * Returns a pointer to an array stored in the file.
+			 *
+			 * @param offset Offset of the array in the file.
+			 * @param count Number of elements.
+			 * @return Pointer to the first element, or a nullptr if the array
+			 * is misaligned or does not fit in the file.
+			 */
+			template <typename T>
+			const T* GetArray(std::uint32_t offset, std::uint32_t count) const
+			{
+				if (offset % alignof(T) != 0 || !Contains(offset, static_cast<std::uint64_t>(sizeof(T)) * count))
+				{
+					return nullptr;
+				}
+
+				return reinterpret_cast<const T*>(m_data + offset);
+			}
+
+			/**
+			 * Reads a string from the strings section.
+			 *
+			 * @param reference Reference to the string.
+			 * @param string Receives the string.
+			 * @return True if the reference is valid.
+			 */
+			bool GetString(const BakedModelFormat::String& reference, std::string& string) const
+			{
+				if (static_cast<std::uint64_t>(reference.offset) + reference.length > m_stringsSize)
+				{
+					return false;
+				}
+
+				string.assign(m_strings + reference.offset, reference.length);
+				return true;
+			}
+
+		private:
+			bool Contains(std::uint64_t offset, std::uint64_t length) const
+			{
+				return offset + length <= m_size;
+			}
+
+		private:
+			const unsigned char* m_data;
+			std::size_t m_size;
+			const char* m_strings;
+			std::uint32_t m_stringsSize;
+		};
+
+		/**
+		 * Appends the node and its descendants to the list in depth-first
+		 * order.
+		 *
+		 * @param node Shared pointer to the node.
+		 * @param parentIndex Index of the node's parent in the list.
+		 * @param nodes List of nodes.
+		 * @param parentIndices Index of the parent for each node in the list.
+		 */
+		void FlattenNodeTree(std::shared_ptr<Model::Node> node, std::int32_t parentIndex,
+			std::vector<std::shared_ptr<Model::Node>>& nodes, std::vector<std::int32_t>& parentIndices)
+		{
+			const std::int32_t index = static_cast<std::int32_t>(nodes.size());
+			nodes.push_back(node);
+			parentIndices.push_back(parentIndex);
+
+			const unsigned int childNodeCount = node->GetChildNodeCount();
+			for (unsigned int n = 0; n < childNodeCount; ++n)
+			{
+				FlattenNodeTree(node->GetChildNode(n), index, nodes, parentIndices);
+			}
+		}
+
+		/**
+		 * Interleaves a mesh's vertices, packing the normals and the texture
+		 * coordinates, and tagging each vertex with its node's palette slot.
+		 *
+		 * @param mesh The mesh.
+		 * @param layout Vertex layout.
+		 * @param node Index of the mesh's node within its node palette.
+		 * @param vertices Receives the vertices. This must have room for all
+		 * of the mesh's vertices.
+		 */
+		void InterleaveVertices(const Model::Node::Mesh& mesh, VertexFormat::Layout layout,
+			std::uint16_t node, unsigned char* vertices)
+		{
+			const std::vector<glm::vec3>& positions = mesh.GetVertexPositions();
+			const std::vector<glm::vec3>& normals = mesh.GetVertexNormals();
+			const std::vector<glm::vec3>& textureCoordinates = mesh.GetVertexTextureCoordinates();
+			if (layout == VertexFormat::Layout::Wide)
+			{
+				VertexFormat::Wide* vertex = reinterpret_cast<VertexFormat::Wide*>(vertices);
+				for (unsigned int v = 0; v < positions.size(); ++v, ++vertex)
+				{
+					std::memcpy(vertex->position, &positions[v][0], sizeof(vertex->position));
+					VertexFormat::EncodeNormal(normals[v], vertex->normal);
+					vertex->textureCoordinates[0] = textureCoordinates[v].x;
+					vertex->textureCoordinates[1] = textureCoordinates[v].y;
+					vertex->node = node;
+					vertex->padding = 0;
+				}
+			}
+			else
+			{
+				VertexFormat::Compact* vertex = reinterpret_cast<VertexFormat::Compact*>(vertices);
+				for (unsigned int v = 0; v < positions.size(); ++v, ++vertex)
+				{
+					std::memcpy(vertex->position, &positions[v][0], sizeof(vertex->position));
+					VertexFormat::EncodeNormal(normals[v], vertex->normal);
+					vertex->textureCoordinates[0] = VertexFormat::EncodeHalf(textureCoordinates[v].x);
+					vertex->textureCoordinates[1] = VertexFormat::EncodeHalf(textureCoordinates[v].y);
+					vertex->node = node;
+					vertex->padding = 0;
+				}
+			}
+		}
+
+		/**
+		 * Checks that every vertex index refers to one of the vertices.
+		 *
+		 * @param indices Vertex indices.
+		 * @param indexCount Number of indices.
+		 * @param vertexCount Number of vertices.
+		 * @return True if every index is less than the vertex count.
+		 */
+		bool AreIndicesInRange(const std::uint32_t* indices, std::uint64_t indexCount, std::uint32_t vertexCount)
+		{
+			for (std::uint64_t i = 0; i < indexCount; ++i)
+			{
+				if (indices[i] >= vertexCount)
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		/**
+		 * Returns the path to the directory containing the specified file.
+		 *
+		 * @param filepath Path to the file.
+		 * @return Path to the parent directory.
+		 */
+		std::string GetDirectoryPath(const std::string& filepath)
+		{
+			return filepath.substr(0, filepath.find_last_of('/'));
+		}
+	}
+
 	Model::Model()
 	: m_name("")
 	, m_rootNode(nullptr)
+	, m_flatNodes()
+	, m_flatMeshes()
+	, m_paletteNodes()
+	, m_materialGroups()
+	, m_clips()
+	, m_poses()
+	, m_bindPose()
+	, m_boundingBoxMinimum(0.0f)
+	, m_boundingBoxMaximum(0.0f)
+	, m_boundingSphereCenter(0.0f)
+	, m_boundingSphereRadius(0.0f)
 	, m_materials()
-	, m_animationDuration(0.0)
 	{
 		// Nothing to do.
 	}
 
 	Model::~Model()
 	{
-		// Nothing to do.
+		// Return the material groups' space in the geometry buffer.
+		for (const MaterialGroup& group : m_materialGroups)
+		{
+			GeometryBuffer::GetInstance().Free(group.allocation);
+		}
 	}
 
 	const std::shared_ptr<Model::Node> Model::GetRootNode() const
@@ -27,12 +370,225 @@ namespace Engine
 		return m_rootNode;
 	}
 
-	const double Model::GetAnimationDuration() const
+	unsigned int Model::GetMaterialCount() const
+	{
+		return m_materials.size();
+	}
+
+	std::shared_ptr<Model::Material> Model::GetMaterial(unsigned int index) const
+	{
+		assert(index < m_materials.size());
+		return m_materials[index];
+	}
+
+	const std::vector<Model::FlatNode>& Model::GetFlatNodes() const
+	{
+		return m_flatNodes;
+	}
+
+	const std::vector<std::shared_ptr<Model::Node::Mesh>>& Model::GetFlatMeshes() const
+	{
+		return m_flatMeshes;
+	}
+
+	const std::vector<unsigned int>& Model::GetPaletteNodes() const
+	{
+		return m_paletteNodes;
+	}
+
+	const std::vector<Model::MaterialGroup>& Model::GetMaterialGroups() const
+	{
+		return m_materialGroups;
+	}
+
+	unsigned int Model::GetAnimationClipCount() const
+	{
+		return m_clips.size();
+	}
+
+	const AnimationClip& Model::GetAnimationClip(unsigned int clip) const
+	{
+		assert(clip < m_clips.size());
+		return m_clips[clip];
+	}
+
+	unsigned int Model::FindAnimationClip(const std::string& name) const
+	{
+		for (unsigned int c = 0; c < m_clips.size(); ++c)
+		{
+			if (m_clips[c].GetName() == name)
+			{
+				return c;
+			}
+		}
+
+		return InvalidAnimationClip;
+	}
+
+	void Model::EvaluateNodeTransformations(unsigned int clip, double time, std::vector<glm::mat4>& transformations) const
+	{
+		// Start from the static transformation matrices and the local bind
+		// pose transformation matrices of the animated nodes.
+		transformations.resize(m_flatNodes.size());
+		for (unsigned int n = 0; n < m_flatNodes.size(); ++n)
+		{
+			transformations[n] = m_flatNodes[n].transformationMatrix;
+		}
+
+		// Replace the local transformation matrices of the nodes that the
+		// clip animates.
+		if (clip < m_clips.size())
+		{
+			const AnimationClip& animationClip = m_clips[clip];
+			const std::vector<AnimationClip::Track>& tracks = animationClip.GetTracks();
+			for (auto iter = tracks.begin(); iter != tracks.end(); ++iter)
+			{
+				transformations[iter->node] = m_flatNodes[iter->node].animationTransformationMatrix
+					* animationClip.EvaluateTrack(*iter, time);
+			}
+		}
+
+		// Parents come first, so the parent's matrix is already known.
+		for (unsigned int n = 0; n < m_flatNodes.size(); ++n)
+		{
+			const FlatNode& node = m_flatNodes[n];
+			if (!node.isStatic && node.parentIndex >= 0)
+			{
+				transformations[n] = transformations[node.parentIndex] * transformations[n];
+			}
+		}
+	}
+
+	unsigned int Model::GetPoseFrameCount(unsigned int clip) const
+	{
+		if (m_flatNodes.empty())
+		{
+			return 0;
+		}
+
+		return (clip < m_poses.size()) ? m_poses[clip].size() / m_flatNodes.size() : 1;
+	}
+
+	const glm::mat4* Model::GetPose(unsigned int clip, double time) const
+	{
+		if (m_flatNodes.empty())
+		{
+			return nullptr;
+		}
+		else if (clip >= m_poses.size())
+		{
+			return &m_bindPose[0];
+		}
+
+		return &m_poses[clip][GetPoseFrame(clip, time) * m_flatNodes.size()];
+	}
+
+	unsigned int Model::GetPoseFrame(unsigned int clip, double time) const
+	{
+		if (clip >= m_poses.size())
+		{
+			return 0;
+		}
+
+		const unsigned int frameCount = GetPoseFrameCount(clip);
+		const double frame = std::round(time * PoseSampleRate);
+		return (frame <= 0.0) ? 0 : std::min(static_cast<unsigned int>(frame), frameCount - 1);
+	}
+
+	void Model::BlendPose(unsigned int clip, double time, std::vector<glm::mat4>& transformations) const
+	{
+		if (m_flatNodes.empty() || clip >= m_poses.size())
+		{
+			transformations = m_bindPose;
+			return;
+		}
+
+		// Find the frames either side of the time, clamped to the clip.
+		const unsigned int frameCount = GetPoseFrameCount(clip);
+		const double frame = std::max(0.0, time * PoseSampleRate);
+		const unsigned int f = std::min(static_cast<unsigned int>(frame), frameCount - 1);
+		const unsigned int nextFrame = std::min(f + 1, frameCount - 1);
+		const float factor = (nextFrame > f) ? static_cast<float>(frame - f) : 0.0f;
+
+		const glm::mat4* pose = &m_poses[clip][f * m_flatNodes.size()];
+		const glm::mat4* nextPose = &m_poses[clip][nextFrame * m_flatNodes.size()];
+		transformations.resize(m_flatNodes.size());
+		for (unsigned int n = 0; n < m_flatNodes.size(); ++n)
+		{
+			transformations[n] = pose[n] * (1.0f - factor) + nextPose[n] * factor;
+		}
+	}
+
+	std::size_t Model::GetCPUMemoryUsage() const
+	{
+		std::size_t bytes = m_bindPose.size() * sizeof(glm::mat4);
+		for (unsigned int c = 0; c < m_clips.size(); ++c)
+		{
+			bytes += m_clips[c].GetCPUMemoryUsage() + m_poses[c].size() * sizeof(glm::mat4);
+		}
+		for (const std::shared_ptr<Node::Mesh>& mesh : m_flatMeshes)
+		{
+			bytes += mesh->GetCPUMemoryUsage();
+		}
+		for (const MaterialGroup& group : m_materialGroups)
+		{
+			bytes += group.parts.capacity() * sizeof(MaterialGroup::Part);
+		}
+
+		return bytes;
+	}
+
+	std::size_t Model::GetGPUMemoryUsage() const
+	{
+		std::size_t bytes = 0;
+		for (const MaterialGroup& group : m_materialGroups)
+		{
+			bytes += group.allocation.vertexCount * VertexFormat::GetVertexSize(group.allocation.layout)
+				+ group.allocation.indexSize;
+		}
+
+		return bytes;
+	}
+
+	const glm::vec3& Model::GetBoundingBoxMinimum() const
+	{
+		return m_boundingBoxMinimum;
+	}
+
+	const glm::vec3& Model::GetBoundingBoxMaximum() const
+	{
+		return m_boundingBoxMaximum;
+	}
+
+	const glm::vec3& Model::GetBoundingSphereCenter() const
+	{
+		return m_boundingSphereCenter;
+	}
+
+	float Model::GetBoundingSphereRadius() const
+	{
+		return m_boundingSphereRadius;
+	}
+
+	double Model::GetAnimationDuration(unsigned int clip) const
 	{
-		return m_animationDuration;
+		return (clip < m_clips.size()) ? m_clips[clip].GetDuration() : 0.0;
 	}
 
 	bool Model::LoadFromFile(std::string filepath)
+	{
+		// Load the model data.
+		if (!Decode(filepath))
+		{
+			return false;
+		}
+
+		// Send the mesh data over to the graphics card.
+		UpdateBuffers();
+		return true;
+	}
+
+	bool Model::Decode(std::string filepath)
 	{
 		// Clear any previously loaded data.
 		Clear();
@@ -41,11 +597,29 @@ namespace Engine
 		Assimp::Importer importer;
 
 		// Have ASSIMP read the file.
-		const aiScene* assimpScene = importer.ReadFile(
-			filepath.c_str(),
-			aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_JoinIdenticalVertices | aiProcess_RemoveRedundantMaterials | aiProcess_FlipUVs | aiProcess_OptimizeGraph | aiProcess_OptimizeMeshes
-		);
+		const aiScene* assimpScene = importer.ReadFile(filepath.c_str(), ImportFlags);
+
+		return LoadScene(assimpScene, importer, filepath);
+	}
+
+	bool Model::Decode(const unsigned char* data, std::size_t size, std::string filepath)
+	{
+		// Clear any previously loaded data.
+		Clear();
+
+		// Create an instance of the ASSIMP importer.
+		Assimp::Importer importer;
+
+		// Have ASSIMP read the data. The file extension tells ASSIMP which
+		// importer to use.
+		const std::string extension = filepath.substr(filepath.find_last_of('.') + 1);
+		const aiScene* assimpScene = importer.ReadFileFromMemory(data, size, ImportFlags, extension.c_str());
 
+		return LoadScene(assimpScene, importer, filepath);
+	}
+
+	bool Model::LoadScene(const aiScene* assimpScene, const Assimp::Importer& importer, std::string filepath)
+	{
 		// Check that the file was read successfully.
 		if (assimpScene)
 		{
@@ -64,8 +638,11 @@ namespace Engine
 				// Load the nodes recursively.
 				LoadNode(assimpRootNode, assimpScene, nullptr);
 
-				// Load the node keyframes.
-				LoadNodeKeyframes(assimpScene);
+				// Load the animation clips.
+				LoadAnimationClips(assimpScene);
+
+				// Flatten the node tree for rendering.
+				Flatten();
 
 				// Success!
 				m_name = filepath;
@@ -88,6 +665,484 @@ namespace Engine
 		}
 	}
 
+	bool Model::DecodeBaked(std::string filepath)
+	{
+		// Clear any previously loaded data.
+		Clear();
+
+		MemoryMappedFile file;
+		if (!file.Open(filepath))
+		{
+			return false;
+		}
+
+		return DecodeBaked(file.GetData(), file.GetSize(), filepath);
+	}
+
+	bool Model::DecodeBaked(const unsigned char* data, std::size_t size, std::string filepath)
+	{
+		// Clear any previously loaded data.
+		Clear();
+
+		// Check that the data is a baked model that we understand.
+		// Note: The data must be 8 byte aligned, as it is when it comes
+		// straight from a memory mapped file or a resource pack.
+		if (size < sizeof(BakedModelFormat::Header) || reinterpret_cast<std::uintptr_t>(data) % alignof(BakedModelFormat::Header) != 0)
+		{
+			std::cerr << "Failed loading baked model \"" << filepath
+				<< "\" due to missing or misaligned header" << std::endl;
+			return false;
+		}
+
+		const BakedModelFormat::Header& header =
+			*reinterpret_cast<const BakedModelFormat::Header*>(data);
+
+		if (std::memcmp(header.magic, BakedModelFormat::Magic, sizeof(header.magic)) != 0 ||
+			header.version != BakedModelFormat::Version)
+		{
+			std::cerr << "Failed loading baked model \"" << filepath
+				<< "\" due to unsupported format or version" << std::endl;
+			return false;
+		}
+
+		// Locate the sections.
+		const BakedModelReader reader(data, size, header);
+		const BakedModelFormat::Material* bakedMaterials =
+			reader.GetArray<BakedModelFormat::Material>(header.materialsOffset, header.materialCount);
+		const BakedModelFormat::Node* bakedNodes =
+			reader.GetArray<BakedModelFormat::Node>(header.nodesOffset, header.nodeCount);
+		const BakedModelFormat::Mesh* bakedMeshes =
+			reader.GetArray<BakedModelFormat::Mesh>(header.meshesOffset, header.meshCount);
+		const BakedModelFormat::Clip* bakedClips =
+			reader.GetArray<BakedModelFormat::Clip>(header.clipsOffset, header.clipCount);
+		const BakedModelFormat::Track* bakedTracks =
+			reader.GetArray<BakedModelFormat::Track>(header.tracksOffset, header.trackCount);
+		const BakedModelFormat::Keyframe* bakedKeyframes =
+			reader.GetArray<BakedModelFormat::Keyframe>(header.keyframesOffset, header.keyframeCount);
+
+		bool valid = bakedMaterials && bakedNodes && bakedMeshes
+			&& bakedClips && bakedTracks && bakedKeyframes && header.nodeCount > 0;
+
+		// Load the materials.
+		// Note: Texture paths are stored relative to the model's directory.
+		const std::string directoryPath = GetDirectoryPath(filepath);
+		m_materials.resize(valid ? header.materialCount : 0);
+		for (unsigned int m = 0; valid && m < header.materialCount; ++m)
+		{
+			const BakedModelFormat::Material& bakedMaterial = bakedMaterials[m];
+
+			std::string name;
+			std::string diffuseTexturePath;
+			valid = reader.GetString(bakedMaterial.name, name)
+				&& reader.GetString(bakedMaterial.diffuseTexturePath, diffuseTexturePath);
+
+			std::shared_ptr<Material> material = std::make_shared<Material>();
+			material->SetName(name);
+			material->SetDiffuseColor(glm::make_vec3(bakedMaterial.diffuseColor));
+			material->SetSpecularColor(glm::make_vec3(bakedMaterial.specularColor));
+			material->SetAmbientColor(glm::make_vec3(bakedMaterial.ambientColor));
+			material->SetEmissiveColor(glm::make_vec3(bakedMaterial.emissiveColor));
+			material->SetShininess(bakedMaterial.shininess);
+			if (!diffuseTexturePath.empty())
+			{
+				material->SetDiffuseTexturePath(diffuseTexturePath.at(0) == '/' ?
+					diffuseTexturePath : directoryPath + "/" + diffuseTexturePath);
+			}
+
+			m_materials[m] = material;
+		}
+
+		// Load the nodes. Parents are always stored before their children.
+		std::vector<std::shared_ptr<Node>> nodes(valid ? header.nodeCount : 0);
+		for (unsigned int n = 0; valid && n < header.nodeCount; ++n)
+		{
+			const BakedModelFormat::Node& bakedNode = bakedNodes[n];
+
+			std::string name;
+			valid = reader.GetString(bakedNode.name, name)
+				&& (n == 0 ? bakedNode.parentIndex == -1 : bakedNode.parentIndex >= 0 && static_cast<unsigned int>(bakedNode.parentIndex) < n)
+				&& static_cast<std::uint64_t>(bakedNode.firstMesh) + bakedNode.meshCount <= header.meshCount;
+
+			if (!valid)
+			{
+				break;
+			}
+
+			std::shared_ptr<Node> node = std::make_shared<Node>(name, glm::make_mat4(bakedNode.bindTransformationMatrix));
+
+			// Load the node's meshes.
+			for (unsigned int m = bakedNode.firstMesh; valid && m < bakedNode.firstMesh + bakedNode.meshCount; ++m)
+			{
+				const BakedModelFormat::Mesh& bakedMesh = bakedMeshes[m];
+
+				const glm::vec3* positions = reader.GetArray<glm::vec3>(bakedMesh.positionsOffset, bakedMesh.vertexCount);
+				const glm::vec3* normals = reader.GetArray<glm::vec3>(bakedMesh.normalsOffset, bakedMesh.vertexCount);
+				const glm::vec3* textureCoordinates = reader.GetArray<glm::vec3>(bakedMesh.textureCoordinatesOffset, bakedMesh.vertexCount);
+				const std::uint32_t* indices = reader.GetArray<std::uint32_t>(bakedMesh.indicesOffset, bakedMesh.indexCount);
+				const std::uint64_t lodIndexCount = static_cast<std::uint64_t>(bakedMesh.lodIndexCounts[0]) + bakedMesh.lodIndexCounts[1];
+				const std::uint32_t* lodIndices = (lodIndexCount <= std::numeric_limits<std::uint32_t>::max())
+					? reader.GetArray<std::uint32_t>(bakedMesh.lodIndicesOffset, static_cast<std::uint32_t>(lodIndexCount)) : nullptr;
+
+				// Indices out of range would make draws read the vertices of
+				// other meshes in the same geometry buffer page.
+				valid = positions && normals && textureCoordinates && indices && lodIndices
+					&& bakedMesh.materialIndex < m_materials.size()
+					&& AreIndicesInRange(indices, bakedMesh.indexCount, bakedMesh.vertexCount)
+					&& AreIndicesInRange(lodIndices, lodIndexCount, bakedMesh.vertexCount);
+
+				if (valid)
+				{
+					std::shared_ptr<Node::Mesh> mesh = std::make_shared<Node::Mesh>();
+					mesh->SetMaterial(m_materials[bakedMesh.materialIndex]);
+					mesh->SetVertexData(
+						std::vector<glm::vec3>(positions, positions + bakedMesh.vertexCount),
+						std::vector<glm::vec3>(normals, normals + bakedMesh.vertexCount),
+						std::vector<glm::vec3>(textureCoordinates, textureCoordinates + bakedMesh.vertexCount),
+						std::vector<unsigned int>(indices, indices + bakedMesh.indexCount)
+					);
+
+					// Only the levels of detail that were generated are
+					// stored.
+					std::vector<std::vector<unsigned int>> meshLodIndices;
+					for (unsigned int l = 0; l < MaxLodCount - 1 && bakedMesh.lodIndexCounts[l] > 0; ++l)
+					{
+						meshLodIndices.emplace_back(lodIndices, lodIndices + bakedMesh.lodIndexCounts[l]);
+						lodIndices += bakedMesh.lodIndexCounts[l];
+					}
+					mesh->SetLodIndices(std::move(meshLodIndices));
+
+					node->AddMesh(mesh);
+				}
+			}
+
+			// Attach the node to its parent.
+			if (n == 0)
+			{
+				m_rootNode = node;
+			}
+			else
+			{
+				nodes[bakedNode.parentIndex]->AddChildNode(node);
+			}
+
+			nodes[n] = node;
+		}
+
+		// Load the animation clips. Tracks refer to nodes by their index in the
+		// nodes section, which is also their index in the flattened node
+		// tree.
+		std::vector<AnimationClip::Key> keys;
+		m_clips.reserve(valid ? header.clipCount : 0);
+		for (unsigned int c = 0; valid && c < header.clipCount; ++c)
+		{
+			const BakedModelFormat::Clip& bakedClip = bakedClips[c];
+
+			std::string name;
+			valid = reader.GetString(bakedClip.name, name)
+				&& static_cast<std::uint64_t>(bakedClip.firstTrack) + bakedClip.trackCount <= header.trackCount;
+
+			AnimationClip clip(name, bakedClip.duration);
+			for (unsigned int t = bakedClip.firstTrack; valid && t < bakedClip.firstTrack + bakedClip.trackCount; ++t)
+			{
+				const BakedModelFormat::Track& bakedTrack = bakedTracks[t];
+
+				valid = bakedTrack.nodeIndex < header.nodeCount && bakedTrack.keyframeCount > 0
+					&& static_cast<std::uint64_t>(bakedTrack.firstKeyframe) + bakedTrack.keyframeCount <= header.keyframeCount;
+
+				keys.resize(valid ? bakedTrack.keyframeCount : 0);
+				for (unsigned int k = 0; valid && k < bakedTrack.keyframeCount; ++k)
+				{
+					const BakedModelFormat::Keyframe& bakedKeyframe = bakedKeyframes[bakedTrack.firstKeyframe + k];
+
+					valid = k == 0 || bakedKeyframe.time > keys[k - 1].time;
+					keys[k].time = bakedKeyframe.time;
+					std::memcpy(keys[k].translation, bakedKeyframe.translation, sizeof(keys[k].translation));
+					std::memcpy(keys[k].rotation, bakedKeyframe.rotation, sizeof(keys[k].rotation));
+					std::memcpy(keys[k].scale, bakedKeyframe.scale, sizeof(keys[k].scale));
+				}
+
+				if (valid)
+				{
+					AnimationClip::Track track;
+					track.node = bakedTrack.nodeIndex;
+					track.firstKey = 0;
+					track.keyCount = bakedTrack.keyframeCount;
+					track.translationOrigin = glm::make_vec3(bakedTrack.translationOrigin);
+					track.translationExtent = glm::make_vec3(bakedTrack.translationExtent);
+					track.scaleOrigin = glm::make_vec3(bakedTrack.scaleOrigin);
+					track.scaleExtent = glm::make_vec3(bakedTrack.scaleExtent);
+					clip.AddTrack(track, keys.data());
+				}
+			}
+
+			m_clips.push_back(std::move(clip));
+		}
+
+		if (!valid)
+		{
+			std::cerr << "Failed loading baked model \"" << filepath
+				<< "\" because the file is corrupt" << std::endl;
+			Clear();
+			return false;
+		}
+
+		// Flatten the node tree for rendering.
+		Flatten();
+
+		// Success!
+		m_name = filepath;
+		return true;
+	}
+
+	bool Model::SaveBaked(std::string filepath) const
+	{
+		if (!m_rootNode)
+		{
+			return false;
+		}
+
+		BakedModelWriter writer;
+		BakedModelFormat::Header header;
+		std::memset(&header, 0, sizeof(header));
+		std::memcpy(header.magic, BakedModelFormat::Magic, sizeof(header.magic));
+		header.version = BakedModelFormat::Version;
+
+		// Bake the materials. Texture paths are made relative to the model's
+		// directory so that baked models can be moved along with their
+		// textures.
+		const std::string directoryPrefix = GetDirectoryPath(m_name) + "/";
+		std::vector<BakedModelFormat::Material> bakedMaterials(m_materials.size());
+		for (unsigned int m = 0; m < m_materials.size(); ++m)
+		{
+			const Material& material = *m_materials[m];
+			BakedModelFormat::Material& bakedMaterial = bakedMaterials[m];
+
+			std::string diffuseTexturePath = material.GetDiffuseTexturePath();
+			if (diffuseTexturePath.compare(0, directoryPrefix.size(), directoryPrefix) == 0)
+			{
+				diffuseTexturePath = diffuseTexturePath.substr(directoryPrefix.size());
+			}
+
+			bakedMaterial.name = writer.AddString(material.GetName());
+			std::memcpy(bakedMaterial.diffuseColor, glm::value_ptr(material.GetDiffuseColor()), sizeof(bakedMaterial.diffuseColor));
+			std::memcpy(bakedMaterial.specularColor, glm::value_ptr(material.GetSpecularColor()), sizeof(bakedMaterial.specularColor));
+			std::memcpy(bakedMaterial.ambientColor, glm::value_ptr(material.GetAmbientColor()), sizeof(bakedMaterial.ambientColor));
+			std::memcpy(bakedMaterial.emissiveColor, glm::value_ptr(material.GetEmissiveColor()), sizeof(bakedMaterial.emissiveColor));
+			bakedMaterial.shininess = material.GetShininess();
+			bakedMaterial.diffuseTexturePath = writer.AddString(diffuseTexturePath);
+		}
+
+		// Bake the nodes, along with their meshes.
+		std::vector<std::shared_ptr<Node>> nodes;
+		std::vector<std::int32_t> parentIndices;
+		FlattenNodeTree(m_rootNode, -1, nodes, parentIndices);
+
+		std::vector<BakedModelFormat::Node> bakedNodes(nodes.size());
+		std::vector<BakedModelFormat::Mesh> bakedMeshes;
+		for (unsigned int n = 0; n < nodes.size(); ++n)
+		{
+			const Node& node = *nodes[n];
+			BakedModelFormat::Node& bakedNode = bakedNodes[n];
+
+			bakedNode.name = writer.AddString(node.GetName());
+			bakedNode.parentIndex = parentIndices[n];
+			std::memcpy(bakedNode.bindTransformationMatrix, glm::value_ptr(node.GetLocalBindTransformationMatrix()), sizeof(bakedNode.bindTransformationMatrix));
+
+			bakedNode.firstMesh = bakedMeshes.size();
+			bakedNode.meshCount = node.GetMeshCount();
+			for (unsigned int m = 0; m < bakedNode.meshCount; ++m)
+			{
+				const Node::Mesh& mesh = *node.GetMesh(m);
+
+				BakedModelFormat::Mesh bakedMesh;
+				bakedMesh.materialIndex = std::find(m_materials.begin(), m_materials.end(), mesh.GetMaterial()) - m_materials.begin();
+				bakedMesh.vertexCount = mesh.GetVerticesCount();
+				bakedMesh.indexCount = mesh.GetIndicesCount();
+				bakedMesh.positionsOffset = writer.Append(mesh.GetVertexPositions().data(), mesh.GetVertexPositions().size());
+				bakedMesh.normalsOffset = writer.Append(mesh.GetVertexNormals().data(), mesh.GetVertexNormals().size());
+				bakedMesh.textureCoordinatesOffset = writer.Append(mesh.GetVertexTextureCoordinates().data(), mesh.GetVertexTextureCoordinates().size());
+				bakedMesh.indicesOffset = writer.Append(mesh.GetVertexIndices().data(), mesh.GetVertexIndices().size());
+
+				std::vector<unsigned int> lodIndices;
+				for (unsigned int l = 0; l < MaxLodCount - 1; ++l)
+				{
+					bakedMesh.lodIndexCounts[l] = 0;
+					if (l + 1 < mesh.GetLodCount())
+					{
+						const std::vector<unsigned int>& indices = mesh.GetLodIndices(l + 1);
+						bakedMesh.lodIndexCounts[l] = indices.size();
+						lodIndices.insert(lodIndices.end(), indices.begin(), indices.end());
+					}
+				}
+				bakedMesh.lodIndicesOffset = writer.Append(lodIndices.data(), lodIndices.size());
+				bakedMeshes.push_back(bakedMesh);
+			}
+		}
+
+		// Bake the animation clips. The keyframes are already quantized, so
+		// they are written as they are.
+		std::vector<BakedModelFormat::Clip> bakedClips(m_clips.size());
+		std::vector<BakedModelFormat::Track> bakedTracks;
+		std::vector<BakedModelFormat::Keyframe> bakedKeyframes;
+		for (unsigned int c = 0; c < m_clips.size(); ++c)
+		{
+			const AnimationClip& clip = m_clips[c];
+			BakedModelFormat::Clip& bakedClip = bakedClips[c];
+
+			bakedClip.name = writer.AddString(clip.GetName());
+			bakedClip.duration = clip.GetDuration();
+			bakedClip.firstTrack = bakedTracks.size();
+			bakedClip.trackCount = clip.GetTracks().size();
+
+			const std::vector<AnimationClip::Key>& keys = clip.GetKeys();
+			for (const AnimationClip::Track& track : clip.GetTracks())
+			{
+				BakedModelFormat::Track bakedTrack;
+				bakedTrack.nodeIndex = track.node;
+				bakedTrack.firstKeyframe = bakedKeyframes.size();
+				bakedTrack.keyframeCount = track.keyCount;
+				std::memcpy(bakedTrack.translationOrigin, glm::value_ptr(track.translationOrigin), sizeof(bakedTrack.translationOrigin));
+				std::memcpy(bakedTrack.translationExtent, glm::value_ptr(track.translationExtent), sizeof(bakedTrack.translationExtent));
+				std::memcpy(bakedTrack.scaleOrigin, glm::value_ptr(track.scaleOrigin), sizeof(bakedTrack.scaleOrigin));
+				std::memcpy(bakedTrack.scaleExtent, glm::value_ptr(track.scaleExtent), sizeof(bakedTrack.scaleExtent));
+				bakedTracks.push_back(bakedTrack);
+
+				for (unsigned int k = track.firstKey; k < track.firstKey + track.keyCount; ++k)
+				{
+					BakedModelFormat::Keyframe bakedKeyframe;
+					bakedKeyframe.time = keys[k].time;
+					std::memcpy(bakedKeyframe.translation, keys[k].translation, sizeof(bakedKeyframe.translation));
+					std::memcpy(bakedKeyframe.rotation, keys[k].rotation, sizeof(bakedKeyframe.rotation));
+					std::memcpy(bakedKeyframe.scale, keys[k].scale, sizeof(bakedKeyframe.scale));
+					bakedKeyframes.push_back(bakedKeyframe);
+				}
+			}
+		}
+
+		// Lay out the record sections.
+		header.materialCount = bakedMaterials.size();
+		header.materialsOffset = writer.Append(bakedMaterials.data(), bakedMaterials.size());
+		header.nodeCount = bakedNodes.size();
+		header.nodesOffset = writer.Append(bakedNodes.data(), bakedNodes.size());
+		header.meshCount = bakedMeshes.size();
+		header.meshesOffset = writer.Append(bakedMeshes.data(), bakedMeshes.size());
+		header.clipCount = bakedClips.size();
+		header.clipsOffset = writer.Append(bakedClips.data(), bakedClips.size());
+		header.trackCount = bakedTracks.size();
+		header.tracksOffset = writer.Append(bakedTracks.data(), bakedTracks.size());
+		header.keyframeCount = bakedKeyframes.size();
+		header.keyframesOffset = writer.Append(bakedKeyframes.data(), bakedKeyframes.size());
+
+		if (!writer.Save(header, filepath))
+		{
+			std::cerr << "Failed writing baked model \"" << filepath << "\"" << std::endl;
+			return false;
+		}
+
+		return true;
+	}
+
+	std::string Model::GetBakedFilepath(std::string filepath)
+	{
+		// Replace the extension, if there is one.
+		const std::size_t extensionPosition = filepath.find_last_of('.');
+		if (extensionPosition != std::string::npos &&
+			(filepath.find_last_of('/') == std::string::npos || extensionPosition > filepath.find_last_of('/')))
+		{
+			filepath.erase(extensionPosition);
+		}
+
+		return filepath + BakedModelExtension;
+	}
+
+	bool Model::IsBakedFileUpToDate(std::string filepath)
+	{
+		struct stat bakedFileStatus;
+		if (stat(GetBakedFilepath(filepath).c_str(), &bakedFileStatus) != 0)
+		{
+			return false;
+		}
+
+		struct stat sourceFileStatus;
+		if (stat(filepath.c_str(), &sourceFileStatus) != 0)
+		{
+			return true;
+		}
+
+		return bakedFileStatus.st_mtime >= sourceFileStatus.st_mtime;
+	}
+
+	void Model::UpdateBuffers()
+	{
+		if (m_materialGroups.empty())
+		{
+			return;
+		}
+
+		GeometryBuffer& geometryBuffer = GeometryBuffer::GetInstance();
+		std::vector<unsigned char> vertices;
+		std::vector<unsigned int> firstVertices;
+		std::vector<unsigned int> indices;
+		for (MaterialGroup& group : m_materialGroups)
+		{
+			// Release the previous upload, since the new data may not fit in
+			// its place.
+			geometryBuffer.Free(group.allocation);
+			group.allocation = GeometryBuffer::Allocation();
+
+			// Merge the parts' vertices.
+			const std::size_t vertexSize = VertexFormat::GetVertexSize(group.layout);
+			vertices.resize(group.vertexCount * vertexSize);
+			firstVertices.clear();
+			unsigned int firstVertex = 0;
+			for (const MaterialGroup::Part& part : group.parts)
+			{
+				const Node::Mesh& mesh = *m_flatMeshes[part.mesh];
+				const std::uint16_t slot = m_flatNodes[part.node].paletteIndex % MaxPaletteNodes;
+				InterleaveVertices(mesh, group.layout, slot, vertices.data() + firstVertex * vertexSize);
+
+				firstVertices.push_back(firstVertex);
+				firstVertex += mesh.GetVerticesCount();
+			}
+
+			// Merge each level of detail's indices, offsetting them by the
+			// vertices merged before their part.
+			indices.clear();
+			indices.reserve(group.indexCount);
+			for (unsigned int l = 0; l < group.lodCount; ++l)
+			{
+				for (unsigned int p = 0; p < group.parts.size(); ++p)
+				{
+					const Node::Mesh& mesh = *m_flatMeshes[group.parts[p].mesh];
+					for (unsigned int index : mesh.GetLodIndices(std::min(l, mesh.GetLodCount() - 1)))
+					{
+						indices.push_back(firstVertices[p] + index);
+					}
+				}
+			}
+
+			// Send the vertices and indices to the geometry buffer, as 16-bit
+			// indices if every vertex can be addressed by one. The indices are
+			// relative to the group's first vertex, so this does not depend on
+			// where the group is placed.
+			if (group.indexType == GL_UNSIGNED_SHORT)
+			{
+				const std::vector<std::uint16_t> shortIndices(indices.begin(), indices.end());
+				group.allocation = geometryBuffer.Upload(group.layout, vertices.data(), group.vertexCount,
+					shortIndices.data(), sizeof(std::uint16_t) * shortIndices.size());
+			}
+			else
+			{
+				group.allocation = geometryBuffer.Upload(group.layout, vertices.data(), group.vertexCount,
+					indices.data(), sizeof(unsigned int) * indices.size());
+			}
+		}
+
+		// Force an OpenGL flush so that the uploads will be visible in all
+		// contexts.
+		glFlush();
+	}
+
 	void Model::Transform(const glm::vec3& translation, const glm::quat& rotation,
 		const glm::vec3& scale)
 	{
@@ -98,6 +1153,11 @@ namespace Engine
 
 		// Transform the root node.
 		m_rootNode->Transform(transformationMatrix);
+
+		// The static transformation matrices have changed. The node tree
+		// and its meshes have not, so the material groups, and their upload
+		// to the geometry buffer, are kept.
+		UpdateNodeTransformations();
 	}
 
 	void Model::Clear()
@@ -110,9 +1170,25 @@ namespace Engine
 
 		// Remove the reference to the root node.
 		m_rootNode = nullptr;
+		m_flatNodes.clear();
+		m_flatMeshes.clear();
+		m_paletteNodes.clear();
+
+		// Release the material groups.
+		for (const MaterialGroup& group : m_materialGroups)
+		{
+			GeometryBuffer::GetInstance().Free(group.allocation);
+		}
+		m_materialGroups.clear();
 
-		// Reset animation duration.
-		m_animationDuration = 0.0;
+		// Clear the animation clips.
+		m_clips.clear();
+		m_poses.clear();
+		m_bindPose.clear();
+		m_boundingBoxMinimum = glm::vec3(0.0f);
+		m_boundingBoxMaximum = glm::vec3(0.0f);
+		m_boundingSphereCenter = glm::vec3(0.0f);
+		m_boundingSphereRadius = 0.0f;
 	}
 
 	std::shared_ptr<Model::Node> Model::FindNodeByName(std::string name)
@@ -278,9 +1354,10 @@ namespace Engine
 				}
 			}
 
-			// Update the mesh's buffer objects.
-			// This sends the mesh data over to the graphics card.
-			mesh->UpdateBuffers();
+			// Reorder the mesh for drawing, then simplify it for drawing at
+			// a distance.
+			mesh->Optimize();
+			mesh->GenerateLods();
 
 			// Add the mesh to the node.
 			node->AddMesh(mesh);
@@ -309,35 +1386,49 @@ namespace Engine
 		}
 	}
 
-	void Model::LoadNodeKeyframes(const aiScene* assimpScene)
+	void Model::LoadAnimationClips(const aiScene* assimpScene)
 	{
 		// Get the number of animations.
 		const unsigned int numAnimations = assimpScene->mNumAnimations;
 
-		// Only proceed if there is an animation to load.
-		if (numAnimations > 0)
+		// Only proceed if there are animations to load.
+		if (numAnimations == 0)
 		{
-			// Check whether we will be ignoring any animations.
-			// Only the first animation will be loaded. All other animations
-			// will be ignored.
-			//
-			// TODO: Support multiple animations.
-			if (numAnimations > 1)
-			{
-				std::cout << "WARNING: The model \"" << m_name
-					<< "\" contains multiple animations. "
-					<< "Only the first animation will be loaded." << std::endl;
-			}
+			return;
+		}
+
+		// Index the nodes by name once, rather than searching the node tree
+		// for every channel. Clips refer to nodes by their index in the
+		// flattened node tree, which has the same depth-first order.
+		std::vector<std::shared_ptr<Node>> nodes;
+		std::vector<std::int32_t> parentIndices;
+		FlattenNodeTree(m_rootNode, -1, nodes, parentIndices);
 
-			// Get the first animation.
-			const aiAnimation* assimpAnimation = assimpScene->mAnimations[0];
+		std::unordered_map<std::string, unsigned int> nodeIndicesByName;
+		nodeIndicesByName.reserve(nodes.size());
+		for (unsigned int n = 0; n < nodes.size(); ++n)
+		{
+			nodeIndicesByName.emplace(nodes[n]->GetName(), n);
+		}
+
+		// Each ASSIMP animation becomes a clip in the library.
+		m_clips.reserve(numAnimations);
+		std::vector<double> times;
+		std::vector<glm::vec3> translations;
+		std::vector<glm::quat> rotations;
+		std::vector<glm::vec3> scales;
+		for (unsigned int a = 0; a < numAnimations; ++a)
+		{
+			const aiAnimation* assimpAnimation = assimpScene->mAnimations[a];
 			assert(assimpAnimation);
 
-			// Get the animation speed.
-			const double speedInTicksPerSecond = assimpAnimation->mTicksPerSecond;
+			// Get the animation speed. ASSIMP leaves it at zero if the file
+			// does not specify it, in which case the times are in seconds.
+			const double speedInTicksPerSecond = (assimpAnimation->mTicksPerSecond > 0.0)
+				? assimpAnimation->mTicksPerSecond : 1.0;
 
-			// Record the animation duration.
-			m_animationDuration = assimpAnimation->mDuration;
+			AnimationClip clip(std::string(assimpAnimation->mName.data),
+				assimpAnimation->mDuration / speedInTicksPerSecond);
 
 			// Get the number of ASSIMP animation channels.
 			// Each animation channel describes the movement of a single node
@@ -350,207 +1441,503 @@ namespace Engine
 				// Get the ASSIMP channel.
 				const aiNodeAnim* channel = assimpAnimation->mChannels[c];
 
-				// Get the ASSIMP node that the channel affects.
-				const aiNode* targetNode = assimpScene->mRootNode->FindNode(channel->mNodeName);
-
-				// Get the name for the node.
-				const std::string targetNodeName(targetNode->mName.data);
+				// Find our node that the channel affects.
+				auto nodeIter = nodeIndicesByName.find(std::string(channel->mNodeName.data));
+				if (nodeIter == nodeIndicesByName.end())
+				{
+					std::cerr << "ERROR: The animation \"" << clip.GetName()
+						<< "\" animates the missing node \"" << channel->mNodeName.data
+						<< "\"." << std::endl;
+					continue;
+				}
 
-				// Get the number of individual keyframes for the node.
-				const unsigned int numPositionKeys = channel->mNumPositionKeys;
+				LoadChannelKeyframes(channel, speedInTicksPerSecond, times, translations, rotations, scales);
 
-				// Determine the keyframe times in "ticks" for the node.
-				// We will need to convert these times to seconds later by using
-				// the animation speed provided by ASSIMP.
-				std::set<double> keyframeTimes;
-				for (unsigned int k = 0; k < numPositionKeys; ++k)
+				// Quantize the keyframes into the clip.
+				if (!times.empty())
 				{
-					keyframeTimes.insert(channel->mPositionKeys[k].mTime);
-
-					// TODO: Check whether it is necessary to insert the
-					// keyframe times for other keys (rotation and scale).
+					clip.AddTrack(nodeIter->second, times, translations, rotations, scales);
 				}
+			}
 
-				// For each keyframe time...
-				for (auto iter = keyframeTimes.begin(); iter != keyframeTimes.end(); ++iter)
-				{
-					// Get the keyframe time (in ticks).
-					const double keyframeTimeInTicks = *iter;
+			m_clips.push_back(std::move(clip));
+		}
+	}
+
+	void Model::LoadChannelKeyframes(const aiNodeAnim* channel, double speedInTicksPerSecond,
+		std::vector<double>& times, std::vector<glm::vec3>& translations,
+		std::vector<glm::quat>& rotations, std::vector<glm::vec3>& scales)
+	{
+		times.clear();
+		translations.clear();
+		rotations.clear();
+		scales.clear();
+
+		// The position, rotation and scaling keys are each sorted by
+		// time, but need not share their times. Each index ends up at
+		// the first key after the current keyframe time.
+		unsigned int positionKeyIndex = 0;
+		unsigned int rotationKeyIndex = 0;
+		unsigned int scalingKeyIndex = 0;
+		while (true)
+		{
+			// Get the earliest keyframe time (in ticks) that has not
+			// yet been added.
+			double keyframeTimeInTicks = std::numeric_limits<double>::infinity();
+			if (positionKeyIndex < channel->mNumPositionKeys)
+			{
+				keyframeTimeInTicks = std::min(keyframeTimeInTicks, channel->mPositionKeys[positionKeyIndex].mTime);
+			}
+			if (rotationKeyIndex < channel->mNumRotationKeys)
+			{
+				keyframeTimeInTicks = std::min(keyframeTimeInTicks, channel->mRotationKeys[rotationKeyIndex].mTime);
+			}
+			if (scalingKeyIndex < channel->mNumScalingKeys)
+			{
+				keyframeTimeInTicks = std::min(keyframeTimeInTicks, channel->mScalingKeys[scalingKeyIndex].mTime);
+			}
+
+			// Stop once every key has been consumed.
+			if (keyframeTimeInTicks == std::numeric_limits<double>::infinity())
+			{
+				break;
+			}
+
+			// Step over the keys at the keyframe time.
+			while (positionKeyIndex < channel->mNumPositionKeys
+				&& channel->mPositionKeys[positionKeyIndex].mTime <= keyframeTimeInTicks)
+			{
+				++positionKeyIndex;
+			}
+			while (rotationKeyIndex < channel->mNumRotationKeys
+				&& channel->mRotationKeys[rotationKeyIndex].mTime <= keyframeTimeInTicks)
+			{
+				++rotationKeyIndex;
+			}
+			while (scalingKeyIndex < channel->mNumScalingKeys
+				&& channel->mScalingKeys[scalingKeyIndex].mTime <= keyframeTimeInTicks)
+			{
+				++scalingKeyIndex;
+			}
 
-					// Find our corresponding node.
-					std::shared_ptr<Node> node = FindNodeByName(targetNodeName);
+			// Add the keyframe.
+			times.push_back(keyframeTimeInTicks / speedInTicksPerSecond); // Convert ticks to seconds here!
+			translations.push_back(DetermineNodeLocalPositionAtTime(channel, positionKeyIndex, keyframeTimeInTicks));
+			rotations.push_back(DetermineNodeLocalRotationAtTime(channel, rotationKeyIndex, keyframeTimeInTicks));
+			scales.push_back(DetermineNodeLocalScaleAtTime(channel, scalingKeyIndex, keyframeTimeInTicks));
+		}
+	}
 
-					// Get the local position for the node at the keyframe time.
-					const glm::vec3 keyframePosition =
-						DetermineNodeLocalPositionAtTime(channel, keyframeTimeInTicks);
+	void Model::Flatten()
+	{
+		m_flatNodes.clear();
+		m_flatMeshes.clear();
+		m_paletteNodes.clear();
 
-					// Get the local rotation for the node at the keyframe time.
-					const glm::quat keyframeRotation =
-						DetermineNodeLocalRotationAtTime(channel, keyframeTimeInTicks);
+		std::vector<std::shared_ptr<Node>> nodes;
+		std::vector<std::int32_t> parentIndices;
+		if (m_rootNode)
+		{
+			FlattenNodeTree(m_rootNode, -1, nodes, parentIndices);
+		}
 
-					// Get the local scale for the node at the keyframe time.
-					const glm::vec3 keyframeScale =
-						DetermineNodeLocalScaleAtTime(channel, keyframeTimeInTicks);
+		// Find the nodes animated by any of the clips.
+		std::vector<bool> animated(nodes.size(), false);
+		for (auto clipIter = m_clips.begin(); clipIter != m_clips.end(); ++clipIter)
+		{
+			const std::vector<AnimationClip::Track>& tracks = clipIter->GetTracks();
+			for (auto iter = tracks.begin(); iter != tracks.end(); ++iter)
+			{
+				assert(iter->node < nodes.size());
+				animated[iter->node] = true;
+			}
+		}
 
-					// Build the local transformation matrix for the node.
-					const glm::mat4 localTransformationMatrix = glm::translate(keyframePosition)
-					 	* glm::toMat4(keyframeRotation)
-					 	* glm::scale(keyframeScale);
+		m_flatNodes.resize(nodes.size());
+		for (unsigned int n = 0; n < nodes.size(); ++n)
+		{
+			const Node& node = *nodes[n];
+			FlatNode& flatNode = m_flatNodes[n];
 
-					// Create our new keyframe.
-					std::shared_ptr<Node::Keyframe> keyframe = std::make_shared<Node::Keyframe>(
-						keyframeTimeInTicks / speedInTicksPerSecond, // Convert ticks to seconds here!
-						localTransformationMatrix
-					);
+			flatNode.parentIndex = parentIndices[n];
+			flatNode.firstMesh = m_flatMeshes.size();
+			flatNode.meshCount = node.GetMeshCount();
+			for (unsigned int m = 0; m < flatNode.meshCount; ++m)
+			{
+				m_flatMeshes.push_back(node.GetMesh(m));
+			}
+
+			// Only the nodes with meshes need their transformation matrices
+			// passed to the vertex shader.
+			flatNode.paletteIndex = InvalidPaletteIndex;
+			if (flatNode.meshCount > 0)
+			{
+				flatNode.paletteIndex = m_paletteNodes.size();
+				m_paletteNodes.push_back(n);
+			}
+
+			// A node is static if neither it nor any of its ancestors are
+			// animated.
+			const FlatNode* parent = (flatNode.parentIndex >= 0) ? &m_flatNodes[flatNode.parentIndex] : nullptr;
+			flatNode.isStatic = !animated[n] && (!parent || parent->isStatic);
+		}
+
+		GroupMeshes();
+		UpdateNodeTransformations();
+	}
+
+	void Model::UpdateNodeTransformations()
+	{
+		std::vector<std::shared_ptr<Node>> nodes;
+		std::vector<std::int32_t> parentIndices;
+		if (m_rootNode)
+		{
+			FlattenNodeTree(m_rootNode, -1, nodes, parentIndices);
+		}
+		assert(nodes.size() == m_flatNodes.size());
+
+		for (unsigned int n = 0; n < nodes.size(); ++n)
+		{
+			const Node& node = *nodes[n];
+			FlatNode& flatNode = m_flatNodes[n];
+
+			// The transformation matrices for the static nodes are
+			// calculated once here, rather than every frame.
+			const FlatNode* parent = (flatNode.parentIndex >= 0) ? &m_flatNodes[flatNode.parentIndex] : nullptr;
+			flatNode.animationTransformationMatrix = node.GetAnimationTransformationMatrix();
+			flatNode.transformationMatrix = (flatNode.isStatic && parent)
+				? parent->transformationMatrix * node.GetLocalBindTransformationMatrix()
+				: node.GetLocalBindTransformationMatrix();
+		}
 
-					// Add the keyframe to the node.
-					node->AddKeyframe(keyframe);
+		BakePoses();
+		CalculateBounds();
+	}
+
+	void Model::GroupMeshes()
+	{
+		for (const MaterialGroup& group : m_materialGroups)
+		{
+			GeometryBuffer::GetInstance().Free(group.allocation);
+		}
+		m_materialGroups.clear();
+
+		// Nodes are visited in palette order, so the groups of each palette
+		// are appended after those of the palette before it.
+		unsigned int firstPaletteGroup = 0;
+		for (unsigned int n = 0; n < m_flatNodes.size(); ++n)
+		{
+			const FlatNode& node = m_flatNodes[n];
+			if (node.meshCount == 0)
+			{
+				continue;
+			}
+
+			const unsigned int palette = node.paletteIndex / MaxPaletteNodes;
+			if (node.paletteIndex % MaxPaletteNodes == 0)
+			{
+				firstPaletteGroup = m_materialGroups.size();
+			}
+
+			for (unsigned int m = node.firstMesh; m < node.firstMesh + node.meshCount; ++m)
+			{
+				const Node::Mesh& mesh = *m_flatMeshes[m];
+				if (mesh.GetIndicesCount() == 0)
+				{
+					continue;
+				}
+
+				// Find the palette's group for the mesh's material.
+				unsigned int g = firstPaletteGroup;
+				while (g < m_materialGroups.size() && m_materialGroups[g].material != mesh.GetMaterial())
+				{
+					++g;
+				}
+
+				if (g == m_materialGroups.size())
+				{
+					MaterialGroup group;
+					group.material = mesh.GetMaterial();
+					group.palette = palette;
+					group.layout = VertexFormat::Layout::Compact;
+					group.vertexCount = 0;
+					group.indexCount = 0;
+					group.lodCount = 1;
+					group.indexType = GL_UNSIGNED_SHORT;
+					m_materialGroups.push_back(group);
+				}
+
+				MaterialGroup& group = m_materialGroups[g];
+				MaterialGroup::Part part;
+				part.node = n;
+				part.mesh = m;
+				group.parts.push_back(part);
+				group.vertexCount += mesh.GetVerticesCount();
+				group.lodCount = std::max(group.lodCount, mesh.GetLodCount());
+
+				// Use the wide layout if any part needs it, and 32-bit indices
+				// once the group is too large for 16-bit ones.
+				const std::vector<glm::vec3>& textureCoordinates = mesh.GetVertexTextureCoordinates();
+				if (!VertexFormat::FitsCompact(textureCoordinates.data(), textureCoordinates.size()))
+				{
+					group.layout = VertexFormat::Layout::Wide;
+				}
+				if (group.vertexCount > 65536)
+				{
+					group.indexType = GL_UNSIGNED_INT;
+				}
+			}
+		}
+
+		// Each level of detail's indices follow those of the level before
+		// it.
+		for (MaterialGroup& group : m_materialGroups)
+		{
+			group.indexCount = 0;
+			for (unsigned int l = 0; l < MaxLodCount; ++l)
+			{
+				group.lodFirstIndex[l] = group.indexCount;
+				group.lodIndexCount[l] = 0;
+				if (l >= group.lodCount)
+				{
+					continue;
+				}
+
+				for (const MaterialGroup::Part& part : group.parts)
+				{
+					const Node::Mesh& mesh = *m_flatMeshes[part.mesh];
+					group.lodIndexCount[l] += mesh.GetLodIndices(std::min(l, mesh.GetLodCount() - 1)).size();
 				}
+				group.indexCount += group.lodIndexCount[l];
 			}
 		}
 	}
 
-	glm::vec3 Model::DetermineNodeLocalPositionAtTime(const aiNodeAnim* channel,
-		double timeInTicks)
+	void Model::CalculateBounds()
 	{
-		// Get the number of position keyframes.
-		const unsigned int numPositionKeys = channel->mNumPositionKeys;
+		m_boundingBoxMinimum = glm::vec3(0.0f);
+		m_boundingBoxMaximum = glm::vec3(0.0f);
+		m_boundingSphereCenter = glm::vec3(0.0f);
+		m_boundingSphereRadius = 0.0f;
 
-		// Get the index for the position key immediately preceding or equal to
-		// the keyframe time.
-		size_t leftPositionKeyIndex = 0;
-		while (leftPositionKeyIndex < numPositionKeys - 1)
+		// Bound the vertices of each node's meshes by a box and a sphere in
+		// the node's space.
+		std::vector<glm::vec3> nodeCenters(m_flatNodes.size());
+		std::vector<glm::vec3> nodeExtents(m_flatNodes.size());
+		std::vector<float> nodeRadii(m_flatNodes.size(), -1.0f);
+		for (unsigned int n = 0; n < m_flatNodes.size(); ++n)
 		{
-			// If the next key is in the future relative to the keyframe time,
-			// then the current key either occurs exactly at the keyframe time
-			// or immediately before the keyframe time.
-			if (channel->mPositionKeys[leftPositionKeyIndex + 1].mTime > timeInTicks)
+			const FlatNode& node = m_flatNodes[n];
+			glm::vec3 minimum(std::numeric_limits<float>::max());
+			glm::vec3 maximum(-std::numeric_limits<float>::max());
+			for (unsigned int m = node.firstMesh; m < node.firstMesh + node.meshCount; ++m)
 			{
-				break;
+				for (const glm::vec3& position : m_flatMeshes[m]->GetVertexPositions())
+				{
+					minimum = glm::min(minimum, position);
+					maximum = glm::max(maximum, position);
+				}
+			}
+
+			if (minimum.x > maximum.x)
+			{
+				continue;
+			}
+
+			nodeCenters[n] = (minimum + maximum) * 0.5f;
+			nodeExtents[n] = (maximum - minimum) * 0.5f;
+			for (unsigned int m = node.firstMesh; m < node.firstMesh + node.meshCount; ++m)
+			{
+				for (const glm::vec3& position : m_flatMeshes[m]->GetVertexPositions())
+				{
+					nodeRadii[n] = std::max(nodeRadii[n], glm::length(position - nodeCenters[n]));
+				}
 			}
+		}
+
+		// Move the node bounds into the model space in every pose. The radii
+		// are scaled by the largest scale of each transformation, and the
+		// boxes are enclosed in boxes aligned with the model's axes.
+		std::vector<glm::vec3> centers;
+		std::vector<float> radii;
+		glm::vec3 boxMinimum(std::numeric_limits<float>::max());
+		glm::vec3 boxMaximum(-std::numeric_limits<float>::max());
+		for (unsigned int c = 0; c <= m_poses.size(); ++c)
+		{
+			const std::vector<glm::mat4>& frames = (c < m_poses.size()) ? m_poses[c] : m_bindPose;
+			for (std::size_t f = 0; f + m_flatNodes.size() <= frames.size(); f += m_flatNodes.size())
+			{
+				for (unsigned int n = 0; n < m_flatNodes.size(); ++n)
+				{
+					if (nodeRadii[n] < 0.0f)
+					{
+						continue;
+					}
 
-			// Move to the next index.
-			++leftPositionKeyIndex;
+					const glm::mat4& transformation = frames[f + n];
+					const float scale = std::max(glm::length(glm::vec3(transformation[0])),
+						std::max(glm::length(glm::vec3(transformation[1])), glm::length(glm::vec3(transformation[2]))));
+					const glm::vec3 center(transformation * glm::vec4(nodeCenters[n], 1.0f));
+					centers.push_back(center);
+					radii.push_back(nodeRadii[n] * scale);
+
+					const glm::vec3 extent = glm::abs(glm::vec3(transformation[0])) * nodeExtents[n].x
+						+ glm::abs(glm::vec3(transformation[1])) * nodeExtents[n].y
+						+ glm::abs(glm::vec3(transformation[2])) * nodeExtents[n].z;
+					boxMinimum = glm::min(boxMinimum, center - extent);
+					boxMaximum = glm::max(boxMaximum, center + extent);
+				}
+			}
 		}
 
-		// Check whether we need to perform linear interpolation. We don't need
-		// to interpolate if the keyframe time specified is outside of the
-		// animation timeframe or the left key index found has a time that is
-		// equal to the specified keyframe time.
-		if (leftPositionKeyIndex >= numPositionKeys - 1 ||
-			channel->mPositionKeys[leftPositionKeyIndex].mTime == timeInTicks)
+		if (centers.empty())
 		{
-			// No need to interpolate.
-			// We just output the position for the keyframe to the left.
-			return ConvertToVec3(channel->mPositionKeys[leftPositionKeyIndex].mValue);
+			return;
 		}
-		else
+
+		m_boundingBoxMinimum = boxMinimum;
+		m_boundingBoxMaximum = boxMaximum;
+
+		// Enclose all of the spheres in one, centered on their bounds.
+		glm::vec3 minimum = centers[0] - glm::vec3(radii[0]);
+		glm::vec3 maximum = centers[0] + glm::vec3(radii[0]);
+		for (unsigned int i = 1; i < centers.size(); ++i)
 		{
-			// Determine the right position key index.
-			const size_t rightPositionKeyIndex = leftPositionKeyIndex + 1;
+			minimum = glm::min(minimum, centers[i] - glm::vec3(radii[i]));
+			maximum = glm::max(maximum, centers[i] + glm::vec3(radii[i]));
+		}
 
-			// Perform linear interpolation.
-			const glm::vec3 leftValue = ConvertToVec3(channel->mPositionKeys[leftPositionKeyIndex].mValue);
-			const double leftTime = channel->mPositionKeys[leftPositionKeyIndex].mTime;
-			const glm::vec3 rightValue = ConvertToVec3(channel->mPositionKeys[rightPositionKeyIndex].mValue);
-			const double rightTime = channel->mPositionKeys[rightPositionKeyIndex].mTime;
-			return leftValue + (rightValue - leftValue) * static_cast<float>((timeInTicks - leftTime) / (rightTime - leftTime));
+		m_boundingSphereCenter = (minimum + maximum) * 0.5f;
+		for (unsigned int i = 0; i < centers.size(); ++i)
+		{
+			m_boundingSphereRadius = std::max(m_boundingSphereRadius,
+				glm::length(centers[i] - m_boundingSphereCenter) + radii[i]);
 		}
 	}
 
-	glm::quat Model::DetermineNodeLocalRotationAtTime(const aiNodeAnim* channel, double timeInTicks)
+	void Model::BakePoses()
 	{
-		// Get the number of rotation keyframes.
-		const unsigned int numRotationKeys = channel->mNumRotationKeys;
+		m_poses.clear();
+		m_bindPose.clear();
+		if (m_flatNodes.empty())
+		{
+			return;
+		}
+
+		EvaluateNodeTransformations(InvalidAnimationClip, 0.0, m_bindPose);
 
-		// Get the index for the rotation key immediately preceding or equal to
-		// the keyframe time.
-		size_t leftRotationKeyIndex = 0;
-		while (leftRotationKeyIndex < numRotationKeys - 1)
+		// Each clip runs until the last keyframe of any of its tracks.
+		std::vector<glm::mat4> transformations;
+		m_poses.resize(m_clips.size());
+		for (unsigned int c = 0; c < m_clips.size(); ++c)
 		{
-			// If the next key is in the future relative to the keyframe time,
-			// then the current key either occurs exactly at the keyframe time
-			// or immediately before the keyframe time.
-			if (channel->mRotationKeys[leftRotationKeyIndex + 1].mTime > timeInTicks)
+			const unsigned int frameCount = static_cast<unsigned int>(std::ceil(m_clips[c].GetLastKeyTime() * PoseSampleRate)) + 1;
+			m_poses[c].reserve(frameCount * m_flatNodes.size());
+			for (unsigned int f = 0; f < frameCount; ++f)
 			{
-				break;
+				EvaluateNodeTransformations(c, static_cast<double>(f) / PoseSampleRate, transformations);
+				m_poses[c].insert(m_poses[c].end(), transformations.begin(), transformations.end());
 			}
+		}
+	}
+
+	glm::vec3 Model::DetermineNodeLocalPositionAtTime(const aiNodeAnim* channel,
+		unsigned int nextKeyIndex, double timeInTicks)
+	{
+		// Get the number of position keyframes.
+		const unsigned int numPositionKeys = channel->mNumPositionKeys;
+
+		// Hold the first or last key outside of the animation timeframe.
+		if (nextKeyIndex == 0)
+		{
+			return ConvertToVec3(channel->mPositionKeys[0].mValue);
+		}
+		else if (nextKeyIndex >= numPositionKeys)
+		{
+			return ConvertToVec3(channel->mPositionKeys[numPositionKeys - 1].mValue);
+		}
 
-			// Move to the next index.
-			++leftRotationKeyIndex;
+		// We don't need to interpolate if the key to the left occurs exactly
+		// at the keyframe time.
+		const unsigned int leftPositionKeyIndex = nextKeyIndex - 1;
+		if (channel->mPositionKeys[leftPositionKeyIndex].mTime == timeInTicks)
+		{
+			return ConvertToVec3(channel->mPositionKeys[leftPositionKeyIndex].mValue);
 		}
 
-		// Check whether we need to perform linear interpolation. We don't need
-		// to interpolate if the keyframe time specified is outside of the
-		// animation timeframe or the left key index found has a time that is
-		// equal to the specified keyframe time.
-		if (leftRotationKeyIndex >= numRotationKeys - 1 ||
-			channel->mRotationKeys[leftRotationKeyIndex].mTime == timeInTicks)
+		// Perform linear interpolation.
+		const glm::vec3 leftValue = ConvertToVec3(channel->mPositionKeys[leftPositionKeyIndex].mValue);
+		const double leftTime = channel->mPositionKeys[leftPositionKeyIndex].mTime;
+		const glm::vec3 rightValue = ConvertToVec3(channel->mPositionKeys[nextKeyIndex].mValue);
+		const double rightTime = channel->mPositionKeys[nextKeyIndex].mTime;
+		const double interpolationFactor = (timeInTicks - leftTime) / (rightTime - leftTime);
+		return leftValue + (rightValue - leftValue) * static_cast<float>(interpolationFactor);
+	}
+
+	glm::quat Model::DetermineNodeLocalRotationAtTime(const aiNodeAnim* channel,
+		unsigned int nextKeyIndex, double timeInTicks)
+	{
+		// Get the number of rotation keyframes.
+		const unsigned int numRotationKeys = channel->mNumRotationKeys;
+
+		// Hold the first or last key outside of the animation timeframe.
+		if (nextKeyIndex == 0)
 		{
-			// No need to interpolate.
-			// We just output the rotation for the keyframe to the left.
-			return ConvertToQuat(channel->mRotationKeys[leftRotationKeyIndex].mValue);
+			return ConvertToQuat(channel->mRotationKeys[0].mValue);
 		}
-		else
+		else if (nextKeyIndex >= numRotationKeys)
 		{
-			// Determine the right rotation key index.
-			const size_t rightRotationKeyIndex = leftRotationKeyIndex + 1;
+			return ConvertToQuat(channel->mRotationKeys[numRotationKeys - 1].mValue);
+		}
 
-			// Perform linear interpolation.
-			const glm::quat leftValue = ConvertToQuat(channel->mRotationKeys[leftRotationKeyIndex].mValue);
-			const double leftTime = channel->mRotationKeys[leftRotationKeyIndex].mTime;
-			const glm::quat rightValue = ConvertToQuat(channel->mRotationKeys[rightRotationKeyIndex].mValue);
-			const double rightTime = channel->mRotationKeys[rightRotationKeyIndex].mTime;
-			const double interpolationFactor = (timeInTicks - leftTime) / (rightTime - leftTime);
-			return glm::mix(leftValue, rightValue, (float) interpolationFactor);
+		// We don't need to interpolate if the key to the left occurs exactly
+		// at the keyframe time.
+		const unsigned int leftRotationKeyIndex = nextKeyIndex - 1;
+		if (channel->mRotationKeys[leftRotationKeyIndex].mTime == timeInTicks)
+		{
+			return ConvertToQuat(channel->mRotationKeys[leftRotationKeyIndex].mValue);
 		}
+
+		// Perform linear interpolation.
+		const glm::quat leftValue = ConvertToQuat(channel->mRotationKeys[leftRotationKeyIndex].mValue);
+		const double leftTime = channel->mRotationKeys[leftRotationKeyIndex].mTime;
+		const glm::quat rightValue = ConvertToQuat(channel->mRotationKeys[nextKeyIndex].mValue);
+		const double rightTime = channel->mRotationKeys[nextKeyIndex].mTime;
+		const double interpolationFactor = (timeInTicks - leftTime) / (rightTime - leftTime);
+		return glm::mix(leftValue, rightValue, static_cast<float>(interpolationFactor));
 	}
 
-	glm::vec3 Model::DetermineNodeLocalScaleAtTime(const aiNodeAnim* channel, double timeInTicks)
+	glm::vec3 Model::DetermineNodeLocalScaleAtTime(const aiNodeAnim* channel,
+		unsigned int nextKeyIndex, double timeInTicks)
 	{
 		// Get the number of scaling keyframes.
 		const unsigned int numScalingKeys = channel->mNumScalingKeys;
 
-		// Get the index for the scaling key immediately preceding or equal to
-		// the keyframe time.
-		size_t leftScalingKeyIndex = 0;
-		while (leftScalingKeyIndex < numScalingKeys - 1)
+		// Hold the first or last key outside of the animation timeframe.
+		if (nextKeyIndex == 0)
 		{
-			// If the next key is in the future relative to the keyframe time,
-			// then the current key either occurs exactly at the keyframe time
-			// or immediately before the keyframe time.
-			if (channel->mScalingKeys[leftScalingKeyIndex + 1].mTime > timeInTicks)
-			{
-				break;
-			}
-
-			// Move to the next index.
-			++leftScalingKeyIndex;
+			return ConvertToVec3(channel->mScalingKeys[0].mValue);
+		}
+		else if (nextKeyIndex >= numScalingKeys)
+		{
+			return ConvertToVec3(channel->mScalingKeys[numScalingKeys - 1].mValue);
 		}
 
-		// Check whether we need to perform linear interpolation. We don't need
-		// to interpolate if the keyframe time specified is outside of the
-		// animation timeframe or the left key index found has a time that is
-		// equal to the specified keyframe time.
-		if (leftScalingKeyIndex >= numScalingKeys - 1 ||
-			channel->mScalingKeys[leftScalingKeyIndex].mTime == timeInTicks)
+		// We don't need to interpolate if the key to the left occurs exactly
+		// at the keyframe time.
+		const unsigned int leftScalingKeyIndex = nextKeyIndex - 1;
+		if (channel->mScalingKeys[leftScalingKeyIndex].mTime == timeInTicks)
 		{
-			// No need to interpolate.
-			// We just output the scale for the keyframe to the left.
 			return ConvertToVec3(channel->mScalingKeys[leftScalingKeyIndex].mValue);
 		}
-		else
-		{
-			// Determine the right position key index.
-			const size_t rightScalingKeyIndex = leftScalingKeyIndex + 1;
 
-			// Perform linear interpolation.
-			const glm::vec3 leftValue = ConvertToVec3(channel->mScalingKeys[leftScalingKeyIndex].mValue);
-			const double leftTime = channel->mScalingKeys[leftScalingKeyIndex].mTime;
-			const glm::vec3 rightValue = ConvertToVec3(channel->mScalingKeys[rightScalingKeyIndex].mValue);
-			const double rightTime = channel->mScalingKeys[rightScalingKeyIndex].mTime;
-			return leftValue + (rightValue - leftValue) * static_cast<float>((timeInTicks - leftTime) / (rightTime - leftTime));
-		}
+		// Perform linear interpolation.
+		const glm::vec3 leftValue = ConvertToVec3(channel->mScalingKeys[leftScalingKeyIndex].mValue);
+		const double leftTime = channel->mScalingKeys[leftScalingKeyIndex].mTime;
+		const glm::vec3 rightValue = ConvertToVec3(channel->mScalingKeys[nextKeyIndex].mValue);
+		const double rightTime = channel->mScalingKeys[nextKeyIndex].mTime;
+		const double interpolationFactor = (timeInTicks - leftTime) / (rightTime - leftTime);
+		return leftValue + (rightValue - leftValue) * static_cast<float>(interpolationFactor);
 	}
 
 	glm::mat4 Model::ConvertToMat4(const aiMatrix4x4& assimpMatrix)
@@ -585,7 +1972,7 @@ namespace Engine
 	Model::Node::Node(std::string name, const glm::mat4& bindTransformationMatrix)
 	: m_name(name)
 	, m_bindTransformationMatrix(bindTransformationMatrix)
-	, m_keyframes()
+	, m_animationTransformationMatrix()
 	, m_children()
 	, m_meshes()
 	{
@@ -647,32 +2034,9 @@ namespace Engine
 		return m_bindTransformationMatrix;
 	}
 
-	// TODO: Perform linear interpolation
-	const glm::mat4 Model::Node::GetLocalTransformationMatrix(double time) const
+	const glm::mat4& Model::Node::GetAnimationTransformationMatrix() const
 	{
-		// If we have no animations, just return the local bind pose
-		// transformation matrix.
-		if (m_keyframes.size() <= 0)
-		{
-			return GetLocalBindTransformationMatrix();
-		}
-		else
-		{
-			// Find the nearest keyframe.
-			for (unsigned int k = 0; k < m_keyframes.size() - 1; ++k)
-			{
-				if (m_keyframes[k + 1]->GetTime() > time)
-				{
-					// Return the local transformation matrix for the node
-					// at this nearest keyframe.
-					return m_keyframes[k]->GetLocalTransformationMatrix();
-				}
-			}
-
-			// Out of range - return the transformation matrix for the last
-			// keyframe.
-			return m_keyframes[m_keyframes.size() - 1]->GetLocalTransformationMatrix();
-		}
+		return m_animationTransformationMatrix;
 	}
 
 	void Model::Node::Transform(const glm::mat4& transform)
@@ -680,16 +2044,10 @@ namespace Engine
 		// Transform the bind pose.
 		m_bindTransformationMatrix = transform * m_bindTransformationMatrix;
 
-		// Transform any keyframes.
-		for (std::shared_ptr<Model::Node::Keyframe> keyframe : m_keyframes)
-		{
-			keyframe->Transform(transform);
-		}
-	}
-
-	void Model::Node::AddKeyframe(std::shared_ptr<Model::Node::Keyframe> keyframe)
-	{
-		m_keyframes.push_back(keyframe);
+		// Transform the animation. The transformation is applied after
+		// interpolating, since it may not be representable as a translation,
+		// rotation and scale.
+		m_animationTransformationMatrix = transform * m_animationTransformationMatrix;
 	}
 
 	void Model::Node::AddMesh(std::shared_ptr<Model::Node::Mesh> mesh)
@@ -702,132 +2060,124 @@ namespace Engine
 		m_children.push_back(node);
 	}
 
-	Model::Node::Keyframe::Keyframe(double time, const glm::mat4& transformationMatrix)
-	: m_time(time)
-	, m_transformationMatrix(transformationMatrix)
+	Model::Node::Mesh::Mesh()
+	: m_material(nullptr)
+	, m_positions()
+	, m_normals()
+	, m_textureCoordinates()
+	, m_indices()
+	, m_lodIndices()
 	{
 		// Nothing to do.
+		// Note: The vertex data is uploaded with the model's material groups
+		// so that meshes can be built on threads without an OpenGL context.
 	}
 
-	Model::Node::Keyframe::~Keyframe()
+	Model::Node::Mesh::~Mesh()
 	{
 		// Nothing to do.
 	}
 
-	double Model::Node::Keyframe::GetTime() const
+	unsigned int Model::Node::Mesh::GetIndicesCount() const
 	{
-		return m_time;
+		return m_indices.size();
 	}
 
-	const glm::mat4& Model::Node::Keyframe::GetLocalTransformationMatrix() const
+	unsigned int Model::Node::Mesh::GetVerticesCount() const
 	{
-		return m_transformationMatrix;
+		return m_positions.size();
 	}
 
-	void Model::Node::Keyframe::Transform(const glm::mat4& transform)
+	std::size_t Model::Node::Mesh::GetCPUMemoryUsage() const
 	{
-		m_transformationMatrix = transform * m_transformationMatrix;
+		std::size_t bytes = m_positions.size() * sizeof(glm::vec3)
+			+ m_normals.size() * sizeof(glm::vec3)
+			+ m_textureCoordinates.size() * sizeof(glm::vec3)
+			+ m_indices.size() * sizeof(unsigned int);
+		for (const std::vector<unsigned int>& indices : m_lodIndices)
+		{
+			bytes += indices.size() * sizeof(unsigned int);
+		}
+
+		return bytes;
 	}
 
-	Model::Node::Mesh::Mesh()
-	: m_material(nullptr)
-	, m_positions()
-	, m_normals()
-	, m_textureCoordinates()
-	, m_indices()
-	, m_positionVBO(0)
-	, m_normalVBO(0)
-	, m_textureCoordinatesVBO(0)
-	, m_indexVBO(0)
-	, m_VAO(0)
+	std::size_t Model::Node::Mesh::GetVertexBufferSize() const
 	{
-		// Generate VBOs.
-		glGenBuffers(1, &m_positionVBO);
-		glGenBuffers(1, &m_normalVBO);
-		glGenBuffers(1, &m_textureCoordinatesVBO);
-		glGenBuffers(1, &m_indexVBO);
-
-		// Check VBOs were generated successfully.
-		assert(m_positionVBO > 0);
-		assert(m_normalVBO > 0);
-		assert(m_textureCoordinatesVBO > 0);
-		assert(m_indexVBO > 0);
+		const bool wideVertices = !VertexFormat::FitsCompact(m_textureCoordinates.data(), m_textureCoordinates.size());
+		return m_positions.size() * (wideVertices ? sizeof(VertexFormat::Wide) : sizeof(VertexFormat::Compact));
 	}
 
-	Model::Node::Mesh::~Mesh()
+	std::size_t Model::Node::Mesh::GetIndexBufferSize() const
 	{
-		// Delete the VBOs.
-		glDeleteBuffers(1, &m_positionVBO);
-		glDeleteBuffers(1, &m_normalVBO);
-		glDeleteBuffers(1, &m_textureCoordinatesVBO);
-		glDeleteBuffers(1, &m_indexVBO);
+		std::size_t indexCount = m_indices.size();
+		for (const std::vector<unsigned int>& indices : m_lodIndices)
+		{
+			indexCount += indices.size();
+		}
+
+		return indexCount * ((m_positions.size() <= 65536) ? sizeof(std::uint16_t) : sizeof(unsigned int));
 	}
 
-	void Model::Node::Mesh::UpdateBuffers() const
+	unsigned int Model::Node::Mesh::GetLodCount() const
 	{
-		// Send the vertex position data to the corresponding VBO.
-		glBindBuffer(GL_ARRAY_BUFFER, m_positionVBO);
-		glBufferData(
-			GL_ARRAY_BUFFER,
-			sizeof(glm::vec3) * m_positions.size(),
-			&m_positions[0],
-			GL_STATIC_DRAW
-		);
+		return 1 + m_lodIndices.size();
+	}
 
-		// Set the vertex position data to be the first attribute
-		// passed to the shader (index 0).
-		glEnableVertexAttribArray(0);
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, 0);
-
-		// Send the vertex normal data to the corresponding VBO.
-		glBindBuffer(GL_ARRAY_BUFFER, m_normalVBO);
-		glBufferData(
-			GL_ARRAY_BUFFER,
-			sizeof(glm::vec3) * m_normals.size(),
-			&m_normals[0],
-			GL_STATIC_DRAW
-		);
+	const std::vector<unsigned int>& Model::Node::Mesh::GetLodIndices(unsigned int lod) const
+	{
+		assert(lod < GetLodCount());
+		return (lod == 0) ? m_indices : m_lodIndices[lod - 1];
+	}
 
-		// Set the vertex normal data to be the second attribute
-		// passed to the shader (index 1).
-		glEnableVertexAttribArray(1);
-		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, 0);
-
-		// Send the vertex texture coordinates data to the corresponding VBO.
-		glBindBuffer(GL_ARRAY_BUFFER, m_textureCoordinatesVBO);
-		glBufferData(
-			GL_ARRAY_BUFFER,
-			sizeof(glm::vec3) * m_textureCoordinates.size(),
-			&m_textureCoordinates[0],
-			GL_STATIC_DRAW
-		);
+	void Model::Node::Mesh::Optimize()
+	{
+		std::vector<unsigned int> indices = MeshOptimizer::OptimizeVertexCache(m_indices, m_positions.size());
+		indices = MeshOptimizer::OptimizeOverdraw(m_positions, indices, OverdrawThreshold);
 
-		// Set the vertex texture coordinates data to be the fourth attribute
-		// passed to the shader (index 3).
-		glEnableVertexAttribArray(3);
-		glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, 0, 0);
-
-		// Send the vertex indices to the corresponding VBO.
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexVBO);
-		glBufferData(
-			GL_ELEMENT_ARRAY_BUFFER,
-			sizeof(unsigned int) * m_indices.size(),
-			&m_indices[0],
-			GL_STATIC_DRAW
-		);
+		const std::vector<unsigned int> remap = MeshOptimizer::GenerateVertexFetchRemap(indices, m_positions.size());
+		RemapVertices(m_positions, remap);
+		RemapVertices(m_normals, remap);
+		RemapVertices(m_textureCoordinates, remap);
+		for (unsigned int& index : indices)
+		{
+			index = remap[index];
+		}
 
-		// Unbind the last buffer.
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		m_indices = std::move(indices);
+		m_lodIndices.clear();
 	}
 
-	unsigned int Model::Node::Mesh::GetIndicesCount() const
+	void Model::Node::Mesh::GenerateLods()
 	{
-		return m_indices.size();
+		m_lodIndices.clear();
+		if (m_indices.size() < MinLodTriangleCount * 3)
+		{
+			return;
+		}
+
+		// Halve the triangles of the previous level, keeping the level only
+		// if it is a worthwhile reduction.
+		const std::vector<unsigned int>* previous = &m_indices;
+		while (m_lodIndices.size() + 1 < MaxLodCount)
+		{
+			const std::size_t targetIndexCount = previous->size() / 6 * 3;
+			std::vector<unsigned int> indices = MeshSimplifier::Simplify(m_positions, *previous, targetIndexCount);
+			if (indices.empty() || indices.size() > previous->size() * MaxLodIndexRatio)
+			{
+				break;
+			}
+			indices = MeshOptimizer::OptimizeVertexCache(indices, m_positions.size());
+
+			m_lodIndices.push_back(std::move(indices));
+			previous = &m_lodIndices.back();
+		}
 	}
 
-	unsigned int Model::Node::Mesh::GetVerticesCount() const
+	void Model::Node::Mesh::SetLodIndices(std::vector<std::vector<unsigned int>> lodIndices)
 	{
-		return m_positions.size();
+		assert(lodIndices.size() < MaxLodCount);
+		m_lodIndices = std::move(lodIndices);
 	}
 
 	std::shared_ptr<Model::Material> Model::Node::Mesh::GetMaterial() const
@@ -865,41 +2215,36 @@ namespace Engine
 		return m_positions[index];
 	}
 
-	GLuint Model::Node::Mesh::GetVAO()
+	const std::vector<glm::vec3>& Model::Node::Mesh::GetVertexPositions() const
 	{
-		// Check whether we need to create the VAO.
-		if (m_VAO <= 0)
-		{
-			// Generate the VAO.
-			glGenVertexArrays(1, &m_VAO);
-			assert(m_VAO > 0);
-
-			// Bind the VAO.
-			glBindVertexArray(m_VAO);
-
-			// Bind the positions VBO to the VAO.
-			glBindBuffer(GL_ARRAY_BUFFER, m_positionVBO);
-			glEnableVertexAttribArray(0);
-			glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, 0);
-
-			// Bind the normals VBO to the VAO.
-			glBindBuffer(GL_ARRAY_BUFFER, m_normalVBO);
-			glEnableVertexAttribArray(1);
-			glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, 0);
+		return m_positions;
+	}
 
-			// Bind the texture coordinates VBO to the VAO.
-			glBindBuffer(GL_ARRAY_BUFFER, m_textureCoordinatesVBO);
-			glEnableVertexAttribArray(3);
-			glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, 0, 0);
+	const std::vector<glm::vec3>& Model::Node::Mesh::GetVertexNormals() const
+	{
+		return m_normals;
+	}
 
-			// Bind the indices VBO to the VAO.
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexVBO);
+	const std::vector<glm::vec3>& Model::Node::Mesh::GetVertexTextureCoordinates() const
+	{
+		return m_textureCoordinates;
+	}
 
-			// Unbind the VAO.
-			glBindVertexArray(0);
-		}
+	const std::vector<unsigned int>& Model::Node::Mesh::GetVertexIndices() const
+	{
+		return m_indices;
+	}
 
-		return m_VAO;
+	void Model::Node::Mesh::SetVertexData(std::vector<glm::vec3> positions,
+		std::vector<glm::vec3> normals,
+		std::vector<glm::vec3> textureCoordinates,
+		std::vector<unsigned int> indices)
+	{
+		m_positions = std::move(positions);
+		m_normals = std::move(normals);
+		m_textureCoordinates = std::move(textureCoordinates);
+		m_indices = std::move(indices);
+		m_lodIndices.clear();
 	}
 
 	Model::Material::Material()
@@ -910,6 +2255,7 @@ namespace Engine
 	, m_emissiveColor(glm::vec3(0.0f, 0.0f, 0.0f))
 	, m_shininess(0.0f)
 	, m_diffuseTexturePath("")
+	, m_diffuseTexture()
 	{
 		// Nothing to do.
 	}
@@ -924,6 +2270,11 @@ namespace Engine
 		m_name = name;
 	}
 
+	std::string Model::Material::GetName() const
+	{
+		return m_name;
+	}
+
 	const glm::vec3& Model::Material::GetDiffuseColor() const
 	{
 		return m_diffuseColor;
@@ -983,4 +2334,14 @@ namespace Engine
 	{
 		m_diffuseTexturePath = diffuseTexturePath;
 	}
+
+	ResourceHandle<Texture> Model::Material::GetDiffuseTexture() const
+	{
+		return m_diffuseTexture;
+	}
+
+	void Model::Material::SetDiffuseTexture(ResourceHandle<Texture> diffuseTexture)
+	{
+		m_diffuseTexture = diffuseTexture;
+	}
 }
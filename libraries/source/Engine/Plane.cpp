@@ -37,6 +37,21 @@ namespace Engine
 		// Nothing to do.
 	}
 
+	const glm::vec3& Plane::GetNormal() const
+	{
+		return m_normal;
+	}
+
+	float Plane::GetDistance() const
+	{
+		return m_distance;
+	}
+
+	float Plane::GetSignedDistance(const glm::vec3& point) const
+	{
+		return glm::dot(point, m_normal) - m_distance;
+	}
+
 	bool Plane::Raycast(const Ray& ray, float& outIntersectionDistance) const
 	{
 		const float dot = glm::dot(ray.GetDirection(), m_normal);
@@ -0,0 +1,110 @@
+#include <Engine/RangeAllocator.hpp>
+
+#include <cassert>
+#include <iterator>
+
+namespace Engine
+{
+	RangeAllocator::RangeAllocator(std::size_t capacity)
+	: m_capacity(capacity)
+	, m_freeSize(capacity)
+	, m_freeRanges()
+	{
+		if (capacity > 0)
+		{
+			m_freeRanges[0] = capacity;
+		}
+	}
+
+	RangeAllocator::~RangeAllocator()
+	{
+		// Nothing to do.
+	}
+
+	bool RangeAllocator::Allocate(std::size_t size, std::size_t alignment, std::size_t& offset)
+	{
+		assert(size > 0);
+		assert(alignment > 0);
+
+		for (auto iter = m_freeRanges.begin(); iter != m_freeRanges.end(); ++iter)
+		{
+			const std::size_t rangeOffset = iter->first;
+			const std::size_t rangeSize = iter->second;
+
+			// Skip ahead to the first aligned offset in the free range.
+			const std::size_t alignedOffset = (rangeOffset + alignment - 1) / alignment * alignment;
+			const std::size_t padding = alignedOffset - rangeOffset;
+			if (padding >= rangeSize || rangeSize - padding < size)
+			{
+				continue;
+			}
+
+			// Split the free range around the allocation. The padding before
+			// the allocation stays free.
+			m_freeRanges.erase(iter);
+			if (padding > 0)
+			{
+				m_freeRanges[rangeOffset] = padding;
+			}
+			if (rangeSize - padding > size)
+			{
+				m_freeRanges[alignedOffset + size] = rangeSize - padding - size;
+			}
+
+			m_freeSize -= size;
+			offset = alignedOffset;
+			return true;
+		}
+
+		return false;
+	}
+
+	void RangeAllocator::Free(std::size_t offset, std::size_t size)
+	{
+		assert(size > 0);
+		assert(offset + size <= m_capacity);
+
+		std::size_t freeOffset = offset;
+		std::size_t freeSize = size;
+
+		// Merge with the following free range.
+		auto next = m_freeRanges.lower_bound(offset);
+		assert(next == m_freeRanges.end() || next->first >= offset + size);
+		if (next != m_freeRanges.end() && next->first == offset + size)
+		{
+			freeSize += next->second;
+			next = m_freeRanges.erase(next);
+		}
+
+		// Merge with the preceding free range.
+		if (next != m_freeRanges.begin())
+		{
+			auto previous = std::prev(next);
+			assert(previous->first + previous->second <= offset);
+			if (previous->first + previous->second == offset)
+			{
+				freeOffset = previous->first;
+				freeSize += previous->second;
+				m_freeRanges.erase(previous);
+			}
+		}
+
+		m_freeRanges[freeOffset] = freeSize;
+		m_freeSize += size;
+	}
+
+	std::size_t RangeAllocator::GetCapacity() const
+	{
+		return m_capacity;
+	}
+
+	std::size_t RangeAllocator::GetFreeSize() const
+	{
+		return m_freeSize;
+	}
+
+	std::size_t RangeAllocator::GetFreeRangeCount() const
+	{
+		return m_freeRanges.size();
+	}
+}
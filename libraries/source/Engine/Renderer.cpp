@@ -3,6 +3,9 @@
 #include <iostream>
 #include <memory>
 #include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/transform.hpp>
@@ -12,21 +15,148 @@
 #include <Engine/Attribute/OrthographicCamera.hpp>
 #include <Engine/Attribute/Model.hpp>
 #include <Engine/Attribute/DirectionalLight.hpp>
+#include <Engine/RadixSort.hpp>
 
 namespace Engine
 {
+	namespace
+	{
+		/**
+		 * Smallest fraction of the viewport height covered by a model's
+		 * bounding sphere for each level of detail to be drawn. Models
+		 * smaller than the last size are drawn at the lowest level of detail.
+		 */
+		const float LodScreenSizes[Model::MaxLodCount - 1] = {0.25f, 0.1f};
+
+		/**
+		 * Returns the largest scale that a transformation matrix applies
+		 * along any of its axes.
+		 *
+		 * @param matrix The transformation matrix.
+		 * @return Largest scale.
+		 */
+		float GetMaxScale(const glm::mat4& matrix)
+		{
+			return std::max(glm::length(glm::vec3(matrix[0])),
+				std::max(glm::length(glm::vec3(matrix[1])), glm::length(glm::vec3(matrix[2]))));
+		}
+
+		/**
+		 * Makes a vertex attribute advance once per instance rather than
+		 * once per vertex, through OpenGL 3.3 or ARB_instanced_arrays.
+		 *
+		 * @param location Attribute location.
+		 */
+		void SetInstanceDivisor(GLuint location)
+		{
+			if (GLEW_VERSION_3_3)
+			{
+				glVertexAttribDivisor(location, 1);
+			}
+			else
+			{
+				glVertexAttribDivisorARB(location, 1);
+			}
+		}
+
+		/**
+		 * Render pass that every model is currently drawn in. Passes are the
+		 * most significant part of the render key, so that later passes,
+		 * such as transparent ones, can be drawn after the opaque pass.
+		 */
+		const unsigned int OpaquePass = 0;
+
+		/**
+		 * Number of bits in each part of a render key, from the most to the
+		 * least significant. The level of detail and pose sit above the
+		 * depth, because items are only drawn together when they share both.
+		 */
+		const unsigned int PassBits = 2;
+		const unsigned int ShaderBits = 12;
+		const unsigned int TextureBits = 12;
+		const unsigned int ModelBits = 12;
+		const unsigned int LodBits = 2;
+		const unsigned int ClipBits = 3;
+		const unsigned int FrameBits = 10;
+		const unsigned int DepthBits = 11;
+		static_assert(PassBits + ShaderBits + TextureBits + ModelBits + LodBits + ClipBits + FrameBits + DepthBits == 64,
+			"Render keys must use every bit of a 64-bit key");
+		static_assert(Model::MaxLodCount <= (1u << LodBits), "Every level of detail must fit the render key");
+
+		/**
+		 * Packs the state that a render item is drawn with into a key, such
+		 * that sorting the keys groups items by state. Resource indices,
+		 * clips and frames that do not fit their bits share keys with others,
+		 * which only makes the grouping less effective.
+		 *
+		 * @param pass Render pass.
+		 * @param shader Index of the shader program resource.
+		 * @param texture Index of the texture resource plus one, or zero for
+		 * no texture.
+		 * @param model Index of the model resource.
+		 * @param lod Level of detail.
+		 * @param clip Index of the animation clip, or @see
+		 * Model::InvalidAnimationClip for the bind pose.
+		 * @param frame Frame of the animation clip in the pose cache.
+		 * @param depth Depth of the item, between zero at the near plane and
+		 * one at the far plane.
+		 * @return Render key.
+		 */
+		std::uint64_t MakeRenderKey(unsigned int pass, unsigned int shader, unsigned int texture,
+			unsigned int model, unsigned int lod, unsigned int clip, unsigned int frame, float depth)
+		{
+			const std::uint64_t depthMask = (1ull << DepthBits) - 1;
+			const std::uint64_t quantizedDepth = static_cast<std::uint64_t>(
+				std::min(std::max(depth, 0.0f), 1.0f) * static_cast<float>(depthMask));
+
+			// The bind pose sorts before the clips.
+			const unsigned int clipSlot = (clip == Model::InvalidAnimationClip) ? 0 : clip + 1;
+
+			std::uint64_t key = pass & ((1u << PassBits) - 1);
+			key = (key << ShaderBits) | (shader & ((1u << ShaderBits) - 1));
+			key = (key << TextureBits) | (texture & ((1u << TextureBits) - 1));
+			key = (key << ModelBits) | (model & ((1u << ModelBits) - 1));
+			key = (key << LodBits) | (lod & ((1u << LodBits) - 1));
+			key = (key << ClipBits) | (clipSlot & ((1u << ClipBits) - 1));
+			key = (key << FrameBits) | (frame & ((1u << FrameBits) - 1));
+			key = (key << DepthBits) | std::min(quantizedDepth, depthMask);
+			return key;
+		}
+	}
+
 	Renderer::Renderer(std::shared_ptr<ResourceManager> resourceManager)
 	: m_resourceManager(resourceManager)
 	, m_renderList()
+	, m_sortScratch()
+	, m_renderBatches()
+	, m_instanceData()
+	, m_instanceBuffer(0)
+	, m_frameUniformBuffer(0)
+	, m_directionalLight()
 	, m_currentShaderProgram(nullptr)
+	, m_uniforms()
+	, m_currentGeometryPage(GeometryBuffer::InvalidPage)
 	, m_drawCount(0)
+	, m_vertexArrayBindCount(0)
+	, m_triangleCount(0)
+	, m_culledObjectCount(0)
+	, m_drawnObjectCount(0)
+	, m_nodePalette(Model::MaxPaletteNodes)
 	{
 		// Nothing to do.
 	}
 
 	Renderer::~Renderer()
 	{
-		// Nothing to do.
+		if (m_instanceBuffer != 0)
+		{
+			glDeleteBuffers(1, &m_instanceBuffer);
+		}
+
+		if (m_frameUniformBuffer != 0)
+		{
+			glDeleteBuffers(1, &m_frameUniformBuffer);
+		}
 	}
 
 	unsigned int Renderer::GetDrawCount() const
@@ -34,11 +164,78 @@ namespace Engine
 		return m_drawCount;
 	}
 
+	unsigned int Renderer::GetVertexArrayBindCount() const
+	{
+		return m_vertexArrayBindCount;
+	}
+
+	unsigned int Renderer::GetTriangleCount() const
+	{
+		return m_triangleCount;
+	}
+
+	unsigned int Renderer::GetCulledObjectCount() const
+	{
+		return m_culledObjectCount;
+	}
+
+	unsigned int Renderer::GetDrawnObjectCount() const
+	{
+		return m_drawnObjectCount;
+	}
+
+	bool Renderer::IsVisible(const Model& model, const glm::mat4& modelMatrix, const Frustum& frustum)
+	{
+		// Try the bounding sphere first, as it is the cheapest to move into
+		// the world space.
+		const glm::vec3 center(modelMatrix * glm::vec4(model.GetBoundingSphereCenter(), 1.0f));
+		if (!frustum.IntersectsSphere(center, model.GetBoundingSphereRadius() * GetMaxScale(modelMatrix)))
+		{
+			return false;
+		}
+
+		// Enclose the bounding box in a box aligned with the world axes.
+		const glm::vec3 boxCenter(modelMatrix * glm::vec4((model.GetBoundingBoxMinimum() + model.GetBoundingBoxMaximum()) * 0.5f, 1.0f));
+		const glm::vec3 boxExtent = (model.GetBoundingBoxMaximum() - model.GetBoundingBoxMinimum()) * 0.5f;
+		const glm::vec3 extent = glm::abs(glm::vec3(modelMatrix[0])) * boxExtent.x
+			+ glm::abs(glm::vec3(modelMatrix[1])) * boxExtent.y
+			+ glm::abs(glm::vec3(modelMatrix[2])) * boxExtent.z;
+		return frustum.IntersectsBox(boxCenter - extent, boxCenter + extent);
+	}
+
+	unsigned int Renderer::SelectLod(const Model& model,
+		const glm::mat4& modelMatrix,
+		const glm::mat4& viewMatrix,
+		const glm::mat4& projectionMatrix)
+	{
+		// Scale the radius by the largest scale of the model matrix.
+		const float radius = model.GetBoundingSphereRadius() * GetMaxScale(modelMatrix);
+
+		// The projected diameter spans 2 * radius * projectionMatrix[1][1] / w
+		// of the viewport's height of 2 in normalized device coordinates. The
+		// w of an orthographic projection is always one.
+		const glm::vec4 center = projectionMatrix * viewMatrix * modelMatrix
+			* glm::vec4(model.GetBoundingSphereCenter(), 1.0f);
+		const float screenSize = radius * std::abs(projectionMatrix[1][1]) / std::max(std::abs(center.w), 1e-6f);
+
+		unsigned int lod = 0;
+		while (lod < Model::MaxLodCount - 1 && screenSize < LodScreenSizes[lod])
+		{
+			++lod;
+		}
+
+		return lod;
+	}
+
 	void Renderer::Render(std::map<GameObject::ID, std::shared_ptr<GameObject>>& gameObjects,
 		std::shared_ptr<GameObject> cameraGameObject)
 	{
-		// Reset the draw counter.
+		// Reset the draw counters.
 		m_drawCount = 0;
+		m_vertexArrayBindCount = 0;
+		m_triangleCount = 0;
+		m_culledObjectCount = 0;
+		m_drawnObjectCount = 0;
 
 		// We cannot render without a valid camera.
 		assert (!cameraGameObject->IsDead()
@@ -60,19 +257,12 @@ namespace Engine
 		// This is simply the inverse of the camera's transformation matrix.
 		const glm::mat4 viewMatrix = glm::inverse(cameraTransform->GetTransformationMatrix());
 
-		// Construct a list of directional lights.
-		std::vector<std::shared_ptr<GameObject>> directionalLights;
-		for (auto iter = gameObjects.begin(); iter != gameObjects.end(); ++iter)
-		{
-			std::shared_ptr<GameObject> gameObject = iter->second;
+		// Determine the volume of the world that the camera can see.
+		const Frustum frustum(projectionMatrix * viewMatrix);
 
-			if (!gameObject->IsDead() &&
-				gameObject->HasAttribute<Attribute::Transform>() &&
-				gameObject->HasAttribute<Attribute::DirectionalLight>())
-			{
-				directionalLights.push_back(gameObject);
-			}
-		}
+		// Pass the camera, time and lighting to every shader program at
+		// once.
+		UploadFrameUniforms(projectionMatrix, viewMatrix, FindDirectionalLight(gameObjects));
 
 		// Clear the render list from the previous execution.
 		m_renderList.clear();
@@ -81,55 +271,56 @@ namespace Engine
 		for (auto iter = gameObjects.begin(); iter != gameObjects.end(); ++iter)
 		{
 			std::shared_ptr<GameObject> gameObject = iter->second;
-			PopulateRenderList(gameObject);
+			PopulateRenderList(gameObject, projectionMatrix, viewMatrix, frustum);
 		}
 
-		// Sort the render list by shader program.
-		// Has complexity O(n*log(n)).
-		std::sort(m_renderList.begin(), m_renderList.end(),
-			[this] (std::shared_ptr<GameObject> one, std::shared_ptr<GameObject> two)
+		// Sort the render list by key, which orders the items by pass, then
+		// shader program, texture and model, and finally front to back.
+		// Has complexity O(n).
+		RadixSort(m_renderList, m_sortScratch);
+
+		// Group the items that can be drawn with one instanced draw call.
+		BuildRenderBatches();
+
+		// Render each batch. Items that use the same shader program are next
+		// to each other, so each shader program is switched to once.
+		for (const RenderBatch& batch : m_renderBatches)
+		{
+			const RenderItem& item = m_renderList[batch.firstItem];
+			if (item.shaderProgram != m_currentShaderProgram)
 			{
-				// Get the game objects' shader program attributes.
-				std::shared_ptr<Attribute::ShaderProgram> oneShaderProgram =
-					one->GetAttribute<Attribute::ShaderProgram>();
-				std::shared_ptr<Attribute::ShaderProgram> twoShaderProgram =
-					two->GetAttribute<Attribute::ShaderProgram>();
-
-				// Get the corresponding shader program resources.
-				std::shared_ptr<ShaderProgram> oneShaderProgramResource =
-					m_resourceManager->GetShaderProgram(oneShaderProgram->GetVertexShaderPath(), oneShaderProgram->GetFragmentShaderPath());
-				std::shared_ptr<ShaderProgram> twoShaderProgramResource =
-					m_resourceManager->GetShaderProgram(twoShaderProgram->GetVertexShaderPath(), twoShaderProgram->GetFragmentShaderPath());
-
-				// Compare the shader program resource IDs.
-				if (oneShaderProgramResource && twoShaderProgramResource)
-				{
-					return oneShaderProgramResource->GetId() > twoShaderProgramResource->GetId();
-				}
-				else
-				{
-					return false;
-				}
+				UseShaderProgram(*item.shaderProgram);
 			}
-		);
 
-		// Render each game object in the render list.
-		for (auto iter = m_renderList.begin(); iter != m_renderList.end(); ++iter)
-		{
-			std::shared_ptr<GameObject> gameObject = *iter;
-			RenderGameObject(gameObject, projectionMatrix, viewMatrix, directionalLights);
+			if (batch.instanceCount > 0)
+			{
+				// The batch's items share their uniforms.
+				item.shaderProgramAttribute->ApplyUniforms();
+				RenderModel(*item.model, item.pose, item.lod, *item.shaderProgram, batch.firstInstance, batch.instanceCount);
+			}
+			else
+			{
+				RenderItemModel(item);
+			}
 		}
 
 		// Reset our record of the shader currently in use.
 		m_currentShaderProgram = nullptr;
 
+		// Unbind the geometry buffer.
+		glBindVertexArray(0);
+		m_currentGeometryPage = GeometryBuffer::InvalidPage;
+
 		// Stop using the last shader.
 		// Just a precaution so that we don't inadvertedly modify or use the
 		// shader from the outside.
 		glUseProgram(0);
 	}
 
-	void Renderer::PopulateRenderList(std::shared_ptr<GameObject> gameObject)
+	void Renderer::PopulateRenderList(std::shared_ptr<GameObject> gameObject,
+		const glm::mat4& projectionMatrix,
+		const glm::mat4& viewMatrix,
+		const Frustum& frustum)
 	{
 		// Check whether the specified game object should be added to the render
 		// list.
@@ -138,258 +329,457 @@ namespace Engine
 			gameObject->HasAttribute<Attribute::Model>() &&
 			gameObject->HasAttribute<Attribute::ShaderProgram>())
 		{
-			// Add the game object to the render list if the model is
-			// visible.
-			if (gameObject->GetAttribute<Attribute::Model>()->GetVisible())
+			std::shared_ptr<Attribute::Model> modelAttr = gameObject->GetAttribute<Attribute::Model>();
+			std::shared_ptr<Attribute::ShaderProgram> shaderProgAttr = gameObject->GetAttribute<Attribute::ShaderProgram>();
+			if (modelAttr->GetVisible())
 			{
-				m_renderList.push_back(gameObject);
-			}			
+				// Look up the shader program and model resources once per
+				// frame. They may be NULL if they haven't been completely
+				// loaded yet. We won't error out in this case. Instead, we
+				// just won't render the game object until both have been
+				// completely loaded.
+				std::shared_ptr<ShaderProgram> shaderProgram = shaderProgAttr->GetResource();
+				std::shared_ptr<Model> modelResource = modelAttr->GetResource();
+				if (!shaderProgram)
+				{
+					std::cerr << "Render Error: Shader \""
+						<< shaderProgAttr->GetVertexShaderPath() << ", " << shaderProgAttr->GetFragmentShaderPath()
+						<< "\" was not loaded" << std::endl;
+				}
+				else if (modelResource)
+				{
+					// Add the game object to the render list if the model
+					// is within the camera's view, and is in a pose that can
+					// be drawn.
+					const glm::mat4 modelMatrix = gameObject->GetAttribute<Attribute::Transform>()->GetTransformationMatrix();
+					const double currentAnimationTime = modelAttr->GetCurrentAnimationTime();
+					assert(currentAnimationTime >= 0.0);
+					if (!IsVisible(*modelResource, modelMatrix, frustum))
+					{
+						++m_culledObjectCount;
+					}
+					else if (const glm::mat4* pose = modelResource->GetPose(modelAttr->GetAnimationClip(), currentAnimationTime))
+					{
+						const unsigned int clip = modelAttr->GetAnimationClip();
+						const unsigned int frame = modelResource->GetPoseFrame(clip, currentAnimationTime);
+
+						// Sort models by the texture of their first material
+						// group, by level of detail, clip and frame, and by
+						// the depth of their center.
+						const std::vector<Model::MaterialGroup>& groups = modelResource->GetMaterialGroups();
+						const ResourceHandle<Texture> texture = groups.empty()
+							? ResourceHandle<Texture>() : groups[0].material->GetDiffuseTexture();
+						const glm::vec4 center = projectionMatrix * viewMatrix * modelMatrix
+							* glm::vec4(modelResource->GetBoundingSphereCenter(), 1.0f);
+						const float depth = (center.z / std::max(std::abs(center.w), 1e-6f) + 1.0f) * 0.5f;
+
+						const unsigned int lod = SelectLod(*modelResource, modelMatrix, viewMatrix, projectionMatrix);
+
+						RenderItem item;
+						item.key = MakeRenderKey(OpaquePass,
+							shaderProgAttr->GetResourceHandle().GetIndex(),
+							texture.IsValid() ? texture.GetIndex() + 1 : 0,
+							modelAttr->GetResourceHandle().GetIndex(),
+							lod,
+							clip,
+							frame,
+							depth);
+						item.shaderProgramAttribute = shaderProgAttr.get();
+						item.shaderProgram = shaderProgram.get();
+						item.model = modelResource.get();
+						item.pose = pose;
+						item.clip = clip;
+						item.frame = frame;
+						item.lod = lod;
+						item.modelMatrix = modelMatrix;
+						m_renderList.push_back(item);
+					}
+				}
+			}
 		}
 
 		// Recursively check any child game objects.
 		const unsigned int childCount = gameObject->GetChildCount();
 		for (unsigned int i = 0; i < childCount; ++i)
 		{
-			PopulateRenderList(gameObject->GetChild(i));
+			PopulateRenderList(gameObject->GetChild(i), projectionMatrix, viewMatrix, frustum);
 		}
 	}
 
-	void Renderer::RenderGameObject(std::shared_ptr<GameObject> gameObject,
-		const glm::mat4& projectionMatrix,
-		const glm::mat4& viewMatrix,
-		const std::vector<std::shared_ptr<GameObject>>& directionalLights)
+	void Renderer::BuildRenderBatches()
 	{
-		// Check that the Game Object can be rendered.
-		if (!gameObject->IsDead() &&
-			gameObject->HasAttribute<Attribute::Transform>() &&
-			gameObject->HasAttribute<Attribute::Model>() &&
-			gameObject->HasAttribute<Attribute::ShaderProgram>())
+		m_renderBatches.clear();
+		m_instanceData.clear();
+
+		std::size_t i = 0;
+		while (i < m_renderList.size())
 		{
-			// Get the transform attribute.
-			std::shared_ptr<Attribute::Transform> transformAttr = gameObject->GetAttribute<Attribute::Transform>();
+			const RenderItem& first = m_renderList[i];
+			RenderBatch batch;
+			batch.firstItem = i;
+			batch.firstInstance = m_instanceData.size();
+			batch.instanceCount = 0;
+			++i;
+
+			if (first.shaderProgram->IsInstanced())
+			{
+				// Extend the batch over the following items that differ only
+				// in their per-instance data. Animated models are only drawn
+				// together when they share a frame of the pose cache, and
+				// items are only drawn together when they share the values
+				// of the uniforms that are not per instance.
+				while (i < m_renderList.size()
+					&& m_renderList[i].shaderProgram == first.shaderProgram
+					&& m_renderList[i].model == first.model
+					&& m_renderList[i].pose == first.pose
+					&& m_renderList[i].lod == first.lod
+					&& (m_renderList[i].shaderProgramAttribute == first.shaderProgramAttribute
+						|| m_renderList[i].shaderProgramAttribute->HasSameUniforms(*first.shaderProgramAttribute, *first.shaderProgram)))
+				{
+					++i;
+				}
 
-			// Determine the MODEL matrix.
-			const glm::mat4 modelMatrix = transformAttr->GetTransformationMatrix();
+				// Gather the instance data of the batch's items.
+				for (std::size_t j = batch.firstItem; j < i; ++j)
+				{
+					const RenderItem& item = m_renderList[j];
+					const glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(item.modelMatrix)));
 
-			// Determine the NORMAL matrix.
-			const glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(modelMatrix)));
+					InstanceData instance;
+					instance.modelMatrix = item.modelMatrix;
+					for (unsigned int c = 0; c < 3; ++c)
+					{
+						instance.normalMatrix[c] = glm::vec4(normalMatrix[c], 0.0f);
+					}
 
-			// Get the shader program attribute.
-			std::shared_ptr<Attribute::ShaderProgram> shaderProgAttr = gameObject->GetAttribute<Attribute::ShaderProgram>();
+					item.shaderProgramAttribute->GetInstanceValues(*item.shaderProgram, instance.values);
+
+					m_instanceData.push_back(instance);
+				}
+
+				batch.instanceCount = static_cast<unsigned int>(i - batch.firstItem);
+			}
 
-			// Get the shader resource.
-			const std::string vertexShaderFilepath = shaderProgAttr->GetVertexShaderPath();
-			const std::string fragmentShaderFilepath = shaderProgAttr->GetFragmentShaderPath();
-			std::shared_ptr<ShaderProgram> shaderProgram = m_resourceManager->GetShaderProgram(vertexShaderFilepath, fragmentShaderFilepath);
-
-			// We can only render a Game Object if it has a shader program.
-			// The pointer to the shader program returned from the resource
-			// manager may be NULL if the shader program hasn't been
-			// completely loaded yet. We won't error out in this case.
-			// Instead, we just won't render the model until the shader
-			// program has been completely loaded.
-			if (shaderProgram)
+			m_renderBatches.push_back(batch);
+		}
+
+		// Stream the instance data of the whole frame to the instance buffer
+		// at once. Respecifying the buffer's storage lets the driver keep
+		// the previous frame's data until it has been drawn.
+		if (!m_instanceData.empty())
+		{
+			if (m_instanceBuffer == 0)
 			{
-				// If the game object's shader program is not already in use
-				// (bound), then we better start using it.
-				if (!m_currentShaderProgram || m_currentShaderProgram->GetId() != shaderProgram->GetId())
-				{
-					shaderProgram->Use();
-					m_currentShaderProgram = shaderProgram;
+				glGenBuffers(1, &m_instanceBuffer);
+			}
 
-					// Pass the current time to the shader.
-					// We only need to do this once for each shader program
-					// every frame.
-					shaderProgram->SetUniform1f("currentTime", static_cast<float>(glfwGetTime()));
-				}
+			glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+			glBufferData(GL_ARRAY_BUFFER, m_instanceData.size() * sizeof(InstanceData), m_instanceData.data(), GL_STREAM_DRAW);
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+		}
+	}
 
-				// Apply the unforms registered with the shader program attribute
-				// to the shader program resource.
-				shaderProgAttr->ApplyUniforms();
+	std::shared_ptr<GameObject> Renderer::FindDirectionalLight(std::map<GameObject::ID, std::shared_ptr<GameObject>>& gameObjects)
+	{
+		std::shared_ptr<GameObject> directionalLight = m_directionalLight.lock();
+		if (directionalLight && !directionalLight->IsDead())
+		{
+			return directionalLight;
+		}
 
-				// Get the model attribute.
-				std::shared_ptr<Attribute::Model> modelAttr = gameObject->GetAttribute<Attribute::Model>();
+		// Only the first directional light is used to light the scene.
+		directionalLight.reset();
+		for (auto iter = gameObjects.begin(); iter != gameObjects.end(); ++iter)
+		{
+			std::shared_ptr<GameObject> gameObject = iter->second;
 
-				// Get the model resource.
-				std::string modelFilepath = modelAttr->GetPath();
-				std::shared_ptr<Model> modelResource = m_resourceManager->GetModel(modelFilepath);
+			if (!gameObject->IsDead() &&
+				gameObject->HasAttribute<Attribute::Transform>() &&
+				gameObject->HasAttribute<Attribute::DirectionalLight>())
+			{
+				directionalLight = gameObject;
+				break;
+			}
+		}
 
-				// Again, like with the shader program, the model resource
-				// pointer returned by the resource manager may be NULL if
-				// the model has not been completely loaded yet. As with
-				// before, we will not error out but instead just skip
-				// rendering the model.
-				if (modelResource)
-				{
-					// Get the current animation time (in seconds).
-					const double currentAnimationTime = modelAttr->GetCurrentAnimationTime();
-					assert(currentAnimationTime >= 0.0);
+		m_directionalLight = directionalLight;
+		return directionalLight;
+	}
 
-					// Pass the projection matrix to the shader.
-					shaderProgram->SetUniformMatrix4fv("projectionMatrix", projectionMatrix);
+	void Renderer::UploadFrameUniforms(const glm::mat4& projectionMatrix,
+		const glm::mat4& viewMatrix,
+		std::shared_ptr<GameObject> directionalLight)
+	{
+		static_assert(sizeof(FrameUniforms) == 176, "FrameUniforms must match the std140 layout of the shaders");
+
+		FrameUniforms uniforms;
+		uniforms.projectionMatrix = projectionMatrix;
+		uniforms.viewMatrix = viewMatrix;
+		uniforms.lightPosition = glm::vec4(0.0f);
+		uniforms.lightColor = glm::vec4(0.0f);
+		uniforms.currentTime = static_cast<float>(glfwGetTime());
+		uniforms.padding[0] = uniforms.padding[1] = uniforms.padding[2] = 0.0f;
+
+		// Lighting.
+		if (directionalLight)
+		{
+			// Get the light's transform attribute.
+			std::shared_ptr<Attribute::Transform> lightTransformAttr =
+				directionalLight->GetAttribute<Attribute::Transform>();
+			assert(lightTransformAttr);
+
+			// Get the light's directional light attribute.
+			std::shared_ptr<Attribute::DirectionalLight> lightDirectionalLightAttr =
+				directionalLight->GetAttribute<Attribute::DirectionalLight>();
+			assert(lightDirectionalLightAttr);
+
+			// Pass the light's position and its color multiplied by its
+			// intensity.
+			uniforms.lightPosition = glm::vec4(lightTransformAttr->GetPosition(), 0.0f);
+			uniforms.lightColor = glm::vec4(lightDirectionalLightAttr->GetColor() * lightDirectionalLightAttr->GetIntensity(), 0.0f);
+		}
 
-					// Pass the view matrix to the shader.
-					shaderProgram->SetUniformMatrix4fv("viewMatrix", viewMatrix);
+		if (m_frameUniformBuffer == 0)
+		{
+			glGenBuffers(1, &m_frameUniformBuffer);
+		}
 
-					// Pass the model matrix to the shader.
-					shaderProgram->SetUniformMatrix4fv("modelMatrix", modelMatrix);
+		glBindBuffer(GL_UNIFORM_BUFFER, m_frameUniformBuffer);
+		glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameUniforms), &uniforms, GL_STREAM_DRAW);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+		glBindBufferBase(GL_UNIFORM_BUFFER, ShaderProgram::FrameUniformBlockBinding, m_frameUniformBuffer);
+	}
 
-					// Pass the normal matrix to the shader.
-					shaderProgram->SetUniformMatrix3fv("normalMatrix", normalMatrix);
+	void Renderer::UseShaderProgram(ShaderProgram& shaderProgram)
+	{
+		shaderProgram.Use();
+		m_currentShaderProgram = &shaderProgram;
+
+		// Resolve the uniforms once for all of the items drawn with the
+		// shader program.
+		m_uniforms.modelMatrix = shaderProgram.GetUniformHandle(BuiltinUniforms::ModelMatrix);
+		m_uniforms.normalMatrix = shaderProgram.GetUniformHandle(BuiltinUniforms::NormalMatrix);
+		m_uniforms.nodeTransformations = shaderProgram.GetUniformHandle(BuiltinUniforms::NodeTransformations);
+		m_uniforms.materialDiffuseColor = shaderProgram.GetUniformHandle(BuiltinUniforms::MaterialDiffuseColor);
+		m_uniforms.materialSpecularColor = shaderProgram.GetUniformHandle(BuiltinUniforms::MaterialSpecularColor);
+		m_uniforms.materialAmbientColor = shaderProgram.GetUniformHandle(BuiltinUniforms::MaterialAmbientColor);
+		m_uniforms.materialEmissiveColor = shaderProgram.GetUniformHandle(BuiltinUniforms::MaterialEmissiveColor);
+		m_uniforms.materialShininess = shaderProgram.GetUniformHandle(BuiltinUniforms::MaterialShininess);
+		m_uniforms.useTexture = shaderProgram.GetUniformHandle(BuiltinUniforms::UseTexture);
+		m_uniforms.diffuseTextureUnit = shaderProgram.GetUniformHandle(BuiltinUniforms::DiffuseTextureUnit);
+	}
 
-					// Lighting.
-					if (directionalLights.size() > 0)
-					{
-						// Get the light's transform attribute.
-						std::shared_ptr<Attribute::Transform> lightTransformAttr =
-							directionalLights[0]->GetAttribute<Attribute::Transform>();
-						assert(lightTransformAttr);
+	void Renderer::RenderItemModel(const RenderItem& item)
+	{
+		// Apply the unforms registered with the shader program attribute
+		// to the shader program resource.
+		item.shaderProgramAttribute->ApplyUniforms();
 
-						// Get the light's directional light attribute.
-						std::shared_ptr<Attribute::DirectionalLight> lightDirectionalLightAttr =
-							directionalLights[0]->GetAttribute<Attribute::DirectionalLight>();
-						assert(lightDirectionalLightAttr);
+		// Determine the NORMAL matrix.
+		const glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(item.modelMatrix)));
 
-						// Get the light's position, color and intensity.
-						const glm::vec3& lightPosition = lightTransformAttr->GetPosition();
-						const glm::vec3& lightColor = lightDirectionalLightAttr->GetColor();
-						const float lightIntensity = lightDirectionalLightAttr->GetIntensity();
+		// Pass the model matrix to the shader.
+		item.shaderProgram->SetUniformMatrix4fv(m_uniforms.modelMatrix, item.modelMatrix);
 
-						// Calculate the light's color intensity.
-						const glm::vec3 lightColorIntensity = lightColor * lightIntensity;
+		// Pass the normal matrix to the shader.
+		item.shaderProgram->SetUniformMatrix3fv(m_uniforms.normalMatrix, normalMatrix);
 
-						// Pass the light position to the shader.
-						shaderProgram->SetUniform3fv("light.position", lightPosition);
+		// Render the model's nodes.
+		RenderModel(*item.model, item.pose, item.lod, *item.shaderProgram, 0, 0);
+	}
 
-						// Pass the light color intensity to the shader.
-						shaderProgram->SetUniform3fv("light.color", lightColorIntensity);
-					}
+	void Renderer::RenderModel(const Model& model,
+		const glm::mat4* pose,
+		unsigned int lod,
+		ShaderProgram& shaderProgram,
+		std::size_t firstInstance,
+		unsigned int instanceCount)
+	{
+		m_drawnObjectCount += std::max(instanceCount, 1u);
 
-					// Render the node tree.
-					std::shared_ptr<Model::Node> rootNode = modelResource->GetRootNode();
-					if (rootNode)
-					{
-						RenderNode(
-							rootNode, // Node to render.
-							glm::mat4(), // Accumulated transformation matrix.
-							currentAnimationTime, // Animation time at which to render.
-							shaderProgram // Shader program.
-						);
-					};
-				}
-			}
-			else
+		// The groups are ordered by node palette, so each palette is passed
+		// to the shader once.
+		const std::vector<unsigned int>& paletteNodes = model.GetPaletteNodes();
+		unsigned int currentPalette = ~0u;
+		for (const Model::MaterialGroup& group : model.GetMaterialGroups())
+		{
+			if (group.palette != currentPalette)
 			{
-				std::cerr << "Render Error: Shader \""
-					<< vertexShaderFilepath << ", " << fragmentShaderFilepath
-					<< "\" was not loaded" << std::endl;
+				// Gather the transformation matrices of the palette's nodes.
+				const unsigned int firstNode = group.palette * Model::MaxPaletteNodes;
+				const unsigned int nodeCount = std::min<unsigned int>(Model::MaxPaletteNodes, paletteNodes.size() - firstNode);
+				for (unsigned int n = 0; n < nodeCount; ++n)
+				{
+					m_nodePalette[n] = pose[paletteNodes[firstNode + n]];
+				}
+
+				shaderProgram.SetUniformMatrix4fv(m_uniforms.nodeTransformations, m_nodePalette.data(), nodeCount);
+				currentPalette = group.palette;
 			}
+
+			RenderMaterialGroup(group, lod, shaderProgram, firstInstance, instanceCount);
 		}
 	}
 
-	void Renderer::RenderNode(std::shared_ptr<Model::Node> node,
-		const glm::mat4& parentAccumulatedTransformation,
-		double animationTime,
-		std::shared_ptr<ShaderProgram> shaderProgram)
+	void Renderer::RenderMaterialGroup(const Model::MaterialGroup& group,
+		unsigned int lod,
+		ShaderProgram& shaderProgram,
+		std::size_t firstInstance,
+		unsigned int instanceCount)
 	{
-		// Get the node's local transformation matrix at the specified
-		// animation time.
-		const glm::mat4 localTransformationMatrix =
-			node->GetLocalTransformationMatrix((double) animationTime);
-
-		// Calculate the node's accumulated transformation matrix.
-		// This is the transformation matrix that will map local node
-		// coordinates to model coordinates.
-		const glm::mat4 accTransformationMatrix = parentAccumulatedTransformation * localTransformationMatrix;
-
-		// Pass the node's accumulated transformation matrix to the shader.
-		shaderProgram->SetUniformMatrix4fv("nodeTransformationMatrix", accTransformationMatrix);
-
-		// Get the number of meshes in the node.
-		const unsigned int meshCount = node->GetMeshCount();
+		// Skip groups that have nothing uploaded.
+		const GeometryBuffer::Allocation& allocation = group.allocation;
+		if (allocation.page == GeometryBuffer::InvalidPage)
+		{
+			return;
+		}
 
-		// For each mesh...
-		for (unsigned int m = 0; m < meshCount; ++m)
+		// Get a shared pointer to the material that should be applied to
+		// the group.
+		std::shared_ptr<Model::Material> material = group.material;
+
+		// Every mesh, and so every group, should contain a material.
+		// ASSIMP should generate one if the 3D modeling software did not
+		// assign one.
+		assert(material);
+
+		// Pass the material properties to the shader.
+		shaderProgram.SetUniform3fv(m_uniforms.materialDiffuseColor, material->GetDiffuseColor());
+		shaderProgram.SetUniform3fv(m_uniforms.materialSpecularColor, material->GetSpecularColor());
+		shaderProgram.SetUniform3fv(m_uniforms.materialAmbientColor, material->GetAmbientColor());
+		shaderProgram.SetUniform3fv(m_uniforms.materialEmissiveColor, material->GetEmissiveColor());
+		shaderProgram.SetUniform1f(m_uniforms.materialShininess, material->GetShininess());
+
+		// If the material has a diffuse texture, pass it to the shader.
+		// The texture handle is resolved when the model is loaded.
+		const ResourceHandle<Texture> diffuseTexture = material->GetDiffuseTexture();
+		if (diffuseTexture.IsValid())
 		{
-			// Get a shared pointer to the mesh.
-			std::shared_ptr<Model::Node::Mesh> mesh = node->GetMesh(m);
-
-			// Get a shared pointer to the material that should be applied to
-			// the mesh.
-			std::shared_ptr<Model::Material> material = mesh->GetMaterial();
-
-			// A mesh should always contain a material.
-			// ASSIMP should generate one if the 3D modeling software did not
-			// assign one.
-			assert(material);
-
-			// Pass the material properties to the shader.
-			shaderProgram->SetUniform3fv("material.diffuseColor", material->GetDiffuseColor());
-			shaderProgram->SetUniform3fv("material.specularColor", material->GetSpecularColor());
-			shaderProgram->SetUniform3fv("material.ambientColor", material->GetAmbientColor());
-			shaderProgram->SetUniform3fv("material.emissiveColor", material->GetEmissiveColor());
-			shaderProgram->SetUniform1f("material.shininess", material->GetShininess());
-
-			// If the material has a diffuse texture, pass it to the shader.
-			const std::string diffuseTexturePath = material->GetDiffuseTexturePath();
-			if (diffuseTexturePath.length() > 0)
-			{
-				// Get a shared pointer to the diffuse texture.
-				std::shared_ptr<Texture> texture = m_resourceManager->GetTexture(diffuseTexturePath);
+			// Get a shared pointer to the diffuse texture.
+			std::shared_ptr<Texture> texture = m_resourceManager->GetTexture(diffuseTexture);
 
-				// Set the uniform flag that specifies whether or not the texture should be used.
-				shaderProgram->SetUniform1i("useTexture", (texture) ? 1 : 0);
+			// Set the uniform flag that specifies whether or not the texture should be used.
+			shaderProgram.SetUniform1i(m_uniforms.useTexture, (texture) ? 1 : 0);
 
-				// Pass the texture to the shader if the shared pointer to the
-				// texture is valid (not null). The pointer may be null if the
-				// texture has not been completely loaded yet.
-				if (texture)
-				{
-					// Activate a texture unit.
-					glActiveTexture(GL_TEXTURE0 + 0);
+			// Pass the texture to the shader if the shared pointer to the
+			// texture is valid (not null). The pointer may be null if the
+			// texture has not been completely loaded yet.
+			if (texture)
+			{
+				// Activate a texture unit.
+				glActiveTexture(GL_TEXTURE0 + 0);
 
-					// Bind the shape's texture to the texture unit.
-					glBindTexture(GL_TEXTURE_2D, texture->GetTextureId());
+				// Bind the shape's texture to the texture unit.
+				glBindTexture(GL_TEXTURE_2D, texture->GetTextureId());
 
-					// Pass the texture unit to the shader attribute.
-					shaderProgram->SetUniform1i("diffuseTextureUnit", 0);
-				}
-			}
-			else
-			{
-				shaderProgram->SetUniform1i("useTexture", 0);
+				// Pass the texture unit to the shader attribute.
+				shaderProgram.SetUniform1i(m_uniforms.diffuseTextureUnit, 0);
 			}
+		}
+		else
+		{
+			shaderProgram.SetUniform1i(m_uniforms.useTexture, 0);
+		}
 
-			// Bind the VAO for the mesh.
-			glBindVertexArray(mesh->GetVAO());
+		// Bind the VAO for the geometry buffer page holding the group,
+		// unless the previous group was on the same page.
+		if (allocation.page != m_currentGeometryPage)
+		{
+			glBindVertexArray(GeometryBuffer::GetInstance().GetVertexArray(allocation.page));
+			m_currentGeometryPage = allocation.page;
+			++m_vertexArrayBindCount;
+		}
 
-			// Draw the mesh.
-			glDrawElements(
+		// Draw the level of detail from its place in the page.
+		const unsigned int groupLod = std::min(lod, group.lodCount - 1);
+		const std::size_t indexSize = (group.indexType == GL_UNSIGNED_SHORT) ? sizeof(std::uint16_t) : sizeof(std::uint32_t);
+		void* indices = reinterpret_cast<void*>(allocation.indexOffset + group.lodFirstIndex[groupLod] * indexSize);
+		if (instanceCount > 0)
+		{
+			EnableInstanceAttributes(shaderProgram, firstInstance);
+			glDrawElementsInstancedBaseVertex(
 				GL_TRIANGLES,
-				mesh->GetIndicesCount(),
-				GL_UNSIGNED_INT,
-				(void*)0
+				group.lodIndexCount[groupLod],
+				group.indexType,
+				indices,
+				instanceCount,
+				allocation.baseVertex
 			);
+			DisableInstanceAttributes(shaderProgram);
+		}
+		else
+		{
+			glDrawElementsBaseVertex(
+				GL_TRIANGLES,
+				group.lodIndexCount[groupLod],
+				group.indexType,
+				indices,
+				allocation.baseVertex
+			);
+		}
+
+		// Increment the draw counters.
+		++m_drawCount;
+		m_triangleCount += group.lodIndexCount[groupLod] / 3 * std::max(instanceCount, 1u);
+	}
 
-			// Unbind the mesh VAO.
-			glBindVertexArray(0);
+	void Renderer::EnableInstanceAttributes(const ShaderProgram& shaderProgram, std::size_t firstInstance)
+	{
+		const GLsizei stride = sizeof(InstanceData);
+		const std::size_t instanceOffset = firstInstance * sizeof(InstanceData);
+		glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
 
-			// Increment the draw counter.
-			++m_drawCount;
+		// Matrices take one attribute location per column. Each attribute
+		// advances once per instance rather than once per vertex.
+		for (GLuint c = 0; c < 4; ++c)
+		{
+			const GLuint location = ShaderProgram::InstanceModelMatrixLocation + c;
+			glEnableVertexAttribArray(location);
+			glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, stride,
+				reinterpret_cast<void*>(instanceOffset + offsetof(InstanceData, modelMatrix) + c * sizeof(glm::vec4)));
+			SetInstanceDivisor(location);
 		}
 
-		// Get the number of child nodes.
-		const unsigned int childNodeCount = node->GetChildNodeCount();
+		for (GLuint c = 0; c < 3; ++c)
+		{
+			const GLuint location = ShaderProgram::InstanceNormalMatrixLocation + c;
+			glEnableVertexAttribArray(location);
+			glVertexAttribPointer(location, 3, GL_FLOAT, GL_FALSE, stride,
+				reinterpret_cast<void*>(instanceOffset + offsetof(InstanceData, normalMatrix) + c * sizeof(glm::vec4)));
+			SetInstanceDivisor(location);
+		}
 
-		// Recursively render child nodes.
-		for (unsigned int c = 0; c < childNodeCount; ++c)
+		const std::vector<ShaderProgram::InstanceValue>& instanceValues = shaderProgram.GetInstanceValues();
+		for (std::size_t v = 0; v < instanceValues.size(); ++v)
 		{
-			RenderNode(
-				node->GetChildNode(c),
-				accTransformationMatrix,
-				animationTime,
-				shaderProgram
-			);
+			const GLuint location = instanceValues[v].location;
+			glEnableVertexAttribArray(location);
+			glVertexAttribPointer(location, 1, GL_FLOAT, GL_FALSE, stride,
+				reinterpret_cast<void*>(instanceOffset + offsetof(InstanceData, values) + v * sizeof(float)));
+			SetInstanceDivisor(location);
+		}
+
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	void Renderer::DisableInstanceAttributes(const ShaderProgram& shaderProgram)
+	{
+		// Leave the page's Vertex Array Object as the geometry buffer set it
+		// up, so that shader programs that are not instanced never read the
+		// instance buffer.
+		for (GLuint c = 0; c < 4; ++c)
+		{
+			glDisableVertexAttribArray(ShaderProgram::InstanceModelMatrixLocation + c);
+		}
+
+		for (GLuint c = 0; c < 3; ++c)
+		{
+			glDisableVertexAttribArray(ShaderProgram::InstanceNormalMatrixLocation + c);
+		}
+
+		for (const ShaderProgram::InstanceValue& value : shaderProgram.GetInstanceValues())
+		{
+			glDisableVertexAttribArray(value.location);
 		}
 	}
 }
@@ -0,0 +1,162 @@
+#include <Engine/ResourceBundle.hpp>
+
+#include <algorithm>
+
+namespace Engine
+{
+	const unsigned int ResourceBundle::MaxRequestsInFlight;
+
+	ResourceBundle::ResourceBundle(const ResourceManifest& manifest,
+		std::function<std::size_t(const ResourceManifest::Entry&)> getSize)
+	: m_entries(manifest.GetEntries())
+	, m_sizes()
+	, m_requestsInFlight()
+	, m_nextRequest(0)
+	, m_loadedCount(0)
+	, m_failedCount(0)
+	, m_totalBytes(0)
+	, m_loadedBytes(0)
+	, m_cancelled(false)
+	, m_complete(false)
+	, m_promise()
+	, m_future(m_promise.get_future().share())
+	{
+		// Request the resources highest priority first, and otherwise in the
+		// order in which they are listed.
+		std::stable_sort(m_entries.begin(), m_entries.end(),
+			[](const ResourceManifest::Entry& one, const ResourceManifest::Entry& two)
+			{
+				return one.priority > two.priority;
+			}
+		);
+
+		m_sizes.reserve(m_entries.size());
+		for (const ResourceManifest::Entry& entry : m_entries)
+		{
+			m_sizes.push_back(getSize(entry));
+			m_totalBytes += m_sizes.back();
+		}
+
+		// An empty bundle is complete straight away.
+		CheckComplete();
+	}
+
+	ResourceBundle::~ResourceBundle()
+	{
+		// Nothing to do.
+	}
+
+	void ResourceBundle::Update(std::function<RequestStatus(const ResourceManifest::Entry&)> getStatus,
+		std::function<void(const ResourceManifest::Entry&)> request)
+	{
+		// Retire the requests that have finished.
+		for (unsigned int i = 0; i < m_requestsInFlight.size();)
+		{
+			const unsigned int index = m_requestsInFlight[i];
+			const RequestStatus status = getStatus(m_entries[index]);
+			if (status == RequestStatus::Loading)
+			{
+				++i;
+				continue;
+			}
+
+			if (status == RequestStatus::Loaded)
+			{
+				++m_loadedCount;
+			}
+			else
+			{
+				++m_failedCount;
+			}
+
+			m_loadedBytes += m_sizes[index];
+			m_requestsInFlight[i] = m_requestsInFlight.back();
+			m_requestsInFlight.pop_back();
+		}
+
+		// Hand over more resources.
+		while (!m_cancelled && m_nextRequest < m_entries.size() && m_requestsInFlight.size() < MaxRequestsInFlight)
+		{
+			request(m_entries[m_nextRequest]);
+			m_requestsInFlight.push_back(m_nextRequest++);
+		}
+
+		CheckComplete();
+	}
+
+	void ResourceBundle::Cancel()
+	{
+		m_cancelled = true;
+		CheckComplete();
+	}
+
+	bool ResourceBundle::IsCancelled() const
+	{
+		return m_cancelled;
+	}
+
+	bool ResourceBundle::IsComplete() const
+	{
+		return m_complete;
+	}
+
+	std::shared_future<bool> ResourceBundle::GetFuture() const
+	{
+		return m_future;
+	}
+
+	unsigned int ResourceBundle::GetResourceCount() const
+	{
+		return m_entries.size();
+	}
+
+	unsigned int ResourceBundle::GetLoadedCount() const
+	{
+		return m_loadedCount;
+	}
+
+	unsigned int ResourceBundle::GetFailedCount() const
+	{
+		return m_failedCount;
+	}
+
+	std::size_t ResourceBundle::GetTotalBytes() const
+	{
+		return m_totalBytes;
+	}
+
+	std::size_t ResourceBundle::GetLoadedBytes() const
+	{
+		return m_loadedBytes;
+	}
+
+	float ResourceBundle::GetProgress() const
+	{
+		if (m_totalBytes > 0)
+		{
+			return static_cast<float>(m_loadedBytes) / m_totalBytes;
+		}
+
+		// Fall back to counting resources if none of the files were found.
+		if (!m_entries.empty())
+		{
+			return static_cast<float>(m_loadedCount + m_failedCount) / m_entries.size();
+		}
+
+		return 1.0f;
+	}
+
+	void ResourceBundle::CheckComplete()
+	{
+		if (m_complete || !m_requestsInFlight.empty())
+		{
+			return;
+		}
+
+		if (m_cancelled || m_nextRequest == m_entries.size())
+		{
+			m_complete = true;
+			m_promise.set_value(!m_cancelled && m_failedCount == 0);
+		}
+	}
+}
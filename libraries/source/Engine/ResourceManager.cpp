@@ -1,14 +1,150 @@
 #include <Engine/ResourceManager.hpp>
 
 #include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <utility>
+
+#include <sys/stat.h>
 
 #include <Engine/WaveFile.hpp>
 
 namespace Engine
 {
+	namespace
+	{
+		/**
+		 * Loaded resource that may be evicted.
+		 */
+		struct EvictionCandidate
+		{
+			/**
+			 * Time at which the resource was last used.
+			 */
+			std::uint64_t lastUsed;
+
+			/**
+			 * Bytes of main memory used by the resource.
+			 */
+			std::size_t cpuBytes;
+
+			/**
+			 * Bytes of graphics memory used by the resource.
+			 */
+			std::size_t gpuBytes;
+
+			/**
+			 * Evicts the resource.
+			 */
+			std::function<void()> evict;
+		};
+
+		/**
+		 * Adds the loaded, unreferenced resources in the table to the list of
+		 * eviction candidates.
+		 *
+		 * @param table Resource table.
+		 * @param evict Function that evicts a resource from the table.
+		 * @param candidates List of eviction candidates.
+		 */
+		template <typename ResourceType>
+		void CollectEvictionCandidates(const ResourceTable<ResourceType>& table,
+			std::function<void(ResourceHandle<ResourceType>)> evict,
+			std::vector<EvictionCandidate>& candidates)
+		{
+			const unsigned int count = table.GetCount();
+			for (unsigned int i = 0; i < count; ++i)
+			{
+				const ResourceHandle<ResourceType> handle(i);
+				if (table.IsEvictable(handle))
+				{
+					EvictionCandidate candidate;
+					candidate.lastUsed = table.GetLastUsed(handle);
+					candidate.cpuBytes = table.GetCPUBytes(handle);
+					candidate.gpuBytes = table.GetGPUBytes(handle);
+					candidate.evict = std::bind(evict, handle);
+					candidates.push_back(candidate);
+				}
+			}
+		}
+
+		/**
+		 * Adds a resource to a group's set of members.
+		 *
+		 * @param members The group's members of the resource type.
+		 * @param handle Handle to the resource.
+		 * @return True if the resource was not already a member, in which
+		 * case the group must reference it.
+		 */
+		template <typename ResourceType>
+		bool AddGroupMember(std::set<ResourceHandle<ResourceType>>& members,
+			ResourceHandle<ResourceType> handle)
+		{
+			return members.insert(handle).second;
+		}
+
+		/**
+		 * Releases the references held on a group's members.
+		 *
+		 * @param table Resource table.
+		 * @param members The group's members of the resource type.
+		 */
+		template <typename ResourceType>
+		void ReleaseGroupMembers(ResourceTable<ResourceType>& table,
+			std::set<ResourceHandle<ResourceType>>& members)
+		{
+			for (const ResourceHandle<ResourceType>& handle : members)
+			{
+				table.ReleaseReference(handle);
+			}
+
+			members.clear();
+		}
+
+		/**
+		 * Returns the state of the request for a resource in a table.
+		 *
+		 * @param table Resource table.
+		 * @param handle Handle to the resource.
+		 * @return State of the request.
+		 */
+		template <typename ResourceType>
+		ResourceBundle::RequestStatus GetTableRequestStatus(const ResourceTable<ResourceType>& table,
+			ResourceHandle<ResourceType> handle)
+		{
+			if (table.Get(handle))
+			{
+				return ResourceBundle::RequestStatus::Loaded;
+			}
+
+			// Requests that fail are cleared so that they can be made again.
+			return table.IsRequested(handle) ? ResourceBundle::RequestStatus::Loading : ResourceBundle::RequestStatus::Failed;
+		}
+
+		/**
+		 * Writes a row of the memory report.
+		 *
+		 * @param stream Output stream.
+		 * @param type Resource type name.
+		 * @param usage Resource usage.
+		 */
+		void PrintMemoryReportRow(std::ostream& stream, const char* type, const ResourceUsage& usage)
+		{
+			stream << std::left << std::setw(16) << type << std::right
+				<< std::setw(10) << usage.residentCount
+				<< std::setw(12) << usage.referencedCount
+				<< std::setw(16) << usage.cpuBytes
+				<< std::setw(16) << usage.gpuBytes << std::endl;
+		}
+	}
+
+	const std::chrono::microseconds ResourceLoader::FramePeriod(1000000 / 60);
+
 	ResourceLoader::ResourceLoader(std::shared_ptr<ThreadEventReceiver> gameThreadReceiver,
-		std::shared_ptr<Window> loadingWindow)
+		std::shared_ptr<Window> loadingWindow, std::string resourcePackPath)
 	: m_terminateLoadingThread(false)
+	, m_frameBudget(0)
 	, m_loadingThreadEventReceiver()
 	, m_gameThreadEventReceiver(gameThreadReceiver)
 	, m_window(loadingWindow)
@@ -16,8 +152,22 @@ namespace Engine
 	, m_loadShaderProgramSubscription(0)
 	, m_loadTextureSubscription(0)
 	, m_loadAudioSubscription(0)
+	, m_uploadSubscription(0)
 	, m_stopThreadSubscription(0)
+	, m_resourcePack()
+	, m_workerPool()
 	{
+		// Open the resource pack, if there is one.
+		struct stat resourcePackStatus;
+		if (!resourcePackPath.empty() && stat(resourcePackPath.c_str(), &resourcePackStatus) == 0)
+		{
+			if (m_resourcePack.Open(resourcePackPath))
+			{
+				std::cout << "Loading resources from \"" << resourcePackPath << "\" ("
+					<< m_resourcePack.GetResourceCount() << " resources)" << std::endl;
+			}
+		}
+
 		// Subscribe to receive loading request events.
 		m_loadModelSubscription = m_loadingThreadEventReceiver.Subscribe<Event::LoadModelResourceEvent>(
 			CALLBACK(ResourceLoader::HandleLoadModelResourceEvent)
@@ -32,6 +182,11 @@ namespace Engine
 			CALLBACK(ResourceLoader::HandleLoadAudioResourceEvent)
 		);
 
+		// Subscribe to receive decoded resources from the worker threads.
+		m_uploadSubscription = m_loadingThreadEventReceiver.Subscribe<Event::UploadResourceEvent>(
+			CALLBACK(ResourceLoader::HandleUploadResourceEvent)
+		);
+
 		// Subscribe to receive thread termination request events.
 		// This should cause the thread entry function to return.
 		m_stopThreadSubscription = m_loadingThreadEventReceiver.Subscribe<Event::StopThreadEvent>(
@@ -46,6 +201,7 @@ namespace Engine
 		m_loadingThreadEventReceiver.Unsubscribe<Event::LoadShaderProgramResourceEvent>(m_loadShaderProgramSubscription);
 		m_loadingThreadEventReceiver.Unsubscribe<Event::LoadTextureResourceEvent>(m_loadTextureSubscription);
 		m_loadingThreadEventReceiver.Unsubscribe<Event::LoadAudioResourceEvent>(m_loadAudioSubscription);
+		m_loadingThreadEventReceiver.Unsubscribe<Event::UploadResourceEvent>(m_uploadSubscription);
 		m_loadingThreadEventReceiver.Unsubscribe<Event::StopThreadEvent>(m_stopThreadSubscription);
 	}
 
@@ -64,12 +220,35 @@ namespace Engine
 		// Process events until a terminate event has been received.
 		while (!m_terminateLoadingThread)
 		{
-			// Process a single event in the queue.
-			m_loadingThreadEventReceiver.ProcessSingleEvent();
+			// Sleep until there is something to load.
+			m_loadingThreadEventReceiver.Wait();
 
-			// Sleep for a little while to avoid high CPU load.
-			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+			// Drain all of the queued requests.
+			std::chrono::steady_clock::time_point frameStart = std::chrono::steady_clock::now();
+			while (!m_terminateLoadingThread && m_loadingThreadEventReceiver.ProcessSingleEvent())
+			{
+				const std::chrono::microseconds budget(m_frameBudget.load(std::memory_order_relaxed));
+				if (budget.count() > 0)
+				{
+					// Give the remainder of the frame period to the render
+					// thread once the budget has been used up.
+					const std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - frameStart;
+					if (elapsed >= budget)
+					{
+						if (elapsed < FramePeriod)
+						{
+							std::this_thread::sleep_for(FramePeriod - elapsed);
+						}
+
+						frameStart = std::chrono::steady_clock::now();
+					}
+				}
+			}
 		}
+
+		// Nothing more will be received, so workers that are still decoding
+		// must not wait for room in the queue while the pool joins them.
+		m_loadingThreadEventReceiver.Stop();
 	}
 
 	ThreadEventReceiver& ResourceLoader::GetReceiver()
@@ -77,116 +256,284 @@ namespace Engine
 		return m_loadingThreadEventReceiver;
 	}
 
-	void ResourceLoader::HandleStopThreadEvent(const Event::StopThreadEvent& event)
+	void ResourceLoader::SetFrameBudget(std::chrono::microseconds budget)
 	{
-		m_terminateLoadingThread = true;
+		m_frameBudget.store(budget.count(), std::memory_order_relaxed);
 	}
 
-	void ResourceLoader::HandleLoadModelResourceEvent(const Event::LoadModelResourceEvent& event)
+	std::size_t ResourceLoader::GetFileSize(const std::string& filepath) const
 	{
-		// Create a new empty model.
-		std::shared_ptr<Model> model = std::make_shared<Model>();
+		std::size_t size = 0;
+		if (m_resourcePack.GetSize(filepath, size))
+		{
+			return size;
+		}
 
-		// Try to initialize the model by loading it from a file.
-		bool success = model->LoadFromFile(event.GetPath());
+		struct stat status;
+		if (stat(filepath.c_str(), &status) == 0)
+		{
+			return status.st_size;
+		}
 
-		// Publish a ResourceLoadedEvent to the game thread receiver.
-		m_gameThreadEventReceiver->Enqueue<Event::ResourceLoadedEvent<Model>>(
-			event.GetName(),
-			success,
-			model,
-			event.GetCallback()
-		);
+		return 0;
 	}
 
-	void ResourceLoader::HandleLoadShaderProgramResourceEvent(const Event::LoadShaderProgramResourceEvent& event)
+	std::size_t ResourceLoader::GetModelFileSize(const std::string& filepath) const
 	{
-		// Create vertex and fragment shaders.
-		Shader vertexShader(Shader::Type::VertexShader);
-		Shader fragmentShader(Shader::Type::FragmentShader);
+		// Mirror the choice of file made by HandleLoadModelResourceEvent().
+		std::size_t size = 0;
+		if (m_resourcePack.GetSize(Model::GetBakedFilepath(filepath), size) ||
+			m_resourcePack.GetSize(filepath, size))
+		{
+			return size;
+		}
 
-		// Load and compile the vertex and fragment shaders.
-		if (vertexShader.LoadFromFile(event.GetVertexShaderPath()) &&
-			fragmentShader.LoadFromFile(event.GetFragmentShaderPath()))
+		return GetFileSize(Model::IsBakedFileUpToDate(filepath) ? Model::GetBakedFilepath(filepath) : filepath);
+	}
+
+	void ResourceLoader::HandleStopThreadEvent(const Event::StopThreadEvent& event)
+	{
+		m_terminateLoadingThread = true;
+	}
+
+	bool ResourceLoader::ReadShaderSource(const std::string& filepath, std::string& source) const
+	{
+		ResourcePack::Blob blob;
+		if (m_resourcePack.Read(filepath, blob))
 		{
-			// Create a shader program.
-			std::shared_ptr<ShaderProgram> shaderProgram = std::make_shared<ShaderProgram>();
+			source.assign(reinterpret_cast<const char*>(blob.GetData()), blob.GetSize());
+			return true;
+		}
+
+		return Shader::ReadSourceFile(filepath, source);
+	}
 
-			// Attach the shaders to the shader program.
-			shaderProgram->AttachShader(vertexShader);
-			shaderProgram->AttachShader(fragmentShader);
+	void ResourceLoader::HandleUploadResourceEvent(const Event::UploadResourceEvent& event)
+	{
+		event.GetUpload()();
+	}
 
-			// Link the shader program.
-			if (shaderProgram->Link())
+	void ResourceLoader::HandleLoadModelResourceEvent(const Event::LoadModelResourceEvent& event)
+	{
+		const std::string name = event.GetName();
+		const std::string filepath = event.GetPath();
+		const std::function<void(const Event::ResourceLoadedEvent<Model>&)> callback = event.GetCallback();
+
+		// Decode the model on a worker thread.
+		m_workerPool.Submit(static_cast<unsigned int>(event.GetPriority()), [this, name, filepath, callback]()
+		{
+			// Create a new empty model.
+			std::shared_ptr<Model> model = std::make_shared<Model>();
+
+			// Try to initialize the model by loading it from a file.
+			// The baked model is preferred, since reading it is far cheaper
+			// than importing the source model with ASSIMP. Fall back to the
+			// source model if the baked model is missing, stale or unreadable.
+			bool success = false;
+			ResourcePack::Blob blob;
+			if (m_resourcePack.Read(Model::GetBakedFilepath(filepath), blob))
 			{
-				m_gameThreadEventReceiver->Enqueue<Event::ResourceLoadedEvent<ShaderProgram>>(
-					event.GetName(),
-					true,
-					shaderProgram,
-					event.GetCallback()
-				);
+				success = model->DecodeBaked(blob.GetData(), blob.GetSize(), Model::GetBakedFilepath(filepath));
+			}
+			else if (m_resourcePack.Read(filepath, blob))
+			{
+				success = model->Decode(blob.GetData(), blob.GetSize(), filepath);
+			}
+			else
+			{
+				success = Model::IsBakedFileUpToDate(filepath)
+					&& model->DecodeBaked(Model::GetBakedFilepath(filepath));
+				if (!success)
+				{
+					success = model->Decode(filepath);
+				}
+			}
 
-				// We are done.
-				return;
+			if (success)
+			{
+				// Have the loading thread send the mesh data over to the
+				// graphics card.
+				m_loadingThreadEventReceiver.Enqueue<Event::UploadResourceEvent>([this, name, model, callback]()
+				{
+					model->UpdateBuffers();
+
+					// Publish a ResourceLoadedEvent to the game thread receiver.
+					m_gameThreadEventReceiver->Enqueue<Event::ResourceLoadedEvent<Model>>(
+						name,
+						true,
+						model,
+						callback
+					);
+				});
 			}
 			else
 			{
-				std::cout << "Unable to link shaders: " << event.GetVertexShaderPath()
-					<< ", " << event.GetFragmentShaderPath() << std::endl;
+				// There is nothing to upload, so notify the game thread
+				// straight away.
+				m_gameThreadEventReceiver->Enqueue<Event::ResourceLoadedEvent<Model>>(
+					name,
+					false,
+					model,
+					callback
+				);
 			}
-		}
-		else
+		});
+	}
+
+	void ResourceLoader::HandleLoadShaderProgramResourceEvent(const Event::LoadShaderProgramResourceEvent& event)
+	{
+		const std::string name = event.GetName();
+		const std::string vertexShaderPath = event.GetVertexShaderPath();
+		const std::string fragmentShaderPath = event.GetFragmentShaderPath();
+		const std::function<void(const Event::ResourceLoadedEvent<ShaderProgram>&)> callback = event.GetCallback();
+
+		// Read the shader sources on a worker thread.
+		m_workerPool.Submit(static_cast<unsigned int>(event.GetPriority()),
+			[this, name, vertexShaderPath, fragmentShaderPath, callback]()
 		{
-			std::cout << "Unable to load shaders: " << event.GetVertexShaderPath()
-				<< ", " << event.GetFragmentShaderPath() << std::endl;
-		}
+			std::string vertexShaderSource;
+			std::string fragmentShaderSource;
+			if (!ReadShaderSource(vertexShaderPath, vertexShaderSource) ||
+				!ReadShaderSource(fragmentShaderPath, fragmentShaderSource))
+			{
+				std::cout << "Unable to load shaders: " << vertexShaderPath
+					<< ", " << fragmentShaderPath << std::endl;
 
-		// Something went wrong if we reach this point.
-		m_gameThreadEventReceiver->Enqueue<Event::ResourceLoadedEvent<ShaderProgram>>(
-			event.GetName(),
-			false,
-			nullptr,
-			event.GetCallback()
-		);
+				m_gameThreadEventReceiver->Enqueue<Event::ResourceLoadedEvent<ShaderProgram>>(
+					name,
+					false,
+					nullptr,
+					callback
+				);
+				return;
+			}
+
+			// Have the loading thread compile and link the shaders.
+			m_loadingThreadEventReceiver.Enqueue<Event::UploadResourceEvent>(
+				[this, name, vertexShaderPath, fragmentShaderPath, vertexShaderSource, fragmentShaderSource, callback]()
+			{
+				// Create vertex and fragment shaders.
+				Shader vertexShader(Shader::Type::VertexShader);
+				Shader fragmentShader(Shader::Type::FragmentShader);
+
+				// Compile the vertex and fragment shaders.
+				if (vertexShader.Compile(vertexShaderSource, vertexShaderPath) &&
+					fragmentShader.Compile(fragmentShaderSource, fragmentShaderPath))
+				{
+					// Create a shader program.
+					std::shared_ptr<ShaderProgram> shaderProgram = std::make_shared<ShaderProgram>();
+
+					// Attach the shaders to the shader program.
+					shaderProgram->AttachShader(vertexShader);
+					shaderProgram->AttachShader(fragmentShader);
+
+					// Link the shader program.
+					if (shaderProgram->Link())
+					{
+						m_gameThreadEventReceiver->Enqueue<Event::ResourceLoadedEvent<ShaderProgram>>(
+							name,
+							true,
+							shaderProgram,
+							callback
+						);
+
+						// We are done.
+						return;
+					}
+					else
+					{
+						std::cout << "Unable to link shaders: " << vertexShaderPath
+							<< ", " << fragmentShaderPath << std::endl;
+					}
+				}
+				else
+				{
+					std::cout << "Unable to compile shaders: " << vertexShaderPath
+						<< ", " << fragmentShaderPath << std::endl;
+				}
+
+				// Something went wrong if we reach this point.
+				m_gameThreadEventReceiver->Enqueue<Event::ResourceLoadedEvent<ShaderProgram>>(
+					name,
+					false,
+					nullptr,
+					callback
+				);
+			});
+		});
 	}
 
 	void ResourceLoader::HandleLoadTextureResourceEvent(const Event::LoadTextureResourceEvent& event)
 	{
-		// Create a new empty texture.
-		std::shared_ptr<Texture> texture = std::make_shared<Texture>();
-
-		// Try to initialize the texture by loading it from a file.
-		bool success = texture->LoadFromFile(event.GetPath());
+		const std::string name = event.GetName();
+		const std::string filepath = event.GetPath();
+		const std::function<void(const Event::ResourceLoadedEvent<Texture>&)> callback = event.GetCallback();
 
-		// Publish a ResourceLoadedEvent to the game thread receiver.
-		m_gameThreadEventReceiver->Enqueue<Event::ResourceLoadedEvent<Texture>>(
-			event.GetName(),
-			success,
-			texture,
-			event.GetCallback()
-		);
+		// Decode the image on a worker thread.
+		m_workerPool.Submit(static_cast<unsigned int>(event.GetPriority()), [this, name, filepath, callback]()
+		{
+			unsigned int width = 0;
+			unsigned int height = 0;
+			std::shared_ptr<std::vector<unsigned char>> pixels = std::make_shared<std::vector<unsigned char>>();
+			ResourcePack::Blob blob;
+			const bool success = m_resourcePack.Read(filepath, blob) ?
+				Texture::DecodeMemory(blob.GetData(), blob.GetSize(), filepath, width, height, *pixels) :
+				Texture::DecodeFile(filepath, width, height, *pixels);
+
+			// Have the loading thread create the texture and send the pixels
+			// over to the graphics card.
+			// Note: An empty texture is still created if decoding failed,
+			// since creating a texture object requires an OpenGL context.
+			m_loadingThreadEventReceiver.Enqueue<Event::UploadResourceEvent>([this, name, success, width, height, pixels, callback]()
+			{
+				std::shared_ptr<Texture> texture = std::make_shared<Texture>();
+				if (success)
+				{
+					texture->Create(width, height, std::move(*pixels));
+					texture->Upload();
+				}
+
+				// Publish a ResourceLoadedEvent to the game thread receiver.
+				m_gameThreadEventReceiver->Enqueue<Event::ResourceLoadedEvent<Texture>>(
+					name,
+					success,
+					texture,
+					callback
+				);
+			});
+		});
 	}
 
 	void ResourceLoader::HandleLoadAudioResourceEvent(const Event::LoadAudioResourceEvent& event)
 	{
+		const std::string name = event.GetName();
 		const std::string filepath = event.GetPath();
+		const std::function<void(const Event::ResourceLoadedEvent<IAudioSource>&)> callback = event.GetCallback();
 		const std::string extension = filepath.substr(filepath.find_last_of(".") + 1);
 
 		if (extension == "wav")
 		{
-			// Create a new empty wave file audio source.
-			std::shared_ptr<WaveFile> source = std::make_shared<WaveFile>();
-
-			// Try to initialize the audio source by loading it from a file.
-			bool success = source->LoadFromFile(filepath);
-
-			// Publish a ResourceLoadedEvent to the game thread receiver.
-			m_gameThreadEventReceiver->Enqueue<Event::ResourceLoadedEvent<IAudioSource>>(
-				event.GetName(),
-				success,
-				source,
-				event.GetCallback()
-			);
+			// Audio sources are not uploaded anywhere, so they are loaded
+			// entirely on a worker thread.
+			m_workerPool.Submit(static_cast<unsigned int>(event.GetPriority()), [this, name, filepath, callback]()
+			{
+				// Create a new empty wave file audio source.
+				std::shared_ptr<WaveFile> source = std::make_shared<WaveFile>();
+
+				// Try to initialize the audio source by loading it from a file.
+				ResourcePack::Blob blob;
+				const bool success = m_resourcePack.Read(filepath, blob) ?
+					source->LoadFromMemory(blob.GetData(), blob.GetSize(), filepath) :
+					source->LoadFromFile(filepath);
+
+				// Publish a ResourceLoadedEvent to the game thread receiver.
+				m_gameThreadEventReceiver->Enqueue<Event::ResourceLoadedEvent<IAudioSource>>(
+					name,
+					success,
+					source,
+					callback
+				);
+			});
 		}
 		else
 		{
@@ -196,19 +543,33 @@ namespace Engine
 	}
 
 
-	ResourceManager::ResourceManager(std::shared_ptr<Window> loadingWindow)
+	const ResourceManager::GroupID ResourceManager::PersistentGroup;
+
+	const char* const ResourceManager::DefaultResourcePackPath = "resources.pack";
+
+	ResourceManager::ResourceManager(std::shared_ptr<Window> loadingWindow, std::string resourcePackPath)
 	: m_gameThreadEventReceiver(std::make_shared<ThreadEventReceiver>())
 	, m_shaderPrograms()
+	, m_shaderProgramFilepaths()
 	, m_models()
 	, m_textures()
 	, m_audioSources()
-	, m_resourceLoader(m_gameThreadEventReceiver, loadingWindow)
+	, m_groups()
+	, m_bundles()
+	, m_nextGroupID(PersistentGroup + 1)
+	, m_cpuMemoryBudget(0)
+	, m_gpuMemoryBudget(0)
+	, m_clock(0)
+	, m_resourceLoader(m_gameThreadEventReceiver, loadingWindow, resourcePackPath)
 	, m_loadingThread(&ResourceLoader::Run, &m_resourceLoader)
 	, m_modelResourceLoadedSubscription(0)
 	, m_shaderProgramResourceLoadedSubscription(0)
 	, m_textureResourceLoadedSubscription(0)
 	, m_audioResourceLoadedSubscription(0)
 	{
+		// Create the persistent group.
+		m_groups[PersistentGroup];
+
 		// Subscribe to receive events in the main game thread.
 		m_modelResourceLoadedSubscription = m_gameThreadEventReceiver->Subscribe<Event::ResourceLoadedEvent<Model>>(CALLBACK(ResourceManager::HandleModelResourceLoadedEvent));
 		m_shaderProgramResourceLoadedSubscription = m_gameThreadEventReceiver->Subscribe<Event::ResourceLoadedEvent<ShaderProgram>>(CALLBACK(ResourceManager::HandleShaderProgramResourceLoadedEvent));
@@ -224,6 +585,10 @@ namespace Engine
 		m_gameThreadEventReceiver->Unsubscribe<Event::ResourceLoadedEvent<Texture>>(m_textureResourceLoadedSubscription);
 		m_gameThreadEventReceiver->Unsubscribe<Event::ResourceLoadedEvent<IAudioSource>>(m_audioResourceLoadedSubscription);
 
+		// The game thread no longer receives loaded resources, so the
+		// loading thread must not wait for room in its queue.
+		m_gameThreadEventReceiver->Stop();
+
 		// Publish a StopThreadEvent to the loading thread's
 		// event receiver.
 		m_resourceLoader.GetReceiver().Enqueue<Event::StopThreadEvent>();
@@ -234,22 +599,442 @@ namespace Engine
 
 	void ResourceManager::Update()
 	{
+		// Advance the clock against which resource use is recorded.
+		++m_clock;
+		m_shaderPrograms.SetClock(m_clock);
+		m_models.SetClock(m_clock);
+		m_textures.SetClock(m_clock);
+		m_audioSources.SetClock(m_clock);
+
 		m_gameThreadEventReceiver->Update();
+
+		// Keep the bundles loading, and forget the ones that are complete.
+		for (auto iter = m_bundles.begin(); iter != m_bundles.end();)
+		{
+			UpdateBundle(**iter);
+			if ((*iter)->IsComplete())
+			{
+				iter = m_bundles.erase(iter);
+			}
+			else
+			{
+				++iter;
+			}
+		}
+
+		EnforceMemoryBudget();
+	}
+
+	std::shared_ptr<ResourceBundle> ResourceManager::LoadBundle(const ResourceManifest& manifest)
+	{
+		std::shared_ptr<ResourceBundle> bundle = std::make_shared<ResourceBundle>(manifest,
+			[this](const ResourceManifest::Entry& entry) -> std::size_t
+			{
+				switch (entry.kind)
+				{
+					case ResourceManifest::Kind::ShaderProgram:
+						return m_resourceLoader.GetFileSize(entry.path) + m_resourceLoader.GetFileSize(entry.secondaryPath);
+					case ResourceManifest::Kind::Model:
+						return m_resourceLoader.GetModelFileSize(entry.path);
+					default:
+						return m_resourceLoader.GetFileSize(entry.path);
+				}
+			}
+		);
+
+		// Start on the highest priority resources straight away.
+		UpdateBundle(*bundle);
+		if (!bundle->IsComplete())
+		{
+			m_bundles.push_back(bundle);
+		}
+
+		return bundle;
+	}
+
+	void ResourceManager::UpdateBundle(ResourceBundle& bundle)
+	{
+		bundle.Update(
+			[this](const ResourceManifest::Entry& entry) { return GetRequestStatus(entry); },
+			[this](const ResourceManifest::Entry& entry) { RequestEntry(entry); }
+		);
+	}
+
+	ResourceBundle::RequestStatus ResourceManager::GetRequestStatus(const ResourceManifest::Entry& entry) const
+	{
+		switch (entry.kind)
+		{
+			case ResourceManifest::Kind::ShaderProgram:
+				return GetTableRequestStatus(m_shaderPrograms,
+					m_shaderPrograms.Find(GetShaderProgramResourceName(entry.path, entry.secondaryPath)));
+			case ResourceManifest::Kind::Model:
+				return GetTableRequestStatus(m_models, m_models.Find(GetModelResourceName(entry.path)));
+			case ResourceManifest::Kind::Texture:
+				return GetTableRequestStatus(m_textures, m_textures.Find(GetTextureResourceName(entry.path)));
+			case ResourceManifest::Kind::Audio:
+				return GetTableRequestStatus(m_audioSources, m_audioSources.Find(GetAudioResourceName(entry.path)));
+		}
+
+		assert(0);
+		return ResourceBundle::RequestStatus::Failed;
+	}
+
+	void ResourceManager::RequestEntry(const ResourceManifest::Entry& entry)
+	{
+		// Resources that have already been loaded, or are being loaded, only
+		// need to be added to the group.
+		switch (entry.kind)
+		{
+			case ResourceManifest::Kind::ShaderProgram:
+			{
+				const ResourceHandle<ShaderProgram> handle = GetShaderProgramHandle(entry.path, entry.secondaryPath);
+				if (m_shaderPrograms.IsRequested(handle))
+				{
+					AddToGroup(entry.group, handle);
+				}
+				else
+				{
+					LoadShaderProgram(entry.path, entry.secondaryPath,
+						[](const Event::ResourceLoadedEvent<ShaderProgram>& event) { /* Nothing to do. */ },
+						entry.priority, entry.group);
+				}
+				break;
+			}
+
+			case ResourceManifest::Kind::Model:
+			{
+				const ResourceHandle<Model> handle = GetModelHandle(entry.path);
+				if (m_models.IsRequested(handle))
+				{
+					AddToGroup(entry.group, handle);
+				}
+				else
+				{
+					LoadModel(entry.path,
+						[](const Event::ResourceLoadedEvent<Model>& event) { /* Nothing to do. */ },
+						entry.priority, entry.group);
+				}
+				break;
+			}
+
+			case ResourceManifest::Kind::Texture:
+			{
+				const ResourceHandle<Texture> handle = GetTextureHandle(entry.path);
+				if (m_textures.IsRequested(handle))
+				{
+					AddToGroup(entry.group, handle);
+				}
+				else
+				{
+					LoadTexture(entry.path,
+						[](const Event::ResourceLoadedEvent<Texture>& event) { /* Nothing to do. */ },
+						entry.priority, entry.group);
+				}
+				break;
+			}
+
+			case ResourceManifest::Kind::Audio:
+			{
+				const ResourceHandle<IAudioSource> handle = GetAudioHandle(entry.path);
+				if (m_audioSources.IsRequested(handle))
+				{
+					AddToGroup(entry.group, handle);
+				}
+				else
+				{
+					LoadAudio(entry.path,
+						[](const Event::ResourceLoadedEvent<IAudioSource>& event) { /* Nothing to do. */ },
+						entry.priority, entry.group);
+				}
+				break;
+			}
+		}
+	}
+
+	void ResourceManager::SetMemoryBudget(std::size_t cpuBytes, std::size_t gpuBytes)
+	{
+		m_cpuMemoryBudget = cpuBytes;
+		m_gpuMemoryBudget = gpuBytes;
+	}
+
+	ResourceManager::MemoryReport ResourceManager::GetMemoryReport() const
+	{
+		MemoryReport report;
+		report.shaderPrograms = m_shaderPrograms.GetUsage();
+		report.models = m_models.GetUsage();
+		report.textures = m_textures.GetUsage();
+		report.audioSources = m_audioSources.GetUsage();
+		return report;
+	}
+
+	void ResourceManager::PrintMemoryReport(std::ostream& stream) const
+	{
+		const MemoryReport report = GetMemoryReport();
+
+		stream << std::left << std::setw(16) << "Type" << std::right
+			<< std::setw(10) << "Resident"
+			<< std::setw(12) << "Referenced"
+			<< std::setw(16) << "CPU Bytes"
+			<< std::setw(16) << "GPU Bytes" << std::endl;
+		PrintMemoryReportRow(stream, "Shader Programs", report.shaderPrograms);
+		PrintMemoryReportRow(stream, "Models", report.models);
+		PrintMemoryReportRow(stream, "Textures", report.textures);
+		PrintMemoryReportRow(stream, "Audio Sources", report.audioSources);
+	}
+
+	ResourceManager::GroupID ResourceManager::CreateGroup()
+	{
+		const GroupID group = m_nextGroupID++;
+		m_groups[group];
+		return group;
+	}
+
+	void ResourceManager::ReleaseGroup(GroupID group)
+	{
+		assert(group != PersistentGroup);
+
+		auto iter = m_groups.find(group);
+		if (iter != m_groups.end())
+		{
+			ReleaseGroupMembers(m_shaderPrograms, iter->second.shaderPrograms);
+			ReleaseGroupMembers(m_models, iter->second.models);
+			ReleaseGroupMembers(m_textures, iter->second.textures);
+			ReleaseGroupMembers(m_audioSources, iter->second.audioSources);
+			m_groups.erase(iter);
+		}
+	}
+
+	void ResourceManager::AddToGroup(GroupID group, ResourceHandle<ShaderProgram> handle)
+	{
+		assert(m_groups.find(group) != m_groups.end());
+		if (AddGroupMember(m_groups[group].shaderPrograms, handle))
+		{
+			AddReference(handle);
+		}
+	}
+
+	void ResourceManager::AddToGroup(GroupID group, ResourceHandle<Model> handle)
+	{
+		assert(m_groups.find(group) != m_groups.end());
+		if (AddGroupMember(m_groups[group].models, handle))
+		{
+			AddReference(handle);
+		}
+	}
+
+	void ResourceManager::AddToGroup(GroupID group, ResourceHandle<Texture> handle)
+	{
+		assert(m_groups.find(group) != m_groups.end());
+		if (AddGroupMember(m_groups[group].textures, handle))
+		{
+			AddReference(handle);
+		}
+	}
+
+	void ResourceManager::AddToGroup(GroupID group, ResourceHandle<IAudioSource> handle)
+	{
+		assert(m_groups.find(group) != m_groups.end());
+		if (AddGroupMember(m_groups[group].audioSources, handle))
+		{
+			AddReference(handle);
+		}
+	}
+
+	void ResourceManager::AddReference(ResourceHandle<ShaderProgram> handle)
+	{
+		if (m_shaderPrograms.AddReference(handle))
+		{
+			Reload(handle);
+		}
+	}
+
+	void ResourceManager::AddReference(ResourceHandle<Model> handle)
+	{
+		if (m_models.AddReference(handle))
+		{
+			Reload(handle);
+		}
+	}
+
+	void ResourceManager::AddReference(ResourceHandle<Texture> handle)
+	{
+		if (m_textures.AddReference(handle))
+		{
+			Reload(handle);
+		}
+	}
+
+	void ResourceManager::AddReference(ResourceHandle<IAudioSource> handle)
+	{
+		if (m_audioSources.AddReference(handle))
+		{
+			Reload(handle);
+		}
+	}
+
+	void ResourceManager::ReleaseReference(ResourceHandle<ShaderProgram> handle)
+	{
+		m_shaderPrograms.ReleaseReference(handle);
+	}
+
+	void ResourceManager::ReleaseReference(ResourceHandle<Model> handle)
+	{
+		m_models.ReleaseReference(handle);
+	}
+
+	void ResourceManager::ReleaseReference(ResourceHandle<Texture> handle)
+	{
+		m_textures.ReleaseReference(handle);
+	}
+
+	void ResourceManager::ReleaseReference(ResourceHandle<IAudioSource> handle)
+	{
+		m_audioSources.ReleaseReference(handle);
+	}
+
+	void ResourceManager::EnforceMemoryBudget()
+	{
+		if (m_cpuMemoryBudget == 0 && m_gpuMemoryBudget == 0)
+		{
+			return;
+		}
+
+		const MemoryReport report = GetMemoryReport();
+		std::size_t cpuBytes = report.shaderPrograms.cpuBytes + report.models.cpuBytes
+			+ report.textures.cpuBytes + report.audioSources.cpuBytes;
+		std::size_t gpuBytes = report.shaderPrograms.gpuBytes + report.models.gpuBytes
+			+ report.textures.gpuBytes + report.audioSources.gpuBytes;
+
+		auto isOverBudget = [this, &cpuBytes, &gpuBytes]()
+		{
+			return (m_cpuMemoryBudget > 0 && cpuBytes > m_cpuMemoryBudget)
+				|| (m_gpuMemoryBudget > 0 && gpuBytes > m_gpuMemoryBudget);
+		};
+
+		if (!isOverBudget())
+		{
+			return;
+		}
+
+		// Gather the resources that are no longer referenced, and evict the
+		// least recently used ones first.
+		std::vector<EvictionCandidate> candidates;
+		CollectEvictionCandidates<ShaderProgram>(m_shaderPrograms,
+			[this](ResourceHandle<ShaderProgram> handle) { m_shaderPrograms.Evict(handle); }, candidates);
+		CollectEvictionCandidates<Model>(m_models,
+			[this](ResourceHandle<Model> handle) { EvictModel(handle); }, candidates);
+		CollectEvictionCandidates<Texture>(m_textures,
+			[this](ResourceHandle<Texture> handle) { m_textures.Evict(handle); }, candidates);
+		CollectEvictionCandidates<IAudioSource>(m_audioSources,
+			[this](ResourceHandle<IAudioSource> handle) { m_audioSources.Evict(handle); }, candidates);
+
+		std::sort(candidates.begin(), candidates.end(),
+			[](const EvictionCandidate& one, const EvictionCandidate& two)
+			{
+				return one.lastUsed < two.lastUsed;
+			}
+		);
+
+		for (auto iter = candidates.begin(); iter != candidates.end() && isOverBudget(); ++iter)
+		{
+			iter->evict();
+			cpuBytes -= iter->cpuBytes;
+			gpuBytes -= iter->gpuBytes;
+		}
+	}
+
+	void ResourceManager::EvictModel(ResourceHandle<Model> handle)
+	{
+		// Release the model's references to its textures, which may then be
+		// evicted in turn.
+		std::shared_ptr<Model> model = m_models.Get(handle);
+		if (model)
+		{
+			const unsigned int materialCount = model->GetMaterialCount();
+			for (unsigned int m = 0; m < materialCount; ++m)
+			{
+				const ResourceHandle<Texture> texture = model->GetMaterial(m)->GetDiffuseTexture();
+				if (texture.IsValid())
+				{
+					m_textures.ReleaseReference(texture);
+				}
+			}
+		}
+
+		m_models.Evict(handle);
+	}
+
+	void ResourceManager::Reload(ResourceHandle<ShaderProgram> handle)
+	{
+		// The file paths were recorded when the shader program was
+		// first requested.
+		const auto& filepaths = m_shaderProgramFilepaths.at(handle.GetIndex());
+		m_shaderPrograms.SetRequested(handle, true);
+		m_resourceLoader.GetReceiver().Enqueue<Event::LoadShaderProgramResourceEvent>(
+			m_shaderPrograms.GetName(handle),
+			filepaths.first,
+			filepaths.second,
+			[](const Event::ResourceLoadedEvent<ShaderProgram>& event) { /* Nothing to do. */ },
+			ResourcePriority::Normal
+		);
+	}
+
+	void ResourceManager::Reload(ResourceHandle<Model> handle)
+	{
+		// Model names are their file paths.
+		const std::string& name = m_models.GetName(handle);
+		m_models.SetRequested(handle, true);
+		m_resourceLoader.GetReceiver().Enqueue<Event::LoadModelResourceEvent>(name, name,
+			[](const Event::ResourceLoadedEvent<Model>& event) { /* Nothing to do. */ },
+			ResourcePriority::Normal);
+	}
+
+	void ResourceManager::Reload(ResourceHandle<Texture> handle)
+	{
+		// Texture names are their file paths.
+		const std::string& name = m_textures.GetName(handle);
+		m_textures.SetRequested(handle, true);
+		m_resourceLoader.GetReceiver().Enqueue<Event::LoadTextureResourceEvent>(name, name,
+			[](const Event::ResourceLoadedEvent<Texture>& event) { /* Nothing to do. */ },
+			ResourcePriority::Normal);
+	}
+
+	void ResourceManager::Reload(ResourceHandle<IAudioSource> handle)
+	{
+		// Audio source names are their file paths.
+		const std::string& name = m_audioSources.GetName(handle);
+		m_audioSources.SetRequested(handle, true);
+		m_resourceLoader.GetReceiver().Enqueue<Event::LoadAudioResourceEvent>(name, name,
+			[](const Event::ResourceLoadedEvent<IAudioSource>& event) { /* Nothing to do. */ },
+			ResourcePriority::Normal);
+	}
+
+	void ResourceManager::SetLoadingFrameBudget(std::chrono::microseconds budget)
+	{
+		m_resourceLoader.SetFrameBudget(budget);
 	}
 
 	void ResourceManager::LoadShaderProgram(std::string vertexShaderFilepath,
 		std::string fragmentShaderFilepath,
-		std::function<void(const Event::ResourceLoadedEvent<ShaderProgram>&)> callback)
+		std::function<void(const Event::ResourceLoadedEvent<ShaderProgram>&)> callback,
+		ResourcePriority priority,
+		GroupID group)
 	{
 		// Unique name for the shader program.
 		const std::string name = GetShaderProgramResourceName(vertexShaderFilepath, fragmentShaderFilepath);
 
 		// Ensure that the shader program has not already been loaded and
 		// is not in the process of being loaded.
-		assert(m_shaderPrograms.find(name) == m_shaderPrograms.end());
+		const ResourceHandle<ShaderProgram> handle = m_shaderPrograms.Intern(name);
+		assert(!m_shaderPrograms.IsRequested(handle));
 
-		// Create an null entry in the shader programs map.
-		m_shaderPrograms[name] = nullptr;
+		// Mark the shader program as requested. The slot stays empty until
+		// the shader program has been loaded.
+		m_shaderPrograms.SetRequested(handle, true);
+		m_shaderProgramFilepaths[handle.GetIndex()] = std::make_pair(vertexShaderFilepath, fragmentShaderFilepath);
+
+		// Keep the resource for as long as the group is alive.
+		AddToGroup(group, handle);
 
 		// Pubish a LoadShaderProgramResourceEvent so that the loading thread
 		// can start on loading the resource.
@@ -257,134 +1042,182 @@ namespace Engine
 			name,
 			vertexShaderFilepath,
 			fragmentShaderFilepath,
-			callback
+			callback,
+			priority
 		);
 	}
 
-	std::shared_ptr<ShaderProgram> ResourceManager::GetShaderProgram(std::string vertexShaderFilepath,
-		std::string fragmentShaderFilepath)
+	ResourceHandle<ShaderProgram> ResourceManager::GetShaderProgramHandle(const std::string& vertexShaderFilepath,
+		const std::string& fragmentShaderFilepath)
 	{
-		auto iter = m_shaderPrograms.find(GetShaderProgramResourceName(vertexShaderFilepath, fragmentShaderFilepath));
-		if (iter != m_shaderPrograms.end())
-		{
-			std::shared_ptr<ShaderProgram> resource = iter->second;
-			return resource;
-		}
-		else
-		{
-			return nullptr;
-		}
+		return m_shaderPrograms.Intern(GetShaderProgramResourceName(vertexShaderFilepath, fragmentShaderFilepath));
+	}
+
+	std::shared_ptr<ShaderProgram> ResourceManager::GetShaderProgram(ResourceHandle<ShaderProgram> handle) const
+	{
+		return m_shaderPrograms.Get(handle);
+	}
+
+	std::shared_ptr<ShaderProgram> ResourceManager::GetShaderProgram(const std::string& vertexShaderFilepath,
+		const std::string& fragmentShaderFilepath) const
+	{
+		return m_shaderPrograms.Get(m_shaderPrograms.Find(GetShaderProgramResourceName(vertexShaderFilepath, fragmentShaderFilepath)));
 	}
 
 	void ResourceManager::LoadModel(std::string filepath,
-		std::function<void(const Event::ResourceLoadedEvent<Model>&)> callback)
+		std::function<void(const Event::ResourceLoadedEvent<Model>&)> callback,
+		ResourcePriority priority,
+		GroupID group)
 	{
 		// Unique name for the model.
 		const std::string name = GetModelResourceName(filepath);
 
 		// Ensure that the model has not already been loaded and
 		// is not in the process of being loaded.
-		assert(m_models.find(name) == m_models.end());
+		const ResourceHandle<Model> handle = m_models.Intern(name);
+		assert(!m_models.IsRequested(handle));
+
+		// Mark the model as requested. The slot stays empty until the model
+		// has been loaded.
+		m_models.SetRequested(handle, true);
 
-		// Create an null entry in the models map.
-		m_models[name] = nullptr;
+		// Keep the resource for as long as the group is alive.
+		AddToGroup(group, handle);
 
 		// Pubish a LoadModelResourceEvent so that the loading thread
 		// can start on loading the resource.
-		m_resourceLoader.GetReceiver().Enqueue<Event::LoadModelResourceEvent>(name, filepath, callback);
+		m_resourceLoader.GetReceiver().Enqueue<Event::LoadModelResourceEvent>(name, filepath, callback, priority);
 	}
 
-	std::shared_ptr<Model> ResourceManager::GetModel(std::string filepath)
+	ResourceHandle<Model> ResourceManager::GetModelHandle(const std::string& filepath)
 	{
-		auto iter = m_models.find(GetModelResourceName(filepath));
-		if (iter != m_models.end())
-		{
-			std::shared_ptr<Model> resource = iter->second;
-			return resource;
-		}
-		else
-		{
-			return nullptr;
-		}
+		return m_models.Intern(GetModelResourceName(filepath));
+	}
+
+	std::shared_ptr<Model> ResourceManager::GetModel(ResourceHandle<Model> handle) const
+	{
+		return m_models.Get(handle);
+	}
+
+	std::shared_ptr<Model> ResourceManager::GetModel(const std::string& filepath) const
+	{
+		return m_models.Get(m_models.Find(GetModelResourceName(filepath)));
 	}
 
 	void ResourceManager::LoadTexture(std::string filepath,
-		std::function<void(const Event::ResourceLoadedEvent<Texture>&)> callback)
+		std::function<void(const Event::ResourceLoadedEvent<Texture>&)> callback,
+		ResourcePriority priority,
+		GroupID group)
 	{
 		// Unique name for the texture.
 		const std::string name = GetTextureResourceName(filepath);
 
 		// Ensure that the texture has not already been loaded and
 		// is not in the process of being loaded.
-		assert(m_textures.find(name) == m_textures.end());
+		const ResourceHandle<Texture> handle = m_textures.Intern(name);
+		assert(!m_textures.IsRequested(handle));
 
-		// Create a null entry in the textures map.
-		m_textures[name] = nullptr;
+		// Mark the texture as requested. The slot stays empty until the
+		// texture has been loaded.
+		m_textures.SetRequested(handle, true);
+
+		// Keep the resource for as long as the group is alive.
+		AddToGroup(group, handle);
 
 		// Publish a LoadTextureResourceEvent so that the loading
 		// thread can start loading the texture.
-		m_resourceLoader.GetReceiver().Enqueue<Event::LoadTextureResourceEvent>(name, filepath, callback);
+		m_resourceLoader.GetReceiver().Enqueue<Event::LoadTextureResourceEvent>(name, filepath, callback, priority);
 	}
 
-	std::shared_ptr<Texture> ResourceManager::GetTexture(std::string filepath)
+	ResourceHandle<Texture> ResourceManager::GetTextureHandle(const std::string& filepath)
 	{
-		auto iter = m_textures.find(GetTextureResourceName(filepath));
-		if (iter != m_textures.end())
-		{
-			std::shared_ptr<Texture> resource = iter->second;
-			return resource;
-		}
-		else
-		{
-			return nullptr;
-		}
+		return m_textures.Intern(GetTextureResourceName(filepath));
+	}
+
+	std::shared_ptr<Texture> ResourceManager::GetTexture(ResourceHandle<Texture> handle) const
+	{
+		return m_textures.Get(handle);
+	}
+
+	std::shared_ptr<Texture> ResourceManager::GetTexture(const std::string& filepath) const
+	{
+		return m_textures.Get(m_textures.Find(GetTextureResourceName(filepath)));
 	}
 
 	void ResourceManager::LoadAudio(std::string filepath,
-		std::function<void(const Event::ResourceLoadedEvent<IAudioSource>&)> callback)
+		std::function<void(const Event::ResourceLoadedEvent<IAudioSource>&)> callback,
+		ResourcePriority priority,
+		GroupID group)
 	{
 		// Unique name for the audio source.
 		const std::string name = GetAudioResourceName(filepath);
 
 		// Ensure that the audio source has not already been loaded and
 		// is not in the process of being loaded.
-		assert(m_audioSources.find(name) == m_audioSources.end());
+		const ResourceHandle<IAudioSource> handle = m_audioSources.Intern(name);
+		assert(!m_audioSources.IsRequested(handle));
 
-		// Create a null entry in the audio sources map.
-		m_audioSources[name] = nullptr;
+		// Mark the audio source as requested. The slot stays empty until the
+		// audio source has been loaded.
+		m_audioSources.SetRequested(handle, true);
+
+		// Keep the resource for as long as the group is alive.
+		AddToGroup(group, handle);
 
 		// Publish a LoadAudioResourceEvent so that the loading
 		// thread can start loading the audio source.
-		m_resourceLoader.GetReceiver().Enqueue<Event::LoadAudioResourceEvent>(name, filepath, callback);
+		m_resourceLoader.GetReceiver().Enqueue<Event::LoadAudioResourceEvent>(name, filepath, callback, priority);
 	}
 
-	std::shared_ptr<IAudioSource> ResourceManager::GetAudio(std::string filepath)
+	ResourceHandle<IAudioSource> ResourceManager::GetAudioHandle(const std::string& filepath)
 	{
-		auto iter = m_audioSources.find(GetAudioResourceName(filepath));
-		if (iter != m_audioSources.end())
-		{
-			std::shared_ptr<IAudioSource> resource = iter->second;
-			return resource;
-		}
-		else
-		{
-			return nullptr;
-		}
+		return m_audioSources.Intern(GetAudioResourceName(filepath));
+	}
+
+	std::shared_ptr<IAudioSource> ResourceManager::GetAudio(ResourceHandle<IAudioSource> handle) const
+	{
+		return m_audioSources.Get(handle);
+	}
+
+	std::shared_ptr<IAudioSource> ResourceManager::GetAudio(const std::string& filepath) const
+	{
+		return m_audioSources.Get(m_audioSources.Find(GetAudioResourceName(filepath)));
 	}
 
 	void ResourceManager::HandleModelResourceLoadedEvent(const Event::ResourceLoadedEvent<Model>& event)
 	{
+		const ResourceHandle<Model> handle = m_models.Find(event.GetName());
+		assert(m_models.IsRequested(handle));
+
 		if (event.WasSuccessful())
 		{
-			assert(event.GetResource());
+			std::shared_ptr<Model> model = event.GetResource();
+			assert(model);
+
+			// Resolve the handles to the materials' diffuse textures now, so
+			// that the renderer does not need to look them up by path.
+			const unsigned int materialCount = model->GetMaterialCount();
+			for (unsigned int m = 0; m < materialCount; ++m)
+			{
+				std::shared_ptr<Model::Material> material = model->GetMaterial(m);
+				const std::string diffuseTexturePath = material->GetDiffuseTexturePath();
+				if (diffuseTexturePath.length() > 0)
+				{
+					// The model keeps its textures until it is evicted. A
+					// texture that was evicted with the model is reloaded.
+					const ResourceHandle<Texture> texture = GetTextureHandle(diffuseTexturePath);
+					AddReference(texture);
+					material->SetDiffuseTexture(texture);
+				}
+			}
 
-			// Save the pointer to the model in the list of model resources.
-			m_models[event.GetName()] = event.GetResource();
+			// Save the pointer to the model in the model's slot.
+			m_models.Set(handle, model, model->GetCPUMemoryUsage(), model->GetGPUMemoryUsage());
 		}
 		else
 		{
-			// Remove any entry to the resource in the models map.
-			m_models.erase(m_models.find(event.GetName()));
+			// Allow the model to be requested again.
+			m_models.SetRequested(handle, false);
 		}
 
 		// Execute the callback.
@@ -393,18 +1226,22 @@ namespace Engine
 
 	void ResourceManager::HandleShaderProgramResourceLoadedEvent(const Event::ResourceLoadedEvent<ShaderProgram>& event)
 	{
+		const ResourceHandle<ShaderProgram> handle = m_shaderPrograms.Find(event.GetName());
+		assert(m_shaderPrograms.IsRequested(handle));
+
 		if (event.WasSuccessful())
 		{
 			assert(event.GetResource());
 
-			// Save the pointer to the shader program in the list of
-			// shader program resources.
-			m_shaderPrograms[event.GetName()] = event.GetResource();
+			// Save the pointer to the shader program in the shader program's
+			// slot.
+			// The size of linked programs is not known.
+			m_shaderPrograms.Set(handle, event.GetResource());
 		}
 		else
 		{
-			// Remove any entry to the resource in the shader program map.
-			m_shaderPrograms.erase(m_shaderPrograms.find(event.GetName()));
+			// Allow the shader program to be requested again.
+			m_shaderPrograms.SetRequested(handle, false);
 		}
 
 		// Execute the callback.
@@ -413,17 +1250,21 @@ namespace Engine
 
 	void ResourceManager::HandleTextureResourceLoadedEvent(const Event::ResourceLoadedEvent<Texture>& event)
 	{
+		const ResourceHandle<Texture> handle = m_textures.Find(event.GetName());
+		assert(m_textures.IsRequested(handle));
+
 		if (event.WasSuccessful())
 		{
 			assert(event.GetResource());
 
-			// Save the pointer to the texture in the list of texture resources.
-			m_textures[event.GetName()] = event.GetResource();
+			// Save the pointer to the texture in the texture's slot.
+			m_textures.Set(handle, event.GetResource(),
+				event.GetResource()->GetCPUMemoryUsage(), event.GetResource()->GetGPUMemoryUsage());
 		}
 		else
 		{
-			// Remove any entry to the resource in the textures map.
-			m_textures.erase(m_textures.find(event.GetName()));
+			// Allow the texture to be requested again.
+			m_textures.SetRequested(handle, false);
 		}
 
 		// Execute the callback.
@@ -432,17 +1273,22 @@ namespace Engine
 
 	void ResourceManager::HandleAudioResourceLoadedEvent(const Event::ResourceLoadedEvent<IAudioSource>& event)
 	{
+		const ResourceHandle<IAudioSource> handle = m_audioSources.Find(event.GetName());
+		assert(m_audioSources.IsRequested(handle));
+
 		if (event.WasSuccessful())
 		{
 			assert(event.GetResource());
 
-			// Save the pointer to the audio source in the list of audio resources.
-			m_audioSources[event.GetName()] = event.GetResource();
+			// Save the pointer to the audio source in the audio source's slot.
+			// Samples are held as 16-bit integers.
+			m_audioSources.Set(handle, event.GetResource(),
+				event.GetResource()->GetSamplesCount() * sizeof(std::int16_t), 0);
 		}
 		else
 		{
-			// Remove any entry to the resource in the audio sources map.
-			m_audioSources.erase(m_audioSources.find(event.GetName()));
+			// Allow the audio source to be requested again.
+			m_audioSources.SetRequested(handle, false);
 		}
 
 		// Execute the callback.
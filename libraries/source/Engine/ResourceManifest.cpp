@@ -0,0 +1,67 @@
+#include <Engine/ResourceManifest.hpp>
+
+#include <utility>
+
+namespace Engine
+{
+	ResourceManifest::ResourceManifest()
+	: m_entries()
+	{
+		// Nothing to do.
+	}
+
+	ResourceManifest::~ResourceManifest()
+	{
+		// Nothing to do.
+	}
+
+	void ResourceManifest::AddShaderProgram(std::string vertexShaderFilepath,
+		std::string fragmentShaderFilepath,
+		ResourcePriority priority,
+		ResourceGroupID group)
+	{
+		AddEntry(Kind::ShaderProgram, std::move(vertexShaderFilepath), std::move(fragmentShaderFilepath), priority, group);
+	}
+
+	void ResourceManifest::AddModel(std::string filepath, ResourcePriority priority, ResourceGroupID group)
+	{
+		AddEntry(Kind::Model, std::move(filepath), std::string(), priority, group);
+	}
+
+	void ResourceManifest::AddTexture(std::string filepath, ResourcePriority priority, ResourceGroupID group)
+	{
+		AddEntry(Kind::Texture, std::move(filepath), std::string(), priority, group);
+	}
+
+	void ResourceManifest::AddAudio(std::string filepath, ResourcePriority priority, ResourceGroupID group)
+	{
+		AddEntry(Kind::Audio, std::move(filepath), std::string(), priority, group);
+	}
+
+	void ResourceManifest::Append(const ResourceManifest& manifest)
+	{
+		m_entries.insert(m_entries.end(), manifest.m_entries.begin(), manifest.m_entries.end());
+	}
+
+	const std::vector<ResourceManifest::Entry>& ResourceManifest::GetEntries() const
+	{
+		return m_entries;
+	}
+
+	unsigned int ResourceManifest::GetEntryCount() const
+	{
+		return m_entries.size();
+	}
+
+	void ResourceManifest::AddEntry(Kind kind, std::string path, std::string secondaryPath,
+		ResourcePriority priority, ResourceGroupID group)
+	{
+		Entry entry;
+		entry.kind = kind;
+		entry.path = std::move(path);
+		entry.secondaryPath = std::move(secondaryPath);
+		entry.priority = priority;
+		entry.group = group;
+		m_entries.push_back(std::move(entry));
+	}
+}
@@ -0,0 +1,201 @@
+#include <Engine/ResourcePack.hpp>
+
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include <lz4.h>
+
+namespace Engine
+{
+	ResourcePack::Blob::Blob()
+	: m_data(nullptr)
+	, m_size(0)
+	, m_buffer()
+	{
+		// Nothing to do.
+	}
+
+	const unsigned char* ResourcePack::Blob::GetData() const
+	{
+		return m_data;
+	}
+
+	std::size_t ResourcePack::Blob::GetSize() const
+	{
+		return m_size;
+	}
+
+	ResourcePack::ResourcePack()
+	: m_file()
+	, m_entries(nullptr)
+	, m_entryCount(0)
+	{
+		// Nothing to do.
+	}
+
+	ResourcePack::~ResourcePack()
+	{
+		// Nothing to do.
+	}
+
+	bool ResourcePack::Open(std::string filepath)
+	{
+		m_entries = nullptr;
+		m_entryCount = 0;
+
+		if (!m_file.Open(filepath))
+		{
+			return false;
+		}
+
+		const unsigned char* data = m_file.GetData();
+		const std::uint64_t size = m_file.GetSize();
+
+		// Check that the file is a resource pack that we understand.
+		if (size < sizeof(ResourcePackFormat::Header))
+		{
+			std::cerr << "ERROR: Resource pack \"" << filepath << "\" is missing its header" << std::endl;
+			m_file.Close();
+			return false;
+		}
+
+		const ResourcePackFormat::Header& header = *reinterpret_cast<const ResourcePackFormat::Header*>(data);
+		if (std::memcmp(header.magic, ResourcePackFormat::Magic, sizeof(header.magic)) != 0 ||
+			header.version != ResourcePackFormat::Version)
+		{
+			std::cerr << "ERROR: Resource pack \"" << filepath << "\" has an unsupported format or version" << std::endl;
+			m_file.Close();
+			return false;
+		}
+
+		// Validate the index up front, so that lookups do not need to.
+		bool valid = header.indexOffset % alignof(ResourcePackFormat::Entry) == 0
+			&& header.indexOffset <= size
+			&& static_cast<std::uint64_t>(header.entryCount) * sizeof(ResourcePackFormat::Entry) <= size - header.indexOffset;
+
+		const ResourcePackFormat::Entry* entries = valid ?
+			reinterpret_cast<const ResourcePackFormat::Entry*>(data + header.indexOffset) : nullptr;
+
+		for (std::uint32_t e = 0; valid && e < header.entryCount; ++e)
+		{
+			const ResourcePackFormat::Entry& entry = entries[e];
+			valid = entry.offset <= size
+				&& entry.storedSize <= size - entry.offset
+				&& entry.size <= static_cast<std::uint64_t>(std::numeric_limits<int>::max())
+				&& (entry.compression == ResourcePackFormat::Compression::LZ4 ||
+					(entry.compression == ResourcePackFormat::Compression::None && entry.storedSize == entry.size))
+				&& (e == 0 || entries[e - 1].pathHash < entry.pathHash);
+		}
+
+		if (!valid)
+		{
+			std::cerr << "ERROR: Resource pack \"" << filepath << "\" is corrupt" << std::endl;
+			m_file.Close();
+			return false;
+		}
+
+		m_entries = entries;
+		m_entryCount = header.entryCount;
+		return true;
+	}
+
+	bool ResourcePack::IsOpen() const
+	{
+		return m_file.IsOpen();
+	}
+
+	unsigned int ResourcePack::GetResourceCount() const
+	{
+		return m_entryCount;
+	}
+
+	bool ResourcePack::Contains(const std::string& path) const
+	{
+		return FindEntry(path) != nullptr;
+	}
+
+	bool ResourcePack::GetSize(const std::string& path, std::size_t& size) const
+	{
+		const ResourcePackFormat::Entry* entry = FindEntry(path);
+		if (!entry)
+		{
+			return false;
+		}
+
+		size = entry->size;
+		return true;
+	}
+
+	bool ResourcePack::Read(const std::string& path, Blob& blob) const
+	{
+		const ResourcePackFormat::Entry* entry = FindEntry(path);
+		if (!entry)
+		{
+			return false;
+		}
+
+		const unsigned char* storedData = m_file.GetData() + entry->offset;
+
+		if (entry->compression == ResourcePackFormat::Compression::None)
+		{
+			// Point straight into the mapping.
+			blob.m_buffer.clear();
+			blob.m_data = storedData;
+			blob.m_size = entry->size;
+			return true;
+		}
+
+		// Decompress the resource.
+		blob.m_buffer.resize(entry->size);
+		const int decompressedSize = LZ4_decompress_safe(
+			reinterpret_cast<const char*>(storedData),
+			reinterpret_cast<char*>(blob.m_buffer.data()),
+			static_cast<int>(entry->storedSize),
+			static_cast<int>(entry->size)
+		);
+
+		if (decompressedSize < 0 || static_cast<std::uint64_t>(decompressedSize) != entry->size)
+		{
+			std::cerr << "ERROR: Unable to decompress \"" << path << "\" from resource pack" << std::endl;
+			blob.m_buffer.clear();
+			blob.m_data = nullptr;
+			blob.m_size = 0;
+			return false;
+		}
+
+		blob.m_data = blob.m_buffer.data();
+		blob.m_size = blob.m_buffer.size();
+		return true;
+	}
+
+	std::uint64_t ResourcePack::HashPath(const std::string& path)
+	{
+		const std::size_t start = path.compare(0, 2, "./") == 0 ? 2 : 0;
+
+		std::uint64_t hash = 14695981039346656037ULL;
+		for (std::size_t i = start; i < path.size(); ++i)
+		{
+			hash ^= static_cast<unsigned char>(path[i]);
+			hash *= 1099511628211ULL;
+		}
+
+		return hash;
+	}
+
+	const ResourcePackFormat::Entry* ResourcePack::FindEntry(const std::string& path) const
+	{
+		if (!m_entries)
+		{
+			return nullptr;
+		}
+
+		const std::uint64_t hash = HashPath(path);
+		const ResourcePackFormat::Entry* end = m_entries + m_entryCount;
+		const ResourcePackFormat::Entry* entry = std::lower_bound(m_entries, end, hash,
+			[](const ResourcePackFormat::Entry& entry, std::uint64_t hash) { return entry.pathHash < hash; });
+
+		return (entry != end && entry->pathHash == hash) ? entry : nullptr;
+	}
+}
@@ -0,0 +1,161 @@
+#include <Engine/ResourcePackWriter.hpp>
+
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include <lz4.h>
+#include <lz4hc.h>
+
+#include <Engine/ResourcePack.hpp>
+
+namespace Engine
+{
+	ResourcePackWriter::ResourcePackWriter()
+	: m_resources()
+	, m_paths()
+	{
+		// Nothing to do.
+	}
+
+	ResourcePackWriter::~ResourcePackWriter()
+	{
+		// Nothing to do.
+	}
+
+	bool ResourcePackWriter::Add(std::string path, std::vector<unsigned char> data, bool compress)
+	{
+		const std::uint64_t hash = ResourcePack::HashPath(path);
+
+		auto iter = m_paths.find(hash);
+		if (iter != m_paths.end())
+		{
+			if (iter->second == path)
+			{
+				std::cerr << "ERROR: \"" << path << "\" is already in the resource pack" << std::endl;
+			}
+			else
+			{
+				std::cerr << "ERROR: Unable to add \"" << path << "\" to resource pack because its hash collides with \""
+					<< iter->second << "\"" << std::endl;
+			}
+			return false;
+		}
+
+		if (data.size() > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+		{
+			std::cerr << "ERROR: Unable to add \"" << path << "\" to resource pack because it is too large" << std::endl;
+			return false;
+		}
+
+		PendingResource resource;
+		std::memset(&resource.entry, 0, sizeof(resource.entry));
+		resource.entry.pathHash = hash;
+		resource.entry.size = data.size();
+		resource.entry.compression = ResourcePackFormat::Compression::None;
+
+		if (compress && !data.empty())
+		{
+			// Compressing offline, so use the slowest, tightest setting.
+			// Decompression speed does not depend on the level.
+			std::vector<unsigned char> compressed(LZ4_compressBound(static_cast<int>(data.size())));
+			const int compressedSize = LZ4_compress_HC(
+				reinterpret_cast<const char*>(data.data()),
+				reinterpret_cast<char*>(compressed.data()),
+				static_cast<int>(data.size()),
+				static_cast<int>(compressed.size()),
+				LZ4HC_CLEVEL_MAX
+			);
+
+			// Only keep the compressed data if it saves at least an eighth.
+			// Resources that are already compressed (e.g. PNG images) are
+			// stored as is, so they can be used without a copy.
+			if (compressedSize > 0 && static_cast<std::size_t>(compressedSize) < data.size() - data.size() / 8)
+			{
+				compressed.resize(compressedSize);
+				data = std::move(compressed);
+				resource.entry.compression = ResourcePackFormat::Compression::LZ4;
+			}
+		}
+
+		resource.entry.storedSize = data.size();
+		resource.data = std::move(data);
+
+		m_resources[hash] = std::move(resource);
+		m_paths[hash] = path;
+		return true;
+	}
+
+	bool ResourcePackWriter::AddFile(std::string filepath, bool compress)
+	{
+		std::ifstream file(filepath, std::ios::in | std::ios::binary);
+		if (!file.is_open())
+		{
+			std::cerr << "ERROR: Unable to open file \"" << filepath << "\"" << std::endl;
+			return false;
+		}
+
+		std::vector<unsigned char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+		return Add(filepath, std::move(data), compress);
+	}
+
+	unsigned int ResourcePackWriter::GetResourceCount() const
+	{
+		return m_resources.size();
+	}
+
+	bool ResourcePackWriter::Save(std::string filepath) const
+	{
+		// Lay out the pack. The index follows the header, and each resource
+		// is aligned after that.
+		ResourcePackFormat::Header header;
+		std::memset(&header, 0, sizeof(header));
+		std::memcpy(header.magic, ResourcePackFormat::Magic, sizeof(header.magic));
+		header.version = ResourcePackFormat::Version;
+		header.entryCount = m_resources.size();
+		header.indexOffset = sizeof(header);
+
+		std::vector<ResourcePackFormat::Entry> index;
+		index.reserve(m_resources.size());
+
+		std::uint64_t offset = header.indexOffset + sizeof(ResourcePackFormat::Entry) * m_resources.size();
+		for (auto iter = m_resources.begin(); iter != m_resources.end(); ++iter)
+		{
+			offset = (offset + ResourcePackFormat::BlobAlignment - 1) & ~(ResourcePackFormat::BlobAlignment - 1);
+
+			ResourcePackFormat::Entry entry = iter->second.entry;
+			entry.offset = offset;
+			index.push_back(entry);
+
+			offset += entry.storedSize;
+		}
+
+		// Write the pack.
+		std::ofstream file(filepath, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+		{
+			std::cerr << "ERROR: Unable to write resource pack \"" << filepath << "\"" << std::endl;
+			return false;
+		}
+
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		if (!index.empty())
+		{
+			file.write(reinterpret_cast<const char*>(index.data()), sizeof(ResourcePackFormat::Entry) * index.size());
+		}
+
+		const char padding[ResourcePackFormat::BlobAlignment] = {};
+		unsigned int e = 0;
+		for (auto iter = m_resources.begin(); iter != m_resources.end(); ++iter, ++e)
+		{
+			const std::uint64_t position = static_cast<std::uint64_t>(file.tellp());
+			file.write(padding, index[e].offset - position);
+			file.write(reinterpret_cast<const char*>(iter->second.data.data()), iter->second.data.size());
+		}
+
+		return file.good();
+	}
+}
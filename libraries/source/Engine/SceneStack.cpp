@@ -116,6 +116,9 @@ namespace Engine
 				{
 					assert(!m_stack.empty());
 
+					// Release the resources that were loaded for the scene.
+					m_resourceManager->ReleaseGroup(m_stack.top()->GetResourceGroup());
+
 					// Pop the top scene off the stack.
 					// The scene may be released from memory at this point.
 					m_stack.pop();
@@ -134,6 +137,10 @@ namespace Engine
 				{
 					while (!m_stack.empty())
 					{
+						// Release the resources that were loaded for the
+						// scene.
+						m_resourceManager->ReleaseGroup(m_stack.top()->GetResourceGroup());
+
 						// Pop the top scene off the stack.
 						// The scene may be released from memory at this point.
 						m_stack.pop();
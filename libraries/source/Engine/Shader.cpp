@@ -4,6 +4,7 @@
 #include <fstream>
 #include <algorithm>
 #include <iostream>
+#include <utility>
 
 namespace Engine
 {
@@ -25,6 +26,12 @@ namespace Engine
 	}
 
 	bool Shader::LoadFromFile(std::string filename)
+	{
+		std::string fileContents;
+		return ReadSourceFile(filename, fileContents) && Compile(std::move(fileContents), filename);
+	}
+
+	bool Shader::ReadSourceFile(const std::string& filename, std::string& source)
 	{
 		std::ifstream file(filename.c_str(), std::ios::in);
 
@@ -60,6 +67,12 @@ namespace Engine
 			return false;
 		}
 
+		source = std::move(fileContents);
+		return true;
+	}
+
+	bool Shader::Compile(std::string source, const std::string& filename)
+	{
 		// Create a new shader object of the specified type.
 		m_id = glCreateShader(m_type);
 
@@ -76,13 +89,13 @@ namespace Engine
 		glslVersion.erase(std::remove_if(glslVersion.begin(), glslVersion.end(), [](char c){ return (c == '.'); }), glslVersion.end());
 
 		// Prepend the GLSL version to the shader source if it has not been already defined.
-		if (fileContents.find("#version") != 0)
+		if (source.find("#version") != 0)
 		{
-			fileContents = "#version " + glslVersion + "\n" + fileContents;
+			source = "#version " + glslVersion + "\n" + source;
 		}
 
 		// Get a character pointer to the shader source.
-		const GLchar *shaderSource = fileContents.c_str();
+		const GLchar *shaderSource = source.c_str();
 
 		// Copy the source code to the shader object.
 		glShaderSource(m_id, 1, &shaderSource, NULL);
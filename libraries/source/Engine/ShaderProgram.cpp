@@ -6,9 +6,14 @@
 
 namespace Engine
 {
+	std::atomic<std::uint64_t> ShaderProgram::s_nextLinkSerial(1);
+
 	ShaderProgram::ShaderProgram()
 	: m_id(0)
+	, m_linkSerial(0)
 	, m_uniformLocationCache()
+	, m_instanced(false)
+	, m_instanceValues()
 	{
 		// Create the shader program object.
 		m_id = glCreateProgram();
@@ -32,7 +37,7 @@ namespace Engine
 	bool ShaderProgram::Link()
 	{
 		// Clear uniform location cache.
-		m_uniformLocationCache.clear();
+		m_uniformLocationCache.Clear();
 
 		// Specify default attribute locations.
 		// This must be set before linking the shader program.
@@ -40,6 +45,9 @@ namespace Engine
 		glBindAttribLocation(m_id, 1, "v_vertNormal");
 		glBindAttribLocation(m_id, 2, "v_vertColor");
 		glBindAttribLocation(m_id, 3, "v_vertTextureCoordinates");
+		glBindAttribLocation(m_id, 4, "v_vertNodeIndex");
+		glBindAttribLocation(m_id, InstanceModelMatrixLocation, "i_modelMatrix");
+		glBindAttribLocation(m_id, InstanceNormalMatrixLocation, "i_normalMatrix");
 
 		// Try to link the shader program.
 		glLinkProgram(m_id);
@@ -62,6 +70,50 @@ namespace Engine
 			return false;
 		}
 
+		// Read the per-frame values from the shared uniform buffer.
+		const GLuint frameBlockIndex = glGetUniformBlockIndex(m_id, "FrameUniforms");
+		if (frameBlockIndex != GL_INVALID_INDEX)
+		{
+			glUniformBlockBinding(m_id, frameBlockIndex, FrameUniformBlockBinding);
+		}
+
+		// Find the per-instance attributes that the program reads.
+		m_instanced = glGetAttribLocation(m_id, "i_modelMatrix") >= 0;
+		m_instanceValues.clear();
+		if (m_instanced)
+		{
+			GLint attributeCount = 0;
+			GLint maxNameLength = 0;
+			glGetProgramiv(m_id, GL_ACTIVE_ATTRIBUTES, &attributeCount);
+			glGetProgramiv(m_id, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &maxNameLength);
+			std::vector<char> name(maxNameLength + 1);
+			for (GLint i = 0; i < attributeCount; ++i)
+			{
+				GLint size;
+				GLenum type;
+				glGetActiveAttrib(m_id, i, static_cast<GLsizei>(name.size()), NULL, &size, &type, &name[0]);
+				const std::string attributeName(&name[0]);
+				if (type != GL_FLOAT || attributeName.compare(0, 2, "i_") != 0)
+				{
+					continue;
+				}
+
+				if (m_instanceValues.size() == MaxInstanceValues)
+				{
+					std::cerr << "ERROR: Shader program reads more than " << MaxInstanceValues
+						<< " per-instance values" << std::endl;
+					return false;
+				}
+
+				InstanceValue value;
+				value.name = attributeName.substr(2);
+				value.location = glGetAttribLocation(m_id, attributeName.c_str());
+				m_instanceValues.push_back(value);
+			}
+		}
+
+		// Invalidate anything resolved for a previous link.
+		m_linkSerial = s_nextLinkSerial++;
 		return true;
 	}
 
@@ -70,13 +122,24 @@ namespace Engine
 		glUseProgram(m_id);
 	}
 
-	void ShaderProgram::SetUniformMatrix4fv(std::string name, const glm::mat4& matrix)
+	UniformHandle ShaderProgram::GetUniformHandle(const UniformName& name)
 	{
-		GLint uniformLocation = GetUniformLocation(name);
-		if (uniformLocation >= 0)
+		GLint location;
+		if (!m_uniformLocationCache.Find(name, location))
+		{
+			location = glGetUniformLocation(m_id, name.GetName());
+			m_uniformLocationCache.Insert(name, location);
+		}
+
+		return UniformHandle(location);
+	}
+
+	void ShaderProgram::SetUniformMatrix4fv(UniformHandle uniform, const glm::mat4& matrix)
+	{
+		if (uniform.IsValid())
 		{
 			glUniformMatrix4fv(
-				uniformLocation,
+				uniform.GetLocation(),
 				1,
 				GL_FALSE,
 				&matrix[0][0]
@@ -84,13 +147,25 @@ namespace Engine
 		}
 	}
 
-	void ShaderProgram::SetUniformMatrix3fv(std::string name, const glm::mat3& matrix)
+	void ShaderProgram::SetUniformMatrix4fv(UniformHandle uniform, const glm::mat4* matrices, unsigned int count)
 	{
-		GLint uniformLocation = GetUniformLocation(name);
-		if (uniformLocation >= 0)
+		if (uniform.IsValid() && count > 0)
+		{
+			glUniformMatrix4fv(
+				uniform.GetLocation(),
+				count,
+				GL_FALSE,
+				&matrices[0][0][0]
+			);
+		}
+	}
+
+	void ShaderProgram::SetUniformMatrix3fv(UniformHandle uniform, const glm::mat3& matrix)
+	{
+		if (uniform.IsValid())
 		{
 			glUniformMatrix3fv(
-				uniformLocation,
+				uniform.GetLocation(),
 				1,
 				GL_FALSE,
 				&matrix[0][0]
@@ -98,56 +173,53 @@ namespace Engine
 		}
 	}
 
-	void ShaderProgram::SetUniform3fv(std::string name, const glm::vec3& vector)
+	void ShaderProgram::SetUniform3fv(UniformHandle uniform, const glm::vec3& vector)
 	{
-		GLint uniformLocation = GetUniformLocation(name);
-		if (uniformLocation >= 0)
+		if (uniform.IsValid())
 		{
 			glUniform3fv(
-				uniformLocation,
+				uniform.GetLocation(),
 				1,
 				&vector[0]
 			);
 		}
 	}
 
-	void ShaderProgram::SetUniform1f(std::string name, float value)
+	void ShaderProgram::SetUniform1f(UniformHandle uniform, float value)
 	{
-		GLint uniformLocation = GetUniformLocation(name);
-		if (uniformLocation >= 0)
+		if (uniform.IsValid())
 		{
 			glUniform1f(
-				uniformLocation,
+				uniform.GetLocation(),
 				value
 			);
 		}
 	}
 
-	void ShaderProgram::SetUniform1i(std::string name, int value)
+	void ShaderProgram::SetUniform1i(UniformHandle uniform, int value)
 	{
-		GLint uniformLocation = GetUniformLocation(name);
-		if (uniformLocation >= 0)
+		if (uniform.IsValid())
 		{
 			glUniform1i(
-				uniformLocation,
+				uniform.GetLocation(),
 				value
 			);
 		}
 	}
 
-	GLint ShaderProgram::GetUniformLocation(std::string name)
+	bool ShaderProgram::IsInstanced() const
 	{
-		auto iter = m_uniformLocationCache.find(name);
-		if (iter != m_uniformLocationCache.end())
-		{
-			return iter->second;
-		}
-		else
-		{
-			const GLint location = glGetUniformLocation(m_id, name.c_str());
-			m_uniformLocationCache[name] = location;
-			return location;
-		}
+		return m_instanced;
+	}
+
+	const std::vector<ShaderProgram::InstanceValue>& ShaderProgram::GetInstanceValues() const
+	{
+		return m_instanceValues;
+	}
+
+	std::uint64_t ShaderProgram::GetLinkSerial() const
+	{
+		return m_linkSerial;
 	}
 
 	GLuint ShaderProgram::GetId() const
@@ -2,6 +2,7 @@
 
 #include <iostream>
 #include <cstring>
+#include <utility>
 
 #include <Engine/stb_image/stb_image.h>
 
@@ -101,67 +102,127 @@ namespace Engine
 		m_dirty = true;
 	}
 
+	void Texture::Create(unsigned int width, unsigned int height, std::vector<unsigned char>&& pixels)
+	{
+		assert(width > 0 && height > 0);
+		assert(pixels.size() == width * height * 4);
+
+		// Take ownership of the supplied pixels.
+		m_pixels = std::move(pixels);
+
+		// Save image dimensions.
+		m_width = width;
+		m_height = height;
+
+		// OpenGL texture object needs updating...
+		m_dirty = true;
+	}
+
 	bool Texture::LoadFromFile(std::string filepath)
 	{
 		// Clear the pixels vector of any existing data.
 		m_pixels.clear();
 
+		// OpenGL texture object needs updating...
+		m_dirty = true;
+
+		// Decode the image.
+		unsigned int width = 0;
+		unsigned int height = 0;
+		std::vector<unsigned char> pixels;
+		if (!DecodeFile(filepath, width, height, pixels))
+		{
+			return false;
+		}
+
+		// Take ownership of the decoded pixels.
+		Create(width, height, std::move(pixels));
+
+		// Immediately pass the texture to OpenGL.
+		// This is performed here so that the texture can be completely
+		// loaded and ready for use in the loading thread.
+		Update();
+
+		// Success!
+		return true;
+	}
+
+	bool Texture::DecodeFile(const std::string& filepath, unsigned int& width,
+		unsigned int& height, std::vector<unsigned char>& pixels)
+	{
 		// Load the image.
 		// Note: If STB_Image fails to load the image then the pointer returned
 		// will be NULL and the width and height variables will be unchanged.
-		int width = 0;
-		int height = 0;
+		int imageWidth = 0;
+		int imageHeight = 0;
 		int channels = 0;
-		unsigned char* data = stbi_load(filepath.c_str(), &width, &height, &channels, 4);
+		unsigned char* data = stbi_load(filepath.c_str(), &imageWidth, &imageHeight, &channels, 4);
 
-		// OpenGL texture object needs updating...
-		m_dirty = true;
+		return TakeDecodedImage(data, imageWidth, imageHeight, channels, filepath, width, height, pixels);
+	}
+
+	bool Texture::DecodeMemory(const unsigned char* data, std::size_t size,
+		const std::string& filepath, unsigned int& width, unsigned int& height,
+		std::vector<unsigned char>& pixels)
+	{
+		int imageWidth = 0;
+		int imageHeight = 0;
+		int channels = 0;
+		unsigned char* decodedData = stbi_load_from_memory(data, static_cast<int>(size),
+			&imageWidth, &imageHeight, &channels, 4);
 
+		return TakeDecodedImage(decodedData, imageWidth, imageHeight, channels, filepath, width, height, pixels);
+	}
+
+	bool Texture::TakeDecodedImage(unsigned char* data, int imageWidth, int imageHeight,
+		int channels, const std::string& filepath, unsigned int& width,
+		unsigned int& height, std::vector<unsigned char>& pixels)
+	{
 		// Check that STB_Image was able to load the image.
-		if (data && width > 0 && height > 0 && channels == 4)
+		if (data && imageWidth > 0 && imageHeight > 0 && channels == 4)
 		{
 			// Check image dimensions.
 			// Older graphics cards can only handle images that have dimensions
 			// that are a power of 2.
-			if ((width & (width - 1)) != 0 || (height & (height - 1)) != 0)
+			if ((imageWidth & (imageWidth - 1)) != 0 || (imageHeight & (imageHeight - 1)) != 0)
 			{
 				std::cout << "WARNING: The image " << filepath
 					<< " does not have dimensions that are a power of 2" << std::endl;
 			}
 
 			// Save image dimensions.
-			m_width = static_cast<unsigned int>(width);
-			m_height = static_cast<unsigned int>(height);
-
-			// Resize the pixels vector to be able to accomodate all of the
-			// data.
-			m_pixels.resize(width * height * 4);
+			width = static_cast<unsigned int>(imageWidth);
+			height = static_cast<unsigned int>(imageHeight);
 
 			// Copy the loaded data into the pixels vector.
-			std::memcpy(&m_pixels[0], data, m_pixels.size());
+			pixels.assign(data, data + imageWidth * imageHeight * 4);
 
 			// Free the data loaded by STB_Image.
-			// This is no longer needed since we have now populated our pixels
-			// vector.
 			stbi_image_free(data);
 			data = nullptr;
 
-			// Immediately pass the texture to OpenGL.
-			// This is performed here so that the texture can be completely
-			// loaded and ready for use in the loading thread.
-			Update();
-
 			// Success!
 			return true;
 		}
 		else
 		{
+			// Free any data that was loaded by STB_Image.
+			if (data)
+			{
+				stbi_image_free(data);
+			}
+
 			std::cerr << "Failed to load image: " << filepath << std::endl;
 			std::cerr << stbi_failure_reason() << std::endl;
 			return false;
 		}
 	}
 
+	void Texture::Upload()
+	{
+		Update();
+	}
+
 	unsigned int Texture::GetWidth() const
 	{
 		return m_width;
@@ -177,6 +238,17 @@ namespace Engine
 		return glm::vec2(static_cast<float>(m_width), static_cast<float>(m_height));
 	}
 
+	std::size_t Texture::GetCPUMemoryUsage() const
+	{
+		return m_pixels.size();
+	}
+
+	std::size_t Texture::GetGPUMemoryUsage() const
+	{
+		// Textures are stored as RGBA8 without mipmaps.
+		return static_cast<std::size_t>(m_width) * m_height * 4;
+	}
+
 	void Texture::SetRepeat(bool repeat)
 	{
 		m_repeat = repeat;
@@ -2,6 +2,8 @@
 
 namespace Engine
 {
+	const std::chrono::milliseconds ThreadEventReceiver::SpaceWaitTimeout(1);
+
 	ThreadEventReceiver::ISpecificThreadEventReceiver::~ISpecificThreadEventReceiver()
 	{
 		// Nothing to do.
@@ -8,6 +8,7 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include <Engine/Attribute/ShaderProgram.hpp>
+#include <Engine/UniformHandle.hpp>
 
 namespace Engine
 {
@@ -55,44 +56,33 @@ namespace Engine
 				// Start using the shader program.
 				shaderProgram->Use();
 
-				// Get the loaction of the Model-View-Projection (MVP) matrix
+				// Get the handle to the Model-View-Projection (MVP) matrix
 				// uniform in the shader.
-				const GLint mvpMatrixLocation = glGetUniformLocation(
-					shaderProgram->GetId(),
-					"modelViewProjectionMatrix"
-				);
-				assert(mvpMatrixLocation >= 0);
+				const UniformHandle mvpMatrixUniform =
+					shaderProgram->GetUniformHandle(BuiltinUniforms::ModelViewProjectionMatrix);
+				assert(mvpMatrixUniform.IsValid());
 
 				// Pass the MVP matrix to the shader.
-				glUniformMatrix4fv(
-					mvpMatrixLocation,
-					1,
-					GL_FALSE,
-					&mvpMatrix[0][0]
-				);
+				shaderProgram->SetUniformMatrix4fv(mvpMatrixUniform, mvpMatrix);
 
 				// Get the shape's texture.
 				std::shared_ptr<Texture> texture = shape.GetTexture();
 
-				// Get the location of the texture flag uniform in the shader.
-				const GLint textureFlagLocation = glGetUniformLocation(
-					shaderProgram->GetId(),
-					"useTexture"
-				);
-				assert(textureFlagLocation >= 0);
+				// Get the handle to the texture flag uniform in the shader.
+				const UniformHandle textureFlagUniform =
+					shaderProgram->GetUniformHandle(BuiltinUniforms::UseTexture);
+				assert(textureFlagUniform.IsValid());
 
 				// Set the texture flag value.
-				glUniform1i(textureFlagLocation, texture ? 1 : 0);
+				shaderProgram->SetUniform1i(textureFlagUniform, texture ? 1 : 0);
 
 				// Pass the texture to the shader if the shape has a texture.
 				if (texture)
 				{
-					// Get the location of the texture uniform in the shader.
-					const GLint textureLocation = glGetUniformLocation(
-						shaderProgram->GetId(),
-						"textureUnit"
-					);
-					assert(textureLocation >= 0);
+					// Get the handle to the texture uniform in the shader.
+					const UniformHandle textureUniform =
+						shaderProgram->GetUniformHandle(BuiltinUniforms::TextureUnit);
+					assert(textureUniform.IsValid());
 
 					// Activate a texture unit.
 					glActiveTexture(GL_TEXTURE0 + 0);
@@ -101,7 +91,7 @@ namespace Engine
 					glBindTexture(GL_TEXTURE_2D, shape.GetTexture()->GetTextureId());
 
 					// Pass the texture unit to the shader attribute.
-					glUniform1i(textureLocation, 0);
+					shaderProgram->SetUniform1i(textureUniform, 0);
 				}
 
 				// Bind the shape's VAO.
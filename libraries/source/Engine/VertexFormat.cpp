@@ -0,0 +1,191 @@
+#include <Engine/VertexFormat.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+namespace Engine
+{
+	namespace VertexFormat
+	{
+		namespace
+		{
+			/**
+			 * Converts a value in [-1, 1] to a 16-bit signed normalized
+			 * integer.
+			 *
+			 * @param value Value.
+			 * @return Signed normalized integer.
+			 */
+			std::int16_t ToSnorm16(float value)
+			{
+				return static_cast<std::int16_t>(std::round(std::max(-1.0f, std::min(1.0f, value)) * 32767.0f));
+			}
+
+			/**
+			 * Returns -1 for negative values and 1 otherwise.
+			 *
+			 * @param value Value.
+			 * @return Sign of the value.
+			 */
+			float SignNotZero(float value)
+			{
+				return (value < 0.0f) ? -1.0f : 1.0f;
+			}
+		}
+
+		std::size_t GetVertexSize(Layout layout)
+		{
+			return (layout == Layout::Wide) ? sizeof(Wide) : sizeof(Compact);
+		}
+
+		bool FitsCompact(const glm::vec3* textureCoordinates, unsigned int count)
+		{
+			for (unsigned int i = 0; i < count; ++i)
+			{
+				if (std::abs(textureCoordinates[i].x) > MaxCompactTextureCoordinate ||
+					std::abs(textureCoordinates[i].y) > MaxCompactTextureCoordinate)
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		void EncodeNormal(const glm::vec3& normal, std::int16_t encoded[2])
+		{
+			// Project onto the octahedron, then fold the lower hemisphere
+			// over the upper one.
+			const float length = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+			if (length <= 0.0f)
+			{
+				encoded[0] = 0;
+				encoded[1] = 0;
+				return;
+			}
+
+			float x = normal.x / length;
+			float y = normal.y / length;
+			if (normal.z < 0.0f)
+			{
+				const float foldedX = (1.0f - std::abs(y)) * SignNotZero(x);
+				const float foldedY = (1.0f - std::abs(x)) * SignNotZero(y);
+				x = foldedX;
+				y = foldedY;
+			}
+
+			encoded[0] = ToSnorm16(x);
+			encoded[1] = ToSnorm16(y);
+		}
+
+		glm::vec3 DecodeNormal(const std::int16_t encoded[2])
+		{
+			const float x = std::max(-1.0f, encoded[0] / 32767.0f);
+			const float y = std::max(-1.0f, encoded[1] / 32767.0f);
+
+			glm::vec3 normal(x, y, 1.0f - std::abs(x) - std::abs(y));
+			if (normal.z < 0.0f)
+			{
+				normal.x = (1.0f - std::abs(y)) * SignNotZero(x);
+				normal.y = (1.0f - std::abs(x)) * SignNotZero(y);
+			}
+
+			return glm::normalize(normal);
+		}
+
+		std::uint16_t EncodeHalf(float value)
+		{
+			std::uint32_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+
+			const std::uint16_t sign = static_cast<std::uint16_t>((bits >> 16) & 0x8000u);
+			const std::uint32_t exponent = (bits >> 23) & 0xFFu;
+			std::uint32_t mantissa = bits & 0x7FFFFFu;
+
+			// Infinity and NaN.
+			if (exponent == 0xFFu)
+			{
+				return sign | 0x7C00u | (mantissa ? 0x200u : 0u);
+			}
+
+			const int halfExponent = static_cast<int>(exponent) - 127 + 15;
+
+			// Too large, so round to infinity.
+			if (halfExponent >= 31)
+			{
+				return sign | 0x7C00u;
+			}
+
+			// Too small for a normal half, so make a subnormal (or zero).
+			if (halfExponent <= 0)
+			{
+				if (halfExponent < -10)
+				{
+					return sign;
+				}
+
+				mantissa |= 0x800000u;
+				const unsigned int shift = static_cast<unsigned int>(14 - halfExponent);
+				std::uint32_t half = mantissa >> shift;
+				const std::uint32_t remainder = mantissa & ((1u << shift) - 1u);
+				const std::uint32_t halfway = 1u << (shift - 1u);
+				if (remainder > halfway || (remainder == halfway && (half & 1u)))
+				{
+					++half;
+				}
+
+				return sign | static_cast<std::uint16_t>(half);
+			}
+
+			// Round the mantissa to nearest, ties to even. A carry out of the
+			// mantissa correctly bumps the exponent, up to infinity.
+			std::uint32_t half = (static_cast<std::uint32_t>(halfExponent) << 10) | (mantissa >> 13);
+			const std::uint32_t remainder = mantissa & 0x1FFFu;
+			if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u)))
+			{
+				++half;
+			}
+
+			return sign | static_cast<std::uint16_t>(half);
+		}
+
+		float DecodeHalf(std::uint16_t value)
+		{
+			const std::uint32_t sign = static_cast<std::uint32_t>(value & 0x8000u) << 16;
+			std::uint32_t exponent = (value >> 10) & 0x1Fu;
+			std::uint32_t mantissa = value & 0x3FFu;
+
+			std::uint32_t bits;
+			if (exponent == 0x1Fu)
+			{
+				// Infinity and NaN.
+				bits = sign | 0x7F800000u | (mantissa << 13);
+			}
+			else if (exponent != 0)
+			{
+				bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+			}
+			else if (mantissa == 0)
+			{
+				bits = sign;
+			}
+			else
+			{
+				// Normalize the subnormal half.
+				exponent = 127 - 15 + 1;
+				while (!(mantissa & 0x400u))
+				{
+					mantissa <<= 1;
+					--exponent;
+				}
+
+				bits = sign | (exponent << 23) | ((mantissa & 0x3FFu) << 13);
+			}
+
+			float result;
+			std::memcpy(&result, &bits, sizeof(result));
+			return result;
+		}
+	}
+}
@@ -7,6 +7,22 @@
 
 namespace Engine
 {
+	namespace
+	{
+		/**
+		 * Stream buffer that reads directly from a block of memory.
+		 */
+		class MemoryStreamBuffer : public std::streambuf
+		{
+		public:
+			MemoryStreamBuffer(const unsigned char* data, std::size_t size)
+			{
+				char* begin = const_cast<char*>(reinterpret_cast<const char*>(data));
+				setg(begin, begin, begin + size);
+			}
+		};
+	}
+
 	WaveFile::WaveFile()
 	: m_channelCount(0)
 	, m_sampleRate(0)
@@ -56,6 +72,18 @@ namespace Engine
 			return false;
 		}
 
+		return Load(file, filepath);
+	}
+
+	bool WaveFile::LoadFromMemory(const unsigned char* data, std::size_t size, std::string filepath)
+	{
+		MemoryStreamBuffer buffer(data, size);
+		std::istream file(&buffer);
+		return Load(file, filepath);
+	}
+
+	bool WaveFile::Load(std::istream& file, const std::string& filepath)
+	{
 		while (file.peek() != std::char_traits<char>::eof())
 		{
 			std::uint32_t chunkID;
@@ -0,0 +1,97 @@
+#include <Engine/WorkerPool.hpp>
+
+#include <cassert>
+#include <utility>
+
+namespace Engine
+{
+	WorkerPool::WorkerPool(unsigned int threadCount)
+	: m_tasks()
+	, m_nextSequence(0)
+	, m_terminate(false)
+	, m_mutex()
+	, m_condition()
+	, m_threads()
+	{
+		assert(threadCount > 0);
+
+		// Start the worker threads.
+		m_threads.reserve(threadCount);
+		for (unsigned int i = 0; i < threadCount; ++i)
+		{
+			m_threads.emplace_back(&WorkerPool::Run, this);
+		}
+	}
+
+	WorkerPool::~WorkerPool()
+	{
+		// Ask the workers to terminate once their current task is complete.
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_terminate = true;
+		}
+		m_condition.notify_all();
+
+		// Wait for the workers to finish.
+		for (auto iter = m_threads.begin(); iter != m_threads.end(); ++iter)
+		{
+			iter->join();
+		}
+	}
+
+	void WorkerPool::Submit(unsigned int priority, Task task)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			PendingTask pendingTask;
+			pendingTask.priority = priority;
+			pendingTask.sequence = m_nextSequence++;
+			pendingTask.task = std::move(task);
+			m_tasks.push(std::move(pendingTask));
+		}
+
+		// Wake a single idle worker.
+		m_condition.notify_one();
+	}
+
+	unsigned int WorkerPool::GetThreadCount() const
+	{
+		return m_threads.size();
+	}
+
+	unsigned int WorkerPool::GetDefaultThreadCount()
+	{
+		// Note: hardware_concurrency may return zero if the number of cores
+		// cannot be determined.
+		const unsigned int cores = std::thread::hardware_concurrency();
+		return cores > 1 ? cores - 1 : 1;
+	}
+
+	void WorkerPool::Run()
+	{
+		for (;;)
+		{
+			Task task;
+
+			// Wait for a task to execute.
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_condition.wait(lock, [this]() { return m_terminate || !m_tasks.empty(); });
+
+				if (m_terminate)
+				{
+					return;
+				}
+
+				// Note: std::priority_queue only provides const access to the
+				// top element, so the task has to be copied out.
+				task = m_tasks.top().task;
+				m_tasks.pop();
+			}
+
+			// Execute the task outside of the lock.
+			task();
+		}
+	}
+}
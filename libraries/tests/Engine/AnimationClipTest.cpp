@@ -0,0 +1,121 @@
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <vector>
+#include <Engine/AnimationClip.hpp>
+
+/**
+ * Adds a track to a clip that moves along the x axis by one unit per keyframe,
+ * with keyframes every half second.
+ *
+ * @param clip The clip.
+ * @param node Index of the animated node.
+ * @param keyCount Number of keyframes.
+ */
+static void AddLinearTrack(Engine::AnimationClip& clip, unsigned int node, int keyCount)
+{
+	std::vector<double> times;
+	std::vector<glm::vec3> translations;
+	std::vector<glm::quat> rotations;
+	std::vector<glm::vec3> scales;
+	for (int k = 0; k < keyCount; ++k)
+	{
+		times.push_back(k * 0.5);
+		translations.push_back(glm::vec3(static_cast<float>(k), 0.0f, 0.0f));
+		rotations.push_back(glm::quat());
+		scales.push_back(glm::vec3(1.0f));
+	}
+
+	clip.AddTrack(node, times, translations, rotations, scales);
+}
+
+/**
+ * Ensure that keyframes are found by time, and that times before or after the
+ * clip clamp to the first or last keyframe.
+ */
+BOOST_AUTO_TEST_CASE(TestKeyframesAreFoundByTime)
+{
+	Engine::AnimationClip clip("Clip", 4.5);
+	AddLinearTrack(clip, 3, 10);
+
+	const Engine::AnimationClip::Track* track = clip.FindTrack(3);
+	BOOST_REQUIRE(track);
+	BOOST_CHECK(!clip.FindTrack(0));
+	BOOST_CHECK_EQUAL(10u, track->keyCount);
+
+	BOOST_CHECK_EQUAL(0u, clip.FindKey(*track, -1.0));
+	BOOST_CHECK_EQUAL(0u, clip.FindKey(*track, 0.0));
+	BOOST_CHECK_EQUAL(0u, clip.FindKey(*track, 0.49));
+	BOOST_CHECK_EQUAL(1u, clip.FindKey(*track, 0.5));
+	BOOST_CHECK_EQUAL(6u, clip.FindKey(*track, 3.2));
+	BOOST_CHECK_EQUAL(9u, clip.FindKey(*track, 4.5));
+	BOOST_CHECK_EQUAL(9u, clip.FindKey(*track, 100.0));
+
+	BOOST_CHECK_SMALL(clip.EvaluateTrack(*track, -1.0)[3][0] - 0.0f, 1e-3f);
+	BOOST_CHECK_SMALL(clip.EvaluateTrack(*track, 1.25)[3][0] - 2.5f, 1e-3f);
+	BOOST_CHECK_SMALL(clip.EvaluateTrack(*track, 100.0)[3][0] - 9.0f, 1e-3f);
+}
+
+/**
+ * Ensure that quantized keyframes decode close to the values they were built
+ * from, and take half the memory of full precision keyframes.
+ */
+BOOST_AUTO_TEST_CASE(TestKeyframesAreQuantized)
+{
+	BOOST_CHECK_EQUAL(24u, sizeof(Engine::AnimationClip::Key));
+
+	std::vector<double> times;
+	std::vector<glm::vec3> translations;
+	std::vector<glm::quat> rotations;
+	std::vector<glm::vec3> scales;
+	for (int k = 0; k < 100; ++k)
+	{
+		const float t = k / 99.0f;
+		times.push_back(t);
+		translations.push_back(glm::vec3(-250.0f + 500.0f * t, 10.0f, std::sin(t * 6.0f)));
+		rotations.push_back(glm::angleAxis(t * 3.0f, glm::normalize(glm::vec3(1.0f, 2.0f, 3.0f))));
+		scales.push_back(glm::vec3(1.0f + t, 1.0f, 0.5f));
+	}
+
+	Engine::AnimationClip clip("Clip", 1.0);
+	clip.AddTrack(0, times, translations, rotations, scales);
+	BOOST_REQUIRE_EQUAL(1u, clip.GetTracks().size());
+	BOOST_REQUIRE_EQUAL(100u, clip.GetKeys().size());
+
+	// Each component is quantized to 1/65535th of the track's range.
+	const Engine::AnimationClip::Track& track = clip.GetTracks()[0];
+	for (unsigned int k = 0; k < times.size(); ++k)
+	{
+		const Engine::AnimationClip::Key& key = clip.GetKeys()[k];
+		const glm::vec3 translation = Engine::AnimationClip::DecodeTranslation(track, key);
+		const glm::quat rotation = Engine::AnimationClip::DecodeRotation(key);
+		const glm::vec3 scale = Engine::AnimationClip::DecodeScale(track, key);
+
+		for (int i = 0; i < 3; ++i)
+		{
+			BOOST_CHECK_SMALL(translation[i] - translations[k][i], 1e-2f);
+			BOOST_CHECK_SMALL(scale[i] - scales[k][i], 1e-4f);
+		}
+		BOOST_CHECK_SMALL(std::abs(glm::dot(rotation, rotations[k])) - 1.0f, 1e-4f);
+	}
+}
+
+/**
+ * Ensure that a clip holds the keyframes of every track that it animates.
+ */
+BOOST_AUTO_TEST_CASE(TestClipHoldsEveryTrack)
+{
+	Engine::AnimationClip clip("Walk", 2.0);
+	AddLinearTrack(clip, 1, 3);
+	AddLinearTrack(clip, 4, 5);
+
+	BOOST_CHECK_EQUAL("Walk", clip.GetName());
+	BOOST_CHECK_EQUAL(2.0, clip.GetDuration());
+	BOOST_CHECK_EQUAL(2.0, clip.GetLastKeyTime());
+	BOOST_REQUIRE_EQUAL(2u, clip.GetTracks().size());
+	BOOST_CHECK_EQUAL(8u, clip.GetKeys().size());
+
+	const Engine::AnimationClip::Track* track = clip.FindTrack(4);
+	BOOST_REQUIRE(track);
+	BOOST_CHECK_EQUAL(3u, track->firstKey);
+	BOOST_CHECK_SMALL(clip.EvaluateTrack(*track, 1.75)[3][0] - 3.5f, 1e-3f);
+}
@@ -0,0 +1,188 @@
+#include <boost/test/unit_test.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <Engine/BakedModelFormat.hpp>
+#include <Engine/Model.hpp>
+
+/**
+ * Source model used by the tests. The tests must be run from the project root
+ * directory.
+ */
+static const std::string SourceModelPath = "resources/models/tests/SimpleCombined.dae";
+
+/**
+ * Scratch baked model written by the tests.
+ */
+static const std::string BakedModelPath = "resources/models/tests/SimpleCombined.test.model";
+
+/**
+ * Recursively checks that two node trees hold the same data.
+ *
+ * @param expected Node loaded from the source model.
+ * @param actual Node loaded from the baked model.
+ */
+static void CheckNodesMatch(std::shared_ptr<Engine::Model::Node> expected,
+	std::shared_ptr<Engine::Model::Node> actual)
+{
+	BOOST_REQUIRE(actual);
+	BOOST_CHECK_EQUAL(expected->GetName(), actual->GetName());
+	BOOST_CHECK(expected->GetLocalBindTransformationMatrix() == actual->GetLocalBindTransformationMatrix());
+
+	BOOST_REQUIRE_EQUAL(expected->GetMeshCount(), actual->GetMeshCount());
+	for (unsigned int m = 0; m < expected->GetMeshCount(); ++m)
+	{
+		std::shared_ptr<Engine::Model::Node::Mesh> expectedMesh = expected->GetMesh(m);
+		std::shared_ptr<Engine::Model::Node::Mesh> actualMesh = actual->GetMesh(m);
+		BOOST_CHECK(expectedMesh->GetVertexPositions() == actualMesh->GetVertexPositions());
+		BOOST_CHECK(expectedMesh->GetVertexNormals() == actualMesh->GetVertexNormals());
+		BOOST_CHECK(expectedMesh->GetVertexTextureCoordinates() == actualMesh->GetVertexTextureCoordinates());
+		BOOST_CHECK(expectedMesh->GetVertexIndices() == actualMesh->GetVertexIndices());
+		BOOST_REQUIRE_EQUAL(expectedMesh->GetLodCount(), actualMesh->GetLodCount());
+		for (unsigned int l = 0; l < expectedMesh->GetLodCount(); ++l)
+		{
+			BOOST_CHECK(expectedMesh->GetLodIndices(l) == actualMesh->GetLodIndices(l));
+		}
+
+		std::shared_ptr<Engine::Model::Material> expectedMaterial = expectedMesh->GetMaterial();
+		std::shared_ptr<Engine::Model::Material> actualMaterial = actualMesh->GetMaterial();
+		BOOST_REQUIRE(actualMaterial);
+		BOOST_CHECK_EQUAL(expectedMaterial->GetName(), actualMaterial->GetName());
+		BOOST_CHECK(expectedMaterial->GetDiffuseColor() == actualMaterial->GetDiffuseColor());
+		BOOST_CHECK_EQUAL(expectedMaterial->GetShininess(), actualMaterial->GetShininess());
+		BOOST_CHECK_EQUAL(expectedMaterial->GetDiffuseTexturePath(), actualMaterial->GetDiffuseTexturePath());
+	}
+
+	BOOST_REQUIRE_EQUAL(expected->GetChildNodeCount(), actual->GetChildNodeCount());
+	for (unsigned int n = 0; n < expected->GetChildNodeCount(); ++n)
+	{
+		CheckNodesMatch(expected->GetChildNode(n), actual->GetChildNode(n));
+	}
+}
+
+/**
+ * Checks that two animation clips hold the same data.
+ *
+ * @param expected Clip loaded from the source model.
+ * @param actual Clip loaded from the baked model.
+ */
+static void CheckClipsMatch(const Engine::AnimationClip& expected, const Engine::AnimationClip& actual)
+{
+	BOOST_CHECK_EQUAL(expected.GetName(), actual.GetName());
+	BOOST_CHECK_EQUAL(expected.GetDuration(), actual.GetDuration());
+
+	BOOST_REQUIRE_EQUAL(expected.GetTracks().size(), actual.GetTracks().size());
+	for (unsigned int t = 0; t < expected.GetTracks().size(); ++t)
+	{
+		const Engine::AnimationClip::Track& expectedTrack = expected.GetTracks()[t];
+		const Engine::AnimationClip::Track& actualTrack = actual.GetTracks()[t];
+		BOOST_CHECK_EQUAL(expectedTrack.node, actualTrack.node);
+		BOOST_CHECK_EQUAL(expectedTrack.firstKey, actualTrack.firstKey);
+		BOOST_CHECK_EQUAL(expectedTrack.keyCount, actualTrack.keyCount);
+		BOOST_CHECK(expectedTrack.translationOrigin == actualTrack.translationOrigin);
+		BOOST_CHECK(expectedTrack.translationExtent == actualTrack.translationExtent);
+		BOOST_CHECK(expectedTrack.scaleOrigin == actualTrack.scaleOrigin);
+		BOOST_CHECK(expectedTrack.scaleExtent == actualTrack.scaleExtent);
+	}
+
+	// The keyframes are already quantized, so they are baked exactly.
+	BOOST_REQUIRE_EQUAL(expected.GetKeys().size(), actual.GetKeys().size());
+	for (unsigned int k = 0; k < expected.GetKeys().size(); ++k)
+	{
+		BOOST_CHECK(std::memcmp(&expected.GetKeys()[k], &actual.GetKeys()[k], sizeof(Engine::AnimationClip::Key)) == 0);
+	}
+}
+
+/**
+ * Ensure that a baked model holds exactly the same nodes, meshes, materials
+ * and animation clips as the source model it was baked from.
+ */
+BOOST_AUTO_TEST_CASE(TestBakedModelMatchesSourceModel)
+{
+	Engine::Model sourceModel;
+	BOOST_REQUIRE(sourceModel.Decode(SourceModelPath));
+	BOOST_REQUIRE(sourceModel.SaveBaked(BakedModelPath));
+
+	Engine::Model bakedModel;
+	const bool success = bakedModel.DecodeBaked(BakedModelPath);
+	std::remove(BakedModelPath.c_str());
+
+	BOOST_REQUIRE(success);
+	CheckNodesMatch(sourceModel.GetRootNode(), bakedModel.GetRootNode());
+
+	BOOST_REQUIRE_EQUAL(sourceModel.GetAnimationClipCount(), bakedModel.GetAnimationClipCount());
+	for (unsigned int c = 0; c < sourceModel.GetAnimationClipCount(); ++c)
+	{
+		CheckClipsMatch(sourceModel.GetAnimationClip(c), bakedModel.GetAnimationClip(c));
+	}
+}
+
+/**
+ * Ensure that a truncated baked model is rejected rather than read out of
+ * bounds.
+ */
+BOOST_AUTO_TEST_CASE(TestTruncatedBakedModelIsRejected)
+{
+	Engine::Model sourceModel;
+	BOOST_REQUIRE(sourceModel.Decode(SourceModelPath));
+	BOOST_REQUIRE(sourceModel.SaveBaked(BakedModelPath));
+
+	// Chop off the second half of the file.
+	std::vector<char> contents;
+	{
+		std::ifstream file(BakedModelPath, std::ios::in | std::ios::binary);
+		contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+	{
+		std::ofstream file(BakedModelPath, std::ios::out | std::ios::binary | std::ios::trunc);
+		file.write(&contents[0], contents.size() / 2);
+	}
+
+	Engine::Model bakedModel;
+	const bool success = bakedModel.DecodeBaked(BakedModelPath);
+	std::remove(BakedModelPath.c_str());
+
+	BOOST_CHECK(!success);
+	BOOST_CHECK(!bakedModel.GetRootNode());
+}
+
+/**
+ * Ensure that a baked model with a vertex index past the end of its mesh's
+ * vertices is rejected rather than drawn from other meshes' vertices.
+ */
+BOOST_AUTO_TEST_CASE(TestOutOfRangeIndexIsRejected)
+{
+	Engine::Model sourceModel;
+	BOOST_REQUIRE(sourceModel.Decode(SourceModelPath));
+	BOOST_REQUIRE(sourceModel.SaveBaked(BakedModelPath));
+
+	std::vector<char> contents;
+	{
+		std::ifstream file(BakedModelPath, std::ios::in | std::ios::binary);
+		contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+	std::remove(BakedModelPath.c_str());
+
+	// Point the first index of the first mesh one past its last vertex.
+	Engine::BakedModelFormat::Header header;
+	BOOST_REQUIRE_GE(contents.size(), sizeof(header));
+	std::memcpy(&header, &contents[0], sizeof(header));
+	BOOST_REQUIRE_GT(header.meshCount, 0u);
+
+	Engine::BakedModelFormat::Mesh mesh;
+	std::memcpy(&mesh, &contents[header.meshesOffset], sizeof(mesh));
+	BOOST_REQUIRE_GT(mesh.indexCount, 0u);
+	std::memcpy(&contents[mesh.indicesOffset], &mesh.vertexCount, sizeof(mesh.vertexCount));
+
+	// Decode from 8 byte aligned memory, as from a memory mapped file.
+	std::vector<std::uint64_t> data((contents.size() + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t));
+	std::memcpy(&data[0], &contents[0], contents.size());
+
+	Engine::Model bakedModel;
+	BOOST_CHECK(!bakedModel.DecodeBaked(reinterpret_cast<const unsigned char*>(&data[0]), contents.size(), BakedModelPath));
+	BOOST_CHECK(!bakedModel.GetRootNode());
+}
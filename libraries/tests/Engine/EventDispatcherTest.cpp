@@ -1,5 +1,8 @@
 #define BOOST_TEST_MODULE EventDispatcherTest
 #include <boost/test/included/unit_test.hpp>
+#include <vector>
+#include <memory>
+#include <utility>
 #include <Engine/EventDispatcher.hpp>
 #include <Engine/Event/IEvent.hpp>
 
@@ -463,3 +466,367 @@ BOOST_FIXTURE_TEST_CASE(TestEventQueueEmptiedAfterUpdate,
 	// Check that the value is zero - indicating that no value was received.
 	BOOST_CHECK_EQUAL(0, valueReceivedByReceiver);
 }
+
+/**
+ * Event that only delivers the most recently enqueued value.
+ */
+class KeepLatestTestEvent : public BaseTestEvent
+{
+public:
+	KeepLatestTestEvent(const int val) :
+	BaseTestEvent(val)
+	{
+		// Nothing to do.
+	}
+};
+
+/**
+ * Event that sums the values of pending events.
+ */
+class MergeTestEvent : public BaseTestEvent
+{
+public:
+	MergeTestEvent(const int val) :
+	BaseTestEvent(val)
+	{
+		// Nothing to do.
+	}
+};
+
+/**
+ * Event that discards values that are already pending.
+ */
+class UniqueTestEvent : public BaseTestEvent
+{
+public:
+	UniqueTestEvent(const int val) :
+	BaseTestEvent(val)
+	{
+		// Nothing to do.
+	}
+};
+
+namespace Engine
+{
+	namespace Event
+	{
+		template <>
+		struct CoalescingTraits<KeepLatestTestEvent>
+		{
+			static const CoalescingPolicy Policy = CoalescingPolicy::KeepLatest;
+		};
+
+		template <>
+		struct CoalescingTraits<MergeTestEvent>
+		{
+			static const CoalescingPolicy Policy = CoalescingPolicy::Merge;
+
+			static MergeTestEvent Merge(const MergeTestEvent& pending, const MergeTestEvent& incoming)
+			{
+				return MergeTestEvent(pending.GetValue() + incoming.GetValue());
+			}
+		};
+
+		template <>
+		struct CoalescingTraits<UniqueTestEvent>
+		{
+			static const CoalescingPolicy Policy = CoalescingPolicy::UniqueByKey;
+
+			typedef int KeyType;
+
+			static KeyType GetKey(const UniqueTestEvent& event)
+			{
+				return event.GetValue();
+			}
+		};
+	}
+}
+
+/**
+ * Event receiver that counts the number of events received and sums their
+ * payloads.
+ */
+template<typename EventType>
+class CountingTestEventReceiver
+{
+public:
+	/**
+	 * Constructor.
+	 *
+	 * @param dsptchr Event Dispatcher instance on which to subscribe to receive
+	 * events.
+	 */
+	CountingTestEventReceiver(Engine::EventDispatcher& dsptchr) :
+	eventsReceived(0),
+	valueReceived(0),
+	totalReceived(0)
+	{
+		dsptchr.Subscribe<EventType>(CALLBACK(CountingTestEventReceiver::Handler));
+	}
+
+	/**
+	 * Event callback handler.
+	 *
+	 * @param event Reference to the event.
+	 */
+	void Handler(const EventType& event)
+	{
+		++eventsReceived;
+		valueReceived = event.GetValue();
+		totalReceived += event.GetValue();
+	}
+
+	/**
+	 * Number of events received.
+	 */
+	int eventsReceived;
+
+	/**
+	 * Payload value received by the last event.
+	 */
+	int valueReceived;
+
+	/**
+	 * Sum of the payload values received.
+	 */
+	int totalReceived;
+};
+
+/**
+ * Ensure that enqueued events without a coalescing policy are all delivered.
+ */
+BOOST_FIXTURE_TEST_CASE(TestEventsWithoutPolicyAreNotCoalesced,
+	EventDispatcherTestFixture)
+{
+	CountingTestEventReceiver<TestEvent> receiver(dispatcher);
+
+	dispatcher.Enqueue<TestEvent>(1);
+	dispatcher.Enqueue<TestEvent>(2);
+	dispatcher.Enqueue<TestEvent>(3);
+	dispatcher.Update();
+
+	BOOST_CHECK_EQUAL(3, receiver.eventsReceived);
+	BOOST_CHECK_EQUAL(6, receiver.totalReceived);
+}
+
+/**
+ * Ensure that only the latest of several pending KeepLatest events is
+ * delivered.
+ */
+BOOST_FIXTURE_TEST_CASE(TestKeepLatestPolicyDeliversLatestEvent,
+	EventDispatcherTestFixture)
+{
+	CountingTestEventReceiver<KeepLatestTestEvent> receiver(dispatcher);
+
+	dispatcher.Enqueue<KeepLatestTestEvent>(1);
+	dispatcher.Enqueue<KeepLatestTestEvent>(2);
+	dispatcher.Enqueue<KeepLatestTestEvent>(3);
+	dispatcher.Update();
+
+	BOOST_CHECK_EQUAL(1, receiver.eventsReceived);
+	BOOST_CHECK_EQUAL(3, receiver.valueReceived);
+
+	// Events enqueued after the update are delivered on the next update.
+	dispatcher.Enqueue<KeepLatestTestEvent>(4);
+	dispatcher.Update();
+
+	BOOST_CHECK_EQUAL(2, receiver.eventsReceived);
+	BOOST_CHECK_EQUAL(4, receiver.valueReceived);
+}
+
+/**
+ * Ensure that pending Merge events are combined into a single event.
+ */
+BOOST_FIXTURE_TEST_CASE(TestMergePolicyCombinesPendingEvents,
+	EventDispatcherTestFixture)
+{
+	CountingTestEventReceiver<MergeTestEvent> receiver(dispatcher);
+
+	dispatcher.Enqueue<MergeTestEvent>(1);
+	dispatcher.Enqueue<MergeTestEvent>(2);
+	dispatcher.Enqueue<MergeTestEvent>(3);
+	dispatcher.Update();
+
+	BOOST_CHECK_EQUAL(1, receiver.eventsReceived);
+	BOOST_CHECK_EQUAL(6, receiver.valueReceived);
+}
+
+/**
+ * Ensure that UniqueByKey events are only discarded while an event with the
+ * same key is pending.
+ */
+BOOST_FIXTURE_TEST_CASE(TestUniqueByKeyPolicyDiscardsDuplicateEvents,
+	EventDispatcherTestFixture)
+{
+	CountingTestEventReceiver<UniqueTestEvent> receiver(dispatcher);
+
+	dispatcher.Enqueue<UniqueTestEvent>(1);
+	dispatcher.Enqueue<UniqueTestEvent>(2);
+	dispatcher.Enqueue<UniqueTestEvent>(1);
+	dispatcher.Update();
+
+	BOOST_CHECK_EQUAL(2, receiver.eventsReceived);
+	BOOST_CHECK_EQUAL(3, receiver.totalReceived);
+
+	// The key is released once the event has been delivered.
+	dispatcher.Enqueue<UniqueTestEvent>(1);
+	dispatcher.Update();
+
+	BOOST_CHECK_EQUAL(3, receiver.eventsReceived);
+}
+
+/**
+ * Ensure that coalescing preserves the order of events of different types.
+ */
+BOOST_FIXTURE_TEST_CASE(TestCoalescedEventsPreserveQueueOrder,
+	EventDispatcherTestFixture)
+{
+	std::vector<int> order;
+	dispatcher.Subscribe<TestEvent>([&order](const TestEvent& event) {
+		order.push_back(event.GetValue());
+	});
+	dispatcher.Subscribe<KeepLatestTestEvent>([&order](const KeepLatestTestEvent& event) {
+		order.push_back(event.GetValue());
+	});
+
+	dispatcher.Enqueue<KeepLatestTestEvent>(1);
+	dispatcher.Enqueue<TestEvent>(2);
+	dispatcher.Enqueue<KeepLatestTestEvent>(3);
+	dispatcher.Update();
+
+	BOOST_CHECK_EQUAL(2u, order.size());
+	BOOST_CHECK_EQUAL(3, order[0]);
+	BOOST_CHECK_EQUAL(2, order[1]);
+}
+
+/**
+ * Payload that counts the number of times it has been copied.
+ */
+class CopyCountingPayload
+{
+public:
+	CopyCountingPayload()
+	{
+		// Nothing to do.
+	}
+
+	CopyCountingPayload(const CopyCountingPayload& other)
+	{
+		++copies;
+	}
+
+	CopyCountingPayload(CopyCountingPayload&& other)
+	{
+		// Nothing to do.
+	}
+
+	/**
+	 * Number of copies made since the last reset.
+	 */
+	static int copies;
+};
+
+int CopyCountingPayload::copies = 0;
+
+/**
+ * Event that stores a CopyCountingPayload, taking it by value so that rvalues
+ * can be moved into the event.
+ */
+class CopyCountingTestEvent : public Engine::Event::IEvent
+{
+public:
+	CopyCountingTestEvent(CopyCountingPayload payload) :
+	Engine::Event::IEvent(),
+	payload(std::move(payload))
+	{
+		// Nothing to do.
+	}
+
+private:
+	/**
+	 * Payload.
+	 */
+	CopyCountingPayload payload;
+};
+
+/**
+ * Event that carries a move-only payload.
+ */
+class MoveOnlyTestEvent : public Engine::Event::IEvent
+{
+public:
+	MoveOnlyTestEvent(std::unique_ptr<int> val) :
+	Engine::Event::IEvent(),
+	value(std::move(val))
+	{
+		// Nothing to do.
+	}
+
+	int GetValue() const
+	{
+		return *value;
+	}
+
+private:
+	/**
+	 * Payload.
+	 */
+	std::unique_ptr<int> value;
+};
+
+/**
+ * Ensure that an rvalue payload is moved all the way into the queued event.
+ */
+BOOST_FIXTURE_TEST_CASE(TestEnqueueDoesNotCopyRvaluePayload,
+	EventDispatcherTestFixture)
+{
+	CopyCountingPayload::copies = 0;
+	dispatcher.Enqueue<CopyCountingTestEvent>(CopyCountingPayload());
+	dispatcher.Update();
+	BOOST_CHECK_EQUAL(0, CopyCountingPayload::copies);
+}
+
+/**
+ * Ensure that an lvalue payload is copied exactly once, into the event.
+ */
+BOOST_FIXTURE_TEST_CASE(TestEnqueueCopiesLvaluePayloadOnce,
+	EventDispatcherTestFixture)
+{
+	CopyCountingPayload payload;
+	CopyCountingPayload::copies = 0;
+	dispatcher.Enqueue<CopyCountingTestEvent>(payload);
+	dispatcher.Update();
+	BOOST_CHECK_EQUAL(1, CopyCountingPayload::copies);
+}
+
+/**
+ * Ensure that an lvalue payload is copied exactly once when dispatched.
+ */
+BOOST_FIXTURE_TEST_CASE(TestDispatchCopiesLvaluePayloadOnce,
+	EventDispatcherTestFixture)
+{
+	CopyCountingPayload payload;
+	CopyCountingPayload::copies = 0;
+	dispatcher.Dispatch<CopyCountingTestEvent>(payload);
+	BOOST_CHECK_EQUAL(1, CopyCountingPayload::copies);
+}
+
+/**
+ * Ensure that events with move-only payloads can be enqueued and dispatched.
+ */
+BOOST_FIXTURE_TEST_CASE(TestMoveOnlyEventsAreSupported,
+	EventDispatcherTestFixture)
+{
+	int valueReceived = 0;
+	dispatcher.Subscribe<MoveOnlyTestEvent>([&valueReceived](const MoveOnlyTestEvent& event) {
+		valueReceived = event.GetValue();
+	});
+
+	dispatcher.Dispatch<MoveOnlyTestEvent>(std::unique_ptr<int>(new int(10)));
+	BOOST_CHECK_EQUAL(10, valueReceived);
+
+	std::unique_ptr<int> value(new int(11));
+	dispatcher.Enqueue<MoveOnlyTestEvent>(std::move(value));
+	dispatcher.Update();
+	BOOST_CHECK_EQUAL(11, valueReceived);
+}
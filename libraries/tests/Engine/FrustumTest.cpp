@@ -0,0 +1,72 @@
+#include <boost/test/unit_test.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <Engine/Frustum.hpp>
+
+/**
+ * Builds the frustum of an orthographic camera that looks down the negative z
+ * axis from (10, 0, 0), seeing 4 units either side and from 1 to 100 units
+ * away.
+ *
+ * @return The frustum, in the world space.
+ */
+static Engine::Frustum BuildOrthographicFrustum()
+{
+	const glm::mat4 projectionMatrix = glm::ortho(-4.0f, 4.0f, -4.0f, 4.0f, 1.0f, 100.0f);
+	const glm::mat4 viewMatrix = glm::translate(glm::mat4(1.0f), glm::vec3(-10.0f, 0.0f, 0.0f));
+	return Engine::Frustum(projectionMatrix * viewMatrix);
+}
+
+/**
+ * Ensure that the planes of an orthographic frustum face inwards, at the
+ * edges of the camera's view.
+ */
+BOOST_AUTO_TEST_CASE(TestPlanesBoundTheView)
+{
+	const Engine::Frustum frustum = BuildOrthographicFrustum();
+	BOOST_REQUIRE_EQUAL(6u, frustum.GetPlanes().size());
+
+	// Left, right, bottom, top, near and far.
+	const glm::vec3 inside[6] = {
+		glm::vec3(6.5f, 0.0f, -50.0f), glm::vec3(13.5f, 0.0f, -50.0f),
+		glm::vec3(10.0f, -3.5f, -50.0f), glm::vec3(10.0f, 3.5f, -50.0f),
+		glm::vec3(10.0f, 0.0f, -1.5f), glm::vec3(10.0f, 0.0f, -99.5f)
+	};
+	for (unsigned int p = 0; p < 6; ++p)
+	{
+		const Engine::Plane& plane = frustum.GetPlanes()[p];
+		BOOST_CHECK_SMALL(glm::length(plane.GetNormal()) - 1.0f, 1e-5f);
+		BOOST_CHECK_CLOSE(0.5f, plane.GetSignedDistance(inside[p]), 1e-2f);
+	}
+}
+
+/**
+ * Ensure that spheres are culled only when they are entirely outside the
+ * frustum.
+ */
+BOOST_AUTO_TEST_CASE(TestSpheresOutsideAreCulled)
+{
+	const Engine::Frustum frustum = BuildOrthographicFrustum();
+
+	BOOST_CHECK(frustum.IntersectsSphere(glm::vec3(10.0f, 0.0f, -50.0f), 1.0f));
+	BOOST_CHECK(frustum.IntersectsSphere(glm::vec3(14.5f, 0.0f, -50.0f), 1.0f));
+	BOOST_CHECK(!frustum.IntersectsSphere(glm::vec3(15.5f, 0.0f, -50.0f), 1.0f));
+	BOOST_CHECK(!frustum.IntersectsSphere(glm::vec3(10.0f, -6.0f, -50.0f), 1.0f));
+	BOOST_CHECK(!frustum.IntersectsSphere(glm::vec3(10.0f, 0.0f, 5.0f), 1.0f));
+	BOOST_CHECK(!frustum.IntersectsSphere(glm::vec3(10.0f, 0.0f, -105.0f), 1.0f));
+}
+
+/**
+ * Ensure that boxes are culled only when they are entirely outside the
+ * frustum.
+ */
+BOOST_AUTO_TEST_CASE(TestBoxesOutsideAreCulled)
+{
+	const Engine::Frustum frustum = BuildOrthographicFrustum();
+
+	BOOST_CHECK(frustum.IntersectsBox(glm::vec3(9.0f, -1.0f, -51.0f), glm::vec3(11.0f, 1.0f, -49.0f)));
+	BOOST_CHECK(frustum.IntersectsBox(glm::vec3(13.0f, -1.0f, -51.0f), glm::vec3(20.0f, 1.0f, -49.0f)));
+	BOOST_CHECK(frustum.IntersectsBox(glm::vec3(0.0f, -20.0f, -200.0f), glm::vec3(20.0f, 20.0f, 0.0f)));
+	BOOST_CHECK(!frustum.IntersectsBox(glm::vec3(14.5f, -1.0f, -51.0f), glm::vec3(20.0f, 1.0f, -49.0f)));
+	BOOST_CHECK(!frustum.IntersectsBox(glm::vec3(9.0f, 5.0f, -51.0f), glm::vec3(11.0f, 6.0f, -49.0f)));
+	BOOST_CHECK(!frustum.IntersectsBox(glm::vec3(9.0f, -1.0f, -0.5f), glm::vec3(11.0f, 1.0f, 3.0f)));
+}
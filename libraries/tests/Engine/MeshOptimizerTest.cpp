@@ -0,0 +1,145 @@
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <Engine/MeshOptimizer.hpp>
+
+/**
+ * Builds a unit sphere from a latitude and longitude grid of triangles, with
+ * the triangles in random order.
+ *
+ * @param segments Number of segments around each axis.
+ * @param positions Receives the vertex positions.
+ * @param indices Receives the vertex indices.
+ */
+static void BuildShuffledSphere(unsigned int segments, std::vector<glm::vec3>& positions, std::vector<unsigned int>& indices)
+{
+	const float pi = 3.14159265f;
+	for (unsigned int i = 0; i <= segments; ++i)
+	{
+		for (unsigned int j = 0; j <= segments; ++j)
+		{
+			const float theta = pi * i / segments;
+			const float phi = 2.0f * pi * j / segments;
+			positions.push_back(glm::vec3(std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta)));
+		}
+	}
+
+	std::vector<std::array<unsigned int, 3>> triangles;
+	for (unsigned int i = 0; i < segments; ++i)
+	{
+		for (unsigned int j = 0; j < segments; ++j)
+		{
+			const unsigned int a = i * (segments + 1) + j;
+			const unsigned int b = a + 1;
+			const unsigned int c = a + segments + 1;
+			const unsigned int d = c + 1;
+			triangles.push_back({{a, c, b}});
+			triangles.push_back({{b, c, d}});
+		}
+	}
+
+	std::mt19937 random(42);
+	std::shuffle(triangles.begin(), triangles.end(), random);
+	for (const std::array<unsigned int, 3>& triangle : triangles)
+	{
+		indices.insert(indices.end(), triangle.begin(), triangle.end());
+	}
+}
+
+/**
+ * Returns the triangles of a mesh, each rotated to start at its smallest
+ * index and then sorted, so that meshes with the same triangles in any order
+ * compare equal.
+ *
+ * @param indices Vertex indices, three per triangle.
+ * @return Sorted triangles.
+ */
+static std::vector<std::array<unsigned int, 3>> GetSortedTriangles(const std::vector<unsigned int>& indices)
+{
+	std::vector<std::array<unsigned int, 3>> triangles;
+	for (std::size_t t = 0; t < indices.size(); t += 3)
+	{
+		std::array<unsigned int, 3> triangle = {{indices[t], indices[t + 1], indices[t + 2]}};
+		std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+		triangles.push_back(triangle);
+	}
+
+	std::sort(triangles.begin(), triangles.end());
+	return triangles;
+}
+
+/**
+ * Ensure that the average cache miss ratio counts the vertices transformed
+ * per triangle.
+ */
+BOOST_AUTO_TEST_CASE(TestAcmrCountsCacheMisses)
+{
+	const unsigned int cacheSize = Engine::MeshOptimizer::DefaultCacheSize;
+	BOOST_CHECK_EQUAL(0.0f, Engine::MeshOptimizer::CalculateAcmr(std::vector<unsigned int>(), 0, cacheSize));
+	BOOST_CHECK_EQUAL(3.0f, Engine::MeshOptimizer::CalculateAcmr({0, 1, 2}, 3, cacheSize));
+
+	// A strip of four triangles transforms each of its six vertices once.
+	BOOST_CHECK_EQUAL(1.5f, Engine::MeshOptimizer::CalculateAcmr({0, 1, 2, 2, 1, 3, 2, 3, 4, 4, 3, 5}, 6, cacheSize));
+
+	// With a cache of three vertices, the first two vertices have been
+	// evicted by the time the last triangle uses them again.
+	BOOST_CHECK_EQUAL(2.0f, Engine::MeshOptimizer::CalculateAcmr({0, 1, 2, 1, 2, 3, 0, 1, 3}, 4, 3));
+}
+
+/**
+ * Ensure that cache optimization keeps every triangle, with its winding, and
+ * transforms far fewer vertices than a random order.
+ */
+BOOST_AUTO_TEST_CASE(TestVertexCacheOrderReducesMisses)
+{
+	std::vector<glm::vec3> positions;
+	std::vector<unsigned int> indices;
+	BuildShuffledSphere(40, positions, indices);
+
+	const std::vector<unsigned int> optimized = Engine::MeshOptimizer::OptimizeVertexCache(indices, positions.size());
+	BOOST_REQUIRE_EQUAL(indices.size(), optimized.size());
+	BOOST_CHECK(GetSortedTriangles(indices) == GetSortedTriangles(optimized));
+
+	const unsigned int cacheSize = Engine::MeshOptimizer::DefaultCacheSize;
+	const float before = Engine::MeshOptimizer::CalculateAcmr(indices, positions.size(), cacheSize);
+	const float after = Engine::MeshOptimizer::CalculateAcmr(optimized, positions.size(), cacheSize);
+	BOOST_CHECK_GT(before, 2.0f);
+	BOOST_CHECK_LT(after, 0.8f);
+}
+
+/**
+ * Ensure that overdraw optimization keeps every triangle, and keeps the cache
+ * miss ratio close to that of the cache optimized order.
+ */
+BOOST_AUTO_TEST_CASE(TestOverdrawOrderKeepsCacheEfficiency)
+{
+	std::vector<glm::vec3> positions;
+	std::vector<unsigned int> indices;
+	BuildShuffledSphere(40, positions, indices);
+
+	const std::vector<unsigned int> cacheOrder = Engine::MeshOptimizer::OptimizeVertexCache(indices, positions.size());
+	const std::vector<unsigned int> optimized = Engine::MeshOptimizer::OptimizeOverdraw(positions, cacheOrder, 1.05f);
+	BOOST_REQUIRE_EQUAL(indices.size(), optimized.size());
+	BOOST_CHECK(GetSortedTriangles(indices) == GetSortedTriangles(optimized));
+
+	const unsigned int cacheSize = Engine::MeshOptimizer::DefaultCacheSize;
+	const float before = Engine::MeshOptimizer::CalculateAcmr(cacheOrder, positions.size(), cacheSize);
+	const float after = Engine::MeshOptimizer::CalculateAcmr(optimized, positions.size(), cacheSize);
+	BOOST_CHECK_LT(after, before * 1.1f);
+}
+
+/**
+ * Ensure that vertices are remapped into the order that they are first used,
+ * with unused vertices last.
+ */
+BOOST_AUTO_TEST_CASE(TestVertexFetchOrderFollowsIndices)
+{
+	const std::vector<unsigned int> indices = {4, 2, 0, 0, 2, 5, 5, 2, 1};
+	const std::vector<unsigned int> remap = Engine::MeshOptimizer::GenerateVertexFetchRemap(indices, 6);
+
+	const std::vector<unsigned int> expected = {2, 4, 1, 5, 0, 3};
+	BOOST_CHECK(expected == remap);
+}
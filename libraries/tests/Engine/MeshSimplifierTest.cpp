@@ -0,0 +1,161 @@
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <vector>
+#include <Engine/MeshSimplifier.hpp>
+
+/**
+ * Builds a unit sphere from a latitude and longitude grid of triangles. The
+ * vertices along the seam and at the poles share positions exactly, so the
+ * sphere is closed.
+ *
+ * @param segments Number of segments around each axis.
+ * @param positions Receives the vertex positions.
+ * @param indices Receives the vertex indices.
+ */
+static void BuildSphere(unsigned int segments, std::vector<glm::vec3>& positions, std::vector<unsigned int>& indices)
+{
+	const float pi = 3.14159265f;
+	for (unsigned int i = 0; i <= segments; ++i)
+	{
+		for (unsigned int j = 0; j <= segments; ++j)
+		{
+			const float theta = pi * i / segments;
+			const float phi = 2.0f * pi * (j % segments) / segments;
+			const float radius = (i == 0 || i == segments) ? 0.0f : std::sin(theta);
+			const float z = (i == 0) ? 1.0f : (i == segments) ? -1.0f : std::cos(theta);
+			positions.push_back(glm::vec3(radius * std::cos(phi), radius * std::sin(phi), z));
+		}
+	}
+
+	for (unsigned int i = 0; i < segments; ++i)
+	{
+		for (unsigned int j = 0; j < segments; ++j)
+		{
+			const unsigned int a = i * (segments + 1) + j;
+			const unsigned int b = a + 1;
+			const unsigned int c = a + segments + 1;
+			const unsigned int d = c + 1;
+			indices.insert(indices.end(), {a, c, b, b, c, d});
+		}
+	}
+}
+
+/**
+ * Ensure that a mesh is simplified to about the requested number of
+ * triangles while keeping close to its original shape.
+ */
+BOOST_AUTO_TEST_CASE(TestSphereKeepsItsShape)
+{
+	std::vector<glm::vec3> positions;
+	std::vector<unsigned int> indices;
+	BuildSphere(40, positions, indices);
+
+	for (std::size_t target : {indices.size() / 2, indices.size() / 4, indices.size() / 10})
+	{
+		const std::vector<unsigned int> simplified = Engine::MeshSimplifier::Simplify(positions, indices, target / 3 * 3);
+		BOOST_REQUIRE_EQUAL(0u, simplified.size() % 3);
+		BOOST_CHECK_LE(simplified.size(), target + 3);
+		BOOST_CHECK_GT(simplified.size(), target / 2);
+
+		for (std::size_t t = 0; t < simplified.size(); t += 3)
+		{
+			BOOST_REQUIRE(simplified[t] < positions.size());
+			BOOST_REQUIRE(simplified[t + 1] < positions.size());
+			BOOST_REQUIRE(simplified[t + 2] < positions.size());
+
+			// Every triangle stays close to the surface and none face
+			// inwards.
+			const glm::vec3& p0 = positions[simplified[t]];
+			const glm::vec3& p1 = positions[simplified[t + 1]];
+			const glm::vec3& p2 = positions[simplified[t + 2]];
+			const glm::vec3 centroid = (p0 + p1 + p2) / 3.0f;
+			const glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+			BOOST_CHECK_SMALL(1.0f - glm::length(centroid), 0.1f);
+			BOOST_CHECK_GE(glm::dot(normal, centroid), -0.01f * glm::length(normal) * glm::length(centroid));
+		}
+	}
+}
+
+/**
+ * Ensure that the border of an open mesh keeps its corners.
+ */
+BOOST_AUTO_TEST_CASE(TestBorderIsKept)
+{
+	// A flat 10x10 grid of quads.
+	std::vector<glm::vec3> positions;
+	std::vector<unsigned int> indices;
+	for (unsigned int i = 0; i <= 10; ++i)
+	{
+		for (unsigned int j = 0; j <= 10; ++j)
+		{
+			positions.push_back(glm::vec3(static_cast<float>(i), static_cast<float>(j), 0.0f));
+		}
+	}
+	for (unsigned int i = 0; i < 10; ++i)
+	{
+		for (unsigned int j = 0; j < 10; ++j)
+		{
+			const unsigned int a = i * 11 + j;
+			indices.insert(indices.end(), {a, a + 11, a + 1, a + 1, a + 11, a + 12});
+		}
+	}
+
+	// A flat grid can be simplified to a couple of triangles.
+	const std::vector<unsigned int> simplified = Engine::MeshSimplifier::Simplify(positions, indices, 6);
+	BOOST_CHECK_LE(simplified.size(), 30u);
+
+	// The corners are kept, so the area is unchanged.
+	float area = 0.0f;
+	for (std::size_t t = 0; t < simplified.size(); t += 3)
+	{
+		const glm::vec3& p0 = positions[simplified[t]];
+		area += 0.5f * glm::cross(positions[simplified[t + 1]] - p0, positions[simplified[t + 2]] - p0).z;
+	}
+	BOOST_CHECK_SMALL(std::abs(area) - 100.0f, 1e-3f);
+}
+
+/**
+ * Ensure that vertices sharing a position are collapsed together, so that
+ * seams do not open.
+ */
+BOOST_AUTO_TEST_CASE(TestSeamsStayClosed)
+{
+	std::vector<glm::vec3> positions;
+	std::vector<unsigned int> indices;
+	BuildSphere(24, positions, indices);
+
+	// The first and last columns of the sphere share positions, like a
+	// texture seam.
+	const std::vector<unsigned int> simplified = Engine::MeshSimplifier::Simplify(positions, indices, indices.size() / 4);
+
+	// Every edge of a closed mesh is shared by two triangles, when
+	// vertices are compared by position.
+	std::vector<std::pair<glm::vec3, glm::vec3>> edges;
+	for (std::size_t t = 0; t < simplified.size(); t += 3)
+	{
+		for (int c = 0; c < 3; ++c)
+		{
+			edges.push_back(std::make_pair(positions[simplified[t + c]], positions[simplified[t + (c + 1) % 3]]));
+		}
+	}
+
+	unsigned int openEdges = 0;
+	for (const std::pair<glm::vec3, glm::vec3>& edge : edges)
+	{
+		bool found = false;
+		for (const std::pair<glm::vec3, glm::vec3>& other : edges)
+		{
+			if (other.first == edge.second && other.second == edge.first)
+			{
+				found = true;
+				break;
+			}
+		}
+
+		if (!found)
+		{
+			++openEdges;
+		}
+	}
+	BOOST_CHECK_EQUAL(0u, openEdges);
+}
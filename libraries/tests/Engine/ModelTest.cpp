@@ -0,0 +1,663 @@
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <Engine/Model.hpp>
+
+/**
+ * Animated models used by the tests. Each animates a node named "Box" over the
+ * first second, with keys sampled at 30Hz, then holds the final pose. The
+ * tests must be run from the project root directory.
+ */
+static const std::string TranslationModelPath = "resources/models/tests/SimpleTranslation.dae";
+static const std::string RotationModelPath = "resources/models/tests/SimpleRotation.dae";
+static const std::string AnimatedModelPath = "resources/models/tests/SimpleCombined.dae";
+
+/**
+ * Chain of 24 nested nodes named "Box0" to "Box23", each translated along the
+ * x axis over ten seconds with keys sampled at 60Hz. Node n moves at
+ * (n + 1) / 24 units per second.
+ */
+static const std::string ManyKeyframesModelPath = "resources/models/tests/ManyKeyframes.dae";
+
+/**
+ * Times (in seconds) that fall halfway between two keyframes.
+ */
+static const double BetweenKeyframes[] = {0.05, 0.25 + 1.0 / 60.0, 0.95};
+
+/**
+ * Recursively searches the node tree for a node, counting nodes in the
+ * depth-first order of the flattened node tree.
+ *
+ * @param node Node to start from.
+ * @param name Name of the node to find.
+ * @param index Index of the node to start from. Receives the index of the
+ * node that was found.
+ * @return True if the node was found.
+ */
+static bool FindFlatNodeIndex(std::shared_ptr<Engine::Model::Node> node,
+	const std::string& name, unsigned int& index)
+{
+	if (node->GetName() == name)
+	{
+		return true;
+	}
+
+	for (unsigned int c = 0; c < node->GetChildNodeCount(); ++c)
+	{
+		++index;
+		if (FindFlatNodeIndex(node->GetChildNode(c), name, index))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * Returns the first animation clip's track for a node of a test model.
+ *
+ * @param model The test model.
+ * @param name Name of the node.
+ * @return Pointer to the node's track.
+ */
+static const Engine::AnimationClip::Track* GetTrack(Engine::Model& model, const std::string& name)
+{
+	unsigned int index = 0;
+	BOOST_REQUIRE(FindFlatNodeIndex(model.GetRootNode(), name, index));
+	BOOST_REQUIRE(model.GetAnimationClipCount() > 0);
+	const Engine::AnimationClip::Track* track = model.GetAnimationClip(0).FindTrack(index);
+	BOOST_REQUIRE(track);
+	return track;
+}
+
+/**
+ * Returns the local transformation matrix of the animated node of a test
+ * model.
+ *
+ * @param model The test model.
+ * @param time Animation time (in seconds).
+ * @return Local transformation matrix of the "Box" node.
+ */
+static glm::mat4 GetBoxTransformation(Engine::Model& model, double time)
+{
+	const Engine::AnimationClip::Track* track = GetTrack(model, "Box");
+	BOOST_REQUIRE(track->keyCount > 1);
+	return model.GetAnimationClip(0).EvaluateTrack(*track, time);
+}
+
+/**
+ * Returns the length of a column of a matrix.
+ *
+ * @param matrix The matrix.
+ * @param column Column index.
+ * @return Length of the column's x, y and z components.
+ */
+static float GetColumnLength(const glm::mat4& matrix, int column)
+{
+	return std::sqrt(matrix[column][0] * matrix[column][0]
+		+ matrix[column][1] * matrix[column][1]
+		+ matrix[column][2] * matrix[column][2]);
+}
+
+/**
+ * Ensure that translations are interpolated between keyframes.
+ */
+BOOST_AUTO_TEST_CASE(TestTranslationIsInterpolated)
+{
+	Engine::Model model;
+	BOOST_REQUIRE(model.Decode(TranslationModelPath));
+
+	// The box moves along the x axis at one unit per second.
+	for (double time : BetweenKeyframes)
+	{
+		const glm::mat4 transformation = GetBoxTransformation(model, time);
+		BOOST_CHECK_SMALL(transformation[3][0] - static_cast<float>(time), 1e-3f);
+		BOOST_CHECK_SMALL(transformation[3][1], 1e-3f);
+		BOOST_CHECK_SMALL(transformation[3][2], 1e-3f);
+	}
+
+	BOOST_CHECK_SMALL(GetBoxTransformation(model, -1.0)[3][0], 1e-3f);
+	BOOST_CHECK_SMALL(GetBoxTransformation(model, 5.0)[3][0] - 1.0f, 1e-3f);
+	BOOST_CHECK_SMALL(GetBoxTransformation(model, 20.0)[3][0] - 1.0f, 1e-3f);
+}
+
+/**
+ * Ensure that rotations are interpolated between keyframes.
+ */
+BOOST_AUTO_TEST_CASE(TestRotationIsInterpolated)
+{
+	Engine::Model model;
+	BOOST_REQUIRE(model.Decode(RotationModelPath));
+
+	// The box turns about the y axis at 90 degrees per second.
+	for (double time : BetweenKeyframes)
+	{
+		const glm::mat4 transformation = GetBoxTransformation(model, time);
+		const double angle = std::atan2(-transformation[0][2], transformation[0][0]);
+		BOOST_CHECK_SMALL(angle - time * 3.14159265 / 2.0, 1e-3);
+		BOOST_CHECK_SMALL(GetColumnLength(transformation, 0) - 1.0f, 1e-3f);
+		BOOST_CHECK_SMALL(transformation[1][1] - 1.0f, 1e-3f);
+	}
+
+	const glm::mat4 finalTransformation = GetBoxTransformation(model, 5.0);
+	BOOST_CHECK_SMALL(finalTransformation[0][0], 1e-3f);
+	BOOST_CHECK_SMALL(finalTransformation[0][2] + 1.0f, 1e-3f);
+}
+
+/**
+ * Ensure that combined translations, rotations and scales are interpolated
+ * between keyframes.
+ */
+BOOST_AUTO_TEST_CASE(TestCombinedTransformationIsInterpolated)
+{
+	Engine::Model model;
+	BOOST_REQUIRE(model.Decode(AnimatedModelPath));
+
+	// The box moves along the y axis at one unit per second while it grows
+	// from one to twice its size.
+	for (double time : BetweenKeyframes)
+	{
+		const glm::mat4 transformation = GetBoxTransformation(model, time);
+		BOOST_CHECK_SMALL(transformation[3][0], 1e-3f);
+		BOOST_CHECK_SMALL(transformation[3][1] - static_cast<float>(time), 1e-3f);
+		for (int column = 0; column < 3; ++column)
+		{
+			BOOST_CHECK_SMALL(GetColumnLength(transformation, column) - static_cast<float>(1.0 + time), 2e-3f);
+		}
+	}
+
+	// The last keyframe is scaled by two and turned a quarter turn about the
+	// x axis.
+	const glm::mat4 finalTransformation = GetBoxTransformation(model, 1.0);
+	BOOST_CHECK_SMALL(finalTransformation[0][0] - 2.0f, 1e-3f);
+	BOOST_CHECK_SMALL(finalTransformation[1][2] - 2.0f, 1e-3f);
+	BOOST_CHECK_SMALL(finalTransformation[2][1] + 2.0f, 1e-3f);
+	BOOST_CHECK_SMALL(finalTransformation[3][1] - 1.0f, 1e-3f);
+}
+
+/**
+ * Recursively walks the node tree, appending the transformation matrix from
+ * each node's space to the model space in depth-first order.
+ *
+ * @param node Node to start from.
+ * @param parentTransformation Transformation matrix of the node's parent.
+ * @param clip Animation clip that animates the nodes.
+ * @param time Animation time (in seconds).
+ * @param transformations Receives the transformation matrices.
+ */
+static void WalkNodeTree(std::shared_ptr<Engine::Model::Node> node,
+	const glm::mat4& parentTransformation, const Engine::AnimationClip& clip,
+	double time, std::vector<glm::mat4>& transformations)
+{
+	const Engine::AnimationClip::Track* track = clip.FindTrack(transformations.size());
+	const glm::mat4 transformation = parentTransformation
+		* (track ? clip.EvaluateTrack(*track, time) : node->GetLocalBindTransformationMatrix());
+	transformations.push_back(transformation);
+
+	for (unsigned int c = 0; c < node->GetChildNodeCount(); ++c)
+	{
+		WalkNodeTree(node->GetChildNode(c), transformation, clip, time, transformations);
+	}
+}
+
+/**
+ * Ensure that evaluating the flattened node tree gives the same
+ * transformations as walking the node tree, at every point in the animation.
+ */
+BOOST_AUTO_TEST_CASE(TestFlattenedNodesMatchNodeTree)
+{
+	Engine::Model model;
+	BOOST_REQUIRE(model.Decode(AnimatedModelPath));
+
+	const std::vector<Engine::Model::FlatNode>& nodes = model.GetFlatNodes();
+	BOOST_REQUIRE(!nodes.empty());
+	BOOST_CHECK_EQUAL(-1, nodes[0].parentIndex);
+
+	bool animated = false;
+	unsigned int meshCount = 0;
+	for (unsigned int n = 0; n < nodes.size(); ++n)
+	{
+		BOOST_CHECK(nodes[n].parentIndex < static_cast<int>(n));
+		BOOST_CHECK_EQUAL(meshCount, nodes[n].firstMesh);
+		meshCount += nodes[n].meshCount;
+		animated = animated || !nodes[n].isStatic;
+	}
+	BOOST_CHECK_EQUAL(meshCount, model.GetFlatMeshes().size());
+	BOOST_CHECK(animated);
+
+	BOOST_REQUIRE_EQUAL(1u, model.GetAnimationClipCount());
+	const double duration = model.GetAnimationDuration(0);
+	for (int step = 0; step <= 20; ++step)
+	{
+		const double time = duration * step / 20.0;
+
+		std::vector<glm::mat4> expected;
+		WalkNodeTree(model.GetRootNode(), glm::mat4(), model.GetAnimationClip(0), time, expected);
+
+		std::vector<glm::mat4> actual;
+		model.EvaluateNodeTransformations(0, time, actual);
+
+		BOOST_REQUIRE_EQUAL(expected.size(), actual.size());
+		for (unsigned int n = 0; n < expected.size(); ++n)
+		{
+			for (int i = 0; i < 4; ++i)
+			{
+				for (int j = 0; j < 4; ++j)
+				{
+					BOOST_CHECK_SMALL(expected[n][i][j] - actual[n][i][j], 1e-4f);
+				}
+			}
+		}
+	}
+}
+
+/**
+ * Ensure that the pose cache holds the same transformations as evaluating the
+ * flattened node tree at each baked frame, and that times outside the
+ * animation clamp to the first or last frame.
+ */
+BOOST_AUTO_TEST_CASE(TestPoseCacheMatchesEvaluatedNodes)
+{
+	Engine::Model model;
+	BOOST_REQUIRE(model.Decode(AnimatedModelPath));
+
+	// The animation lasts one second. The bind pose has a single frame.
+	const unsigned int frameCount = model.GetPoseFrameCount(0);
+	BOOST_CHECK_EQUAL(Engine::Model::PoseSampleRate + 1, frameCount);
+	BOOST_CHECK_EQUAL(1u, model.GetPoseFrameCount(Engine::Model::InvalidAnimationClip));
+
+	const unsigned int nodeCount = model.GetFlatNodes().size();
+	std::vector<glm::mat4> expected;
+	for (unsigned int f = 0; f < frameCount; ++f)
+	{
+		const double time = static_cast<double>(f) / Engine::Model::PoseSampleRate;
+		model.EvaluateNodeTransformations(0, time, expected);
+
+		const glm::mat4* pose = model.GetPose(0, time);
+		BOOST_REQUIRE(pose);
+		BOOST_CHECK_EQUAL(f, model.GetPoseFrame(0, time));
+		BOOST_CHECK(pose == model.GetPose(0, 0.0) + f * nodeCount);
+		for (unsigned int n = 0; n < nodeCount; ++n)
+		{
+			for (int i = 0; i < 4; ++i)
+			{
+				for (int j = 0; j < 4; ++j)
+				{
+					BOOST_CHECK_SMALL(expected[n][i][j] - pose[n][i][j], 1e-5f);
+				}
+			}
+		}
+	}
+
+	BOOST_CHECK(model.GetPose(0, -1.0) == model.GetPose(0, 0.0));
+	BOOST_CHECK(model.GetPose(0, 20.0) == model.GetPose(0, 1.0));
+	BOOST_CHECK_EQUAL(frameCount - 1, model.GetPoseFrame(0, 20.0));
+	BOOST_CHECK_EQUAL(0u, model.GetPoseFrame(Engine::Model::InvalidAnimationClip, 0.5));
+
+	// Blending halfway between two frames averages them.
+	std::vector<glm::mat4> blended;
+	model.BlendPose(0, 0.5 / Engine::Model::PoseSampleRate, blended);
+	BOOST_REQUIRE_EQUAL(nodeCount, blended.size());
+	const glm::mat4* first = model.GetPose(0, 0.0);
+	const glm::mat4* second = model.GetPose(0, 1.0 / Engine::Model::PoseSampleRate);
+	for (unsigned int n = 0; n < nodeCount; ++n)
+	{
+		BOOST_CHECK_SMALL(blended[n][3][1] - (first[n][3][1] + second[n][3][1]) * 0.5f, 1e-5f);
+	}
+}
+
+/**
+ * Ensure that a model with many animated nodes and keyframes loads, and that
+ * every key reaches the node that it animates.
+ */
+BOOST_AUTO_TEST_CASE(TestManyKeyframesReachTheirNodes)
+{
+	Engine::Model model;
+	BOOST_REQUIRE(model.Decode(ManyKeyframesModelPath));
+
+	const Engine::AnimationClip& clip = model.GetAnimationClip(0);
+	BOOST_CHECK_EQUAL(24u, clip.GetTracks().size());
+	for (int n = 0; n < 24; ++n)
+	{
+		const Engine::AnimationClip::Track* track = GetTrack(model, "Box" + std::to_string(n));
+		BOOST_CHECK_EQUAL(601u, track->keyCount);
+
+		const float speed = (n + 1) / 24.0f;
+		BOOST_CHECK_SMALL(clip.EvaluateTrack(*track, 5.0 + 1.0 / 120.0)[3][0] - speed * (5.0f + 1.0f / 120.0f), 1e-3f);
+		BOOST_CHECK_SMALL(clip.EvaluateTrack(*track, 10.0)[3][0] - speed * 10.0f, 1e-3f);
+	}
+}
+
+/**
+ * Ensure that position, rotation and scaling keys at different times are
+ * merged into a keyframe at every time that any of them has a key, with the
+ * other streams interpolated at that time.
+ */
+BOOST_AUTO_TEST_CASE(TestKeyStreamsAreMerged)
+{
+	std::vector<aiVectorKey> positionKeys(3);
+	for (unsigned int k = 0; k < positionKeys.size(); ++k)
+	{
+		positionKeys[k].mTime = 2.0 * k;
+		positionKeys[k].mValue = aiVector3D(2.0f * k, 0.0f, 0.0f);
+	}
+
+	std::vector<aiQuatKey> rotationKeys(2);
+	rotationKeys[0].mTime = 1.0;
+	rotationKeys[1].mTime = 3.0;
+
+	std::vector<aiVectorKey> scalingKeys(1);
+	scalingKeys[0].mTime = 2.0;
+	scalingKeys[0].mValue = aiVector3D(1.0f, 1.0f, 1.0f);
+
+	aiNodeAnim channel;
+	channel.mNumPositionKeys = positionKeys.size();
+	channel.mPositionKeys = &positionKeys[0];
+	channel.mNumRotationKeys = rotationKeys.size();
+	channel.mRotationKeys = &rotationKeys[0];
+	channel.mNumScalingKeys = scalingKeys.size();
+	channel.mScalingKeys = &scalingKeys[0];
+
+	std::vector<double> times;
+	std::vector<glm::vec3> translations;
+	std::vector<glm::quat> rotations;
+	std::vector<glm::vec3> scales;
+	Engine::Model::LoadChannelKeyframes(&channel, 2.0, times, translations, rotations, scales);
+
+	// The channel does not own the keys.
+	channel.mPositionKeys = nullptr;
+	channel.mRotationKeys = nullptr;
+	channel.mScalingKeys = nullptr;
+
+	BOOST_REQUIRE_EQUAL(5u, times.size());
+	BOOST_REQUIRE_EQUAL(5u, translations.size());
+	BOOST_REQUIRE_EQUAL(5u, rotations.size());
+	BOOST_REQUIRE_EQUAL(5u, scales.size());
+	for (unsigned int k = 0; k < times.size(); ++k)
+	{
+		// Ticks are converted to seconds, and translations interpolated at
+		// the rotation keys' times.
+		BOOST_CHECK_CLOSE(0.5 * k, times[k], 1e-9);
+		BOOST_CHECK_SMALL(translations[k].x - static_cast<float>(k), 1e-5f);
+	}
+}
+
+/**
+ * Ensure that merging long key streams with disjoint times takes time linear
+ * in the number of keys. Merging by searching every stream for each key would
+ * make billions of comparisons here.
+ */
+BOOST_AUTO_TEST_CASE(TestDisjointKeyStreamsMergeQuickly)
+{
+	const unsigned int keyCount = 100000;
+	std::vector<aiVectorKey> positionKeys(keyCount);
+	std::vector<aiQuatKey> rotationKeys(keyCount);
+	std::vector<aiVectorKey> scalingKeys(keyCount);
+	for (unsigned int k = 0; k < keyCount; ++k)
+	{
+		positionKeys[k].mTime = 3.0 * k;
+		positionKeys[k].mValue = aiVector3D(static_cast<float>(k), 0.0f, 0.0f);
+		rotationKeys[k].mTime = 3.0 * k + 1.0;
+		scalingKeys[k].mTime = 3.0 * k + 2.0;
+		scalingKeys[k].mValue = aiVector3D(1.0f, 1.0f, 1.0f);
+	}
+
+	aiNodeAnim channel;
+	channel.mNumPositionKeys = keyCount;
+	channel.mPositionKeys = &positionKeys[0];
+	channel.mNumRotationKeys = keyCount;
+	channel.mRotationKeys = &rotationKeys[0];
+	channel.mNumScalingKeys = keyCount;
+	channel.mScalingKeys = &scalingKeys[0];
+
+	std::vector<double> times;
+	std::vector<glm::vec3> translations;
+	std::vector<glm::quat> rotations;
+	std::vector<glm::vec3> scales;
+
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	Engine::Model::LoadChannelKeyframes(&channel, 1.0, times, translations, rotations, scales);
+	const std::chrono::duration<double> loadTime = std::chrono::steady_clock::now() - start;
+
+	// The channel does not own the keys.
+	channel.mPositionKeys = nullptr;
+	channel.mRotationKeys = nullptr;
+	channel.mScalingKeys = nullptr;
+
+	// Every key of every stream gives its own keyframe.
+	BOOST_REQUIRE_EQUAL(3 * keyCount, times.size());
+	for (std::size_t k = 1; k < times.size(); ++k)
+	{
+		BOOST_REQUIRE_LT(times[k - 1], times[k]);
+	}
+
+	// Allow plenty of headroom for slow machines.
+	BOOST_CHECK_LT(loadTime.count(), 1.0);
+}
+
+/**
+ * Ensure that the animation is loaded into the clip library, that clips can be
+ * found by name, and that the bind pose is used without a clip.
+ */
+BOOST_AUTO_TEST_CASE(TestAnimationIsLoadedIntoClipLibrary)
+{
+	Engine::Model model;
+	BOOST_REQUIRE(model.Decode(TranslationModelPath));
+
+	BOOST_REQUIRE_EQUAL(1u, model.GetAnimationClipCount());
+	const Engine::AnimationClip& clip = model.GetAnimationClip(0);
+	BOOST_CHECK_EQUAL(0u, model.FindAnimationClip(clip.GetName()));
+	BOOST_CHECK_EQUAL(Engine::Model::InvalidAnimationClip, model.FindAnimationClip(clip.GetName() + "Missing"));
+	BOOST_CHECK_EQUAL(clip.GetDuration(), model.GetAnimationDuration(0));
+	BOOST_CHECK_EQUAL(0.0, model.GetAnimationDuration(Engine::Model::InvalidAnimationClip));
+
+	// The clip holds only the compact keyframes, not a copy of the nodes.
+	BOOST_CHECK(clip.GetCPUMemoryUsage() < clip.GetKeys().size() * 32 + 1024);
+
+	// Without a clip, the box stays at its bind pose.
+	unsigned int box = 0;
+	BOOST_REQUIRE(FindFlatNodeIndex(model.GetRootNode(), "Box", box));
+	const glm::mat4* bindPose = model.GetPose(Engine::Model::InvalidAnimationClip, 0.5);
+	const glm::mat4* pose = model.GetPose(0, 0.5);
+	BOOST_REQUIRE(bindPose && pose);
+	BOOST_CHECK(bindPose == model.GetPose(Engine::Model::InvalidAnimationClip, 0.0));
+	BOOST_CHECK_SMALL(pose[box][3][0] - 0.5f, 1e-3f);
+}
+
+/**
+ * Ensure that meshes sharing a material are merged into one material group,
+ * with every node that has a mesh in the node palette.
+ */
+BOOST_AUTO_TEST_CASE(TestMeshesAreGroupedByMaterial)
+{
+	Engine::Model model;
+	BOOST_REQUIRE(model.Decode(ManyKeyframesModelPath));
+
+	// Every box node draws the same triangle with the same material.
+	const std::vector<Engine::Model::FlatNode>& nodes = model.GetFlatNodes();
+	const std::vector<unsigned int>& paletteNodes = model.GetPaletteNodes();
+	BOOST_REQUIRE_EQUAL(24u, paletteNodes.size());
+	BOOST_REQUIRE(24 <= Engine::Model::MaxPaletteNodes);
+	for (unsigned int p = 0; p < paletteNodes.size(); ++p)
+	{
+		BOOST_REQUIRE(paletteNodes[p] < nodes.size());
+		BOOST_CHECK_EQUAL(p, nodes[paletteNodes[p]].paletteIndex);
+	}
+
+	const std::vector<Engine::Model::MaterialGroup>& groups = model.GetMaterialGroups();
+	BOOST_REQUIRE_EQUAL(1u, groups.size());
+	const Engine::Model::MaterialGroup& group = groups[0];
+	BOOST_CHECK_EQUAL(0u, group.palette);
+	BOOST_REQUIRE_EQUAL(24u, group.parts.size());
+	BOOST_CHECK(group.indexType == GL_UNSIGNED_SHORT);
+
+	unsigned int vertexCount = 0;
+	unsigned int indexCount = 0;
+	for (const Engine::Model::MaterialGroup::Part& part : group.parts)
+	{
+		const std::shared_ptr<Engine::Model::Node::Mesh>& mesh = model.GetFlatMeshes()[part.mesh];
+		BOOST_CHECK(mesh->GetMaterial() == group.material);
+		BOOST_CHECK(nodes[part.node].paletteIndex != Engine::Model::InvalidPaletteIndex);
+		vertexCount += mesh->GetVerticesCount();
+		indexCount += mesh->GetIndicesCount();
+	}
+	BOOST_CHECK_EQUAL(vertexCount, group.vertexCount);
+	BOOST_CHECK_EQUAL(indexCount, group.indexCount);
+}
+
+/**
+ * Ensure that small meshes are drawn at full detail only, and that the bounding
+ * box and sphere enclose every vertex in every frame of the animation.
+ */
+BOOST_AUTO_TEST_CASE(TestSmallMeshesHaveOneLod)
+{
+	Engine::Model model;
+	BOOST_REQUIRE(model.Decode(ManyKeyframesModelPath));
+
+	for (const std::shared_ptr<Engine::Model::Node::Mesh>& mesh : model.GetFlatMeshes())
+	{
+		BOOST_CHECK_EQUAL(1u, mesh->GetLodCount());
+		BOOST_CHECK(mesh->GetLodIndices(0) == mesh->GetVertexIndices());
+	}
+
+	for (const Engine::Model::MaterialGroup& group : model.GetMaterialGroups())
+	{
+		BOOST_CHECK_EQUAL(1u, group.lodCount);
+		BOOST_CHECK_EQUAL(0u, group.lodFirstIndex[0]);
+		BOOST_CHECK_EQUAL(group.indexCount, group.lodIndexCount[0]);
+	}
+
+	BOOST_CHECK(model.GetBoundingSphereRadius() > 0.0f);
+	const unsigned int frameCount = model.GetPoseFrameCount(0);
+	for (unsigned int f = 0; f < frameCount; ++f)
+	{
+		const glm::mat4* pose = model.GetPose(0, static_cast<double>(f) / Engine::Model::PoseSampleRate);
+		for (const Engine::Model::MaterialGroup::Part& part : model.GetMaterialGroups()[0].parts)
+		{
+			for (const glm::vec3& position : model.GetFlatMeshes()[part.mesh]->GetVertexPositions())
+			{
+				const glm::vec3 vertex(pose[part.node] * glm::vec4(position, 1.0f));
+				BOOST_CHECK(glm::length(vertex - model.GetBoundingSphereCenter()) <= model.GetBoundingSphereRadius() + 1e-3f);
+				for (int i = 0; i < 3; ++i)
+				{
+					BOOST_CHECK(vertex[i] >= model.GetBoundingBoxMinimum()[i] - 1e-3f);
+					BOOST_CHECK(vertex[i] <= model.GetBoundingBoxMaximum()[i] + 1e-3f);
+				}
+			}
+		}
+	}
+}
+
+/**
+ * Ensure that each level of detail generated for a large mesh has fewer
+ * triangles than the one before, and indexes only the mesh's own vertices.
+ */
+BOOST_AUTO_TEST_CASE(TestLargeMeshesHaveLods)
+{
+	const int size = 32;
+	std::vector<glm::vec3> positions;
+	std::vector<unsigned int> indices;
+	for (int y = 0; y <= size; ++y)
+	{
+		for (int x = 0; x <= size; ++x)
+		{
+			const float height = std::sin(x * 0.3f) * std::cos(y * 0.2f);
+			positions.push_back(glm::vec3(static_cast<float>(x), height, static_cast<float>(y)));
+		}
+	}
+	for (int y = 0; y < size; ++y)
+	{
+		for (int x = 0; x < size; ++x)
+		{
+			const unsigned int corner = y * (size + 1) + x;
+			indices.push_back(corner);
+			indices.push_back(corner + size + 1);
+			indices.push_back(corner + 1);
+			indices.push_back(corner + 1);
+			indices.push_back(corner + size + 1);
+			indices.push_back(corner + size + 2);
+		}
+	}
+
+	Engine::Model::Node::Mesh mesh;
+	std::vector<glm::vec3> normals(positions.size(), glm::vec3(0.0f, 1.0f, 0.0f));
+	std::vector<glm::vec3> textureCoordinates(positions.size());
+	mesh.SetVertexData(positions, normals, textureCoordinates, indices);
+	mesh.GenerateLods();
+
+	BOOST_REQUIRE_EQUAL(Engine::Model::MaxLodCount, mesh.GetLodCount());
+	BOOST_CHECK(mesh.GetLodIndices(0) == indices);
+	for (unsigned int l = 1; l < mesh.GetLodCount(); ++l)
+	{
+		const std::vector<unsigned int>& lod = mesh.GetLodIndices(l);
+		BOOST_CHECK_EQUAL(0u, lod.size() % 3);
+		BOOST_CHECK(!lod.empty());
+		BOOST_CHECK(lod.size() < mesh.GetLodIndices(l - 1).size());
+		for (unsigned int index : lod)
+		{
+			BOOST_CHECK(index < positions.size());
+		}
+	}
+}
+
+/**
+ * Ensure that imported meshes store their vertices in the order that their
+ * indices first use them.
+ */
+BOOST_AUTO_TEST_CASE(TestMeshesAreInVertexFetchOrder)
+{
+	for (const std::string& path : {TranslationModelPath, RotationModelPath, AnimatedModelPath, ManyKeyframesModelPath})
+	{
+		Engine::Model model;
+		BOOST_REQUIRE(model.Decode(path));
+
+		for (const std::shared_ptr<Engine::Model::Node::Mesh>& mesh : model.GetFlatMeshes())
+		{
+			unsigned int nextVertex = 0;
+			for (unsigned int index : mesh->GetVertexIndices())
+			{
+				BOOST_REQUIRE(index <= nextVertex);
+				if (index == nextVertex)
+				{
+					++nextVertex;
+				}
+			}
+		}
+	}
+}
+
+/**
+ * Ensure that transforming a model moves its poses and bounds, and keeps its
+ * material groups.
+ */
+BOOST_AUTO_TEST_CASE(TestTransformKeepsMaterialGroups)
+{
+	Engine::Model model;
+	BOOST_REQUIRE(model.Decode(AnimatedModelPath));
+
+	unsigned int box = 0;
+	BOOST_REQUIRE(FindFlatNodeIndex(model.GetRootNode(), "Box", box));
+	const glm::mat4 boxBefore = model.GetPose(0, 0.5)[box];
+	const glm::vec3 centerBefore = model.GetBoundingSphereCenter();
+	const std::size_t groupCount = model.GetMaterialGroups().size();
+	BOOST_REQUIRE(groupCount > 0);
+
+	const glm::vec3 offset(1.0f, 2.0f, 3.0f);
+	model.Transform(offset, glm::quat(), glm::vec3(1.0f));
+
+	// The groups are left as they were.
+	BOOST_CHECK_EQUAL(groupCount, model.GetMaterialGroups().size());
+
+	// The pose cache and bounds are rebuilt with the offset.
+	const glm::mat4 boxAfter = model.GetPose(0, 0.5)[box];
+	const glm::vec3 centerAfter = model.GetBoundingSphereCenter();
+	for (int i = 0; i < 3; ++i)
+	{
+		BOOST_CHECK_SMALL(boxAfter[3][i] - boxBefore[3][i] - offset[i], 1e-4f);
+		BOOST_CHECK_SMALL(centerAfter[i] - centerBefore[i] - offset[i], 1e-4f);
+	}
+}
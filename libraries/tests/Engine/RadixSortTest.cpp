@@ -0,0 +1,77 @@
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <Engine/RadixSort.hpp>
+
+/**
+ * Value sorted in the tests, which remembers its original position.
+ */
+struct SortItem
+{
+	std::uint64_t key;
+	unsigned int position;
+};
+
+/**
+ * Ensure that values are sorted by key, with values that have equal keys kept
+ * in their original order.
+ */
+BOOST_AUTO_TEST_CASE(TestValuesAreSortedStably)
+{
+	std::mt19937_64 random(7);
+	std::vector<SortItem> values;
+	for (unsigned int i = 0; i < 5000; ++i)
+	{
+		// Use few distinct keys so that many are equal, spread over the
+		// high and low bytes.
+		const std::uint64_t key = (random() % 50) << 40 | (random() % 4);
+		values.push_back({key, i});
+	}
+
+	std::vector<SortItem> expected = values;
+	std::stable_sort(expected.begin(), expected.end(), [] (const SortItem& a, const SortItem& b) {
+		return a.key < b.key;
+	});
+
+	std::vector<SortItem> scratch;
+	Engine::RadixSort(values, scratch);
+	BOOST_REQUIRE_EQUAL(expected.size(), values.size());
+	for (unsigned int i = 0; i < values.size(); ++i)
+	{
+		BOOST_CHECK_EQUAL(expected[i].key, values[i].key);
+		BOOST_CHECK_EQUAL(expected[i].position, values[i].position);
+	}
+}
+
+/**
+ * Ensure that keys using every bit are sorted, and that empty and single value
+ * lists are left alone.
+ */
+BOOST_AUTO_TEST_CASE(TestFullKeysAreSorted)
+{
+	std::vector<SortItem> scratch;
+	std::vector<SortItem> values;
+	Engine::RadixSort(values, scratch);
+	BOOST_CHECK(values.empty());
+
+	values.push_back({~0ull, 0});
+	Engine::RadixSort(values, scratch);
+	BOOST_REQUIRE_EQUAL(1u, values.size());
+
+	std::mt19937_64 random(11);
+	for (unsigned int i = 1; i < 1000; ++i)
+	{
+		values.push_back({random(), i});
+	}
+	values.push_back({0, 1000});
+
+	Engine::RadixSort(values, scratch);
+	BOOST_CHECK_EQUAL(0u, values.front().key);
+	BOOST_CHECK_EQUAL(~0ull, values.back().key);
+	for (unsigned int i = 1; i < values.size(); ++i)
+	{
+		BOOST_CHECK(values[i - 1].key <= values[i].key);
+	}
+}
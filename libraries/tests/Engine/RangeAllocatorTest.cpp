@@ -0,0 +1,72 @@
+#include <boost/test/unit_test.hpp>
+#include <cstddef>
+#include <Engine/RangeAllocator.hpp>
+
+/**
+ * Ensure that allocations are placed first-fit, respect their alignment and
+ * fail once there is no free range large enough.
+ */
+BOOST_AUTO_TEST_CASE(TestRangesAreAllocatedFirstFit)
+{
+	Engine::RangeAllocator allocator(100);
+
+	std::size_t first = 0;
+	BOOST_REQUIRE(allocator.Allocate(10, 1, first));
+	BOOST_CHECK_EQUAL(0u, first);
+
+	// The padding needed to align the second range stays free.
+	std::size_t second = 0;
+	BOOST_REQUIRE(allocator.Allocate(20, 16, second));
+	BOOST_CHECK_EQUAL(16u, second);
+	BOOST_CHECK_EQUAL(70u, allocator.GetFreeSize());
+	BOOST_CHECK_EQUAL(2u, allocator.GetFreeRangeCount());
+
+	// The padding is used by the next allocation small enough to fit.
+	std::size_t third = 0;
+	BOOST_REQUIRE(allocator.Allocate(6, 2, third));
+	BOOST_CHECK_EQUAL(10u, third);
+	BOOST_CHECK_EQUAL(1u, allocator.GetFreeRangeCount());
+
+	std::size_t fourth = 0;
+	BOOST_CHECK(!allocator.Allocate(65, 1, fourth));
+	BOOST_REQUIRE(allocator.Allocate(64, 1, fourth));
+	BOOST_CHECK_EQUAL(36u, fourth);
+	BOOST_CHECK_EQUAL(0u, allocator.GetFreeSize());
+	BOOST_CHECK_EQUAL(0u, allocator.GetFreeRangeCount());
+	BOOST_CHECK(!allocator.Allocate(1, 1, fourth));
+}
+
+/**
+ * Ensure that freed ranges are merged with their free neighbours, so that
+ * the whole capacity can be allocated again once everything is freed.
+ */
+BOOST_AUTO_TEST_CASE(TestFreedRangesAreMerged)
+{
+	Engine::RangeAllocator allocator(40);
+
+	std::size_t offsets[4];
+	for (int i = 0; i < 4; ++i)
+	{
+		BOOST_REQUIRE(allocator.Allocate(10, 1, offsets[i]));
+	}
+
+	// Freeing alternate ranges leaves holes too small for a larger range.
+	allocator.Free(offsets[0], 10);
+	allocator.Free(offsets[2], 10);
+	BOOST_CHECK_EQUAL(2u, allocator.GetFreeRangeCount());
+	std::size_t offset = 0;
+	BOOST_CHECK(!allocator.Allocate(20, 1, offset));
+
+	// Freeing the range between the holes merges all three.
+	allocator.Free(offsets[1], 10);
+	BOOST_CHECK_EQUAL(1u, allocator.GetFreeRangeCount());
+	BOOST_REQUIRE(allocator.Allocate(30, 1, offset));
+	BOOST_CHECK_EQUAL(0u, offset);
+
+	allocator.Free(offset, 30);
+	allocator.Free(offsets[3], 10);
+	BOOST_CHECK_EQUAL(1u, allocator.GetFreeRangeCount());
+	BOOST_CHECK_EQUAL(allocator.GetCapacity(), allocator.GetFreeSize());
+	BOOST_REQUIRE(allocator.Allocate(40, 1, offset));
+	BOOST_CHECK_EQUAL(0u, offset);
+}
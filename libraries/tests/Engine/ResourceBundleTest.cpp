@@ -0,0 +1,160 @@
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <future>
+#include <map>
+#include <string>
+#include <vector>
+#include <Engine/ResourceBundle.hpp>
+
+/**
+ * Stands in for the resource manager by recording requests and reporting
+ * the state that the test has given to each resource.
+ */
+class FakeLoader
+{
+public:
+	void Update(Engine::ResourceBundle& bundle)
+	{
+		bundle.Update(
+			[this](const Engine::ResourceManifest::Entry& entry)
+			{
+				auto iter = statuses.find(entry.path);
+				return (iter != statuses.end()) ? iter->second : Engine::ResourceBundle::RequestStatus::Loading;
+			},
+			[this](const Engine::ResourceManifest::Entry& entry)
+			{
+				requests.push_back(entry.path);
+			}
+		);
+	}
+
+	std::vector<std::string> requests;
+
+	std::map<std::string, Engine::ResourceBundle::RequestStatus> statuses;
+};
+
+/**
+ * Returns the size of a resource, which is the length of its path.
+ *
+ * @param entry Manifest entry for the resource.
+ * @return Size of the resource (in bytes).
+ */
+static std::size_t GetPathLength(const Engine::ResourceManifest::Entry& entry)
+{
+	return entry.path.size() + entry.secondaryPath.size();
+}
+
+/**
+ * Ensure that resources are requested highest priority first, in manifest
+ * order within a priority, and no more than the limit at once.
+ */
+BOOST_AUTO_TEST_CASE(TestResourcesAreRequestedInPriorityOrder)
+{
+	Engine::ResourceManifest manifest;
+	for (unsigned int i = 0; i < Engine::ResourceBundle::MaxRequestsInFlight; ++i)
+	{
+		manifest.AddModel("low" + std::to_string(i), Engine::ResourcePriority::Low);
+	}
+	manifest.AddTexture("normal", Engine::ResourcePriority::Normal);
+	manifest.AddAudio("high0", Engine::ResourcePriority::High);
+	manifest.AddShaderProgram("high1.vert", "high1.frag", Engine::ResourcePriority::High);
+
+	Engine::ResourceBundle bundle(manifest, GetPathLength);
+	BOOST_CHECK_EQUAL(manifest.GetEntryCount(), bundle.GetResourceCount());
+
+	FakeLoader loader;
+	loader.Update(bundle);
+	BOOST_REQUIRE_EQUAL(Engine::ResourceBundle::MaxRequestsInFlight, loader.requests.size());
+	BOOST_CHECK_EQUAL("high0", loader.requests[0]);
+	BOOST_CHECK_EQUAL("high1.vert", loader.requests[1]);
+	BOOST_CHECK_EQUAL("normal", loader.requests[2]);
+	BOOST_CHECK_EQUAL("low0", loader.requests[3]);
+
+	// Nothing more is requested until a request finishes.
+	loader.Update(bundle);
+	BOOST_CHECK_EQUAL(Engine::ResourceBundle::MaxRequestsInFlight, loader.requests.size());
+
+	loader.statuses["high0"] = Engine::ResourceBundle::RequestStatus::Loaded;
+	loader.Update(bundle);
+	BOOST_REQUIRE_EQUAL(Engine::ResourceBundle::MaxRequestsInFlight + 1, loader.requests.size());
+	BOOST_CHECK_EQUAL("low" + std::to_string(Engine::ResourceBundle::MaxRequestsInFlight - 3), loader.requests.back());
+	BOOST_CHECK(!bundle.IsComplete());
+}
+
+/**
+ * Ensure that progress is measured by size, that failures count towards it,
+ * and that the future reports whether every resource was loaded.
+ */
+BOOST_AUTO_TEST_CASE(TestProgressAndCompletion)
+{
+	Engine::ResourceManifest manifest;
+	manifest.AddTexture("abc");
+	manifest.AddTexture("d");
+
+	Engine::ResourceBundle bundle(manifest, GetPathLength);
+	BOOST_CHECK_EQUAL(4u, bundle.GetTotalBytes());
+	BOOST_CHECK_EQUAL(0.0f, bundle.GetProgress());
+
+	FakeLoader loader;
+	loader.Update(bundle);
+	loader.statuses["abc"] = Engine::ResourceBundle::RequestStatus::Loaded;
+	loader.Update(bundle);
+	BOOST_CHECK_EQUAL(3u, bundle.GetLoadedBytes());
+	BOOST_CHECK_EQUAL(0.75f, bundle.GetProgress());
+	BOOST_CHECK(!bundle.IsComplete());
+
+	std::shared_future<bool> future = bundle.GetFuture();
+	BOOST_CHECK(future.wait_for(std::chrono::seconds(0)) == std::future_status::timeout);
+
+	loader.statuses["d"] = Engine::ResourceBundle::RequestStatus::Failed;
+	loader.Update(bundle);
+	BOOST_CHECK_EQUAL(1.0f, bundle.GetProgress());
+	BOOST_CHECK_EQUAL(1u, bundle.GetLoadedCount());
+	BOOST_CHECK_EQUAL(1u, bundle.GetFailedCount());
+	BOOST_CHECK(bundle.IsComplete());
+	BOOST_REQUIRE(future.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+	BOOST_CHECK(!future.get());
+}
+
+/**
+ * Ensure that a cancelled bundle stops requesting resources, and completes
+ * once the requests in flight have finished.
+ */
+BOOST_AUTO_TEST_CASE(TestCancelledBundleStopsRequesting)
+{
+	Engine::ResourceManifest manifest;
+	for (unsigned int i = 0; i < Engine::ResourceBundle::MaxRequestsInFlight * 2; ++i)
+	{
+		manifest.AddAudio("audio" + std::to_string(i));
+	}
+
+	Engine::ResourceBundle bundle(manifest, GetPathLength);
+	FakeLoader loader;
+	loader.Update(bundle);
+
+	bundle.Cancel();
+	BOOST_CHECK(bundle.IsCancelled());
+	BOOST_CHECK(!bundle.IsComplete());
+
+	for (const std::string& path : loader.requests)
+	{
+		loader.statuses[path] = Engine::ResourceBundle::RequestStatus::Loaded;
+	}
+	loader.Update(bundle);
+
+	BOOST_CHECK_EQUAL(Engine::ResourceBundle::MaxRequestsInFlight, loader.requests.size());
+	BOOST_CHECK_EQUAL(Engine::ResourceBundle::MaxRequestsInFlight, bundle.GetLoadedCount());
+	BOOST_CHECK(bundle.IsComplete());
+	BOOST_CHECK(!bundle.GetFuture().get());
+}
+
+/**
+ * Ensure that an empty bundle is complete straight away.
+ */
+BOOST_AUTO_TEST_CASE(TestEmptyBundleIsComplete)
+{
+	Engine::ResourceBundle bundle(Engine::ResourceManifest(), GetPathLength);
+	BOOST_CHECK(bundle.IsComplete());
+	BOOST_CHECK_EQUAL(1.0f, bundle.GetProgress());
+	BOOST_CHECK(bundle.GetFuture().get());
+}
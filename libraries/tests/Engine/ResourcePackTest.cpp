@@ -0,0 +1,114 @@
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <Engine/ResourcePack.hpp>
+#include <Engine/ResourcePackWriter.hpp>
+
+/**
+ * Scratch resource pack written by the tests.
+ */
+static const std::string ResourcePackPath = "ResourcePackTest.pack";
+
+/**
+ * Returns the contents of a blob as a vector.
+ *
+ * @param blob The blob.
+ * @return Copy of the blob contents.
+ */
+static std::vector<unsigned char> GetContents(const Engine::ResourcePack::Blob& blob)
+{
+	return std::vector<unsigned char>(blob.GetData(), blob.GetData() + blob.GetSize());
+}
+
+/**
+ * Ensure that resources written to a pack, compressed or not, are read back
+ * unchanged, and that resources that were not written are not found.
+ */
+BOOST_AUTO_TEST_CASE(TestResourcesAreReadBackUnchanged)
+{
+	// Repetitive text compresses well.
+	std::string text;
+	for (int i = 0; i < 200; ++i)
+	{
+		text += "uniform mat4 modelViewProjectionMatrix;\n";
+	}
+	const std::vector<unsigned char> compressible(text.begin(), text.end());
+
+	// Noise does not compress, so it is stored as is.
+	std::vector<unsigned char> incompressible(4096);
+	unsigned int seed = 12345;
+	for (std::size_t i = 0; i < incompressible.size(); ++i)
+	{
+		seed = seed * 1103515245u + 12345u;
+		incompressible[i] = static_cast<unsigned char>(seed >> 16);
+	}
+
+	const std::vector<unsigned char> empty;
+
+	Engine::ResourcePackWriter writer;
+	BOOST_REQUIRE(writer.Add("resources/shaders/Test.vert", compressible, true));
+	BOOST_REQUIRE(writer.Add("resources/images/Noise.raw", incompressible, true));
+	BOOST_REQUIRE(writer.Add("resources/Empty.txt", empty, false));
+	BOOST_CHECK(!writer.Add("resources/Empty.txt", empty, false));
+	BOOST_CHECK_EQUAL(3u, writer.GetResourceCount());
+	BOOST_REQUIRE(writer.Save(ResourcePackPath));
+
+	{
+		Engine::ResourcePack pack;
+		BOOST_REQUIRE(pack.Open(ResourcePackPath));
+		BOOST_CHECK_EQUAL(3u, pack.GetResourceCount());
+
+		Engine::ResourcePack::Blob blob;
+		BOOST_REQUIRE(pack.Read("resources/shaders/Test.vert", blob));
+		BOOST_CHECK(GetContents(blob) == compressible);
+
+		BOOST_REQUIRE(pack.Read("./resources/images/Noise.raw", blob));
+		BOOST_CHECK(GetContents(blob) == incompressible);
+
+		BOOST_REQUIRE(pack.Read("resources/Empty.txt", blob));
+		BOOST_CHECK_EQUAL(0u, blob.GetSize());
+
+		std::size_t size = 0;
+		BOOST_REQUIRE(pack.GetSize("resources/shaders/Test.vert", size));
+		BOOST_CHECK_EQUAL(compressible.size(), size);
+
+		BOOST_CHECK(!pack.Contains("resources/shaders/Missing.vert"));
+		BOOST_CHECK(!pack.GetSize("resources/shaders/Missing.vert", size));
+		BOOST_CHECK(!pack.Read("resources/shaders/Missing.vert", blob));
+	}
+
+	std::remove(ResourcePackPath.c_str());
+}
+
+/**
+ * Ensure that a pack whose index runs past the end of the file is rejected.
+ */
+BOOST_AUTO_TEST_CASE(TestTruncatedResourcePackIsRejected)
+{
+	Engine::ResourcePackWriter writer;
+	for (int i = 0; i < 10; ++i)
+	{
+		BOOST_REQUIRE(writer.Add("resource" + std::to_string(i), std::vector<unsigned char>(100, i), false));
+	}
+	BOOST_REQUIRE(writer.Save(ResourcePackPath));
+
+	// Keep the header and only part of the index.
+	std::vector<char> contents;
+	{
+		std::ifstream file(ResourcePackPath, std::ios::in | std::ios::binary);
+		contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+	{
+		std::ofstream file(ResourcePackPath, std::ios::out | std::ios::binary | std::ios::trunc);
+		file.write(&contents[0], sizeof(Engine::ResourcePackFormat::Header) + sizeof(Engine::ResourcePackFormat::Entry) * 5);
+	}
+
+	Engine::ResourcePack pack;
+	BOOST_CHECK(!pack.Open(ResourcePackPath));
+	BOOST_CHECK(!pack.IsOpen());
+
+	std::remove(ResourcePackPath.c_str());
+}
@@ -0,0 +1,170 @@
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <string>
+#include <Engine/ResourceTable.hpp>
+
+/**
+ * Ensure that interning a name always returns the same handle, and that
+ * distinct names are given distinct handles.
+ */
+BOOST_AUTO_TEST_CASE(TestInternedHandlesAreStable)
+{
+	Engine::ResourceTable<std::string> table;
+
+	const Engine::ResourceHandle<std::string> first = table.Intern("resources/models/tank/Tank.dae");
+	const Engine::ResourceHandle<std::string> second = table.Intern("resources/models/scout/Scout.dae");
+
+	BOOST_CHECK(first.IsValid());
+	BOOST_CHECK(second.IsValid());
+	BOOST_CHECK(first != second);
+	BOOST_CHECK(first == table.Intern("resources/models/tank/Tank.dae"));
+	BOOST_CHECK(second == table.Find("resources/models/scout/Scout.dae"));
+	BOOST_CHECK_EQUAL(2u, table.GetCount());
+
+	// Finding a name that has not been interned does not add a slot.
+	BOOST_CHECK(!table.Find("resources/models/wall/Wall.dae").IsValid());
+	BOOST_CHECK_EQUAL(2u, table.GetCount());
+}
+
+/**
+ * Ensure that resources are only returned once they have been stored, and
+ * that invalid handles return a nullptr.
+ */
+BOOST_AUTO_TEST_CASE(TestResourcesAreFetchedByHandle)
+{
+	Engine::ResourceTable<std::string> table;
+
+	const Engine::ResourceHandle<std::string> handle = table.Intern("name");
+	BOOST_CHECK(!table.Get(handle));
+	BOOST_CHECK(!table.IsRequested(handle));
+
+	table.SetRequested(handle, true);
+	BOOST_CHECK(table.IsRequested(handle));
+	BOOST_CHECK(!table.Get(handle));
+
+	std::shared_ptr<std::string> resource = std::make_shared<std::string>("resource");
+	table.Set(handle, resource);
+	BOOST_CHECK(table.Get(handle) == resource);
+
+	BOOST_CHECK(!table.Get(Engine::ResourceHandle<std::string>()));
+	BOOST_CHECK(!table.IsRequested(Engine::ResourceHandle<std::string>()));
+}
+
+/**
+ * Ensure that only loaded resources without references can be evicted, and
+ * that evicted resources can be requested again.
+ */
+BOOST_AUTO_TEST_CASE(TestOnlyUnreferencedResourcesAreEvicted)
+{
+	Engine::ResourceTable<std::string> table;
+
+	const Engine::ResourceHandle<std::string> handle = table.Intern("name");
+	table.SetRequested(handle, true);
+	table.AddReference(handle);
+
+	// Not loaded yet.
+	BOOST_CHECK(!table.IsEvictable(handle));
+
+	table.Set(handle, std::make_shared<std::string>("resource"), 100, 200);
+	BOOST_CHECK(!table.IsEvictable(handle));
+	BOOST_CHECK(!table.Evict(handle));
+
+	table.ReleaseReference(handle);
+	BOOST_CHECK_EQUAL(0u, table.GetReferenceCount(handle));
+	BOOST_CHECK(table.IsEvictable(handle));
+	BOOST_CHECK(table.Evict(handle));
+
+	BOOST_CHECK(!table.Get(handle));
+	BOOST_CHECK(!table.IsRequested(handle));
+	BOOST_CHECK_EQUAL(0u, table.GetCPUBytes(handle));
+	BOOST_CHECK_EQUAL(0u, table.GetGPUBytes(handle));
+}
+
+/**
+ * Ensure that the usage report only counts loaded resources, and that lookups
+ * record the time of use.
+ */
+BOOST_AUTO_TEST_CASE(TestUsageCountsLoadedResources)
+{
+	Engine::ResourceTable<std::string> table;
+
+	const Engine::ResourceHandle<std::string> first = table.Intern("first");
+	const Engine::ResourceHandle<std::string> second = table.Intern("second");
+	table.Intern("third");
+
+	table.Set(first, std::make_shared<std::string>("first"), 10, 20);
+	table.Set(second, std::make_shared<std::string>("second"), 30, 40);
+	table.AddReference(second);
+
+	const Engine::ResourceUsage usage = table.GetUsage();
+	BOOST_CHECK_EQUAL(2u, usage.residentCount);
+	BOOST_CHECK_EQUAL(1u, usage.referencedCount);
+	BOOST_CHECK_EQUAL(40u, usage.cpuBytes);
+	BOOST_CHECK_EQUAL(60u, usage.gpuBytes);
+
+	table.SetClock(5);
+	table.Get(first);
+	BOOST_CHECK_EQUAL(5u, table.GetLastUsed(first));
+	BOOST_CHECK_EQUAL(0u, table.GetLastUsed(second));
+}
+
+/**
+ * Ensure that an evicted resource is reported as needing to be reloaded
+ * until it is requested again, even once it is referenced again.
+ */
+BOOST_AUTO_TEST_CASE(TestEvictedResourcesNeedReloading)
+{
+	Engine::ResourceTable<std::string> table;
+
+	const Engine::ResourceHandle<std::string> handle = table.Intern("resources/models/tank/Tank.dae");
+	BOOST_CHECK_EQUAL("resources/models/tank/Tank.dae", table.GetName(handle));
+	BOOST_CHECK(!table.IsEvicted(handle));
+
+	table.SetRequested(handle, true);
+	table.Set(handle, std::make_shared<std::string>("resource"));
+	BOOST_CHECK(table.Evict(handle));
+	BOOST_CHECK(table.IsEvicted(handle));
+
+	// Referencing the resource does not load it.
+	table.AddReference(handle);
+	BOOST_CHECK(table.IsEvicted(handle));
+	BOOST_CHECK(!table.Get(handle));
+
+	// Requesting it again clears the flag, and the reloaded resource is kept.
+	table.SetRequested(handle, true);
+	BOOST_CHECK(!table.IsEvicted(handle));
+	table.Set(handle, std::make_shared<std::string>("reloaded"));
+	BOOST_CHECK_EQUAL("reloaded", *table.Get(handle));
+	BOOST_CHECK(!table.IsEvictable(handle));
+}
+
+/**
+ * Ensure that adding a reference reports when the resource must be requested
+ * again, as when a reloaded model or a group references a texture that was
+ * evicted, and that it is only reported once the resource is requested.
+ */
+BOOST_AUTO_TEST_CASE(TestReferencingEvictedResourceRequestsReload)
+{
+	Engine::ResourceTable<std::string> textures;
+
+	const Engine::ResourceHandle<std::string> texture = textures.Intern("resources/textures/Tank.png");
+	textures.SetRequested(texture, true);
+	textures.Set(texture, std::make_shared<std::string>("texture"));
+
+	// A resource that has not been evicted needs no reload.
+	BOOST_CHECK(!textures.AddReference(texture));
+	textures.ReleaseReference(texture);
+	BOOST_CHECK(textures.Evict(texture));
+
+	// The first reference after the eviction, from the reloaded model,
+	// requests the texture again.
+	BOOST_CHECK(textures.AddReference(texture));
+	textures.SetRequested(texture, true);
+
+	// A group referencing it while it reloads does not request it twice.
+	BOOST_CHECK(!textures.AddReference(texture));
+	BOOST_CHECK_EQUAL(2u, textures.GetReferenceCount(texture));
+
+	textures.Set(texture, std::make_shared<std::string>("reloaded"));
+	BOOST_CHECK_EQUAL("reloaded", *textures.Get(texture));
+}
@@ -0,0 +1,145 @@
+#include <boost/test/unit_test.hpp>
+#include <vector>
+#include <thread>
+#include <Engine/ThreadEventReceiver.hpp>
+
+/**
+ * Event carrying the identifier of the producer that sent it and the
+ * producer's sequence number for the event.
+ */
+class ProducerTestEvent
+{
+public:
+	/**
+	 * Constructor.
+	 *
+	 * @param prdcr Producer identifier.
+	 * @param seq Sequence number.
+	 */
+	ProducerTestEvent(const int prdcr, const int seq) :
+	producer(prdcr),
+	sequence(seq)
+	{
+		// Nothing to do.
+	}
+
+	/**
+	 * Producer identifier.
+	 */
+	int producer;
+
+	/**
+	 * Sequence number.
+	 */
+	int sequence;
+};
+
+/**
+ * Ensure that a StopThreadEvent is delivered before events that were queued
+ * ahead of it.
+ */
+BOOST_AUTO_TEST_CASE(TestStopThreadEventIsDeliveredFirst)
+{
+	Engine::ThreadEventReceiver receiver;
+
+	std::vector<int> order;
+	receiver.Subscribe<ProducerTestEvent>([&order](const ProducerTestEvent& event) {
+		order.push_back(event.sequence);
+	});
+	receiver.Subscribe<Engine::Event::StopThreadEvent>([&order](const Engine::Event::StopThreadEvent& event) {
+		order.push_back(-1);
+	});
+
+	receiver.Enqueue<ProducerTestEvent>(0, 1);
+	receiver.Enqueue<ProducerTestEvent>(0, 2);
+	receiver.Enqueue<Engine::Event::StopThreadEvent>();
+	receiver.Update();
+
+	BOOST_CHECK_EQUAL(3u, order.size());
+	BOOST_CHECK_EQUAL(-1, order[0]);
+	BOOST_CHECK_EQUAL(1, order[1]);
+	BOOST_CHECK_EQUAL(2, order[2]);
+	BOOST_CHECK(!receiver.HasQueuedEvents());
+}
+
+/**
+ * Stress test: several producers enqueue events concurrently into a small
+ * queue while the receiving thread waits for and drains them. Every event
+ * must be delivered exactly once, and each producer's events must arrive in
+ * the order in which they were sent.
+ *
+ * This test is intended to be run under ThreadSanitizer (-Dtsan=ON).
+ */
+BOOST_AUTO_TEST_CASE(TestMultipleProducersStress)
+{
+	const int producerCount = 4;
+	const int eventsPerProducer = 20000;
+
+	// A small capacity forces producers to wait for the receiver.
+	Engine::ThreadEventReceiver receiver(64);
+
+	std::vector<int> nextSequence(producerCount, 0);
+	int eventsReceived = 0;
+	int outOfOrderEvents = 0;
+	receiver.Subscribe<ProducerTestEvent>([&](const ProducerTestEvent& event) {
+		if (event.sequence != nextSequence[event.producer])
+		{
+			++outOfOrderEvents;
+		}
+		nextSequence[event.producer] = event.sequence + 1;
+		++eventsReceived;
+	});
+
+	std::vector<std::thread> producers;
+	for (int producer = 0; producer < producerCount; ++producer)
+	{
+		producers.emplace_back([&receiver, producer, eventsPerProducer]() {
+			for (int sequence = 0; sequence < eventsPerProducer; ++sequence)
+			{
+				receiver.Enqueue<ProducerTestEvent>(producer, sequence);
+			}
+		});
+	}
+
+	while (eventsReceived < producerCount * eventsPerProducer)
+	{
+		receiver.Wait();
+		receiver.Update();
+	}
+
+	for (auto iter = producers.begin(); iter != producers.end(); ++iter)
+	{
+		iter->join();
+	}
+
+	BOOST_CHECK_EQUAL(producerCount * eventsPerProducer, eventsReceived);
+	BOOST_CHECK_EQUAL(0, outOfOrderEvents);
+	BOOST_CHECK(!receiver.HasQueuedEvents());
+}
+
+/**
+ * Ensure that a producer blocked on a full queue gives up once the receiving
+ * thread stops, and that later events into the full queue are dropped
+ * rather than waited on.
+ */
+BOOST_AUTO_TEST_CASE(TestEnqueueIntoStoppedFullReceiverReturns)
+{
+	Engine::ThreadEventReceiver receiver(4);
+	for (int sequence = 0; sequence < 4; ++sequence)
+	{
+		BOOST_CHECK(receiver.Enqueue<ProducerTestEvent>(0, sequence));
+	}
+
+	// This producer waits for room that the receiver never makes.
+	bool blockedResult = true;
+	std::thread producer([&receiver, &blockedResult]() {
+		blockedResult = receiver.Enqueue<ProducerTestEvent>(1, 0);
+	});
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	receiver.Stop();
+	producer.join();
+
+	BOOST_CHECK(!blockedResult);
+	BOOST_CHECK(!receiver.Enqueue<ProducerTestEvent>(2, 0));
+}
@@ -0,0 +1,95 @@
+#include <boost/test/unit_test.hpp>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <Engine/UniformHandle.hpp>
+
+// Names are hashed at compile time, with the published FNV-1a test values.
+static_assert(Engine::HashUniformName("") == 0x811C9DC5u, "The empty name hashes to the offset basis");
+static_assert(Engine::HashUniformName("a") == 0xE40C292Cu, "FNV-1a hash of \"a\"");
+static_assert(Engine::BuiltinUniforms::ModelMatrix.GetHash() == Engine::HashUniformName("modelMatrix"),
+	"Built-in uniform names are hashed at compile time");
+static_assert(Engine::HashUniformName("costarring") == Engine::HashUniformName("liquid"),
+	"Known FNV-1a collision used to test the location cache");
+
+/**
+ * Ensure that names hashed at run time match those hashed at compile time.
+ */
+BOOST_AUTO_TEST_CASE(TestRuntimeNamesMatchCompileTimeNames)
+{
+	const std::string name = "material.diffuseColor";
+	const Engine::UniformName runtimeName(name.c_str());
+	BOOST_CHECK_EQUAL(Engine::BuiltinUniforms::MaterialDiffuseColor.GetHash(), runtimeName.GetHash());
+	BOOST_CHECK_EQUAL(Engine::HashUniformName("foobar"), 0xBF9CF968u);
+}
+
+/**
+ * Ensure that the built-in uniform names have distinct hashes, so that each
+ * is cached by shader programs.
+ */
+BOOST_AUTO_TEST_CASE(TestBuiltinUniformHashesAreDistinct)
+{
+	const Engine::UniformName names[] = {
+		Engine::BuiltinUniforms::ModelMatrix,
+		Engine::BuiltinUniforms::NormalMatrix,
+		Engine::BuiltinUniforms::NodeTransformations,
+		Engine::BuiltinUniforms::MaterialDiffuseColor,
+		Engine::BuiltinUniforms::MaterialSpecularColor,
+		Engine::BuiltinUniforms::MaterialAmbientColor,
+		Engine::BuiltinUniforms::MaterialEmissiveColor,
+		Engine::BuiltinUniforms::MaterialShininess,
+		Engine::BuiltinUniforms::UseTexture,
+		Engine::BuiltinUniforms::DiffuseTextureUnit,
+		Engine::BuiltinUniforms::ModelViewProjectionMatrix,
+		Engine::BuiltinUniforms::TextureUnit
+	};
+
+	std::set<std::uint32_t> hashes;
+	for (const Engine::UniformName& name : names)
+	{
+		hashes.insert(name.GetHash());
+	}
+
+	BOOST_CHECK_EQUAL(sizeof(names) / sizeof(names[0]), hashes.size());
+}
+
+/**
+ * Ensure that a default handle refers to no uniform.
+ */
+BOOST_AUTO_TEST_CASE(TestDefaultHandleIsInvalid)
+{
+	BOOST_CHECK(!Engine::UniformHandle().IsValid());
+	BOOST_CHECK(Engine::UniformHandle(0).IsValid());
+	BOOST_CHECK_EQUAL(3, Engine::UniformHandle(3).GetLocation());
+}
+
+/**
+ * Ensure that a name whose hash collides with a cached name is not given the
+ * cached name's location.
+ */
+BOOST_AUTO_TEST_CASE(TestCollidingNamesAreNotConfused)
+{
+	Engine::UniformLocationCache cache;
+	const Engine::UniformName first("costarring");
+	const Engine::UniformName second("liquid");
+
+	GLint location = -1;
+	BOOST_CHECK(!cache.Find(first, location));
+
+	cache.Insert(first, 7);
+	BOOST_CHECK(cache.Find(first, location));
+	BOOST_CHECK_EQUAL(7, location);
+
+	// The colliding name misses, so its location is looked up instead.
+	location = -1;
+	BOOST_CHECK(!cache.Find(second, location));
+	BOOST_CHECK_EQUAL(-1, location);
+
+	// Caching it does not replace the first name's location.
+	cache.Insert(second, 3);
+	BOOST_CHECK(cache.Find(first, location));
+	BOOST_CHECK_EQUAL(7, location);
+
+	cache.Clear();
+	BOOST_CHECK(!cache.Find(first, location));
+}
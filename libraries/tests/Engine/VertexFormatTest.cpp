@@ -0,0 +1,82 @@
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <Engine/VertexFormat.hpp>
+
+/**
+ * Ensure that octahedral encoded normals decode to within a small angle of
+ * the original, in every octant and along the axes.
+ */
+BOOST_AUTO_TEST_CASE(TestNormalsSurviveEncoding)
+{
+	float maxAngle = 0.0f;
+	for (int i = 0; i < 64; ++i)
+	{
+		for (int j = 0; j <= 32; ++j)
+		{
+			const float theta = 2.0f * 3.14159265f * i / 64.0f;
+			const float phi = 3.14159265f * j / 32.0f;
+			const glm::vec3 normal(std::sin(phi) * std::cos(theta), std::sin(phi) * std::sin(theta), std::cos(phi));
+
+			std::int16_t encoded[2];
+			Engine::VertexFormat::EncodeNormal(normal, encoded);
+			const glm::vec3 decoded = Engine::VertexFormat::DecodeNormal(encoded);
+
+			const float angle = std::acos(std::min(1.0f, glm::dot(glm::normalize(normal), decoded)));
+			maxAngle = std::max(maxAngle, angle);
+		}
+	}
+
+	// A 16-bit octahedral encoding is accurate to well under a thousandth
+	// of a radian.
+	BOOST_CHECK_LT(maxAngle, 0.001f);
+}
+
+/**
+ * Ensure that half floats are rounded to nearest and that values outside
+ * of the half range become zero or infinity.
+ */
+BOOST_AUTO_TEST_CASE(TestHalfFloatConversion)
+{
+	// Exactly representable values.
+	const float exact[] = {0.0f, 0.5f, 1.0f, -2.0f, 0.25f, 1024.0f, 65504.0f, 5.9604645e-08f};
+	for (float value : exact)
+	{
+		BOOST_CHECK_EQUAL(value, Engine::VertexFormat::DecodeHalf(Engine::VertexFormat::EncodeHalf(value)));
+	}
+
+	BOOST_CHECK_EQUAL(0x3C00u, Engine::VertexFormat::EncodeHalf(1.0f));
+	BOOST_CHECK_EQUAL(0xC000u, Engine::VertexFormat::EncodeHalf(-2.0f));
+	BOOST_CHECK_EQUAL(0x0001u, Engine::VertexFormat::EncodeHalf(5.9604645e-08f));
+	BOOST_CHECK_EQUAL(0x7C00u, Engine::VertexFormat::EncodeHalf(1.0e6f));
+	BOOST_CHECK_EQUAL(0x0000u, Engine::VertexFormat::EncodeHalf(1.0e-10f));
+	BOOST_CHECK(std::isnan(Engine::VertexFormat::DecodeHalf(Engine::VertexFormat::EncodeHalf(std::numeric_limits<float>::quiet_NaN()))));
+
+	// Ties round to even: 1 + 2^-11 lies halfway between 1 and 1 + 2^-10.
+	BOOST_CHECK_EQUAL(0x3C00u, Engine::VertexFormat::EncodeHalf(1.0f + std::ldexp(1.0f, -11)));
+	BOOST_CHECK_EQUAL(0x3C02u, Engine::VertexFormat::EncodeHalf(1.0f + 3.0f * std::ldexp(1.0f, -11)));
+
+	// Texture coordinates in the compact range keep a relative precision of
+	// 2^-11.
+	for (int i = 0; i <= 2000; ++i)
+	{
+		const float value = i / 1000.0f;
+		const float decoded = Engine::VertexFormat::DecodeHalf(Engine::VertexFormat::EncodeHalf(value));
+		BOOST_CHECK_SMALL(decoded - value, std::max(value, 6.1e-5f) * std::ldexp(1.0f, -11));
+	}
+}
+
+/**
+ * Ensure that texture coordinates are only considered compact while they
+ * are within the half float range that keeps sub-texel precision.
+ */
+BOOST_AUTO_TEST_CASE(TestCompactTextureCoordinateRange)
+{
+	const glm::vec3 inRange[] = {glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(-2.0f, 2.0f, 100.0f)};
+	BOOST_CHECK(Engine::VertexFormat::FitsCompact(inRange, 2));
+
+	const glm::vec3 tiled[] = {glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(16.0f, 0.0f, 0.0f)};
+	BOOST_CHECK(!Engine::VertexFormat::FitsCompact(tiled, 2));
+}
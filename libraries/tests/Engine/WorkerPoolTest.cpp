@@ -0,0 +1,92 @@
+#include <boost/test/unit_test.hpp>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <Engine/WorkerPool.hpp>
+
+/**
+ * Ensure that pending tasks are started in order of priority, and in order of
+ * submission for equal priorities.
+ */
+BOOST_AUTO_TEST_CASE(TestTasksAreStartedInPriorityOrder)
+{
+	std::mutex mutex;
+	std::condition_variable condition;
+	bool released = false;
+	std::vector<int> order;
+	std::atomic<int> completed(0);
+
+	{
+		Engine::WorkerPool pool(1);
+
+		// Occupy the only worker until all of the other tasks are queued.
+		pool.Submit(0, [&]() {
+			std::unique_lock<std::mutex> lock(mutex);
+			condition.wait(lock, [&]() { return released; });
+		});
+
+		pool.Submit(0, [&]() { order.push_back(4); ++completed; });
+		pool.Submit(2, [&]() { order.push_back(1); ++completed; });
+		pool.Submit(1, [&]() { order.push_back(3); ++completed; });
+		pool.Submit(2, [&]() { order.push_back(2); ++completed; });
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			released = true;
+		}
+		condition.notify_one();
+
+		while (completed.load() < 4)
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	BOOST_CHECK_EQUAL(4u, order.size());
+	BOOST_CHECK_EQUAL(1, order[0]);
+	BOOST_CHECK_EQUAL(2, order[1]);
+	BOOST_CHECK_EQUAL(3, order[2]);
+	BOOST_CHECK_EQUAL(4, order[3]);
+}
+
+/**
+ * Ensure that every task submitted from several threads is executed exactly
+ * once.
+ */
+BOOST_AUTO_TEST_CASE(TestAllTasksAreExecuted)
+{
+	const int submitterCount = 4;
+	const int tasksPerSubmitter = 5000;
+
+	std::atomic<int> executed(0);
+
+	{
+		Engine::WorkerPool pool(4);
+		BOOST_CHECK_EQUAL(4u, pool.GetThreadCount());
+
+		std::vector<std::thread> submitters;
+		for (int submitter = 0; submitter < submitterCount; ++submitter)
+		{
+			submitters.emplace_back([&pool, &executed, submitter, tasksPerSubmitter]() {
+				for (int task = 0; task < tasksPerSubmitter; ++task)
+				{
+					pool.Submit(task % 3, [&executed]() { ++executed; });
+				}
+			});
+		}
+
+		for (auto iter = submitters.begin(); iter != submitters.end(); ++iter)
+		{
+			iter->join();
+		}
+
+		while (executed.load() < submitterCount * tasksPerSubmitter)
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	BOOST_CHECK_EQUAL(submitterCount * tasksPerSubmitter, executed.load());
+}
@@ -5,6 +5,16 @@ struct Light
 	vec3 color;
 };
 
+// Values that are the same for every object in a frame, shared by all
+// shader programs (see Engine::Renderer::FrameUniforms).
+layout(std140) uniform FrameUniforms
+{
+	mat4 projectionMatrix;
+	mat4 viewMatrix;
+	Light light;
+	float currentTime;
+};
+
 // Material definition.
 struct Material
 {
@@ -21,18 +31,12 @@ in vec3 f_vertNormal;
 in vec4 f_vertColor;
 in vec3 f_vertTextureCoordinates;
 
-// Current time (seconds).
-uniform float currentTime;
-
 // Fraction of time left until the cloud is destroyed.
-uniform float timeLeftFraction;
+flat in float f_timeLeftFraction;
 
 // Material for the mesh.
 uniform Material material;
 
-// Directional light.
-uniform Light light;
-
 // Output for fragment color.
 out vec4 f_fragColor;
 
@@ -69,7 +73,7 @@ void main()
 	phongModel(f_vertPosition, f_vertNormal, ambient, diffuse, specular);
 
 	// Compute the fragment color.
-	float darkenFactor = max(min(timeLeftFraction, 1.0), 0.3);
+	float darkenFactor = max(min(f_timeLeftFraction, 1.0), 0.3);
 	f_fragColor = vec4(darkenFactor * light.color * (ambient + diffuse + specular), 1.0) // Darken
-		+ timeLeftFraction * 0.75 * vec4(1.0, 0.6, 0.0, 0.0); // Fiery!
+		+ f_timeLeftFraction * 0.75 * vec4(1.0, 0.6, 0.0, 0.0); // Fiery!
 }
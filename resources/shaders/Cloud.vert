@@ -0,0 +1,64 @@
+// Vertex inputs.
+// Note: Normals are octahedral encoded (see Engine::VertexFormat).
+in vec3 v_vertPosition;
+in vec2 v_vertNormal;
+in vec4 v_vertColor;
+in vec2 v_vertTextureCoordinates;
+in uint v_vertNodeIndex;
+
+// Per-instance inputs (see Engine::Renderer::InstanceData).
+in mat4 i_modelMatrix;
+in mat3 i_normalMatrix;
+in float i_timeLeftFraction;
+
+// Light definition.
+struct Light
+{
+	vec3 position;
+	vec3 color;
+};
+
+// Values that are the same for every object in a frame, shared by all
+// shader programs (see Engine::Renderer::FrameUniforms).
+layout(std140) uniform FrameUniforms
+{
+	mat4 projectionMatrix;
+	mat4 viewMatrix;
+	Light light;
+	float currentTime;
+};
+
+// Transformation matrices for the nodes in the palette, selected by each
+// vertex's node index (see Engine::Model::MaxPaletteNodes).
+uniform mat4 nodeTransformations[32];
+
+// Values to pass to fragment shader.
+out vec3 f_vertPosition;
+out vec3 f_vertNormal;
+out vec4 f_vertColor;
+out vec3 f_vertTextureCoordinates;
+flat out float f_timeLeftFraction;
+
+// Decodes an octahedral encoded unit vector.
+vec3 decodeNormal(vec2 encoded)
+{
+	vec3 normal = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+	if (normal.z < 0.0)
+	{
+		normal.xy = (1.0 - abs(normal.yx)) * vec2(encoded.x < 0.0 ? -1.0 : 1.0, encoded.y < 0.0 ? -1.0 : 1.0);
+	}
+
+	return normalize(normal);
+}
+
+void main()
+{
+	mat4 nodeTransformation = nodeTransformations[v_vertNodeIndex];
+	f_vertPosition = vec3(viewMatrix * i_modelMatrix * nodeTransformation * vec4(v_vertPosition, 1.0));
+	f_vertNormal = normalize(i_normalMatrix * mat3(nodeTransformation) * decodeNormal(v_vertNormal));
+	f_vertColor = v_vertColor;
+	f_vertTextureCoordinates = vec3(v_vertTextureCoordinates, 0.0);
+	f_timeLeftFraction = i_timeLeftFraction;
+
+	gl_Position = projectionMatrix * vec4(f_vertPosition, 1.0);
+}
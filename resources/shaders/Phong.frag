@@ -5,6 +5,16 @@ struct Light
 	vec3 color;
 };
 
+// Values that are the same for every object in a frame, shared by all
+// shader programs (see Engine::Renderer::FrameUniforms).
+layout(std140) uniform FrameUniforms
+{
+	mat4 projectionMatrix;
+	mat4 viewMatrix;
+	Light light;
+	float currentTime;
+};
+
 // Material definition.
 struct Material
 {
@@ -21,15 +31,9 @@ in vec3 f_vertNormal;
 in vec4 f_vertColor;
 in vec3 f_vertTextureCoordinates;
 
-// Current time (seconds).
-uniform float currentTime;
-
 // Material for the mesh.
 uniform Material material;
 
-// Directional light.
-uniform Light light;
-
 // Texture flag.
 uniform int useTexture;
 
@@ -0,0 +1,9 @@
+if [ "${PWD##*/}" == "build" ]; then
+	echo "== Baking Models =="
+	cd ..
+	find resources/models -name "*.dae" -exec ./build/bin/model-bake {} +
+else
+	echo "Sorry, this script must be run from the 'build' directory."
+	echo "You are trying to run this script from the ${PWD##*/} directory"
+	exit 1
+fi
@@ -0,0 +1,9 @@
+if [ "${PWD##*/}" == "build" ]; then
+	echo "== Packing Resources =="
+	cd ..
+	./build/bin/resource-pack --lz4 resources.pack resources
+else
+	echo "Sorry, this script must be run from the 'build' directory."
+	echo "You are trying to run this script from the ${PWD##*/} directory"
+	exit 1
+fi
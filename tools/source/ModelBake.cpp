@@ -0,0 +1,41 @@
+#include <iostream>
+#include <string>
+
+#include <Engine/Model.hpp>
+
+/**
+ * Converts each of the source models named on the command line to a baked
+ * model, which is written next to the source model. The game loads baked
+ * models without going through ASSIMP.
+ *
+ * Usage: model-bake <model>...
+ */
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " <model>..." << std::endl;
+		return 1;
+	}
+
+	int failures = 0;
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string filepath(argv[i]);
+		const std::string bakedFilepath = Engine::Model::GetBakedFilepath(filepath);
+
+		// Import the source model with ASSIMP. The model must not be
+		// transformed before it is baked.
+		Engine::Model model;
+		if (!model.Decode(filepath) || !model.SaveBaked(bakedFilepath))
+		{
+			std::cerr << "Failed baking \"" << filepath << "\"" << std::endl;
+			++failures;
+			continue;
+		}
+
+		std::cout << filepath << " -> " << bakedFilepath << std::endl;
+	}
+
+	return failures == 0 ? 0 : 1;
+}
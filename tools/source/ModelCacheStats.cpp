@@ -0,0 +1,121 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+
+#include <Engine/MeshOptimizer.hpp>
+#include <Engine/Model.hpp>
+
+/**
+ * Vertex cache totals for a model.
+ */
+struct CacheStats
+{
+	double misses;
+	std::size_t triangles;
+};
+
+/**
+ * Adds the cache misses and triangles of a mesh to the totals.
+ *
+ * @param indices Vertex indices of the mesh.
+ * @param vertexCount Number of vertices in the mesh.
+ * @param stats Totals.
+ */
+static void AddMesh(const std::vector<unsigned int>& indices, std::size_t vertexCount, CacheStats& stats)
+{
+	const float acmr = Engine::MeshOptimizer::CalculateAcmr(indices, vertexCount, Engine::MeshOptimizer::DefaultCacheSize);
+	stats.misses += acmr * (indices.size() / 3);
+	stats.triangles += indices.size() / 3;
+}
+
+/**
+ * Returns the average cache miss ratio of totals.
+ *
+ * @param stats Totals.
+ * @return Average cache miss ratio.
+ */
+static double GetAcmr(const CacheStats& stats)
+{
+	return stats.triangles > 0 ? stats.misses / stats.triangles : 0.0;
+}
+
+/**
+ * Reports the average post-transform vertex cache miss ratio (ACMR) of
+ * models, in the triangle order that the exporter wrote and in the order that
+ * the model is drawn in after import.
+ *
+ * Usage: model-cache-stats <model>...
+ */
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " <model>..." << std::endl;
+		return 1;
+	}
+
+	std::cout << std::left << std::setw(56) << "Model" << std::right
+		<< std::setw(12) << "Triangles"
+		<< std::setw(10) << "Before"
+		<< std::setw(10) << "After" << std::endl;
+	std::cout << std::fixed << std::setprecision(3);
+
+	CacheStats totalBefore = {0.0, 0};
+	CacheStats totalAfter = {0.0, 0};
+	int failures = 0;
+	for (int i = 1; i < argc; ++i)
+	{
+		Engine::Model model;
+		Assimp::Importer importer;
+		const aiScene* scene = importer.ReadFile(argv[i], aiProcess_Triangulate | aiProcess_JoinIdenticalVertices);
+		if (!scene || !model.Decode(argv[i]))
+		{
+			std::cerr << "Failed loading \"" << argv[i] << "\"" << std::endl;
+			++failures;
+			continue;
+		}
+
+		CacheStats before = {0.0, 0};
+		for (unsigned int m = 0; m < scene->mNumMeshes; ++m)
+		{
+			const aiMesh* mesh = scene->mMeshes[m];
+			std::vector<unsigned int> indices;
+			for (unsigned int f = 0; f < mesh->mNumFaces; ++f)
+			{
+				if (mesh->mFaces[f].mNumIndices == 3)
+				{
+					indices.insert(indices.end(), mesh->mFaces[f].mIndices, mesh->mFaces[f].mIndices + 3);
+				}
+			}
+			AddMesh(indices, mesh->mNumVertices, before);
+		}
+
+		CacheStats after = {0.0, 0};
+		for (const std::shared_ptr<Engine::Model::Node::Mesh>& mesh : model.GetFlatMeshes())
+		{
+			AddMesh(mesh->GetVertexIndices(), mesh->GetVerticesCount(), after);
+		}
+
+		std::cout << std::left << std::setw(56) << argv[i] << std::right
+			<< std::setw(12) << after.triangles
+			<< std::setw(10) << GetAcmr(before)
+			<< std::setw(10) << GetAcmr(after) << std::endl;
+
+		totalBefore.misses += before.misses;
+		totalBefore.triangles += before.triangles;
+		totalAfter.misses += after.misses;
+		totalAfter.triangles += after.triangles;
+	}
+
+	std::cout << std::left << std::setw(56) << "Total" << std::right
+		<< std::setw(12) << totalAfter.triangles
+		<< std::setw(10) << GetAcmr(totalBefore)
+		<< std::setw(10) << GetAcmr(totalAfter) << std::endl;
+
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,110 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include <Engine/Model.hpp>
+
+/**
+ * Returns the average time taken to load the model (in milliseconds).
+ *
+ * @param filepath Path to the model file.
+ * @param iterations Number of times to load the model.
+ * @param baked Load the baked model rather than the source model?
+ * @return Average load time (in milliseconds), or a negative value if the
+ * model failed to load.
+ */
+double MeasureLoadTime(const std::string& filepath, unsigned int iterations, bool baked)
+{
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for (unsigned int i = 0; i < iterations; ++i)
+	{
+		Engine::Model model;
+		const bool success = baked ? model.DecodeBaked(filepath) : model.Decode(filepath);
+		if (!success)
+		{
+			return -1.0;
+		}
+	}
+
+	const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+	return elapsed.count() / iterations;
+}
+
+/**
+ * Compares the time taken to import source models with ASSIMP against the time
+ * taken to load the equivalent baked models. Models are decoded only; nothing
+ * is sent to the graphics card.
+ *
+ * Usage: model-load-benchmark [iterations] [model...]
+ *
+ * The test models in resources/models/tests are used if no models are
+ * specified, so this should be run from the project root directory.
+ */
+int main(int argc, char* argv[])
+{
+	unsigned int iterations = 50;
+	std::vector<std::string> filepaths;
+
+	if (argc > 1)
+	{
+		iterations = std::max(1, std::atoi(argv[1]));
+	}
+
+	for (int i = 2; i < argc; ++i)
+	{
+		filepaths.push_back(argv[i]);
+	}
+
+	if (filepaths.empty())
+	{
+		filepaths.push_back("resources/models/tests/SimpleTranslation.dae");
+		filepaths.push_back("resources/models/tests/SimpleRotation.dae");
+		filepaths.push_back("resources/models/tests/SimpleCombined.dae");
+	}
+
+	std::cout << std::fixed << std::setprecision(3);
+	std::cout << "Average load time over " << iterations << " iterations (ms)" << std::endl;
+
+	int failures = 0;
+	for (auto iter = filepaths.begin(); iter != filepaths.end(); ++iter)
+	{
+		const std::string& filepath = *iter;
+
+		// Bake the model to a scratch file next to the source model, so that
+		// relative texture paths resolve in the same way, without touching
+		// any existing baked model.
+		const std::string bakedFilepath = filepath + ".benchmark.model";
+		Engine::Model model;
+		if (!model.Decode(filepath) || !model.SaveBaked(bakedFilepath))
+		{
+			std::cerr << "Failed baking \"" << filepath << "\"" << std::endl;
+			++failures;
+			continue;
+		}
+
+		const double sourceTime = MeasureLoadTime(filepath, iterations, false);
+		const double bakedTime = MeasureLoadTime(bakedFilepath, iterations, true);
+		std::remove(bakedFilepath.c_str());
+
+		if (sourceTime < 0.0 || bakedTime < 0.0)
+		{
+			std::cerr << "Failed loading \"" << filepath << "\"" << std::endl;
+			++failures;
+			continue;
+		}
+
+		std::cout << filepath
+			<< "  source: " << sourceTime
+			<< "  baked: " << bakedTime
+			<< "  speedup: " << std::setprecision(1) << sourceTime / bakedTime << "x"
+			<< std::setprecision(3) << std::endl;
+	}
+
+	return failures == 0 ? 0 : 1;
+}
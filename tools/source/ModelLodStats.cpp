@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <memory>
+
+#include <Engine/Model.hpp>
+
+/**
+ * Reports the number of triangles drawn for one instance of a model at each
+ * level of detail. Meshes with fewer levels are drawn at their lowest level.
+ *
+ * Usage: model-lod-stats <model>...
+ */
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " <model>..." << std::endl;
+		return 1;
+	}
+
+	std::cout << std::left << std::setw(56) << "Model" << std::right;
+	for (unsigned int l = 0; l < Engine::Model::MaxLodCount; ++l)
+	{
+		std::cout << std::setw(12) << ("LOD " + std::to_string(l));
+	}
+	std::cout << std::endl;
+
+	std::vector<std::size_t> total(Engine::Model::MaxLodCount, 0);
+	int failures = 0;
+	for (int i = 1; i < argc; ++i)
+	{
+		Engine::Model model;
+		if (!model.Decode(argv[i]))
+		{
+			std::cerr << "Failed loading \"" << argv[i] << "\"" << std::endl;
+			++failures;
+			continue;
+		}
+
+		std::vector<std::size_t> triangles(Engine::Model::MaxLodCount, 0);
+		for (const Engine::Model::MaterialGroup& group : model.GetMaterialGroups())
+		{
+			for (const Engine::Model::MaterialGroup::Part& part : group.parts)
+			{
+				const std::shared_ptr<Engine::Model::Node::Mesh>& mesh = model.GetFlatMeshes()[part.mesh];
+				for (unsigned int l = 0; l < Engine::Model::MaxLodCount; ++l)
+				{
+					triangles[l] += mesh->GetLodIndices(std::min(l, mesh->GetLodCount() - 1)).size() / 3;
+				}
+			}
+		}
+
+		std::cout << std::left << std::setw(56) << argv[i] << std::right;
+		for (unsigned int l = 0; l < Engine::Model::MaxLodCount; ++l)
+		{
+			std::cout << std::setw(12) << triangles[l];
+			total[l] += triangles[l];
+		}
+		std::cout << std::endl;
+	}
+
+	std::cout << std::left << std::setw(56) << "Total" << std::right;
+	for (unsigned int l = 0; l < Engine::Model::MaxLodCount; ++l)
+	{
+		std::cout << std::setw(12) << total[l];
+	}
+	std::cout << std::endl;
+
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,104 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <memory>
+
+#include <Engine/Model.hpp>
+
+/**
+ * Vertex data totals for a model.
+ */
+struct VertexStats
+{
+	std::size_t vertices;
+	std::size_t indices;
+	std::size_t separateBytes;
+	std::size_t packedBytes;
+};
+
+/**
+ * Adds the vertex data of the meshes in a node, and its descendants, to the
+ * totals.
+ *
+ * @param node The node.
+ * @param stats Totals.
+ */
+static void AddNode(const std::shared_ptr<Engine::Model::Node>& node, VertexStats& stats)
+{
+	for (unsigned int m = 0; m < node->GetMeshCount(); ++m)
+	{
+		const std::shared_ptr<Engine::Model::Node::Mesh> mesh = node->GetMesh(m);
+		stats.vertices += mesh->GetVerticesCount();
+		stats.indices += mesh->GetIndicesCount();
+
+		// Separate float3 position, normal and texture coordinate buffers
+		// with 32-bit indices.
+		stats.separateBytes += mesh->GetVerticesCount() * sizeof(glm::vec3) * 3
+			+ mesh->GetIndicesCount() * sizeof(unsigned int);
+		stats.packedBytes += mesh->GetVertexBufferSize() + mesh->GetIndexBufferSize();
+	}
+
+	for (unsigned int c = 0; c < node->GetChildNodeCount(); ++c)
+	{
+		AddNode(node->GetChildNode(c), stats);
+	}
+}
+
+/**
+ * Reports the graphics memory taken by the vertex data of models, both as
+ * separate float buffers with 32-bit indices and in the packed interleaved
+ * layout that is uploaded. Every vertex is fetched at least once per draw,
+ * so this is also the least vertex fetch bandwidth per drawn instance.
+ *
+ * Usage: model-vertex-stats <model>...
+ */
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " <model>..." << std::endl;
+		return 1;
+	}
+
+	std::cout << std::left << std::setw(56) << "Model" << std::right
+		<< std::setw(10) << "Vertices"
+		<< std::setw(10) << "Indices"
+		<< std::setw(12) << "Before"
+		<< std::setw(12) << "After" << std::endl;
+
+	VertexStats total = {0, 0, 0, 0};
+	int failures = 0;
+	for (int i = 1; i < argc; ++i)
+	{
+		Engine::Model model;
+		if (!model.Decode(argv[i]))
+		{
+			std::cerr << "Failed loading \"" << argv[i] << "\"" << std::endl;
+			++failures;
+			continue;
+		}
+
+		VertexStats stats = {0, 0, 0, 0};
+		AddNode(model.GetRootNode(), stats);
+
+		std::cout << std::left << std::setw(56) << argv[i] << std::right
+			<< std::setw(10) << stats.vertices
+			<< std::setw(10) << stats.indices
+			<< std::setw(12) << stats.separateBytes
+			<< std::setw(12) << stats.packedBytes << std::endl;
+
+		total.vertices += stats.vertices;
+		total.indices += stats.indices;
+		total.separateBytes += stats.separateBytes;
+		total.packedBytes += stats.packedBytes;
+	}
+
+	std::cout << std::left << std::setw(56) << "Total" << std::right
+		<< std::setw(10) << total.vertices
+		<< std::setw(10) << total.indices
+		<< std::setw(12) << total.separateBytes
+		<< std::setw(12) << total.packedBytes << std::endl;
+
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,103 @@
+#include <iostream>
+#include <string>
+#include <cstring>
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <Engine/ResourcePackWriter.hpp>
+
+/**
+ * Adds a file to the pack, or every file beneath a directory.
+ *
+ * @param writer Pack being built.
+ * @param path Path to the file or directory.
+ * @param compress Try to compress the files with LZ4?
+ * @return True if every file was added.
+ */
+static bool AddPath(Engine::ResourcePackWriter& writer, const std::string& path, bool compress)
+{
+	struct stat status;
+	if (stat(path.c_str(), &status) != 0)
+	{
+		std::cerr << "ERROR: Unable to find \"" << path << "\"" << std::endl;
+		return false;
+	}
+
+	if (!S_ISDIR(status.st_mode))
+	{
+		return writer.AddFile(path, compress);
+	}
+
+	DIR* directory = opendir(path.c_str());
+	if (!directory)
+	{
+		std::cerr << "ERROR: Unable to open directory \"" << path << "\"" << std::endl;
+		return false;
+	}
+
+	bool success = true;
+	while (dirent* entry = readdir(directory))
+	{
+		// Skip this directory, the parent directory and hidden files.
+		if (entry->d_name[0] == '.')
+		{
+			continue;
+		}
+
+		success = AddPath(writer, path + "/" + entry->d_name, compress) && success;
+	}
+
+	closedir(directory);
+	return success;
+}
+
+/**
+ * Packs the files named on the command line into a single resource pack.
+ * Resources are stored under the paths given, so the packer should be run
+ * from the directory that the game is run from.
+ *
+ * Usage: resource-pack [--lz4] <output> <file-or-directory>...
+ */
+int main(int argc, char* argv[])
+{
+	int argument = 1;
+	bool compress = false;
+	if (argument < argc && std::strcmp(argv[argument], "--lz4") == 0)
+	{
+		compress = true;
+		++argument;
+	}
+
+	if (argc - argument < 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " [--lz4] <output> <file-or-directory>..." << std::endl;
+		return 1;
+	}
+
+	const std::string outputFilepath(argv[argument++]);
+
+	Engine::ResourcePackWriter writer;
+	bool success = true;
+	for (; argument < argc; ++argument)
+	{
+		// Strip any trailing slashes so that the stored paths match the ones
+		// used by the game.
+		std::string path(argv[argument]);
+		while (path.size() > 1 && path[path.size() - 1] == '/')
+		{
+			path.erase(path.size() - 1);
+		}
+
+		success = AddPath(writer, path, compress) && success;
+	}
+
+	if (!success || !writer.Save(outputFilepath))
+	{
+		std::cerr << "Failed packing \"" << outputFilepath << "\"" << std::endl;
+		return 1;
+	}
+
+	std::cout << writer.GetResourceCount() << " resources -> " << outputFilepath << std::endl;
+	return 0;
+}